@@ -1,57 +1,72 @@
 #include "json_evented.h"
 
-#include <cctype>
+#include <cstdio>
 #include <cstdlib>
-#include <utility>
+#include <cstring>
+#include <new>
 
 namespace {
+// Buffered character source. get()/peek() are inline pointer reads; the
+// ReadBlock callback only runs when the buffer drains, once per block.
+// String input is parsed in place with no callback at all.
 class CharStream {
 public:
-  explicit CharStream(JsonVisitor::NextChar nextChar) : nextChar_(std::move(nextChar)) {}
+  CharStream(const char* data, size_t size) : cur_(data), end_(data + size) {}
+  CharStream(const JsonVisitor::ReadBlock& readBlock, char* buffer, size_t capacity)
+      : readBlock_(&readBlock), buffer_(buffer), capacity_(capacity) {}
 
   bool get(char& c) {
-    if (hasBuffered_) {
-      hasBuffered_ = false;
-      c = buffered_;
-      return true;
-    }
-    int value = nextChar_();
-    if (value < 0) {
-      return false;
-    }
-    c = static_cast<char>(value);
+    if (cur_ == end_ && !refill()) return false;
+    c = *cur_++;
     return true;
   }
 
   bool peek(char& c) {
-    if (hasBuffered_) {
-      c = buffered_;
-      return true;
-    }
-    int value = nextChar_();
-    if (value < 0) {
-      return false;
-    }
-    buffered_ = static_cast<char>(value);
-    hasBuffered_ = true;
-    c = buffered_;
+    if (cur_ == end_ && !refill()) return false;
+    c = *cur_;
     return true;
   }
 
+  void skip() { ++cur_; }
+
   void skipWhitespace() {
-    char c;
-    while (peek(c)) {
-      if (!std::isspace(static_cast<unsigned char>(c))) break;
-      hasBuffered_ = false;
+    while (cur_ != end_ || refill()) {
+      char c = *cur_;
+      if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+      ++cur_;
     }
   }
 
+  // Scratch buffers reused for every key and string value.
+  std::string key;
+  std::string text;
+
 private:
-  JsonVisitor::NextChar nextChar_;
-  char buffered_ = 0;
-  bool hasBuffered_ = false;
+  bool refill() {
+    if (!readBlock_) return false;
+    size_t n = (*readBlock_)(buffer_, capacity_);
+    if (n == 0 || n > capacity_) {
+      readBlock_ = nullptr;
+      return false;
+    }
+    cur_ = buffer_;
+    end_ = buffer_ + n;
+    return true;
+  }
+
+  const char* cur_ = nullptr;
+  const char* end_ = nullptr;
+  const JsonVisitor::ReadBlock* readBlock_ = nullptr;
+  char* buffer_ = nullptr;
+  size_t capacity_ = 0;
 };
 
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool isHexDigit(char c) {
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
 bool parseValue(CharStream& stream, JsonObserver& observer);
 
 bool parseLiteral(CharStream& stream, const char* literal) {
@@ -89,7 +104,7 @@ bool parseString(CharStream& stream, std::string& out) {
       case 'u': {
         // Minimal \uXXXX handling: consume four hex digits and skip unicode conversion.
         for (int i = 0; i < 4; ++i) {
-          if (!stream.get(esc) || !std::isxdigit(static_cast<unsigned char>(esc))) return false;
+          if (!stream.get(esc) || !isHexDigit(esc)) return false;
         }
         out.push_back('?');
         break;
@@ -105,31 +120,47 @@ bool parseString(CharStream& stream, std::string& out) {
 }
 
 bool parseNumber(CharStream& stream, JsonObserver& observer, char firstChar) {
-  std::string numStr;
-  numStr.push_back(firstChar);
+  char buf[64];
+  size_t len = 0;
+  buf[len++] = firstChar;
+  bool isFloat = false;
   char c;
   while (stream.peek(c)) {
-    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
-      stream.get(c);
-      numStr.push_back(c);
-    } else {
+    if (c == '.' || c == 'e' || c == 'E') {
+      isFloat = true;
+    } else if (!isDigit(c) && c != '+' && c != '-') {
       break;
     }
+    if (len + 1 >= sizeof(buf)) return false;
+    stream.skip();
+    buf[len++] = c;
   }
+  buf[len] = '\0';
 
-  bool isFloat = (numStr.find('.') != std::string::npos) || (numStr.find('e') != std::string::npos) ||
-                 (numStr.find('E') != std::string::npos);
-  const char* start = numStr.c_str();
   char* endPtr = nullptr;
   if (isFloat) {
-    double value = std::strtod(start, &endPtr);
-    if (endPtr != start + static_cast<int>(numStr.size())) return false;
+    double value = std::strtod(buf, &endPtr);
+    if (endPtr != buf + len) return false;
     observer.onNumber(value);
-  } else {
-    long long value = std::strtoll(start, &endPtr, 10);
-    if (endPtr != start + static_cast<int>(numStr.size())) return false;
+    return true;
+  }
+  if (len > 18) {
+    long long value = std::strtoll(buf, &endPtr, 10);
+    if (endPtr != buf + len) return false;
     observer.onNumber(static_cast<int>(value));
+    return true;
   }
+  // Integers are most of a scene file; convert without strtoll.
+  const char* p = buf;
+  bool negative = *p == '-';
+  if (negative) ++p;
+  if (p == buf + len) return false;
+  long long value = 0;
+  for (; p < buf + len; ++p) {
+    if (!isDigit(*p)) return false;
+    value = value * 10 + (*p - '0');
+  }
+  observer.onNumber(static_cast<int>(negative ? -value : value));
   return true;
 }
 
@@ -138,7 +169,7 @@ bool parseArray(CharStream& stream, JsonObserver& observer) {
   stream.skipWhitespace();
   char c;
   if (stream.peek(c) && c == ']') {
-    stream.get(c);
+    stream.skip();
     observer.onArrayEnd();
     return true;
   }
@@ -169,7 +200,7 @@ bool parseObject(CharStream& stream, JsonObserver& observer) {
   stream.skipWhitespace();
   char c;
   if (stream.peek(c) && c == '}') {
-    stream.get(c);
+    stream.skip();
     observer.onObjectEnd();
     return true;
   }
@@ -183,9 +214,8 @@ bool parseObject(CharStream& stream, JsonObserver& observer) {
       printf("JsonVisitor::parseObject: Expected '\"' (key start), got '%c' (%d)\n", c, (int)c);
       return false;
     }
-    std::string key;
-    if (!parseString(stream, key)) return false;
-    observer.onObjectKey(key);
+    if (!parseString(stream, stream.key)) return false;
+    observer.onObjectKey(stream.key);
     stream.skipWhitespace();
     if (!stream.get(c) || c != ':') {
       printf("JsonVisitor::parseObject: Expected ':', got '%c' (%d)\n", c, (int)c);
@@ -224,12 +254,10 @@ bool parseValue(CharStream& stream, JsonObserver& observer) {
     return parseObject(stream, observer);
   case '[':
     return parseArray(stream, observer);
-  case '"': {
-    std::string value;
-    if (!parseString(stream, value)) return false;
-    observer.onString(value);
+  case '"':
+    if (!parseString(stream, stream.text)) return false;
+    observer.onString(stream.text);
     return true;
-  }
   case 't':
     if (!parseLiteral(stream, "rue")) return false;
     observer.onBool(true);
@@ -243,28 +271,35 @@ bool parseValue(CharStream& stream, JsonObserver& observer) {
     observer.onNull();
     return true;
   default:
-    if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
+    if (c == '-' || isDigit(c)) {
       return parseNumber(stream, observer, c);
     }
     printf("JsonVisitor::parseValue: Unexpected character '%c' (%d)\n", c, (int)c);
     return false;
   }
 }
-} // namespace
 
-bool JsonVisitor::parse(const std::string& input, JsonObserver& observer) {
-  size_t idx = 0;
-  auto nextChar = [&input, &idx]() -> int {
-    if (idx >= input.size()) return -1;
-    return static_cast<unsigned char>(input[idx++]);
-  };
-  return parseImpl(nextChar, observer);
-}
-
-bool JsonVisitor::parseImpl(NextChar nextChar, JsonObserver& observer) {
-  CharStream stream(std::move(nextChar));
+bool parseDocument(CharStream& stream, JsonObserver& observer) {
   if (!parseValue(stream, observer)) return false;
   stream.skipWhitespace();
   char extra;
   return !stream.peek(extra);
 }
+} // namespace
+
+bool JsonVisitor::parse(const std::string& input, JsonObserver& observer) {
+  CharStream stream(input.data(), input.size());
+  return parseDocument(stream, observer);
+}
+
+bool JsonVisitor::parseBlocks(const ReadBlock& readBlock, JsonObserver& observer) {
+  // One heap block per parse; a small stack buffer if the heap is tight
+  // still works, just with more callback trips.
+  char fallback[128];
+  char* buffer = new (std::nothrow) char[kReadBlockSize];
+  CharStream stream = buffer ? CharStream(readBlock, buffer, kReadBlockSize)
+                             : CharStream(readBlock, fallback, sizeof(fallback));
+  bool ok = parseDocument(stream, observer);
+  delete[] buffer;
+  return ok;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <string>
 
@@ -14,26 +16,56 @@ public:
   virtual void onNumber(double value) = 0;
   virtual void onBool(bool value) = 0;
   virtual void onNull() = 0;
+  // Strings and keys arrive in a buffer the parser reuses: copy, don't keep.
   virtual void onString(const std::string& value) = 0;
   virtual void onObjectKey(const std::string& key) = 0;
   virtual void onObjectValueStart() = 0;
   virtual void onObjectValueEnd() = 0;
 };
 
+namespace json_detail {
+// Block read from anything with read(uint8_t*, size_t) (Arduino File,
+// Stream), else byte by byte through read(). Returns 0 at end of input.
+template <typename Stream>
+auto readBlockImpl(Stream& stream, char* dst, size_t cap, int)
+    -> decltype(stream.read(reinterpret_cast<uint8_t*>(dst), cap), size_t()) {
+  auto n = stream.read(reinterpret_cast<uint8_t*>(dst), cap);
+  return n > 0 ? static_cast<size_t>(n) : 0;
+}
+
+template <typename Stream>
+size_t readBlockImpl(Stream& stream, char* dst, size_t cap, long) {
+  size_t n = 0;
+  while (n < cap) {
+    int c = stream.read();
+    if (c < 0) break;
+    dst[n++] = static_cast<char>(c);
+  }
+  return n;
+}
+
+template <typename Stream>
+size_t readBlock(Stream& stream, char* dst, size_t cap) {
+  return readBlockImpl(stream, dst, cap, 0);
+}
+} // namespace json_detail
+
+// Streaming JSON parser. Input is pulled in kReadBlockSize blocks, so a
+// source is called once per block rather than once per byte, and the
+// per-character path is a plain buffer read.
 class JsonVisitor {
 public:
-  using NextChar = std::function<int()>;
+  // Fills dst with up to cap bytes; returns 0 at end of input.
+  using ReadBlock = std::function<size_t(char* dst, size_t cap)>;
+  static constexpr size_t kReadBlockSize = 4096;
 
   bool parse(const std::string& input, JsonObserver& observer);
+  bool parseBlocks(const ReadBlock& readBlock, JsonObserver& observer);
 
   template <typename Stream>
   bool parse(Stream& stream, JsonObserver& observer) {
-    auto nextChar = [&stream]() -> int {
-      return stream.read();
-    };
-    return parseImpl(nextChar, observer);
+    return parseBlocks([&stream](char* dst, size_t cap) -> size_t {
+      return json_detail::readBlock(stream, dst, cap);
+    }, observer);
   }
-
-private:
-  bool parseImpl(NextChar nextChar, JsonObserver& observer);
 };
@@ -18,6 +18,7 @@
 #include "src/ui/led_manager.h"
 #include "src/audio/audio_diagnostics.h"
 #include "src/ui/key_normalize.h"
+#include <atomic>
 #include <new>
 
 static constexpr IGfxColor CP_BLACK = IGfxColor::Black();
@@ -26,14 +27,17 @@ CardputerDisplay g_display;
 MiniAcidDisplay* g_miniDisplay = nullptr;
 SceneStorageCardputer g_sceneStorage;
 CardputerAudioRecorder* g_audioRecorder = nullptr;
-#include "src/sampler/ram_sample_store.h"
+#include "src/sampler/streaming_sample_store.h"
 #include "src/audio/audio_out_i2s.h"
-RamSampleStore g_sampleStore;
+StreamingSampleStore g_sampleStore;
 
 static AudioOutI2S g_audioOut;
-static int16_t g_audioBuffer[kBlockFrames];
+static int16_t g_audioBuffer[kMaxBlockFrames];
 
 TaskHandle_t g_audioTaskHandle = nullptr;
+// UI -> audio task: park between blocks so the UI can re-configure audio.
+static std::atomic<bool> g_audioPauseRequest{false};
+static std::atomic<bool> g_audioParked{false};
 
 // Static engine instance to avoid heap fragmentation
 static MiniAcid g_miniAcidInstance(kSampleRate, &g_sceneStorage);
@@ -59,25 +63,41 @@ void audioTask(void *param) {
   Serial.println("AudioTask: Starting...");
 
   // Initialize I2S audio output
-  if (!g_audioOut.begin(kSampleRate, kBlockFrames)) {
+  AudioConfig config = g_miniAcid ? g_miniAcid->audioConfig() : AudioConfig{};
+  if (!g_audioOut.begin(config.sampleRate, config.blockFrames)) {
     Serial.println("[FATAL] I2S audio init failed");
     while (true) { delay(1000); }
   }
   Serial.println("AudioTask: Loop start");
+  uint32_t warmupBlocks = 32; // ~90ms at 44.1kHz/128 for hardware stability
   
   while (true) {
+    // The UI thread re-configures I2S and the engine (serviceAudioConfig())
+    // while this task is parked between blocks.
+    if (g_audioPauseRequest.load(std::memory_order_acquire)) {
+      g_audioParked.store(true, std::memory_order_release);
+      while (g_audioPauseRequest.load(std::memory_order_acquire)) vTaskDelay(1);
+      if (g_miniAcid) {
+        g_miniAcid->attachAudioThread();
+        config = g_miniAcid->audioConfig();
+        g_miniAcid->perfStats.lastCallbackMicros = 0;
+      }
+      warmupBlocks = 4;
+      g_audioParked.store(false, std::memory_order_release);
+    }
+    const size_t frames = config.blockFrames;
+
     uint32_t now = micros();
     uint32_t start = now;
-    static uint32_t warmupBlocks = 32; // ~90ms at 44.1kHz/128 for hardware stability
 
     if (warmupBlocks > 0) {
-      std::fill(g_audioBuffer, g_audioBuffer + kBlockFrames, 0);
+      std::fill(g_audioBuffer, g_audioBuffer + frames, 0);
       warmupBlocks--;
       if (warmupBlocks == 0) Serial.println("AudioTask: Warmup complete");
     } else if (g_miniAcid) {
-      g_miniAcid->generateAudioBuffer(g_audioBuffer, kBlockFrames);
+      g_miniAcid->generateAudioBuffer(g_audioBuffer, frames);
     } else {
-      std::fill(g_audioBuffer, g_audioBuffer + kBlockFrames, 0);
+      std::fill(g_audioBuffer, g_audioBuffer + frames, 0);
     }
     
     uint32_t dsp_time = micros() - start;
@@ -85,7 +105,7 @@ void audioTask(void *param) {
     // Update performance stats
     if (g_miniAcid) {
         auto& stats = g_miniAcid->perfStats;
-        constexpr uint32_t ideal_period_us = (1000000UL * kBlockFrames) / kSampleRate;
+        const uint32_t ideal_period_us = config.blockBudgetUs();
         uint32_t actual_period_us = (stats.lastCallbackMicros > 0) ? (now - stats.lastCallbackMicros) : ideal_period_us;
         
         static int heartbeat = 0;
@@ -104,7 +124,7 @@ void audioTask(void *param) {
     }
 
     if (g_audioRecorder) {
-      g_audioRecorder->writeSamples(g_audioBuffer, kBlockFrames);
+      g_audioRecorder->writeSamples(g_audioBuffer, frames);
     }
     
     if (AudioDiagnostics::instance().isEnabled()) {
@@ -112,7 +132,7 @@ void audioTask(void *param) {
     }
 
     // Write to I2S
-    if (!g_audioOut.writeMono16(g_audioBuffer, kBlockFrames)) {
+    if (!g_audioOut.writeMono16(g_audioBuffer, frames)) {
       static uint32_t lastErrorLog = 0;
       if (millis() - lastErrorLog > 1000) {
         Serial.println("[I2S] Write Timeout / Error");
@@ -128,6 +148,42 @@ void drawUI() {
   if (g_miniDisplay) g_miniDisplay->update();
 }
 
+// Runtime audio config (UI or block-size auto-tune). Re-opening I2S and
+// re-sizing the engine's buffers allocate, so both happen here with the
+// audio task parked, not on the audio task.
+static void serviceAudioConfig() {
+  AudioConfig requested;
+  if (!g_miniAcid || !g_miniAcid->takeAudioConfigRequest(requested)) return;
+  const AudioConfig current = g_miniAcid->audioConfig();
+
+  g_audioPauseRequest.store(true, std::memory_order_release);
+  while (!g_audioParked.load(std::memory_order_acquire)) vTaskDelay(1);
+
+  if (requested.sampleRate != current.sampleRate || requested.blockFrames != current.blockFrames) {
+    // A recording at the old rate was already closed by the UI before it
+    // posted the request (stop() blocks, so it never runs here).
+    g_audioOut.end();
+    if (!g_audioOut.begin(requested.sampleRate, requested.blockFrames)) {
+      Serial.printf("[AUDIO] %u Hz / %u frames failed, keeping %u / %u\n",
+                    (unsigned)requested.sampleRate, (unsigned)requested.blockFrames,
+                    (unsigned)current.sampleRate, (unsigned)current.blockFrames);
+      requested.sampleRate = current.sampleRate;
+      requested.blockFrames = current.blockFrames;
+      g_audioOut.begin(current.sampleRate, current.blockFrames);
+    }
+  }
+  // Parked, so the setters applyAudioConfig() runs apply right here.
+  g_miniAcid->detachAudioThread();
+  bool buffersOk = g_miniAcid->applyAudioConfig(requested);
+
+  // Wait until the audio task has claimed the engine again, so no setter
+  // from this thread applies directly under its first block.
+  g_audioPauseRequest.store(false, std::memory_order_release);
+  while (g_audioParked.load(std::memory_order_acquire)) vTaskDelay(1);
+
+  if (!buffersOk && g_miniDisplay) g_miniDisplay->showToast("Looper off: no memory", 2500);
+}
+
 static void logHeapCaps(const char* tag) {
   auto freeInt  = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
   auto largInt  = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
@@ -264,9 +320,12 @@ void setup() {
   }
   markBootStage(61, "after sample scan");
 
+  // Samples larger than the pool stream from SD (needs PSRAM for the pages).
+  g_sampleStore.beginStreaming();
+
   for (const auto& file : g_miniAcid->sampleIndex.getFiles()) {
       Serial.printf("Found sample: %s (id=%u)\n", file.filename.c_str(), file.id.value);
-      // Register with RamSampleStore. 
+      // Register with the sample store. 
       // Note: "registerFile" just stores the path for lazy loading.
       g_sampleStore.registerFile(file.id, file.fullPath);
   }
@@ -287,17 +346,18 @@ void setup() {
   // Configure Audio Guard for synchronization
   AudioGuard guard;
   guard.lock = [](void*) {
-      // In a real dual-core ESP32 setup, we could use a mutex here
-      // For now, grooveputer uses a single-threaded DSP model with volatile flags
+      // No lock needed: MiniAcid setters called from this task are queued and
+      // applied by the audio task at the top of generateAudioBuffer.
   };
   guard.unlock = [](void*) {};
   g_miniDisplay->setAudioGuard(guard);
   
   Serial.println("7c. UI setAudioRecorder");
-  // Initialize audio recorder (done after other initialization to avoid boot issues)
-  // DISABLING FOR CRASH DEBUGGING
-  // g_audioRecorder = new CardputerAudioRecorder();
-  // g_miniDisplay->setAudioRecorder(g_audioRecorder);
+  // Initialize audio recorder (done after other initialization to avoid boot issues).
+  // Nothing is allocated until start(); the audio task only ever copies into
+  // the recorder's ring, SD writes happen on its own core-0 task.
+  g_audioRecorder = new CardputerAudioRecorder();
+  g_miniDisplay->setAudioRecorder(g_audioRecorder);
 
   Serial.println("8. Creating AudioTask...");
   markBootStage(80, "before AudioTask create");
@@ -338,6 +398,7 @@ void setup() {
 void loop() {
   M5Cardputer.update();
   LedManager::instance().update();
+  serviceAudioConfig();
 
   if (g_encoder8) g_encoder8->update();
 
@@ -620,6 +681,15 @@ void loop() {
     if (g_miniDisplay) g_miniDisplay->update();
   }
 
+  // Auto-save appends only what changed to the scene journal; a full
+  // snapshot, when due, is written by a background task.
+  static constexpr unsigned long AUTOSAVE_INTERVAL_MS = 30000;
+  static unsigned long lastAutosave = millis();
+  if (millis() - lastAutosave > AUTOSAVE_INTERVAL_MS) {
+    lastAutosave = millis();
+    if (g_miniAcid) g_miniAcid->autosaveScene();
+  }
+
   static unsigned long lastMemLog = 0;
   if (millis() - lastMemLog > 5000) {
     lastMemLog = millis();
@@ -0,0 +1,3 @@
+#pragma once
+// Desktop stand-in for the Arduino core header; the mocks live in arduino_compat.h.
+#include "arduino_compat.h"
@@ -0,0 +1,3 @@
+#pragma once
+// Desktop stand-in for the Arduino SD library header; the mock lives in arduino_compat.h.
+#include "arduino_compat.h"
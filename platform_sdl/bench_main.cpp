@@ -0,0 +1,392 @@
+// DSP microbenchmark: renders every synth engine, drum kit and FX block in
+// kBlockFrames blocks and reports ns/sample plus the share of the
+// kSampleRate/kBlockFrames realtime budget, as a table and as JSON.
+//
+// Before timing anything it checks that the vector master-bus kernel matches
+// the scalar reference bit for bit, and exits with status 1 if it does not.
+//
+// usage: miniacid_bench [--seconds S] [--json out.json | --json -] [--filter substr]
+//
+//   --seconds S     audio rendered per benchmark (default 10)
+//   --json FILE     also write machine-readable results ("-" = stdout)
+//   --filter STR    only run benchmarks whose name contains STR
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "../src/audio/audio_config.h"
+#include "../src/dsp/mini_tb303.h"
+#include "../src/dsp/sid_synth_voice.h"
+#include "../src/dsp/ay_synth_voice.h"
+#include "../src/dsp/opl2_synth_voice.h"
+#include "../src/dsp/mini_drumvoices.h"
+#include "../src/dsp/drum_reverb.h"
+#include "../src/dsp/tape_fx.h"
+#include "../src/dsp/tape_looper.h"
+#include "../src/dsp/tube_distortion.h"
+#include "../src/dsp/one_knob_compressor.h"
+#include "../src/dsp/transient_shaper.h"
+#include "../src/dsp/formant_synth.h"
+#include "../src/dsp/master_bus.h"
+#include "arduino_compat.h"
+
+SerialMock Serial;
+SDMock SD;
+
+// Sequencer-like trigger cadence: a 16th at 120 BPM.
+static constexpr size_t kStepFrames = kSampleRate / 8;
+
+struct BenchResult {
+  std::string name;
+  double nsPerSample;
+  double usPerBlock;
+  double budgetPct;
+};
+
+struct BenchConfig {
+  size_t frames = kSampleRate * 10;
+  std::string filter;
+};
+
+// One benchmark: 'block' renders n frames into buf (which holds the shared
+// test signal on entry), 'step' fires once per kStepFrames before the block
+// that crosses the boundary.
+struct Bench {
+  std::string name;
+  std::function<void(float* buf, size_t n)> block;
+  std::function<void(uint32_t step)> step;
+};
+
+static float gTestSignal[kBlockFrames];
+
+// Drum-bus-ish input for the FX blocks: decaying noise bursts over a saw.
+static void buildTestSignal() {
+  uint32_t seed = 0x1234567u;
+  float saw = 0.0f;
+  for (size_t i = 0; i < kBlockFrames; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    float noise = static_cast<float>(seed >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    float burst = 1.0f - static_cast<float>(i % 128) / 128.0f;
+    saw += 110.0f / kSampleRate;
+    if (saw >= 1.0f) saw -= 1.0f;
+    gTestSignal[i] = 0.4f * noise * burst * burst + 0.3f * (2.0f * saw - 1.0f);
+  }
+}
+
+static BenchResult runBench(const Bench& bench, const BenchConfig& cfg) {
+  float buf[kBlockFrames];
+  auto runFrames = [&](size_t frames, uint32_t& stepIndex, size_t& sinceStep) {
+    size_t done = 0;
+    while (done < frames) {
+      size_t n = std::min(static_cast<size_t>(kBlockFrames), frames - done);
+      if (sinceStep == 0 && bench.step) bench.step(stepIndex++);
+      std::memcpy(buf, gTestSignal, n * sizeof(float));
+      bench.block(buf, n);
+      done += n;
+      sinceStep += n;
+      if (sinceStep >= kStepFrames) sinceStep = 0;
+    }
+  };
+
+  uint32_t stepIndex = 0;
+  size_t sinceStep = 0;
+  runFrames(kSampleRate, stepIndex, sinceStep); // warm caches and envelopes
+
+  auto t0 = std::chrono::steady_clock::now();
+  runFrames(cfg.frames, stepIndex, sinceStep);
+  auto t1 = std::chrono::steady_clock::now();
+
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  BenchResult r;
+  r.name = bench.name;
+  r.nsPerSample = ns / static_cast<double>(cfg.frames);
+  r.usPerBlock = r.nsPerSample * kBlockFrames / 1000.0;
+  // Block budget is kBlockFrames / kSampleRate seconds, i.e. 1e9 / kSampleRate ns per sample.
+  r.budgetPct = r.nsPerSample * kSampleRate / 1e7;
+  return r;
+}
+
+static const float kNotes[8] = {55.0f, 110.0f, 65.41f, 130.81f, 73.42f, 146.83f, 82.41f, 98.0f};
+
+static void addSynthBench(std::vector<Bench>& out, const std::string& name,
+                          std::shared_ptr<IMonoSynthVoice> voice) {
+  Bench b;
+  b.name = name;
+  b.block = [voice](float* buf, size_t n) { voice->processBlock(buf, n); };
+  b.step = [voice](uint32_t step) {
+    // Mostly notes with some slides/accents, released every 4th step.
+    if ((step & 3) == 3) {
+      voice->release();
+      return;
+    }
+    voice->startNote(kNotes[step & 7], (step % 5) == 0, (step % 3) == 1);
+  };
+  out.push_back(b);
+}
+
+static void addDrumBench(std::vector<Bench>& out, const std::string& name,
+                         std::shared_ptr<DrumSynthVoice> kit) {
+  static const float kVolumes[8] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+  Bench b;
+  b.name = name;
+  b.block = [kit](float* buf, size_t n) { kit->renderBlock(buf, kVolumes, 0, n); };
+  b.step = [kit](uint32_t step) {
+    // Busy pattern so most voices ring at once (worst case for the bus).
+    bool accent = (step & 3) == 0;
+    if ((step & 3) == 0) kit->triggerKick(accent);
+    if ((step & 7) == 4) kit->triggerSnare(accent);
+    if ((step & 1) == 0) kit->triggerHat(accent);
+    if ((step & 7) == 6) kit->triggerOpenHat(accent);
+    if ((step & 15) == 10) kit->triggerMidTom(accent);
+    if ((step & 15) == 14) kit->triggerHighTom(accent);
+    if ((step & 7) == 3) kit->triggerRim(accent);
+    if ((step & 15) == 12) kit->triggerClap(accent);
+  };
+  out.push_back(b);
+}
+
+static void addTapeFxBench(std::vector<Bench>& out, const std::string& name, const TapeMacro& macro,
+                           uint8_t space = 0, uint8_t movement = 0) {
+  auto fx = std::make_shared<TapeFX>();
+  fx->applyMacro(macro);
+  fx->applyMinimalParams(space, movement, 0);
+  Bench b;
+  b.name = name;
+  b.block = [fx](float* buf, size_t n) {
+    for (size_t i = 0; i < n; ++i) buf[i] = fx->process(buf[i]);
+  };
+  out.push_back(b);
+}
+
+static std::vector<Bench> buildBenches() {
+  const float sr = static_cast<float>(kSampleRate);
+  std::vector<Bench> benches;
+
+  // TB303: one run per filter profile, taken from the FilterType option list.
+  {
+    TB303Voice probe(sr);
+    const Parameter& filterParam = probe.parameter(TB303ParamId::FilterType);
+    for (int i = 0; i < filterParam.optionCount(); ++i) {
+      auto voice = std::make_shared<TB303Voice>(sr);
+      voice->setParameter(TB303ParamId::FilterType, static_cast<float>(i));
+      addSynthBench(benches, std::string("tb303/") + voice->parameter(TB303ParamId::FilterType).optionLabel(),
+                    voice);
+    }
+  }
+  addSynthBench(benches, "sid", std::make_shared<SidSynthVoice>(sr));
+  addSynthBench(benches, "ay", std::make_shared<AySynthVoice>(sr));
+  addSynthBench(benches, "opl2", std::make_shared<Opl2SynthVoice>(sr));
+
+  addDrumBench(benches, "drums/808", std::make_shared<TR808DrumSynthVoice>(sr));
+  addDrumBench(benches, "drums/909", std::make_shared<TR909DrumSynthVoice>(sr));
+  addDrumBench(benches, "drums/606", std::make_shared<TR606DrumSynthVoice>(sr));
+  addDrumBench(benches, "drums/cr78", std::make_shared<CR78DrumSynthVoice>(sr));
+  addDrumBench(benches, "drums/kpr77", std::make_shared<KPR77DrumSynthVoice>(sr));
+  addDrumBench(benches, "drums/sp12", std::make_shared<SP12DrumSynthVoice>(sr));
+
+  {
+    auto reverb = std::make_shared<DrumReverb>();
+    reverb->setSampleRate(sr);
+    reverb->setMix(0.5f);
+    reverb->setDecay(0.8f);
+    benches.push_back({"fx/drum_reverb", [reverb](float* buf, size_t n) { reverb->processBlock(buf, n); }, nullptr});
+  }
+
+  // TapeFX: defaults, then each macro pinned to its minimum and maximum.
+  {
+    const TapeMacro def;
+    addTapeFxBench(benches, "fx/tape/default", def);
+    TapeMacro m = def;
+    m.wow = 0;   addTapeFxBench(benches, "fx/tape/wow_min", m);
+    m.wow = 100; addTapeFxBench(benches, "fx/tape/wow_max", m);
+    m = def;
+    m.age = 0;   addTapeFxBench(benches, "fx/tape/age_min", m);
+    m.age = 100; addTapeFxBench(benches, "fx/tape/age_max", m);
+    m = def;
+    m.sat = 0;   addTapeFxBench(benches, "fx/tape/sat_min", m);
+    m.sat = 100; addTapeFxBench(benches, "fx/tape/sat_max", m);
+    m = def;
+    m.tone = 0;   addTapeFxBench(benches, "fx/tape/tone_min", m);
+    m.tone = 100; addTapeFxBench(benches, "fx/tape/tone_max", m);
+    m = def;
+    m.crush = 3; addTapeFxBench(benches, "fx/tape/crush_max", m);
+    addTapeFxBench(benches, "fx/tape/space_max", def, 100, 0);
+    addTapeFxBench(benches, "fx/tape/movement_max", def, 0, 100);
+    TapeMacro all;
+    all.wow = 100; all.age = 100; all.sat = 100; all.tone = 0; all.crush = 3;
+    addTapeFxBench(benches, "fx/tape/all_max", all, 100, 100);
+  }
+
+  // TapeLooper: record one second, then benchmark playback and overdub.
+  for (TapeMode mode : {TapeMode::Play, TapeMode::Dub}) {
+    auto looper = std::make_shared<TapeLooper>();
+    looper->init(TapeLooper::kMaxSeconds);
+    looper->setMode(TapeMode::Rec);
+    float loopOut = 0.0f;
+    for (size_t i = 0; i < kSampleRate; ++i) looper->process(gTestSignal[i % kBlockFrames], &loopOut);
+    looper->setMode(mode);
+    Bench b;
+    b.name = mode == TapeMode::Play ? "fx/looper/play" : "fx/looper/dub";
+    b.block = [looper](float* buf, size_t n) {
+      for (size_t i = 0; i < n; ++i) {
+        float loopPart = 0.0f;
+        looper->process(buf[i], &loopPart);
+        buf[i] += loopPart;
+      }
+    };
+    b.step = [looper, mode](uint32_t) {
+      // Dub may auto-exit to Play; keep the mode under test.
+      if (looper->mode() != mode) looper->setMode(mode);
+    };
+    benches.push_back(b);
+  }
+
+  {
+    auto dist = std::make_shared<TubeDistortion>();
+    dist->setDrive(6.0f);
+    dist->setMix(1.0f);
+    dist->setEnabled(true);
+    benches.push_back({"fx/tube_distortion", [dist](float* buf, size_t n) { dist->processBlock(buf, n); }, nullptr});
+  }
+  {
+    auto comp = std::make_shared<OneKnobCompressor>();
+    comp->setAmount(0.7f);
+    comp->setMix(1.0f);
+    comp->setEnabled(true);
+    benches.push_back({"fx/compressor", [comp](float* buf, size_t n) { comp->processBlock(buf, n); }, nullptr});
+  }
+  {
+    auto shaper = std::make_shared<TransientShaper>();
+    shaper->setSampleRate(sr);
+    shaper->setAttackAmount(0.6f);
+    shaper->setSustainAmount(-0.4f);
+    benches.push_back({"fx/transient_shaper", [shaper](float* buf, size_t n) { shaper->processBlock(buf, n); }, nullptr});
+  }
+  for (int simd = 1; simd >= 0; --simd) {
+    auto bus = std::make_shared<MasterBus>();
+    auto pcm = std::make_shared<std::vector<int16_t>>(kBlockFrames);
+    Bench b;
+    b.name = simd ? "master/bus" : "master/bus_reference";
+    b.block = [bus, pcm, simd](float* buf, size_t n) {
+      bus->filterBlock(buf, n);
+      if (simd) bus->limitBlock(buf, pcm->data(), n, 1.0f);
+      else bus->limitBlockReference(buf, pcm->data(), n, 1.0f);
+    };
+    benches.push_back(b);
+  }
+  {
+    auto voice = std::make_shared<FormantSynth>(sr);
+    Bench b;
+    b.name = "formant_synth";
+    b.block = [voice](float* buf, size_t n) { voice->render(buf, n); };
+    b.step = [voice](uint32_t) {
+      if (!voice->isSpeaking()) voice->speak("acid bass line");
+    };
+    benches.push_back(b);
+  }
+  return benches;
+}
+
+static void writeJson(FILE* f, const std::vector<BenchResult>& results, const BenchConfig& cfg) {
+  fprintf(f, "{\n  \"sampleRate\": %u,\n  \"blockFrames\": %u,\n  \"seconds\": %.3f,\n  \"results\": [\n",
+          kSampleRate, kBlockFrames, static_cast<double>(cfg.frames) / kSampleRate);
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult& r = results[i];
+    fprintf(f, "    {\"name\": \"%s\", \"nsPerSample\": %.2f, \"usPerBlock\": %.2f, \"budgetPct\": %.3f}%s\n",
+            r.name.c_str(), r.nsPerSample, r.usPerBlock, r.budgetPct, i + 1 < results.size() ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+}
+
+// Drives both limiter paths with the same input, across odd block lengths
+// (vector body plus scalar tail), volumes and levels that hit the clip.
+static bool checkMasterBus() {
+  MasterBus vec;
+  MasterBus ref;
+  float mixVec[kBlockFrames];
+  float mixRef[kBlockFrames];
+  int16_t outVec[kBlockFrames];
+  int16_t outRef[kBlockFrames];
+  static const float kVolumes[4] = {0.0f, 0.7f, 1.8f, 2.5f};
+  static const float kLevels[4] = {0.05f, 1.0f, 6.0f, 40.0f};
+  for (int block = 0; block < 256; ++block) {
+    size_t n = 1 + (static_cast<size_t>(block) * 37u) % kBlockFrames;
+    float level = kLevels[block % 4];
+    float vol = kVolumes[(block / 4) % 4];
+    for (size_t i = 0; i < n; ++i) mixVec[i] = mixRef[i] = gTestSignal[i] * level;
+    vec.filterBlock(mixVec, n);
+    ref.filterBlock(mixRef, n);
+    vec.limitBlock(mixVec, outVec, n, vol);
+    ref.limitBlockReference(mixRef, outRef, n, vol);
+    for (size_t i = 0; i < n; ++i) {
+      if (outVec[i] != outRef[i]) {
+        fprintf(stderr, "master bus mismatch: block %d sample %zu: %d != %d (reference)\n", block, i,
+                outVec[i], outRef[i]);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void printUsage(const char* prog) {
+  fprintf(stderr, "usage: %s [--seconds S] [--json out.json | --json -] [--filter substr]\n", prog);
+}
+
+int main(int argc, char** argv) {
+  BenchConfig cfg;
+  std::string jsonPath;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--seconds" && i + 1 < argc) {
+      double seconds = std::atof(argv[++i]);
+      if (seconds < 0.1) seconds = 0.1;
+      cfg.frames = static_cast<size_t>(seconds * kSampleRate);
+    } else if (arg == "--json" && i + 1 < argc) {
+      jsonPath = argv[++i];
+    } else if (arg == "--filter" && i + 1 < argc) {
+      cfg.filter = argv[++i];
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  buildTestSignal();
+  if (!checkMasterBus()) return 1;
+  std::vector<Bench> benches = buildBenches();
+  std::vector<BenchResult> results;
+
+  FILE* table = jsonPath == "-" ? stderr : stdout;
+  double budgetUs = kBlockFrames * 1e6 / kSampleRate;
+  fprintf(table, "%u Hz, %u-frame blocks (budget %.0f us/block), %.1f s per benchmark\n", kSampleRate,
+          kBlockFrames, budgetUs, static_cast<double>(cfg.frames) / kSampleRate);
+  fprintf(table, "%-24s %12s %12s %9s\n", "benchmark", "ns/sample", "us/block", "budget");
+  for (const Bench& bench : benches) {
+    if (!cfg.filter.empty() && bench.name.find(cfg.filter) == std::string::npos) continue;
+    BenchResult r = runBench(bench, cfg);
+    fprintf(table, "%-24s %12.1f %12.1f %8.2f%%\n", r.name.c_str(), r.nsPerSample, r.usPerBlock, r.budgetPct);
+    fflush(table);
+    results.push_back(r);
+  }
+
+  if (jsonPath == "-") {
+    writeJson(stdout, results, cfg);
+  } else if (!jsonPath.empty()) {
+    FILE* f = fopen(jsonPath.c_str(), "w");
+    if (!f) {
+      fprintf(stderr, "Failed to open %s\n", jsonPath.c_str());
+      return 1;
+    }
+    writeJson(f, results, cfg);
+    fclose(f);
+  }
+  return 0;
+}
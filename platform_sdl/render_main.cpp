@@ -0,0 +1,229 @@
+// Headless offline renderer: loads a scene (JSON or binary .gps) and renders
+// it to a WAV file without a display or audio device, then reports how much
+// faster than realtime the engine ran plus the per-section PerfStats breakdown.
+//
+// usage: miniacid_render <scene.json|scene.gps> [-o out.wav] [--song | --bars N]
+//                        [--tail SEC] [--samples DIR] [--dual-core] [--no-profile]
+//
+//   --song        render the whole song arrangement (default if the scene has song mode on)
+//   --bars N      pattern mode: render N bars of the current patterns (default 4)
+//   --tail SEC    keep rendering SEC seconds after the last step for FX tails (default 1)
+//   --samples DIR sample library for the sampler tracks (default ../samples)
+//   --dual-core   render drums on a worker thread one block ahead (as on ESP32-S3)
+//   --no-profile  skip per-section timing; gives a cleaner realtime factor
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "../src/dsp/miniacid_engine.h"
+#include "../src/audio/audio_config.h"
+#include "../scene_storage.h"
+#include "../scenes.h"
+#include "../src/sampler/ram_sample_store.h"
+#include "wav_recorder.h"
+#include "arduino_compat.h"
+
+SerialMock Serial;
+SDMock SD;
+
+// Read-only storage bound to a single scene file. Writes (e.g. the save on
+// stop()) are dropped so rendering never touches the input.
+class SceneFileStorage : public SceneStorage {
+public:
+  explicit SceneFileStorage(const std::string& path) : path_(path) {}
+
+  void initializeStorage() override {}
+  bool readScene(std::string& out) override {
+    std::ifstream file(path_, std::ios::in | std::ios::binary);
+    if (!file.is_open()) return false;
+    out.assign((std::istreambuf_iterator<char>(file)),
+               std::istreambuf_iterator<char>());
+    return !out.empty();
+  }
+  bool readScene(SceneManager& manager) override {
+    std::string serialized;
+    if (!readScene(serialized)) return false;
+    loaded_ = manager.loadScene(serialized);
+    return loaded_;
+  }
+  bool writeScene(const std::string&) override { return true; }
+  bool writeScene(const SceneManager&) override { return true; }
+  bool writeSceneAuto(const SceneManager&) override { return true; }
+  bool readSceneAuto(SceneManager& manager) override { return readScene(manager); }
+  std::vector<std::string> getAvailableSceneNames() const override { return {path_}; }
+  std::string getCurrentSceneName() const override { return path_; }
+  bool setCurrentSceneName(const std::string&) override { return false; }
+
+  bool loaded() const { return loaded_; }
+
+private:
+  std::string path_;
+  bool loaded_ = false;
+};
+
+struct SectionTotals {
+  uint64_t sum = 0;
+  uint32_t peak = 0;
+  void add(uint32_t us) {
+    sum += us;
+    if (us > peak) peak = us;
+  }
+};
+
+static void printUsage(const char* prog) {
+  fprintf(stderr,
+          "usage: %s <scene.json|scene.gps> [-o out.wav] [--song | --bars N] [--tail SEC] [--samples DIR] [--rate HZ] [--block N]\n"
+          "       [--dual-core] [--no-profile]\n",
+          prog);
+}
+
+static void printSection(const char* name, const SectionTotals& t, size_t buffers, double budgetUs) {
+  double avg = buffers ? static_cast<double>(t.sum) / static_cast<double>(buffers) : 0.0;
+  printf("  %-8s %9.1f %9u %7.1f%%\n", name, avg, t.peak, avg * 100.0 / budgetUs);
+}
+
+int main(int argc, char** argv) {
+  std::string scenePath;
+  std::string outPath = "render.wav";
+  int forceSong = -1; // -1 = follow the scene, 0 = pattern, 1 = song
+  int bars = 4;
+  float tailSeconds = 1.0f;
+  std::string samplesDir = "../samples";
+  bool profile = true;
+  AudioConfig config;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if ((arg == "-o" || arg == "--out") && i + 1 < argc) {
+      outPath = argv[++i];
+    } else if (arg == "--song") {
+      forceSong = 1;
+    } else if (arg == "--bars" && i + 1 < argc) {
+      forceSong = 0;
+      bars = std::atoi(argv[++i]);
+    } else if (arg == "--tail" && i + 1 < argc) {
+      tailSeconds = static_cast<float>(std::atof(argv[++i]));
+    } else if (arg == "--samples" && i + 1 < argc) {
+      samplesDir = argv[++i];
+    } else if (arg == "--rate" && i + 1 < argc) {
+      config.sampleRate = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else if (arg == "--block" && i + 1 < argc) {
+      config.blockFrames = static_cast<uint32_t>(std::atoi(argv[++i]));
+    } else if (arg == "--dual-core") {
+      config.dualCore = true;
+    } else if (arg == "--no-profile") {
+      profile = false;
+    } else if (!arg.empty() && arg[0] != '-' && scenePath.empty()) {
+      scenePath = arg;
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (scenePath.empty()) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  if (bars < 1) bars = 1;
+  if (tailSeconds < 0.0f) tailSeconds = 0.0f;
+  config = config.sanitized();
+
+  SceneFileStorage storage(scenePath);
+  RamSampleStore pool;
+  MiniAcid synth(static_cast<float>(config.sampleRate), &storage);
+  synth.sampleStore = &pool;
+  synth.init();
+  synth.applyAudioConfig(config);
+  synth.sampleIndex.scanDirectory(samplesDir);
+  for (const auto& file : synth.sampleIndex.getFiles()) {
+    pool.registerFile(file.id, file.fullPath);
+  }
+  if (!storage.loaded()) {
+    fprintf(stderr, "Failed to load scene: %s\n", scenePath.c_str());
+    return 1;
+  }
+
+  bool songMode = forceSong < 0 ? synth.songModeEnabled() : forceSong == 1;
+  synth.setSongMode(songMode);
+  int totalSteps = 0;
+  if (songMode) {
+    synth.setSongPosition(0);
+    totalSteps = synth.songLength() * SEQ_STEPS;
+  }
+  if (totalSteps <= 0) totalSteps = bars * SEQ_STEPS;
+
+  const float sampleRate = synth.sampleRate();
+  const double samplesPerStep = (sampleRate * 60.0) / (synth.bpm() * 4.0);
+  const size_t totalFrames = static_cast<size_t>(totalSteps * samplesPerStep + tailSeconds * sampleRate);
+  const size_t stopFrame = static_cast<size_t>(totalSteps * samplesPerStep);
+
+  WavRecorder wav;
+  if (!wav.start(outPath, static_cast<int>(sampleRate), 1)) {
+    fprintf(stderr, "Failed to open %s\n", outPath.c_str());
+    return 1;
+  }
+
+  synth.setDetailedProfiling(profile);
+  synth.start();
+  synth.publishPatterns();
+
+  const size_t blockFrames = config.blockFrames;
+  std::vector<int16_t> buffer(blockFrames);
+  SectionTotals total, voices, drums, fx, sampler;
+  size_t buffers = 0;
+  size_t rendered = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  while (rendered < totalFrames) {
+    if (rendered >= stopFrame && synth.isPlaying()) synth.stop();
+    // This thread is the UI as well: between blocks, hand the sequencer the
+    // patterns it asked for, as MiniAcidDisplay::update() does on device.
+    if (synth.patternPublishWanted()) {
+      synth.detachAudioThread();
+      synth.publishPatterns();
+    }
+    size_t n = std::min(blockFrames, totalFrames - rendered);
+    synth.generateAudioBuffer(buffer.data(), n);
+    wav.writeSamples(buffer.data(), n);
+    rendered += n;
+    ++buffers;
+
+    const PerfStats& ps = synth.perfStats;
+    total.add(ps.dspTimeUs);
+    if (profile) {
+      voices.add(ps.dspVoicesUs);
+      drums.add(ps.dspDrumsUs);
+      fx.add(ps.dspFxUs);
+      sampler.add(ps.dspSamplerUs);
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  if (synth.isPlaying()) synth.stop();
+  wav.stop();
+
+  double wallSeconds = std::chrono::duration<double>(t1 - t0).count();
+  double audioSeconds = static_cast<double>(rendered) / sampleRate;
+  double budgetUs = blockFrames * 1e6 / sampleRate;
+
+  printf("\n%s: %s, %d steps @ %.1f BPM -> %s\n", scenePath.c_str(), songMode ? "song" : "pattern",
+         totalSteps, synth.bpm(), outPath.c_str());
+  printf("Rendered %.2f s of audio in %.3f s (%.1fx realtime)\n", audioSeconds, wallSeconds,
+         wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0);
+  printf("Per-buffer DSP (%zu buffers of %u frames, budget %.0f us):\n", buffers, (unsigned)blockFrames, budgetUs);
+  printf("  %-8s %9s %9s %8s\n", "section", "avg us", "peak us", "budget");
+  printSection("total", total, buffers, budgetUs);
+  if (profile) {
+    printSection("voices", voices, buffers, budgetUs);
+    printSection("drums", drums, buffers, budgetUs);
+    printSection("fx", fx, buffers, budgetUs);
+    printSection("sampler", sampler, buffers, budgetUs);
+  }
+  return 0;
+}
@@ -0,0 +1,324 @@
+// Scene I/O benchmark: builds a large two-song scene (every pattern slot,
+// automation lane and song row filled) and times JSON and binary save/load
+// and a journaled auto-save of a one-step edit through an SD-File-like
+// stream, reporting ms per operation plus how many read/write calls reached
+// the "file". On the device each of those calls is a trip through
+// VFS/FATFS, so the call count matters as much as the time.
+//
+// Before timing anything it checks that the scene survives a JSON and a
+// binary round trip unchanged, and that a snapshot plus journal (with a torn
+// last batch) replays to the last committed auto-save, and exits with status
+// 1 if not.
+//
+// usage: miniacid_scene_bench [--iterations N] [--dump scene.json]
+//
+//   --iterations N  loads/saves per measurement (default 50)
+//   --dump FILE     also write the generated scene JSON to FILE
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <stdio.h>
+#include <string>
+
+#include "../scene_binary.h"
+#include "../scene_journal.h"
+#include "../scenes.h"
+#include "arduino_compat.h"
+
+SerialMock Serial;
+SDMock SD;
+
+// In-memory stand-in for an Arduino SD File: byte and block reads, block
+// writes, with call counters.
+class MemoryFile {
+public:
+  void rewind() { pos_ = 0; }
+  bool seek(size_t pos) {
+    if (pos > data_.size()) return false;
+    pos_ = pos;
+    return true;
+  }
+  void clear() { data_.clear(); pos_ = 0; }
+  const std::string& data() const { return data_; }
+  void resetCounters() { readCalls = writeCalls = 0; }
+
+  int read() {
+    ++readCalls;
+    if (pos_ >= data_.size()) return -1;
+    return static_cast<unsigned char>(data_[pos_++]);
+  }
+  size_t read(uint8_t* dst, size_t len) {
+    ++readCalls;
+    size_t n = std::min(len, data_.size() - pos_);
+    std::memcpy(dst, data_.data() + pos_, n);
+    pos_ += n;
+    return n;
+  }
+  size_t write(const uint8_t* src, size_t len) {
+    ++writeCalls;
+    data_.append(reinterpret_cast<const char*>(src), len);
+    return len;
+  }
+
+  size_t readCalls = 0;
+  size_t writeCalls = 0;
+
+private:
+  std::string data_;
+  size_t pos_ = 0;
+};
+
+static void buildLargeScene(SceneManager& manager) {
+  manager.loadDefaultScene();
+  Scene& scene = manager.currentScene();
+  uint32_t seed = 0x5eed1234u;
+  auto rnd = [&seed](int range) {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<int>((seed >> 8) % static_cast<uint32_t>(range));
+  };
+
+  for (int b = 0; b < kBankCount; ++b) {
+    for (int p = 0; p < Bank<DrumPatternSet>::kPatterns; ++p) {
+      DrumPatternSet& set = scene.drumBanks[b].patterns[p];
+      for (int v = 0; v < DrumPatternSet::kVoices; ++v) {
+        for (int s = 0; s < DrumPattern::kSteps; ++s) {
+          DrumStep& step = set.voices[v].steps[s];
+          step.hit = rnd(3) == 0;
+          step.accent = rnd(4) == 0;
+          step.fx = static_cast<uint8_t>(rnd(7));
+          step.fxParam = static_cast<uint8_t>(rnd(8));
+          step.probability = static_cast<uint8_t>(50 + rnd(51));
+        }
+      }
+      for (int l = 0; l < DrumPatternSet::kMaxLanes; ++l) {
+        AutomationLane& lane = set.lanes[l];
+        lane.targetParam = static_cast<uint8_t>(l);
+        lane.nodeCount = AutomationLane::kMaxNodes;
+        for (int n = 0; n < AutomationLane::kMaxNodes; ++n) {
+          lane.nodes[n].step = static_cast<uint8_t>(n * 2);
+          lane.nodes[n].value = static_cast<float>(rnd(1000)) / 1000.0f;
+          lane.nodes[n].curveType = static_cast<uint8_t>(rnd(3));
+        }
+      }
+      set.groove.swing = static_cast<float>(rnd(66)) / 100.0f;
+      set.groove.humanize = static_cast<float>(rnd(100)) / 100.0f;
+    }
+    for (int p = 0; p < Bank<SynthPattern>::kPatterns; ++p) {
+      for (Bank<SynthPattern>* banks : {scene.synthABanks, scene.synthBBanks}) {
+        SynthPattern& pattern = banks[b].patterns[p];
+        for (int s = 0; s < SynthPattern::kSteps; ++s) {
+          SynthStep& step = pattern.steps[s];
+          step.note = static_cast<int8_t>(rnd(4) == 0 ? -1 : 36 + rnd(36));
+          step.slide = rnd(4) == 0;
+          step.accent = rnd(3) == 0;
+          step.fx = static_cast<uint8_t>(rnd(7));
+          step.fxParam = static_cast<uint8_t>(rnd(8));
+          step.probability = static_cast<uint8_t>(50 + rnd(51));
+        }
+      }
+    }
+  }
+
+  for (int slot = 0; slot < 2; ++slot) {
+    manager.setActiveSongSlot(slot);
+    for (int pos = 0; pos < Song::kMaxPositions; ++pos) {
+      manager.setSongPattern(pos, SongTrack::SynthA, rnd(kMaxGlobalPatterns));
+      manager.setSongPattern(pos, SongTrack::SynthB, rnd(kMaxGlobalPatterns));
+      manager.setSongPattern(pos, SongTrack::Drums, rnd(kMaxGlobalPatterns));
+      if (rnd(2)) manager.setSongPattern(pos, SongTrack::Voice, rnd(kMaxGlobalPatterns));
+    }
+  }
+  manager.setActiveSongSlot(0);
+
+  for (int i = 0; i < Scene::kMaxCustomPhrases; ++i) {
+    std::snprintf(scene.customPhrases[i], Scene::kMaxPhraseLength, "phrase %d \"acid\" line", i);
+  }
+  for (int i = 0; i < 16; ++i) {
+    SamplerPadState& pad = scene.samplerPads[i];
+    pad.sampleId = static_cast<uint32_t>(1000 + i);
+    pad.volume = 0.8f;
+    pad.pitch = 1.0f + static_cast<float>(i) / 16.0f;
+    pad.endFrame = static_cast<uint32_t>(22050 + rnd(22050));
+  }
+}
+
+template <typename Fn>
+static double timeMs(int iterations, Fn&& fn) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+}
+
+static int replayJournal(SceneManager& manager, MemoryFile& journalFile, uint32_t snapshotCrc,
+                         size_t* committed) {
+  journalFile.rewind();
+  return SceneJournal::replay(manager, [&journalFile](void* dst, size_t len) -> size_t {
+    return journalFile.read(static_cast<uint8_t*>(dst), len);
+  }, [&journalFile](size_t offset) -> bool {
+    return journalFile.seek(offset);
+  }, snapshotCrc, committed);
+}
+
+// Journals three auto-saves (pattern, song plus tempo, engine name) over the
+// snapshot of the scene in `manager`, then half of a fourth, and checks that
+// replaying onto the snapshot gives the scene as of the third.
+static bool checkJournalReplay(SceneManager& manager, MemoryFile& snapshot, MemoryFile& journalFile) {
+  const uint32_t snapshotCrc = scene_binary::crc32(snapshot.data().data(), snapshot.data().size());
+  auto write = [&journalFile](const void* data, size_t len) -> bool {
+    return journalFile.write(static_cast<const uint8_t*>(data), len) == len;
+  };
+  journalFile.clear();
+  SceneJournal journal;
+  if (!SceneJournal::writeHeader(write, snapshotCrc) || !journal.setBaseline(manager)) return false;
+
+  DrumStep& step = manager.editCurrentDrumPattern().voices[0].steps[0];
+  step.hit = !step.hit;
+  if (!journal.append(manager, write)) return false;
+  manager.setSongPattern(3, SongTrack::Drums, 5);
+  manager.setBpm(97.0f);
+  if (!journal.append(manager, write)) return false;
+  manager.setDrumEngineName("TR909");
+  if (!journal.append(manager, write)) return false;
+  const std::string expected = manager.dumpCurrentScene();
+  const size_t committedSize = journalFile.data().size();
+
+  MemoryFile torn;
+  manager.setBpm(140.0f);
+  if (!journal.append(manager, [&torn](const void* data, size_t len) -> bool {
+        return torn.write(static_cast<const uint8_t*>(data), len) == len;
+      })) {
+    return false;
+  }
+  journalFile.write(reinterpret_cast<const uint8_t*>(torn.data().data()), torn.data().size() / 2);
+
+  snapshot.rewind();
+  if (!manager.loadSceneBinary(snapshot)) return false;
+  size_t committed = 0;
+  int batches = replayJournal(manager, journalFile, snapshotCrc, &committed);
+  return batches == 3 && committed == committedSize && manager.dumpCurrentScene() == expected;
+}
+
+static void printUsage(const char* prog) {
+  fprintf(stderr, "usage: %s [--iterations N] [--dump scene.json]\n", prog);
+}
+
+int main(int argc, char** argv) {
+  int iterations = 50;
+  std::string dumpPath;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--iterations" && i + 1 < argc) {
+      iterations = std::atoi(argv[++i]);
+      if (iterations < 1) iterations = 1;
+    } else if (arg == "--dump" && i + 1 < argc) {
+      dumpPath = argv[++i];
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  SceneManager manager;
+  buildLargeScene(manager);
+  const std::string reference = manager.dumpCurrentScene();
+  if (!dumpPath.empty()) {
+    FILE* f = fopen(dumpPath.c_str(), "wb");
+    if (!f) {
+      fprintf(stderr, "Failed to open %s\n", dumpPath.c_str());
+      return 1;
+    }
+    fwrite(reference.data(), 1, reference.size(), f);
+    fclose(f);
+  }
+
+  MemoryFile jsonFile;
+  MemoryFile binaryFile;
+  manager.writeSceneJson(jsonFile);
+  manager.writeSceneBinary(binaryFile);
+  if (jsonFile.data() != reference) {
+    fprintf(stderr, "JSON written to a file differs from the string dump\n");
+    return 1;
+  }
+  manager.loadDefaultScene();
+  jsonFile.rewind();
+  if (!manager.loadSceneEvented(jsonFile) || manager.dumpCurrentScene() != reference) {
+    fprintf(stderr, "JSON round trip changed the scene\n");
+    return 1;
+  }
+  manager.loadDefaultScene();
+  binaryFile.rewind();
+  if (!manager.loadSceneBinary(binaryFile) || manager.dumpCurrentScene() != reference) {
+    fprintf(stderr, "binary round trip changed the scene\n");
+    return 1;
+  }
+  MemoryFile journalFile;
+  if (!checkJournalReplay(manager, binaryFile, journalFile)) {
+    fprintf(stderr, "journal replay did not restore the last auto-save\n");
+    return 1;
+  }
+  const uint32_t snapshotCrc = scene_binary::crc32(binaryFile.data().data(), binaryFile.data().size());
+  binaryFile.rewind();
+  manager.loadSceneBinary(binaryFile);
+
+  printf("two-song scene: %zu bytes JSON, %zu bytes binary, %d iterations\n", jsonFile.data().size(),
+         binaryFile.data().size(), iterations);
+  printf("%-16s %10s %12s\n", "operation", "ms", "file calls");
+
+  MemoryFile out;
+  double ms = timeMs(iterations, [&] {
+    out.clear();
+    out.resetCounters();
+    manager.writeSceneJson(out);
+  });
+  printf("%-16s %10.3f %12zu\n", "json/save", ms, out.writeCalls);
+
+  ms = timeMs(iterations, [&] {
+    jsonFile.rewind();
+    jsonFile.resetCounters();
+    manager.loadSceneEvented(jsonFile);
+  });
+  printf("%-16s %10.3f %12zu\n", "json/load", ms, jsonFile.readCalls);
+
+  ms = timeMs(iterations, [&] { manager.loadScene(reference); });
+  printf("%-16s %10.3f %12s\n", "json/load_string", ms, "-");
+
+  ms = timeMs(iterations, [&] {
+    out.clear();
+    out.resetCounters();
+    manager.writeSceneBinary(out);
+  });
+  printf("%-16s %10.3f %12zu\n", "binary/save", ms, out.writeCalls);
+
+  ms = timeMs(iterations, [&] {
+    binaryFile.rewind();
+    binaryFile.resetCounters();
+    manager.loadSceneBinary(binaryFile);
+  });
+  printf("%-16s %10.3f %12zu\n", "binary/load", ms, binaryFile.readCalls);
+
+  // Auto-save after a one-step edit: only the changed slice is journaled.
+  SceneJournal journal;
+  journal.setBaseline(manager);
+  size_t journalBytes = 0;
+  ms = timeMs(iterations, [&] {
+    DrumStep& step = manager.editCurrentDrumPattern().voices[0].steps[0];
+    step.hit = !step.hit;
+    out.clear();
+    out.resetCounters();
+    journal.append(manager, [&out](const void* data, size_t len) -> bool {
+      return out.write(static_cast<const uint8_t*>(data), len) == len;
+    }, &journalBytes);
+  });
+  printf("%-16s %10.3f %12zu  (%zu bytes)\n", "journal/append", ms, out.writeCalls, journalBytes);
+
+  // Boot-time replay of the three-batch journal from the check above.
+  ms = timeMs(iterations, [&] {
+    journalFile.resetCounters();
+    replayJournal(manager, journalFile, snapshotCrc, nullptr);
+  });
+  printf("%-16s %10.3f %12zu  (%zu bytes)\n", "journal/replay", ms, journalFile.readCalls,
+         journalFile.data().size());
+  return 0;
+}
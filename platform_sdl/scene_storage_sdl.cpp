@@ -1,5 +1,6 @@
 #include "scene_storage_sdl.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iterator>
 #include <sstream>
@@ -96,10 +97,13 @@ void SceneStorageSdl::initializeStorage() {
 std::string SceneStorageSdl::normalizeSceneName(const std::string& name) const {
   std::string cleaned = name;
   if (cleaned.empty()) cleaned = kDefaultSceneName;
-  if (cleaned.size() >= std::strlen(kSceneExtension) &&
-      cleaned.compare(cleaned.size() - std::strlen(kSceneExtension),
-                      std::strlen(kSceneExtension), kSceneExtension) == 0) {
-    cleaned.resize(cleaned.size() - std::strlen(kSceneExtension));
+  for (const char* extension : {kSceneExtension, kBinarySceneExtension}) {
+    size_t extLen = std::strlen(extension);
+    if (cleaned.size() >= extLen &&
+        cleaned.compare(cleaned.size() - extLen, extLen, extension) == 0) {
+      cleaned.resize(cleaned.size() - extLen);
+      break;
+    }
   }
   if (cleaned.empty()) cleaned = kDefaultSceneName;
   return cleaned;
@@ -111,6 +115,12 @@ std::string SceneStorageSdl::sceneFilePath() const {
   return path;
 }
 
+std::string SceneStorageSdl::binarySceneFilePath() const {
+  std::string path = normalizeSceneName(currentSceneName_);
+  path += kBinarySceneExtension;
+  return path;
+}
+
 void SceneStorageSdl::loadStoredSceneName() {
 #ifdef __EMSCRIPTEN__
   int length = wasm_read_current_scene_name(nullptr, 0);
@@ -175,11 +185,36 @@ bool SceneStorageSdl::writeScene(const SceneManager& manager) {
   std::string out;
   bool ok = manager.writeSceneJson(out);
   if (!ok) return false;
-  return writeScene(out);
+  if (!writeScene(out)) return false;
+#ifndef __EMSCRIPTEN__
+  // Written after the JSON so its timestamp marks it as current.
+  std::string binary;
+  if (manager.writeSceneBinary(binary)) {
+    std::ofstream file(binarySceneFilePath(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (file.is_open()) file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+  }
+#endif
+  return true;
 }
 
 bool SceneStorageSdl::readScene(SceneManager& manager) {
   std::string serialized;
+#ifndef __EMSCRIPTEN__
+  // A JSON edited after the last save wins over the binary beside it.
+  std::error_code ec;
+  const std::string binaryPath = binarySceneFilePath();
+  auto jsonTime = std::filesystem::last_write_time(sceneFilePath(), ec);
+  if (!ec) {
+    auto binaryTime = std::filesystem::last_write_time(binaryPath, ec);
+    if (!ec && jsonTime > binaryTime) std::filesystem::remove(binaryPath, ec);
+  }
+  std::ifstream binary(binaryPath, std::ios::in | std::ios::binary);
+  if (binary.is_open()) {
+    serialized.assign((std::istreambuf_iterator<char>(binary)),
+                      std::istreambuf_iterator<char>());
+    if (manager.loadScene(serialized)) return true;
+  }
+#endif
   if (!readScene(serialized)) return false;
   return manager.loadScene(serialized);
 }
@@ -208,8 +243,11 @@ std::vector<std::string> SceneStorageSdl::findSceneNamesOnDisk() const {
     if (ec) break;
     if (!entry.is_regular_file()) continue;
     const fs::path& path = entry.path();
-    if (path.extension() == kSceneExtension) {
-      names.push_back(path.stem().string());
+    if (path.extension() == kSceneExtension || path.extension() == kBinarySceneExtension) {
+      std::string name = path.stem().string();
+      if (std::find(names.begin(), names.end(), name) == names.end()) {
+        names.push_back(name);
+      }
     }
   }
   return names;
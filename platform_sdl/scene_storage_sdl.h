@@ -22,9 +22,12 @@ private:
   static constexpr const char* kDefaultSceneName = "grooveputer_scene";
   static constexpr const char* kSceneNameFile = "grooveputer_scene_name.txt";
   static constexpr const char* kSceneExtension = ".json";
+  // Binary container written next to the JSON on desktop; preferred on load.
+  static constexpr const char* kBinarySceneExtension = ".gps";
 
   std::string normalizeSceneName(const std::string& name) const;
   std::string sceneFilePath() const;
+  std::string binarySceneFilePath() const;
   void loadStoredSceneName();
   bool persistCurrentSceneName() const;
   std::vector<std::string> findSceneNamesOnDisk() const;
@@ -14,7 +14,7 @@
 #include "../src/dsp/miniacid_engine.h"
 #include "../src/audio/audio_config.h"
 #include "scene_storage_sdl.h"
-#include "../src/sampler/ram_sample_store.h"
+#include "../src/sampler/streaming_sample_store.h"
 #include "arduino_compat.h"
 
 // Define Serial and SD instances for SDL build
@@ -30,7 +30,7 @@ SDMock SD;
 struct AudioContext {
   explicit AudioContext(float sampleRate) : storage(), pool(), synth(sampleRate, &storage), device(0) { synth.sampleStore = &pool; }
   SceneStorageSdl storage;
-  RamSampleStore pool;
+  StreamingSampleStore pool;
   MiniAcid synth;
   SDL_AudioDeviceID device;
 #ifndef __EMSCRIPTEN__
@@ -62,6 +62,56 @@ static void audioCallback(void *userdata, Uint8 *stream, int len) {
   ctx->recorder.writeSamples(out, frames);
 }
 
+static bool openAudio(AudioContext& audio, const AudioConfig& config) {
+  SDL_AudioSpec desired{};
+  desired.freq = static_cast<int>(config.sampleRate);
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 1;
+  desired.samples = static_cast<Uint16>(config.blockFrames);
+  desired.callback = audioCallback;
+  desired.userdata = &audio;
+
+  SDL_AudioSpec obtained{};
+  audio.device = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, 0);
+  if (audio.device == 0) return false;
+  SDL_PauseAudioDevice(audio.device, 0); // start playback
+  return true;
+}
+
+// SDL cannot change rate or buffer size on an open device: close it, let the
+// engine re-initialize for the new config, and reopen.
+static void serviceAudioConfig(AppState& s) {
+  MiniAcid& synth = s.audio.synth;
+  AudioConfig requested;
+  if (!synth.takeAudioConfigRequest(requested)) return;
+  const AudioConfig current = synth.audioConfig();
+  if (requested.sampleRate == current.sampleRate && requested.blockFrames == current.blockFrames) {
+    SDL_LockAudioDevice(s.audio.device);
+    synth.applyAudioConfig(requested);
+    SDL_UnlockAudioDevice(s.audio.device);
+    return;
+  }
+
+  if (s.audio.recorder.isRecording() && requested.sampleRate != current.sampleRate) {
+    SDL_LockAudioDevice(s.audio.device);
+    s.audio.recorder.stop();
+    SDL_UnlockAudioDevice(s.audio.device);
+    printf("WAV Recording stopped (sample rate change): %s\n", s.audio.recorder.filename().c_str());
+  }
+  SDL_CloseAudioDevice(s.audio.device);
+  synth.detachAudioThread();
+  if (!synth.applyAudioConfig(requested) && s.ui) s.ui->showToast("Looper off: no memory", 2500);
+  if (!openAudio(s.audio, requested)) {
+    fprintf(stderr, "Failed to open audio at %u Hz / %u frames: %s\n", (unsigned)requested.sampleRate,
+            (unsigned)requested.blockFrames, SDL_GetError());
+    synth.applyAudioConfig(current);
+    if (!openAudio(s.audio, current)) {
+      fprintf(stderr, "Failed to reopen audio: %s\n", SDL_GetError());
+      s.running = false;
+    }
+  }
+}
+
 static void handleEvents(AppState& s) {
   SDL_Event e;
   auto scaleMouse = [&](int value) {
@@ -283,11 +333,6 @@ static void updateUI(AppState& s) {
 static void cleanup(AppState& s) {
   if (s.cleaned_up) return;
   
-  // Auto-save scene before exit to prevent data loss
-  SDL_LockAudioDevice(s.audio.device);
-  s.audio.synth.stop(); // This also calls saveSceneToStorage()
-  SDL_UnlockAudioDevice(s.audio.device);
-  
   if (s.audio.recorder.isRecording()) {
     SDL_LockAudioDevice(s.audio.device);
     s.audio.recorder.stop();
@@ -295,6 +340,11 @@ static void cleanup(AppState& s) {
     printf("WAV Recording stopped: %s\n", s.audio.recorder.filename().c_str());
   }
   SDL_CloseAudioDevice(s.audio.device);
+
+  // The callback is gone; let setters apply directly again (and flush the queue).
+  s.audio.synth.detachAudioThread();
+  // Auto-save scene before exit to prevent data loss
+  s.audio.synth.stop(); // This also calls saveSceneToStorage()
   delete s.ui;
   s.ui = nullptr;
   delete s.sdl;
@@ -309,6 +359,7 @@ static void cleanup(AppState& s) {
 static void mainLoopTick(void* userdata) {
   AppState* s = static_cast<AppState*>(userdata);
   handleEvents(*s);
+  serviceAudioConfig(*s);
   updateUI(*s);
   if (!s->running) {
 #ifdef __EMSCRIPTEN__
@@ -350,34 +401,26 @@ int main(int argc, char **argv) {
   state.audio.synth.init();
   
   // Initialize sample index and register files into the store
+#if !defined(__EMSCRIPTEN__)
+  state.audio.pool.beginStreaming();
+#endif
   state.audio.synth.sampleIndex.scanDirectory("../samples");
   for (const auto& file : state.audio.synth.sampleIndex.getFiles()) {
       state.audio.pool.registerFile(file.id, file.fullPath);
   }
 
-  SDL_AudioSpec desired{};
-  desired.freq = kSampleRate;
-  desired.format = AUDIO_S16SYS;
-  desired.channels = 1;
-  desired.samples = kBlockFrames;
-  desired.callback = audioCallback;
-  desired.userdata = &state.audio;
-
-  SDL_AudioSpec obtained{};
-  state.audio.device = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, 0);
-  if (state.audio.device == 0) {
+  if (!openAudio(state.audio, state.audio.synth.audioConfig())) {
     fprintf(stderr, "Failed to open audio: %s\n", SDL_GetError());
     SDL_Quit();
     return 1;
   }
 
-  SDL_PauseAudioDevice(state.audio.device, 0); // start playback
-
   state.ui = new MiniAcidDisplay(*state.gfx, state.audio.synth);
   AudioGuard guard;
-  guard.lock = [](void* ctx) { SDL_LockAudioDevice((SDL_AudioDeviceID)(uintptr_t)ctx); };
-  guard.unlock = [](void* ctx) { SDL_UnlockAudioDevice((SDL_AudioDeviceID)(uintptr_t)ctx); };
-  guard.context = (void*)(uintptr_t)state.audio.device;
+  // The device id changes when the audio config is re-opened; resolve it per call.
+  guard.lock = [](void* ctx) { SDL_LockAudioDevice(static_cast<AudioContext*>(ctx)->device); };
+  guard.unlock = [](void* ctx) { SDL_UnlockAudioDevice(static_cast<AudioContext*>(ctx)->device); };
+  guard.context = &state.audio;
   state.ui->setAudioGuard(guard);
   state.ui->setAudioRecorder(&state.audio.recorder);
 
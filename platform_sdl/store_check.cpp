@@ -0,0 +1,167 @@
+// RamSampleStore arena check: loads small WAVs into a 100 KB pool, pins one
+// sample with a handle, evicts around it so the free space is fragmented and
+// then loads a sample that only fits once the arena is compacted. Checks
+// that the pinned sample did not move, that moved samples are bit-exact, that
+// compaction ran instead of eviction, and that an oversized sample is
+// refused. Exits with status 1 on any failure.
+//
+// usage: miniacid_store_check [--dir DIR]
+//
+//   --dir DIR  where to write the test WAVs (default: a fresh directory
+//              under /tmp)
+
+#include <cstdlib>
+#include <cstring>
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+
+#include "../src/audio/audio_config.h"
+#include "../src/sampler/ram_sample_store.h"
+#include "arduino_compat.h"
+
+SerialMock Serial;
+SDMock SD;
+
+namespace {
+
+constexpr size_t kPoolBytes = 100000;
+constexpr int kSmallFrames = 5000;  // 10000 bytes each
+constexpr int kSmallCount = 8;
+constexpr int kBigFrames = 15000;   // fits only in the compacted tail
+constexpr int kHugeFrames = 60000;  // larger than the whole pool
+constexpr uint32_t kBigId = 100;
+constexpr uint32_t kHugeId = 101;
+
+int failures = 0;
+
+void expect(bool ok, const char* what) {
+  printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok) ++failures;
+}
+
+int16_t testSample(uint32_t id, int frame) {
+  return static_cast<int16_t>(frame * static_cast<int>(id) + static_cast<int>(id));
+}
+
+// 16-bit mono at the store's rate, so the loader copies frames unchanged.
+bool writeWav(const std::string& path, uint32_t id, int frames) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) return false;
+  uint32_t dataBytes = static_cast<uint32_t>(frames) * 2;
+  uint32_t riffBytes = 36 + dataBytes;
+  uint32_t fmtBytes = 16;
+  uint16_t format = 1;
+  uint16_t channels = 1;
+  uint32_t rate = kSampleRate;
+  uint32_t byteRate = rate * 2;
+  uint16_t blockAlign = 2;
+  uint16_t bits = 16;
+  fwrite("RIFF", 1, 4, f);
+  fwrite(&riffBytes, 4, 1, f);
+  fwrite("WAVEfmt ", 1, 8, f);
+  fwrite(&fmtBytes, 4, 1, f);
+  fwrite(&format, 2, 1, f);
+  fwrite(&channels, 2, 1, f);
+  fwrite(&rate, 4, 1, f);
+  fwrite(&byteRate, 4, 1, f);
+  fwrite(&blockAlign, 2, 1, f);
+  fwrite(&bits, 2, 1, f);
+  fwrite("data", 1, 4, f);
+  fwrite(&dataBytes, 4, 1, f);
+  for (int i = 0; i < frames; ++i) {
+    int16_t v = testSample(id, i);
+    fwrite(&v, 2, 1, f);
+  }
+  return fclose(f) == 0;
+}
+
+bool registerWav(RamSampleStore& store, const std::string& dir, uint32_t id, int frames) {
+  std::string path = dir + "/s" + std::to_string(id) + ".wav";
+  if (!writeWav(path, id, frames)) return false;
+  store.registerFile({id}, path);
+  return true;
+}
+
+const int16_t* dataOf(RamSampleStore& store, uint32_t id) {
+  SampleHandle h = store.acquireHandle({id});
+  if (!h.valid()) return nullptr;
+  const int16_t* pcm = store.viewHandle(h).pcm;
+  store.releaseHandle(h);
+  return pcm;
+}
+
+bool intact(RamSampleStore& store, uint32_t id, int frames) {
+  SampleHandle h = store.acquireHandle({id});
+  if (!h.valid()) return false;
+  SampleView v = store.viewHandle(h);
+  bool ok = v.pcm && v.frames == static_cast<uint32_t>(frames);
+  for (int i = 0; ok && i < frames; ++i) ok = v.pcm[i] == testSample(id, i);
+  store.releaseHandle(h);
+  return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string dir;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--dir") == 0 && i + 1 < argc) {
+      dir = argv[++i];
+    } else {
+      fprintf(stderr, "usage: %s [--dir DIR]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (dir.empty()) {
+    char tmpl[] = "/tmp/miniacid_store_check.XXXXXX";
+    if (!mkdtemp(tmpl)) {
+      perror("mkdtemp");
+      return 1;
+    }
+    dir = tmpl;
+  }
+
+  RamSampleStore store;
+  store.setTargetSampleRate(kSampleRate);
+  store.setPoolSize(kPoolBytes);
+
+  // Samples 1..8 fill the arena front to back: 80000 of 100000 bytes.
+  bool loaded = true;
+  for (uint32_t id = 1; id <= kSmallCount; ++id) {
+    loaded = loaded && registerWav(store, dir, id, kSmallFrames) && store.preload({id});
+  }
+  expect(loaded, "preload 8 x 10000 bytes");
+  if (!loaded) return 1;
+
+  // Pin 4, touch everything but 2 and 6, then evict those two: the free
+  // space is 40000 bytes, but the largest gap is the 20000-byte tail.
+  SampleHandle pin = store.acquireHandle({4});
+  expect(pin.valid(), "pin sample 4");
+  const int16_t* pinnedBefore = store.viewHandle(pin).pcm;
+  for (uint32_t id : {1u, 3u, 5u, 7u, 8u}) store.preload({id});
+  store.evictLRU();
+  store.evictLRU();
+  expect(store.freePoolBytes() == 40000 && store.largestFreeBlock() == 20000,
+         "evict 2 and 6: 40000 free, largest gap 20000");
+  const int16_t* lastBefore = dataOf(store, 8);
+
+  // 30000 bytes fit only after the arena is compacted.
+  bool bigLoaded = registerWav(store, dir, kBigId, kBigFrames) && store.preload({kBigId});
+  expect(bigLoaded, "load 30000 bytes into the fragmented pool");
+  expect(store.compactionCount() == 1, "compacted once");
+  expect(store.viewHandle(pin).pcm == pinnedBefore, "pinned sample 4 not moved");
+  expect(dataOf(store, 8) != lastBefore, "unpinned sample 8 moved");
+  bool allIntact = true;
+  for (uint32_t id : {1u, 3u, 4u, 5u, 7u, 8u}) allIntact = allIntact && intact(store, id, kSmallFrames);
+  expect(allIntact, "loaded samples bit-exact after compaction");
+  expect(intact(store, kBigId, kBigFrames), "new sample bit-exact");
+  store.releaseHandle(pin);
+
+  bool hugeLoaded = registerWav(store, dir, kHugeId, kHugeFrames) && store.preload({kHugeId});
+  expect(!hugeLoaded, "refuse a sample larger than the pool");
+  expect(intact(store, kBigId, kBigFrames), "resident samples kept after the refusal");
+
+  printf("%s\n", failures == 0 ? "all checks passed" : "CHECKS FAILED");
+  return failures == 0 ? 0 : 1;
+}
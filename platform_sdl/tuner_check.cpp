@@ -0,0 +1,76 @@
+// BlockSizeTuner check: drives the tuner with a quality governor that stays
+// degraded block after block while the platform is slow to apply the new
+// size. Checks that the tuner steps up exactly once per applied size, that
+// it ignores the underrun a switch itself causes, and that it only steps
+// again once the larger size has run and settled. Exits with status 1 on any
+// failure.
+//
+// usage: miniacid_tuner_check
+
+#include <stdio.h>
+
+#include "../src/audio/audio_config.h"
+#include "../src/dsp/block_size_tuner.h"
+
+namespace {
+
+constexpr uint32_t kStartFrames = 256;
+constexpr uint32_t kDspUs = 1000;  // light load: only the flags drive the tuner
+
+int failures = 0;
+
+void expect(bool ok, const char* what) {
+  printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok) ++failures;
+}
+
+float budgetUs(uint32_t frames) {
+  return static_cast<float>(frames) * 1000000.0f / kSampleRate;
+}
+
+// Runs `blocks` blocks at runningFrames; returns how many times the requested
+// size changed.
+int run(BlockSizeTuner& tuner, uint32_t runningFrames, int blocks, bool underrun, bool degraded) {
+  int steps = 0;
+  for (int i = 0; i < blocks; ++i) {
+    uint32_t before = tuner.blockFrames();
+    uint32_t frames = tuner.update(runningFrames, kDspUs, budgetUs(runningFrames), underrun, degraded);
+    if (frames != before) ++steps;
+  }
+  return steps;
+}
+
+} // namespace
+
+int main() {
+  BlockSizeTuner tuner;
+  tuner.reset(kStartFrames);
+
+  // Degraded from the first block; the platform has not applied anything for
+  // a second's worth of blocks at the old size.
+  const int secondOfBlocks = static_cast<int>(kSampleRate / kStartFrames);
+  int steps = run(tuner, kStartFrames, secondOfBlocks, false, true);
+  expect(steps == 1, "sustained degrade steps up once");
+  expect(tuner.blockFrames() == kStartFrames * 2, "step is one doubling");
+
+  // The platform switches; the switch underruns and the governor is still
+  // catching up. Nothing within the settle window counts.
+  const uint32_t applied = tuner.blockFrames();
+  steps = run(tuner, applied, 1, true, true);
+  steps += run(tuner, applied, 2, false, true);
+  expect(steps == 0, "switch underrun and settle window ignored");
+  expect(tuner.blockFrames() == applied, "size held while settling");
+
+  // Still degraded once settled: this size fails too, one more step.
+  steps = run(tuner, applied, secondOfBlocks, false, true);
+  expect(steps == 1, "settled degrade steps up once more");
+  expect(tuner.blockFrames() == applied * 2, "next step is one doubling");
+
+  // A healthy size is kept until its probe window is over.
+  tuner.reset(kStartFrames);
+  steps = run(tuner, kStartFrames, secondOfBlocks, false, false);
+  expect(steps == 0 && !tuner.settled(), "healthy size not stepped within a second");
+
+  printf("%s\n", failures == 0 ? "all checks passed" : "CHECKS FAILED");
+  return failures == 0 ? 0 : 1;
+}
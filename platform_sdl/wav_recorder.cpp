@@ -26,11 +26,15 @@ WavRecorder::~WavRecorder() {
 }
 
 bool WavRecorder::start(int sampleRate, int channels) {
+  return start(generateTimestampFilename(), sampleRate, channels);
+}
+
+bool WavRecorder::start(const std::string& filename, int sampleRate, int channels) {
   if (file_) {
     return false;
   }
 
-  filename_ = generateTimestampFilename();
+  filename_ = filename;
   file_ = std::fopen(filename_.c_str(), "wb");
   if (!file_) {
     filename_.clear();
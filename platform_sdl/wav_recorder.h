@@ -11,6 +11,7 @@ class WavRecorder {
   ~WavRecorder();
 
   bool start(int sampleRate, int channels);
+  bool start(const std::string& filename, int sampleRate, int channels);
   void stop();
   bool isRecording() const;
   void writeSamples(const int16_t* samples, size_t sampleCount);
@@ -0,0 +1,35 @@
+#include "scene_binary.h"
+
+#include <cstring>
+
+namespace scene_binary {
+
+namespace {
+// Nibble table: 64 bytes instead of 1 KB, and scene files are small.
+constexpr uint32_t kCrcNibble[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+};
+} // namespace
+
+uint32_t crc32(const void* data, size_t len, uint32_t crc) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= p[i];
+    crc = (crc >> 4) ^ kCrcNibble[crc & 0x0F];
+    crc = (crc >> 4) ^ kCrcNibble[crc & 0x0F];
+  }
+  return ~crc;
+}
+
+bool isBinaryScene(const void* data, size_t len) {
+  if (!data || len < sizeof(FileHeader)) return false;
+  uint32_t magic = 0;
+  std::memcpy(&magic, data, sizeof(magic));
+  return magic == kMagic;
+}
+
+} // namespace scene_binary
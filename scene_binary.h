@@ -0,0 +1,78 @@
+#pragma once
+#ifndef SCENE_BINARY_H
+#define SCENE_BINARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Binary scene container (*.gps), the fast load/save format. JSON stays the
+// interchange format.
+//
+//   FileHeader                       magic, format version, section count
+//   SectionHeader + payload  x N     tag, section version, size, CRC-32
+//
+// Pattern banks, songs and the other Scene sub-structs are stored as raw
+// struct images, like PatternPagingService pages, so a section loads with a
+// single read straight into the Scene. A loader skips tags it does not know;
+// a known tag whose version or size does not match the running build is
+// skipped too (or fails the load if the section is required), which lets
+// either side add sections without breaking the other. Any CRC mismatch fails
+// the whole load so the caller can fall back to JSON.
+namespace scene_binary {
+
+constexpr uint32_t makeTag(char a, char b, char c, char d) {
+  return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+}
+
+constexpr uint32_t kMagic = makeTag('G', 'P', 'S', 'C');
+// Bumped only for changes an older loader cannot skip past (header layout).
+constexpr uint16_t kFormatVersion = 1;
+
+struct FileHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t sectionCount;
+};
+
+struct SectionHeader {
+  uint32_t tag;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t size;  // payload bytes following this header
+  uint32_t crc;   // CRC-32 of the payload
+};
+
+static_assert(sizeof(FileHeader) == 8, "FileHeader must stay packed");
+static_assert(sizeof(SectionHeader) == 16, "SectionHeader must stay packed");
+
+// Required sections: a file without them is rejected.
+constexpr uint32_t kTagDrumBanks = makeTag('D', 'R', 'M', 'B');
+constexpr uint32_t kTagSynthABanks = makeTag('S', 'Y', 'N', 'A');
+constexpr uint32_t kTagSynthBBanks = makeTag('S', 'Y', 'N', 'B');
+constexpr uint32_t kTagSongs = makeTag('S', 'O', 'N', 'G');
+constexpr uint32_t kTagState = makeTag('S', 'T', 'A', 'T');
+// Optional sections: missing or incompatible ones keep their defaults.
+constexpr uint32_t kTagEngines = makeTag('E', 'N', 'G', 'N');
+constexpr uint32_t kTagSamplerPads = makeTag('S', 'M', 'P', 'L');
+constexpr uint32_t kTagTape = makeTag('T', 'A', 'P', 'E');
+constexpr uint32_t kTagFeel = makeTag('F', 'E', 'E', 'L');
+constexpr uint32_t kTagGenre = makeTag('G', 'E', 'N', 'R');
+constexpr uint32_t kTagDrumFx = makeTag('D', 'F', 'X', ' ');
+constexpr uint32_t kTagGenerator = makeTag('G', 'E', 'N', 'P');
+constexpr uint32_t kTagVocal = makeTag('V', 'O', 'C', 'L');
+constexpr uint32_t kTagLed = makeTag('L', 'E', 'D', ' ');
+constexpr uint32_t kTagTrackVolumes = makeTag('T', 'V', 'O', 'L');
+constexpr uint32_t kTagPhrases = makeTag('P', 'H', 'R', 'S');
+
+// Standard CRC-32 (IEEE, reflected). Pass the previous result to continue.
+uint32_t crc32(const void* data, size_t len, uint32_t crc = 0);
+
+// True if the buffer starts with a binary scene header.
+bool isBinaryScene(const void* data, size_t len);
+
+} // namespace scene_binary
+
+#endif // SCENE_BINARY_H
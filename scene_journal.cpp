@@ -0,0 +1,256 @@
+#include "scene_journal.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include "scene_binary.h"
+#include "scenes.h"
+
+namespace {
+using scene_binary::FileHeader;
+using scene_binary::SectionHeader;
+using scene_binary::crc32;
+using scene_binary::makeTag;
+
+constexpr uint32_t kJournalMagic = makeTag('G', 'P', 'J', 'N');
+constexpr uint16_t kJournalVersion = 1;
+constexpr uint32_t kTagCommit = makeTag('C', 'M', 'I', 'T');
+
+struct JournalHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t snapshotCrc;  // CRC-32 of the snapshot file this journal extends
+};
+
+struct RecordHeader {
+  uint32_t tag;             // section tag, or kTagCommit
+  uint16_t sectionVersion;
+  uint16_t length;          // payload bytes following this header
+  uint32_t sectionSize;     // size of the whole section; record count for a commit
+  uint32_t offset;          // where the payload goes in the section
+  uint32_t crc;             // CRC-32 of the fields above and the payload
+};
+
+static_assert(sizeof(JournalHeader) == SceneJournal::headerSize(), "JournalHeader must stay packed");
+static_assert(sizeof(RecordHeader) == 20, "RecordHeader must stay packed");
+static_assert(SceneJournal::kBlockSize <= UINT16_MAX, "slice length must fit RecordHeader::length");
+
+uint32_t recordCrc(const RecordHeader& record, const void* payload) {
+  uint32_t crc = crc32(&record, offsetof(RecordHeader, crc));
+  return crc32(payload, record.length, crc);
+}
+
+// Cuts a binary scene container into per-section kBlockSize slices as it
+// streams out of SceneManager::writeSceneBinary, so a scan never holds more
+// than one slice of the scene.
+class SliceSink {
+public:
+  using OnSlice = std::function<bool(const SectionHeader& section, uint32_t offset, const uint8_t* data,
+                                     size_t len)>;
+
+  explicit SliceSink(const OnSlice& onSlice) : onSlice_(onSlice) {}
+
+  size_t write(const uint8_t* data, size_t len) {
+    size_t pos = 0;
+    while (pos < len && !failed_) {
+      if (!inSection_) {
+        size_t need = (haveFileHeader_ ? sizeof(SectionHeader) : sizeof(FileHeader)) - headerFill_;
+        size_t n = std::min(need, len - pos);
+        std::memcpy(header_ + headerFill_, data + pos, n);
+        headerFill_ += n;
+        pos += n;
+        if (n < need) break;
+        headerFill_ = 0;
+        if (!haveFileHeader_) {
+          haveFileHeader_ = true;
+          continue;
+        }
+        std::memcpy(&section_, header_, sizeof(section_));
+        remaining_ = section_.size;
+        offset_ = 0;
+        inSection_ = remaining_ > 0;
+        continue;
+      }
+      size_t n = std::min(len - pos, std::min(SceneJournal::kBlockSize - blockFill_, static_cast<size_t>(remaining_)));
+      std::memcpy(block_ + blockFill_, data + pos, n);
+      blockFill_ += n;
+      remaining_ -= static_cast<uint32_t>(n);
+      pos += n;
+      if (blockFill_ == SceneJournal::kBlockSize || remaining_ == 0) {
+        if (!onSlice_(section_, offset_, block_, blockFill_)) failed_ = true;
+        offset_ += static_cast<uint32_t>(blockFill_);
+        blockFill_ = 0;
+        if (remaining_ == 0) inSection_ = false;
+      }
+    }
+    return failed_ ? 0 : len;
+  }
+
+  bool complete() const { return !failed_ && haveFileHeader_ && !inSection_ && headerFill_ == 0; }
+
+private:
+  const OnSlice& onSlice_;
+  uint8_t header_[sizeof(SectionHeader)];
+  size_t headerFill_ = 0;
+  bool haveFileHeader_ = false;
+  bool inSection_ = false;
+  bool failed_ = false;
+  SectionHeader section_{};
+  uint32_t remaining_ = 0;
+  uint32_t offset_ = 0;
+  uint8_t block_[SceneJournal::kBlockSize];
+  size_t blockFill_ = 0;
+};
+
+// Read() may return short counts before the end of the file.
+size_t readFully(const SceneJournal::Read& read, void* dst, size_t len) {
+  size_t got = 0;
+  while (got < len) {
+    size_t n = read(static_cast<uint8_t*>(dst) + got, len - got);
+    if (n == 0) break;
+    got += n;
+  }
+  return got;
+}
+
+// Reads the next record and its payload; false at the end of the journal or
+// at a record that is torn or fails its CRC.
+bool readRecord(const SceneJournal::Read& read, RecordHeader& record, uint8_t* payload) {
+  if (readFully(read, &record, sizeof(record)) != sizeof(record)) return false;
+  if (record.length > SceneJournal::kBlockSize) return false;
+  if (readFully(read, payload, record.length) != record.length) return false;
+  return recordCrc(record, payload) == record.crc;
+}
+} // namespace
+
+void SceneJournal::reset() {
+  sections_.clear();
+  hasBaseline_ = false;
+}
+
+bool SceneJournal::scan(const SceneManager& manager, std::vector<SectionState>& sections,
+                        const std::function<bool(const SectionState& section, uint32_t offset,
+                                                 const uint8_t* data, size_t len, bool changed)>& onBlock) const {
+  sections.clear();
+  const SectionState* previous = nullptr;
+  SliceSink::OnSlice onSlice = [&](const SectionHeader& sh, uint32_t offset, const uint8_t* data,
+                                   size_t len) -> bool {
+    if (offset == 0) {
+      sections.push_back({sh.tag, sh.version, sh.size, {}});
+      sections.back().blockCrcs.reserve((sh.size + kBlockSize - 1) / kBlockSize);
+      previous = nullptr;
+      for (const SectionState& old : sections_) {
+        if (old.tag == sh.tag && old.version == sh.version && old.size == sh.size) {
+          previous = &old;
+          break;
+        }
+      }
+    }
+    SectionState& section = sections.back();
+    size_t index = section.blockCrcs.size();
+    uint32_t crc = crc32(data, len);
+    section.blockCrcs.push_back(crc);
+    bool changed = !previous || previous->blockCrcs[index] != crc;
+    return onBlock(section, offset, data, len, changed);
+  };
+  SliceSink sink(onSlice);
+  return manager.writeSceneBinary(sink) && sink.complete();
+}
+
+bool SceneJournal::setBaseline(const SceneManager& manager) {
+  std::vector<SectionState> sections;
+  bool ok = scan(manager, sections, [](const SectionState&, uint32_t, const uint8_t*, size_t, bool) {
+    return true;
+  });
+  if (!ok) {
+    reset();
+    return false;
+  }
+  sections_ = std::move(sections);
+  hasBaseline_ = true;
+  return true;
+}
+
+bool SceneJournal::writeHeader(const Write& write, uint32_t snapshotCrc) {
+  JournalHeader header{kJournalMagic, kJournalVersion, 0, snapshotCrc};
+  return write(&header, sizeof(header));
+}
+
+bool SceneJournal::append(const SceneManager& manager, const Write& write, size_t* bytesWritten) {
+  size_t bytes = 0;
+  if (bytesWritten) *bytesWritten = 0;
+  if (!hasBaseline_) return false;
+
+  std::vector<SectionState> sections;
+  uint32_t records = 0;
+  bool ok = scan(manager, sections, [&](const SectionState& section, uint32_t offset, const uint8_t* data,
+                                        size_t len, bool changed) -> bool {
+    if (!changed) return true;
+    RecordHeader record{section.tag, section.version, static_cast<uint16_t>(len), section.size, offset, 0};
+    record.crc = recordCrc(record, data);
+    if (!write(&record, sizeof(record)) || !write(data, len)) return false;
+    bytes += sizeof(record) + len;
+    ++records;
+    return true;
+  });
+  if (ok && records > 0) {
+    RecordHeader commit{kTagCommit, 0, 0, records, 0, 0};
+    commit.crc = recordCrc(commit, nullptr);
+    ok = write(&commit, sizeof(commit));
+    bytes += sizeof(commit);
+  }
+  if (bytesWritten) *bytesWritten = bytes;
+  if (!ok) return false;
+  sections_ = std::move(sections);
+  return true;
+}
+
+int SceneJournal::replay(SceneManager& manager, const Read& read, const Seek& seek, uint32_t snapshotCrc,
+                         size_t* committedBytes) {
+  if (committedBytes) *committedBytes = 0;
+
+  JournalHeader header;
+  if (readFully(read, &header, sizeof(header)) != sizeof(header)) return 0;
+  if (header.magic != kJournalMagic || header.version != kJournalVersion || header.snapshotCrc != snapshotCrc) {
+    return 0;
+  }
+
+  // Find the end of the last batch whose records and commit are all intact.
+  RecordHeader record;
+  uint8_t payload[kBlockSize];
+  size_t pos = sizeof(header);
+  size_t committed = pos;
+  uint32_t pending = 0;
+  int batches = 0;
+  while (readRecord(read, record, payload)) {
+    pos += sizeof(record) + record.length;
+    if (record.tag == kTagCommit) {
+      if (record.sectionSize != pending) break;
+      pending = 0;
+      committed = pos;
+      ++batches;
+    } else {
+      ++pending;
+    }
+  }
+  if (committedBytes) *committedBytes = committed;
+  if (batches == 0) return 0;
+
+  // Second pass: patch the committed slices into a staged copy of the scene.
+  if (!seek(sizeof(header))) return -1;
+  manager.beginSectionPatch();
+  pos = sizeof(header);
+  while (pos < committed) {
+    if (!readRecord(read, record, payload)) return -1;
+    pos += sizeof(record) + record.length;
+    if (record.tag == kTagCommit) continue;
+    // Sections this build does not write, or writes in another layout, are
+    // left to the snapshot.
+    manager.patchSection(record.tag, record.sectionVersion, record.sectionSize, record.offset, payload,
+                         record.length);
+  }
+  if (!manager.commitSectionPatch()) return -1;
+  return batches;
+}
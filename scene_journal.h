@@ -0,0 +1,80 @@
+#pragma once
+#ifndef SCENE_JOURNAL_H
+#define SCENE_JOURNAL_H
+
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class SceneManager;
+
+// Append-only autosave journal on top of a binary scene snapshot (*.gps).
+//
+//   JournalHeader                     magic, version, CRC of the snapshot file
+//   RecordHeader + bytes  x N         changed kBlockSize slices of sections
+//   RecordHeader (commit)             closes the batch of one append()
+//   ... further batches ...
+//
+// Edits are not hooked one by one: append() streams the scene through the
+// binary container writer, CRCs every section in kBlockSize slices and
+// writes only the slices that differ from what was last persisted, so an
+// autosave costs what changed rather than the size of the scene. Records
+// hold absolute bytes, not deltas, so replaying them is idempotent.
+//
+// replay() applies whole batches only, up to the last intact commit record:
+// a batch torn by a power loss is dropped and the scene comes back as of
+// the previous autosave. A journal written against a different snapshot
+// (its snapshot CRC does not match) is ignored.
+class SceneJournal {
+public:
+  static constexpr size_t kBlockSize = 256;
+
+  using Write = std::function<bool(const void* data, size_t len)>;
+  using Read = std::function<size_t(void* dst, size_t len)>;
+  using Seek = std::function<bool(size_t offset)>;
+
+  // Forgets the persisted state; append() fails until setBaseline().
+  void reset();
+  bool hasBaseline() const { return hasBaseline_; }
+  // Marks the scene as persisted, e.g. right after a snapshot was written or
+  // a snapshot plus journal was loaded.
+  bool setBaseline(const SceneManager& manager);
+
+  // Starts a journal for the snapshot whose file bytes have this CRC.
+  static bool writeHeader(const Write& write, uint32_t snapshotCrc);
+  static constexpr size_t headerSize() { return 12; }
+
+  // Appends one batch with every slice changed since the baseline, then
+  // moves the baseline. Nothing is written when nothing changed. On failure
+  // the baseline stays put, so the next append() writes the slices again.
+  bool append(const SceneManager& manager, const Write& write, size_t* bytesWritten = nullptr);
+
+  // Applies the committed batches of a journal to `manager`, which must hold
+  // the snapshot the journal was started for. Reads the journal twice, once
+  // to find the intact prefix and once (after seek(), to a file offset) to
+  // patch it into the scene, holding one record at a time. Returns the
+  // number of batches applied (0 for an empty or foreign journal), or -1 if
+  // the second pass failed; the scene is unchanged then. committedBytes
+  // receives the length of the intact prefix, so a caller can tell whether
+  // the file has a torn tail.
+  static int replay(SceneManager& manager, const Read& read, const Seek& seek, uint32_t snapshotCrc,
+                    size_t* committedBytes = nullptr);
+
+private:
+  struct SectionState {
+    uint32_t tag;
+    uint16_t version;
+    uint32_t size;
+    std::vector<uint32_t> blockCrcs;
+  };
+
+  bool scan(const SceneManager& manager, std::vector<SectionState>& sections,
+            const std::function<bool(const SectionState& section, uint32_t offset, const uint8_t* data,
+                                     size_t len, bool changed)>& onBlock) const;
+
+  std::vector<SectionState> sections_;
+  bool hasBaseline_ = false;
+};
+
+#endif // SCENE_JOURNAL_H
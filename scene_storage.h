@@ -22,7 +22,9 @@ public:
   virtual bool readScene(SceneManager& manager) = 0;
   virtual bool writeScene(const SceneManager& manager) = 0;
   
-  // Auto-save variants (saves to *.auto.json)
+  // Auto-save variants. Called periodically, so writes should cost what
+  // changed (the Cardputer journals edits over a *.auto.gps snapshot); reads
+  // fall back to the saved scene.
   virtual bool writeSceneAuto(const SceneManager& manager) = 0;
   virtual bool readSceneAuto(SceneManager& manager) = 0;
 
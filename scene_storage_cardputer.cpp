@@ -1,5 +1,6 @@
 #include "scene_storage_cardputer.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstring>
 #include <new>
@@ -10,7 +11,10 @@
 #if defined(ESP32) || defined(ESP_PLATFORM)
 #include <esp_heap_caps.h>
 #endif
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
+#include "scene_binary.h"
 #include "scenes.h"
 
 #define SD_SPI_SCK_PIN  40
@@ -47,6 +51,8 @@ std::string SceneStorageCardputer::normalizeSceneName(const std::string& name) c
   if (!cleaned.empty() && cleaned.front() == '/') cleaned.erase(0, 1);
   if (endsWith(cleaned, kSceneExtension)) {
     cleaned.resize(cleaned.size() - std::strlen(kSceneExtension));
+  } else if (endsWith(cleaned, kBinarySceneExtension)) {
+    cleaned.resize(cleaned.size() - std::strlen(kBinarySceneExtension));
   }
   if (cleaned.empty()) cleaned = kDefaultSceneName;
   return cleaned;
@@ -76,6 +82,114 @@ std::string SceneStorageCardputer::currentAutoScenePath() const {
   return autoScenePathFor(currentSceneName_);
 }
 
+std::string SceneStorageCardputer::currentBinaryScenePath() const {
+  std::string path = kScenesDirectory;
+  path += "/";
+  path += normalizeSceneName(currentSceneName_);
+  path += kBinarySceneExtension;
+  return path;
+}
+
+std::string SceneStorageCardputer::currentAutoBinaryScenePath() const {
+  std::string path = kScenesDirectory;
+  path += "/";
+  path += normalizeSceneName(currentSceneName_);
+  path += kAutoBinarySceneExtension;
+  return path;
+}
+
+std::string SceneStorageCardputer::currentJournalPath() const {
+  std::string path = kScenesDirectory;
+  path += "/";
+  path += normalizeSceneName(currentSceneName_);
+  path += kJournalExtension;
+  return path;
+}
+
+std::string SceneStorageCardputer::currentSnapshotTempPath() const {
+  std::string path = kScenesDirectory;
+  path += "/";
+  path += normalizeSceneName(currentSceneName_);
+  path += kSnapshotTempExtension;
+  return path;
+}
+
+bool SceneStorageCardputer::readBinaryScene(const std::string& path, SceneManager& manager,
+                                            uint32_t* fileCrc) const {
+  if (!SD.exists(path.c_str())) return false;
+  File file = SD.open(path.c_str(), FILE_READ);
+  if (!file) return false;
+  unsigned long start = millis();
+  // The loader reads the whole file, so the CRC of what passes through
+  // identifies the snapshot a journal belongs to.
+  struct CrcReader {
+    File& file;
+    uint32_t crc;
+    size_t read(uint8_t* dst, size_t len) {
+      size_t n = file.read(dst, len);
+      crc = scene_binary::crc32(dst, n, crc);
+      return n;
+    }
+  } reader{file, 0};
+  bool ok = manager.loadSceneBinary(reader);
+  if (fileCrc) *fileCrc = reader.crc;
+  file.close();
+  Serial.printf("Binary read %s %s in %lu ms\n", path.c_str(), ok ? "succeeded" : "failed",
+                millis() - start);
+  return ok;
+}
+
+bool SceneStorageCardputer::readMainBinaryScene(SceneManager& manager) const {
+  std::string binaryPath = currentBinaryScenePath();
+  std::string jsonPath = currentScenePath();
+  if (SD.exists(binaryPath.c_str()) && SD.exists(jsonPath.c_str())) {
+    File binary = SD.open(binaryPath.c_str(), FILE_READ);
+    File json = SD.open(jsonPath.c_str(), FILE_READ);
+    time_t binaryTime = binary ? binary.getLastWrite() : 0;
+    time_t jsonTime = json ? json.getLastWrite() : 0;
+    if (binary) binary.close();
+    if (json) json.close();
+    if (jsonTime > binaryTime) {
+      Serial.printf("%s is newer than %s, dropping the binary\n", jsonPath.c_str(), binaryPath.c_str());
+      SD.remove(binaryPath.c_str());
+      return false;
+    }
+  }
+  return readBinaryScene(binaryPath, manager);
+}
+
+bool SceneStorageCardputer::writeBinaryScene(const std::string& path, const SceneManager& manager) const {
+  SD.remove(path.c_str());
+  File file = SD.open(path.c_str(), FILE_WRITE);
+  if (!file) {
+    Serial.printf("Failed to open file for writing: %s\n", path.c_str());
+    return false;
+  }
+  bool ok = manager.writeSceneBinary(file);
+  file.flush();
+  file.close();
+  if (!ok) {
+    // A truncated container would shadow the JSON on the next load.
+    SD.remove(path.c_str());
+  }
+  Serial.printf("Binary write %s %s\n", path.c_str(), ok ? "succeeded" : "FAILED");
+  return ok;
+}
+
+bool SceneStorageCardputer::readJsonScene(const std::string& path, SceneManager& manager) const {
+  Serial.printf("Reading scene (streaming) from SD card (%s)...\n", path.c_str());
+  File file = SD.open(path.c_str(), FILE_READ);
+  if (!file) return false;
+
+  Serial.println("File opened successfully, loading scene...");
+  bool ok = manager.loadSceneEvented(file);
+  file.close();
+  // ArduinoJson fallback REMOVED - it causes OOM on DRAM-only devices
+  // If streaming parse fails, caller will load default scene instead
+  Serial.printf("Streaming read %s\n", ok ? "succeeded" : "failed");
+  return ok;
+}
+
 void SceneStorageCardputer::loadStoredSceneName() {
   if (!isInitialized_) return;
   File file = SD.open(kSceneNamePath, FILE_READ);
@@ -185,18 +299,8 @@ bool SceneStorageCardputer::readScene(SceneManager& manager) {
     Serial.println("Storage not initialized. Please call initializeStorage() first.");
     return false;
   }
-  std::string path = currentScenePath();
-  Serial.printf("Reading scene (streaming) from SD card (%s)...\n", path.c_str());
-  File file = SD.open(path.c_str(), FILE_READ);
-  if (!file) return false;
-
-  Serial.println("File opened successfully, loading scene...");
-  bool ok = manager.loadSceneEvented(file);
-  file.close();
-  // ArduinoJson fallback REMOVED - it causes OOM on DRAM-only devices
-  // If streaming parse fails, caller will load default scene instead
-  Serial.printf("Streaming read %s\n", ok ? "succeeded" : "failed");
-  return ok;
+  if (readMainBinaryScene(manager)) return true;
+  return readJsonScene(currentScenePath(), manager);
 }
 
 bool SceneStorageCardputer::writeScene(const SceneManager& manager) {
@@ -204,8 +308,9 @@ bool SceneStorageCardputer::writeScene(const SceneManager& manager) {
     Serial.println("Storage not initialized. Please call initializeStorage() first.");
     return false;
   }
-  Serial.println("Writing scene (streaming) to SD card...");
   persistCurrentSceneName();
+
+  Serial.println("Writing scene (streaming) to SD card...");
   std::string path = currentScenePath();
   SD.remove(path.c_str());
   
@@ -227,40 +332,191 @@ bool SceneStorageCardputer::writeScene(const SceneManager& manager) {
 
   if (ok && bytesWritten > 0 && verifiedSize == bytesWritten) {
     Serial.printf("Streaming write succeeded to %s (total size: %zu bytes, verified: %zu)\n", path.c_str(), bytesWritten, verifiedSize);
-    return true;
+    // Binary for loading, written after the JSON so it is not taken as
+    // stale; the JSON keeps the scene portable.
+    bool binaryOk = writeBinaryScene(currentBinaryScenePath(), manager);
+    // The saved scene is now newer than any auto-save of it.
+    retireAutoSave();
+    return binaryOk;
   } else {
     Serial.printf("Streaming write FAILED! ok=%d, written=%zu, verified=%zu\n", ok, bytesWritten, verifiedSize);
     return false;
   }
 }
 
+struct SceneStorageCardputer::CompactionJob {
+  SceneStorageCardputer* storage;
+  std::string image;  // serialized on the UI thread; the task never reads the Scene
+  uint32_t imageCrc;
+  std::string snapshotPath;
+  std::string tempPath;
+  std::string journalPath;
+};
+
 bool SceneStorageCardputer::writeSceneAuto(const SceneManager& manager) {
   if (!isInitialized_) {
     Serial.println("Storage not initialized. Please call initializeStorage() first.");
     return false;
   }
-  Serial.println("Writing auto-save scene to SD card...");
-  std::string path = currentAutoScenePath();
-  SD.remove(path.c_str());
-  
-  File file = SD.open(path.c_str(), FILE_WRITE);
-  if (!file) {
-    Serial.printf("Failed to open auto-save file for writing: %s\n", path.c_str());
+  // The snapshot being written holds everything up to its start; edits since
+  // then are still ahead of the baseline and go into the next append.
+  if (compacting_.load(std::memory_order_acquire)) return true;
+  if (compactionFailed_.exchange(false)) journal_.reset();
+
+  if (journal_.hasBaseline() && journalBytes_ < kJournalCompactBytes) {
+    if (appendJournal(manager)) return true;
+    // A torn batch would hide every later one from replay; start over.
+    journal_.reset();
+  }
+  if (!startCompaction(manager)) return false;
+  // Drop a legacy JSON auto-save so it cannot outlive this one.
+  SD.remove(currentAutoScenePath().c_str());
+  return true;
+}
+
+bool SceneStorageCardputer::appendJournal(const SceneManager& manager) {
+  std::string path = currentJournalPath();
+  unsigned long start = millis();
+  // Opened on the first record, so an auto-save with no changes costs no I/O.
+  File file;
+  bool opened = false;
+  size_t bytes = 0;
+  bool ok = journal_.append(manager, [&](const void* data, size_t len) -> bool {
+    if (!opened) {
+      opened = true;
+      file = SD.open(path.c_str(), FILE_APPEND);
+    }
+    if (!file) return false;
+    return file.write(static_cast<const uint8_t*>(data), len) == len;
+  }, &bytes);
+  if (file) {
+    file.flush();
+    file.close();
+  }
+  journalBytes_ += bytes;
+  if (bytes > 0 || !ok) {
+    Serial.printf("Journal append %s: %zu bytes in %lu ms\n", ok ? "ok" : "FAILED", bytes, millis() - start);
+  }
+  return ok;
+}
+
+void SceneStorageCardputer::replayJournal(SceneManager& manager, uint32_t snapshotCrc) {
+  std::string path = currentJournalPath();
+  File file = SD.open(path.c_str(), FILE_READ);
+  if (!file) return;
+  size_t fileSize = file.size();
+  size_t committed = 0;
+  unsigned long start = millis();
+  int batches = SceneJournal::replay(manager, [&file](void* dst, size_t len) -> size_t {
+    return file.read(static_cast<uint8_t*>(dst), len);
+  }, [&file](size_t offset) -> bool {
+    return file.seek(offset);
+  }, snapshotCrc, &committed);
+  file.close();
+  Serial.printf("Journal replay %s: %d batches, %zu/%zu bytes in %lu ms\n", path.c_str(), batches, committed,
+                fileSize, millis() - start);
+  if (batches < 0) {
+    // It would fail the same way on every boot. The scene stays as of the
+    // snapshot, and with no baseline the next auto-save writes a fresh one.
+    SD.remove(path.c_str());
+    return;
+  }
+  // Keep appending only to this snapshot's journal with no torn tail; in any
+  // other case the next auto-save starts over with a fresh snapshot.
+  if (committed > 0 && committed == fileSize && journal_.setBaseline(manager)) {
+    journalBytes_ = committed;
+  }
+}
+
+bool SceneStorageCardputer::startCompaction(const SceneManager& manager) {
+  CompactionJob* job = new (std::nothrow) CompactionJob();
+  if (!job) return false;
+  job->storage = this;
+  job->image.reserve(sizeof(Scene) + 1024);
+  if (!manager.writeSceneBinary(job->image) || !journal_.setBaseline(manager)) {
+    journal_.reset();
+    delete job;
     return false;
   }
+  job->imageCrc = scene_binary::crc32(job->image.data(), job->image.size());
+  job->snapshotPath = currentAutoBinaryScenePath();
+  job->tempPath = currentSnapshotTempPath();
+  job->journalPath = currentJournalPath();
+
+  compacting_.store(true, std::memory_order_release);
+  if (xTaskCreatePinnedToCore(compactionTask, "SceneCompact", 4096, job, 1, nullptr, 0) != pdPASS) {
+    Serial.println("Compaction task failed to start, writing snapshot inline");
+    runCompaction(job);
+  }
+  return true;
+}
 
-  bool ok = manager.writeSceneJson(file);
+void SceneStorageCardputer::compactionTask(void* arg) {
+  CompactionJob* job = static_cast<CompactionJob*>(arg);
+  job->storage->runCompaction(job);
+  vTaskDelete(nullptr);
+}
+
+void SceneStorageCardputer::runCompaction(CompactionJob* job) {
+  bool ok = writeSnapshot(*job);
+  delete job;
+  compactionFailed_.store(!ok, std::memory_order_relaxed);
+  compacting_.store(false, std::memory_order_release);
+}
+
+bool SceneStorageCardputer::writeSnapshot(const CompactionJob& job) {
+  unsigned long start = millis();
+  // 1. New snapshot beside the old one. Losing power here leaves the old
+  //    snapshot and its journal as they were.
+  SD.remove(job.tempPath.c_str());
+  File file = SD.open(job.tempPath.c_str(), FILE_WRITE);
+  if (!file) {
+    Serial.printf("Failed to open file for writing: %s\n", job.tempPath.c_str());
+    return false;
+  }
+  size_t written = file.write(reinterpret_cast<const uint8_t*>(job.image.data()), job.image.size());
   file.flush();
-  size_t bytesWritten = file.size();
   file.close();
+  if (written != job.image.size()) {
+    SD.remove(job.tempPath.c_str());
+    Serial.printf("Snapshot write FAILED (%zu of %zu bytes)\n", written, job.image.size());
+    return false;
+  }
 
-  if (ok && bytesWritten > 0) {
-    Serial.printf("Auto-save succeeded to %s (%zu bytes)\n", path.c_str(), bytesWritten);
-    return true;
-  } else {
-    Serial.printf("Auto-save FAILED! ok=%d, written=%zu\n", ok, bytesWritten);
+  // 2. Swap it in. A power loss between remove and rename is picked up by
+  //    readSceneAuto, which falls back to the .tmp file.
+  SD.remove(job.snapshotPath.c_str());
+  if (!SD.rename(job.tempPath.c_str(), job.snapshotPath.c_str())) {
+    Serial.printf("Snapshot rename FAILED: %s\n", job.snapshotPath.c_str());
     return false;
   }
+
+  // 3. Fresh journal. The old one names the old snapshot's CRC, so until it
+  //    is replaced it is ignored, and the new snapshot already contains it.
+  SD.remove(job.journalPath.c_str());
+  File journal = SD.open(job.journalPath.c_str(), FILE_WRITE);
+  if (!journal) return false;
+  bool ok = SceneJournal::writeHeader([&journal](const void* data, size_t len) -> bool {
+    return journal.write(static_cast<const uint8_t*>(data), len) == len;
+  }, job.imageCrc);
+  journal.flush();
+  journal.close();
+  journalBytes_ = SceneJournal::headerSize();
+  Serial.printf("Auto-save snapshot %s: %zu bytes in %lu ms\n", ok ? "written" : "journal FAILED",
+                job.image.size(), millis() - start);
+  return ok;
+}
+
+void SceneStorageCardputer::waitForCompaction() const {
+  while (compacting_.load(std::memory_order_acquire)) delay(5);
+}
+
+void SceneStorageCardputer::retireAutoSave() {
+  waitForCompaction();
+  journal_.reset();
+  SD.remove(currentAutoBinaryScenePath().c_str());
+  SD.remove(currentSnapshotTempPath().c_str());
+  SD.remove(currentJournalPath().c_str());
 }
 
 bool SceneStorageCardputer::readSceneAuto(SceneManager& manager) {
@@ -268,6 +524,20 @@ bool SceneStorageCardputer::readSceneAuto(SceneManager& manager) {
     Serial.println("Storage not initialized. Please call initializeStorage() first.");
     return false;
   }
+  waitForCompaction();
+  journal_.reset();
+  std::string snapshotPath = currentAutoBinaryScenePath();
+  std::string tempPath = currentSnapshotTempPath();
+  // A compaction cut off between dropping the old snapshot and renaming the
+  // new one; the loader's CRCs reject the file if it is incomplete.
+  if (!SD.exists(snapshotPath.c_str()) && SD.exists(tempPath.c_str())) {
+    SD.rename(tempPath.c_str(), snapshotPath.c_str());
+  }
+  uint32_t snapshotCrc = 0;
+  if (readBinaryScene(snapshotPath, manager, &snapshotCrc)) {
+    replayJournal(manager, snapshotCrc);
+    return true;
+  }
   std::string autoPath = currentAutoScenePath();
   
   // Try auto-save file first
@@ -287,6 +557,7 @@ bool SceneStorageCardputer::readSceneAuto(SceneManager& manager) {
   }
   
   // Fallback to main scene file
+  if (readMainBinaryScene(manager)) return true;
   std::string mainPath = currentScenePath();
   if (SD.exists(mainPath.c_str())) {
     Serial.printf("Reading main scene from SD card (%s)...\n", mainPath.c_str());
@@ -330,9 +601,20 @@ std::vector<std::string> SceneStorageCardputer::getAvailableSceneNames() const {
     if (!entry.isDirectory()) {
       std::string fileName = entry.name();
       if (!fileName.empty() && fileName.front() == '/') fileName.erase(0, 1);
-      if (endsWith(fileName, kSceneExtension)) {
-        fileName.resize(fileName.size() - std::strlen(kSceneExtension));
-        if (names.size() < kMaxSceneNamesInUi) {
+      // Auto-saves belong to their scene and are not listed on their own.
+      bool isAuto = endsWith(fileName, kAutoSceneExtension) ||
+                    endsWith(fileName, kAutoBinarySceneExtension);
+      const char* extension = nullptr;
+      if (!isAuto && endsWith(fileName, kSceneExtension)) {
+        extension = kSceneExtension;
+      } else if (!isAuto && endsWith(fileName, kBinarySceneExtension)) {
+        extension = kBinarySceneExtension;
+      }
+      if (extension) {
+        fileName.resize(fileName.size() - std::strlen(extension));
+        // A scene saved with both formats is listed once.
+        if (names.size() < kMaxSceneNamesInUi &&
+            std::find(names.begin(), names.end(), fileName) == names.end()) {
           try {
             names.emplace_back(std::move(fileName));
           } catch (const std::bad_alloc&) {
@@ -361,6 +643,9 @@ std::string SceneStorageCardputer::getCurrentSceneName() const {
 }
 
 bool SceneStorageCardputer::setCurrentSceneName(const std::string& name) {
+  // The journal belongs to the scene it was started for.
+  waitForCompaction();
+  journal_.reset();
   currentSceneName_ = normalizeSceneName(name);
   if (!isInitialized_) return false;
   return persistCurrentSceneName();
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <stdint.h>
 #include <string>
 #include <vector>
+#include "scene_journal.h"
 #include "scene_storage.h"
 
 class SceneStorageCardputer : public SceneStorage {
@@ -24,16 +27,51 @@ private:
   static constexpr const char* kScenesDirectory = "/scenes";
   static constexpr const char* kSceneExtension = ".json";
   static constexpr const char* kAutoSceneExtension = ".auto.json";
+  // Binary container (scene_binary.h). Saves write it right after the JSON
+  // and loads prefer it, unless the JSON is newer (edited off-device); then
+  // the stale .gps is dropped and the JSON loads.
+  static constexpr const char* kBinarySceneExtension = ".gps";
+  static constexpr const char* kAutoBinarySceneExtension = ".auto.gps";
+  // Auto-saves append to a journal (scene_journal.h) over the .auto.gps
+  // snapshot. Once it outgrows kJournalCompactBytes, the next auto-save
+  // writes a new snapshot from a background task (via the .tmp file) and
+  // starts an empty journal.
+  static constexpr const char* kJournalExtension = ".journal";
+  static constexpr const char* kSnapshotTempExtension = ".auto.gps.tmp";
+  static constexpr size_t kJournalCompactBytes = 32 * 1024;
+
+  struct CompactionJob;
 
   std::string scenePathFor(const std::string& name) const;
   std::string autoScenePathFor(const std::string& name) const;
   std::string currentScenePath() const;
   std::string currentAutoScenePath() const;
+  std::string currentBinaryScenePath() const;
+  std::string currentAutoBinaryScenePath() const;
+  std::string currentJournalPath() const;
+  std::string currentSnapshotTempPath() const;
+  bool readBinaryScene(const std::string& path, SceneManager& manager, uint32_t* fileCrc = nullptr) const;
+  bool readMainBinaryScene(SceneManager& manager) const;
+  bool writeBinaryScene(const std::string& path, const SceneManager& manager) const;
+  bool readJsonScene(const std::string& path, SceneManager& manager) const;
   std::string normalizeSceneName(const std::string& name) const;
   void loadStoredSceneName();
   bool persistCurrentSceneName() const;
+  bool appendJournal(const SceneManager& manager);
+  void replayJournal(SceneManager& manager, uint32_t snapshotCrc);
+  bool startCompaction(const SceneManager& manager);
+  void runCompaction(CompactionJob* job);
+  bool writeSnapshot(const CompactionJob& job);
+  static void compactionTask(void* arg);
+  void waitForCompaction() const;
+  void retireAutoSave();
 
   bool isInitialized_;
   std::string currentSceneName_;
 
+  SceneJournal journal_;         // UI thread only
+  size_t journalBytes_ = 0;      // written by the compaction task while compacting_
+  std::atomic<bool> compacting_{false};
+  std::atomic<bool> compactionFailed_{false};
+
 };
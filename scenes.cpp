@@ -2,10 +2,12 @@
 #include "scenes.h"
 #include "src/debug_log.h"
 #include "src/audio/pattern_paging.h"
+#include "scene_binary.h"
 #ifdef ARDUINO
 #include <SD.h>
 #endif
 
+#include <algorithm>
 #include <memory>
 
 namespace {
@@ -68,6 +70,16 @@ void clearSong(Song& song) {
   }
 }
 
+// Rows up to the last one with any pattern (at least one).
+int usedSongLength(const Song& song) {
+  for (int pos = song.length - 1; pos >= 0; --pos) {
+    for (int t = 0; t < SongPosition::kTrackCount; ++t) {
+      if (song.positions[pos].patterns[t] >= 0) return pos + 1;
+    }
+  }
+  return 1;
+}
+
 void clearCustomPhrases(Scene& scene) {
   for (int i = 0; i < Scene::kMaxCustomPhrases; ++i) {
     scene.customPhrases[i][0] = '\0';
@@ -102,6 +114,102 @@ void clearSceneData(Scene& scene) {
   scene.drumFX = DrumFX();
 }
 
+} // namespace
+
+// Payload of the binary STAT section: the SceneManager fields that live
+// outside Scene, in fixed-width types.
+struct SceneStateRecord {
+  static constexpr uint16_t kBinaryVersion = 1;
+  int32_t drumPatternIndex;
+  int32_t synthPatternIndex[2];
+  int32_t drumBankIndex;
+  int32_t synthBankIndex[2];
+  int32_t songPosition;
+  int32_t loopStartRow;
+  int32_t loopEndRow;
+  int32_t activeSongSlot;
+  float bpm;
+  float masterVolume;
+  SynthParameters synthParams[2];
+  uint8_t drumMute[DrumPatternSet::kVoices];
+  uint8_t synthMute[2];
+  uint8_t synthDistortion[2];
+  uint8_t synthDelay[2];
+  uint8_t songMode;
+  uint8_t loopMode;
+  uint8_t mode;
+  uint8_t grooveFlavor;
+};
+
+static_assert(sizeof(SceneStateRecord) == 108 && offsetof(SceneStateRecord, bpm) == 40 &&
+                  offsetof(SceneStateRecord, drumMute) == 88 && offsetof(SceneStateRecord, songMode) == 102,
+              "SceneStateRecord layout is part of the .gps format");
+
+namespace {
+// ENGN section: three length-prefixed engine names.
+constexpr uint16_t kEnginesSectionVersion = 1;
+constexpr size_t kMaxEngineNameLength = 32;
+static_assert(SceneManager::kEngineRecordBytes == 3 * (1 + kMaxEngineNameLength),
+              "kEngineRecordBytes must hold three engine names");
+
+enum : uint32_t {
+  kHaveDrums = 1u << 0,
+  kHaveSynthA = 1u << 1,
+  kHaveSynthB = 1u << 2,
+  kHaveSongs = 1u << 3,
+  kHaveState = 1u << 4,
+  kHaveRequired = 0x1Fu,
+};
+
+// Where a raw-image section of the binary container lands in a staged scene.
+// Returns false for ENGN and for tags this build does not know; flag is set
+// for the sections a file must have.
+struct SectionSlot {
+  void* dst = nullptr;
+  size_t size = 0;
+  uint16_t version = 0;
+  uint32_t flag = 0;
+};
+
+bool sectionSlot(uint32_t tag, Scene& scene, SceneStateRecord& state, SectionSlot& out) {
+  using namespace scene_binary;
+  auto image = [&out](void* d, size_t size, uint16_t v, uint32_t flag) {
+    out = {d, size, v, flag};
+    return true;
+  };
+  switch (tag) {
+  case kTagDrumBanks: return image(scene.drumBanks, sizeof(scene.drumBanks), DrumPatternSet::kBinaryVersion, kHaveDrums);
+  case kTagSynthABanks: return image(scene.synthABanks, sizeof(scene.synthABanks), SynthPattern::kBinaryVersion, kHaveSynthA);
+  case kTagSynthBBanks: return image(scene.synthBBanks, sizeof(scene.synthBBanks), SynthPattern::kBinaryVersion, kHaveSynthB);
+  case kTagSongs: return image(scene.songs, sizeof(scene.songs), Song::kBinaryVersion, kHaveSongs);
+  case kTagState: return image(&state, sizeof(state), SceneStateRecord::kBinaryVersion, kHaveState);
+  case kTagSamplerPads: return image(scene.samplerPads, sizeof(scene.samplerPads), SamplerPadState::kBinaryVersion, 0);
+  case kTagTape: return image(&scene.tape, sizeof(scene.tape), TapeState::kBinaryVersion, 0);
+  case kTagFeel: return image(&scene.feel, sizeof(scene.feel), FeelSettings::kBinaryVersion, 0);
+  case kTagGenre: return image(&scene.genre, sizeof(scene.genre), GenreSettings::kBinaryVersion, 0);
+  case kTagDrumFx: return image(&scene.drumFX, sizeof(scene.drumFX), DrumFX::kBinaryVersion, 0);
+  case kTagGenerator: return image(&scene.generatorParams, sizeof(scene.generatorParams), GeneratorParams::kBinaryVersion, 0);
+  case kTagVocal: return image(&scene.vocal, sizeof(scene.vocal), VocalSettings::kBinaryVersion, 0);
+  case kTagLed: return image(&scene.led, sizeof(scene.led), LedSettings::kBinaryVersion, 0);
+  case kTagTrackVolumes: return image(scene.trackVolumes, sizeof(scene.trackVolumes), Scene::kTrackVolumesBinaryVersion, 0);
+  case kTagPhrases: return image(scene.customPhrases, sizeof(scene.customPhrases), Scene::kPhrasesBinaryVersion, 0);
+  default: return false;
+  }
+}
+
+// Names left empty in the record keep what `names` held.
+bool parseEngineNames(const uint8_t* engines, size_t size, std::string names[3]) {
+  size_t pos = 0;
+  for (int i = 0; i < 3; ++i) {
+    if (pos >= size) break;
+    size_t len = engines[pos++];
+    if (pos + len > size) return false;
+    if (len > 0) names[i].assign(reinterpret_cast<const char*>(engines + pos), len);
+    pos += len;
+  }
+  return true;
+}
+
 void serializeDrumPattern(const DrumPattern& pattern, ArduinoJson::JsonObject obj) {
   ArduinoJson::JsonArray hit = obj["hit"].to<ArduinoJson::JsonArray>();
   ArduinoJson::JsonArray accent = obj["accent"].to<ArduinoJson::JsonArray>();
@@ -535,6 +643,91 @@ bool SynthPattern::isEmpty() const {
   return true;
 }
 
+// Every key the scene observer dispatches on. onObjectKey interns the key
+// once, so the path and field checks compare small integers, not strings.
+enum class SceneJsonObserver::Key : uint8_t {
+  Unknown, A, Accent, ActiveSongSlot, Age, Amt, B, Bars, Bpm, Bri, C, Chk, Clr, Comp, Crush, Cur,
+  CustomPhrases, Cutoff, Drive, DriveAmt, DrumBankIndex, DrumBanks, DrumEngine, DrumFX,
+  DrumPatternIndex, Drums, End, EnvAmount, EnvDecay, Feel, Fls, Flv, Fx, Fxp, Gen, GeneratorParams,
+  Genre, GhostNoteProbability, Grid, Groove, Grv, Hit, Hz, Id, Lanes, Led, Length, Lofi, LofiAmt,
+  LoopEnd, LoopMode, LoopStart, Lop, Mam, MasterVolume, MaxNotes, MaxOctave, MicroTimingAmount,
+  MinNotes, MinOctave, Mode, Movement, Mto, Mute, N, Note, OscType, Pch, Positions, Prb,
+  PreferDownbeats, Preset, Rcp, RDec, Regen, Resonance, Rev, Reverse, RMix, Rob, S, SamplerPads,
+  Sat, Scale, ScaleQuantize, ScaleRoot, Slide, Song, SongMode, SongPosition, Songs, Sound, Space,
+  Spd, Speed, Src, State, Str, Sw, SwingAmount, Synth, SynthABanks, SynthBankIndex, SynthBBanks,
+  SynthDelay, SynthDistortion, SynthEngines, SynthParams, SynthPatternIndex, T, Tape, TAtt, Tb,
+  Tempo, Tex, Tone, TrackVolumes, TSus, V, VelocityRange, Vocal, Voice, Vol, Wow,
+  Count,
+};
+
+namespace {
+// Indexed by SceneJsonObserver::Key; slot 0 is Key::Unknown.
+constexpr const char* kSceneKeyNames[] = {
+    "", "a", "accent", "activeSongSlot", "age", "amt", "b", "bars", "bpm", "bri", "c", "chk", "clr",
+    "comp", "crush", "cur", "customPhrases", "cutoff", "drive", "driveAmt", "drumBankIndex",
+    "drumBanks", "drumEngine", "drumFX", "drumPatternIndex", "drums", "end", "envAmount",
+    "envDecay", "feel", "fls", "flv", "fx", "fxp", "gen", "generatorParams", "genre",
+    "ghostNoteProbability", "grid", "groove", "grv", "hit", "hz", "id", "lanes", "led", "length",
+    "lofi", "lofiAmt", "loopEnd", "loopMode", "loopStart", "lop", "mam", "masterVolume", "maxNotes",
+    "maxOctave", "microTimingAmount", "minNotes", "minOctave", "mode", "movement", "mto", "mute",
+    "n", "note", "oscType", "pch", "positions", "prb", "preferDownbeats", "preset", "rcp", "rDec",
+    "regen", "resonance", "rev", "reverse", "rMix", "rob", "s", "samplerPads", "sat", "scale",
+    "scaleQuantize", "scaleRoot", "slide", "song", "songMode", "songPosition", "songs", "sound",
+    "space", "spd", "speed", "src", "state", "str", "sw", "swingAmount", "synth", "synthABanks",
+    "synthBankIndex", "synthBBanks", "synthDelay", "synthDistortion", "synthEngines", "synthParams",
+    "synthPatternIndex", "t", "tape", "tAtt", "tb", "tempo", "tex", "tone", "trackVolumes", "tSus",
+    "v", "velocityRange", "vocal", "voice", "vol", "wow",
+};
+constexpr size_t kSceneKeyCount = sizeof(kSceneKeyNames) / sizeof(kSceneKeyNames[0]);
+
+constexpr size_t constLength(const char* text) {
+  size_t len = 0;
+  while (text[len]) ++len;
+  return len;
+}
+
+constexpr uint32_t fnv1a(const char* text, size_t len) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= static_cast<uint8_t>(text[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Open-addressed FNV-1a index over kSceneKeyNames, built at compile time so
+// it sits in flash. A slot holds a key index, 0 meaning empty.
+constexpr size_t kSceneKeySlots = 256;
+static_assert(kSceneKeyCount < kSceneKeySlots / 2, "scene key index too full");
+
+struct SceneKeyIndex {
+  uint8_t slots[kSceneKeySlots];
+};
+
+constexpr SceneKeyIndex buildSceneKeyIndex() {
+  SceneKeyIndex index{};
+  for (size_t k = 1; k < kSceneKeyCount; ++k) {
+    size_t slot = fnv1a(kSceneKeyNames[k], constLength(kSceneKeyNames[k])) & (kSceneKeySlots - 1);
+    while (index.slots[slot] != 0) slot = (slot + 1) & (kSceneKeySlots - 1);
+    index.slots[slot] = static_cast<uint8_t>(k);
+  }
+  return index;
+}
+
+constexpr SceneKeyIndex kSceneKeyIndex = buildSceneKeyIndex();
+} // namespace
+
+SceneJsonObserver::Key SceneJsonObserver::internKey(const char* text, size_t len) {
+  static_assert(kSceneKeyCount == static_cast<size_t>(Key::Count), "kSceneKeyNames out of sync with Key");
+  size_t slot = fnv1a(text, len) & (kSceneKeySlots - 1);
+  while (uint8_t k = kSceneKeyIndex.slots[slot]) {
+    const char* name = kSceneKeyNames[k];
+    if (std::strncmp(name, text, len) == 0 && name[len] == '\0') return static_cast<Key>(k);
+    slot = (slot + 1) & (kSceneKeySlots - 1);
+  }
+  return Key::Unknown;
+}
+
 SceneJsonObserver::SceneJsonObserver(Scene& scene, float defaultBpm)
     : target_(scene), bpm_(defaultBpm) {
   clearSong(song_);
@@ -656,33 +849,33 @@ void SceneJsonObserver::onObjectStart() {
     if (parent.type == Context::Type::Array) {
       path = deduceObjectPath(parent);
     } else if (parent.path == Path::Root || parent.path == Path::State) {
-      if (lastKey_ == "state") path = Path::State;
-      else if (lastKey_ == "song") {
+      if (key_ == Key::State) path = Path::State;
+      else if (key_ == Key::Song) {
          // Legacy 'song' object -> maps to songs[0] by default logic (index 0)
          path = Path::Song; 
       }
-      else if (lastKey_ == "tape") path = Path::Tape;
-      else if (lastKey_ == "feel") path = Path::Feel;
-      else if (lastKey_ == "genre") path = Path::Genre;
-      else if (lastKey_ == "led") path = Path::Led;
-      else if (lastKey_ == "generatorParams") path = Path::GeneratorParams;
-      else if (lastKey_ == "vocal") path = Path::Vocal;
-      else if (lastKey_ == "mute") path = Path::Mute;
-      else if (lastKey_ == "drumFX") path = Path::DrumFX;
-    } else if (parent.path == Path::Led && lastKey_ == "vocal") {
+      else if (key_ == Key::Tape) path = Path::Tape;
+      else if (key_ == Key::Feel) path = Path::Feel;
+      else if (key_ == Key::Genre) path = Path::Genre;
+      else if (key_ == Key::Led) path = Path::Led;
+      else if (key_ == Key::GeneratorParams) path = Path::GeneratorParams;
+      else if (key_ == Key::Vocal) path = Path::Vocal;
+      else if (key_ == Key::Mute) path = Path::Mute;
+      else if (key_ == Key::DrumFX) path = Path::DrumFX;
+    } else if (parent.path == Path::Led && key_ == Key::Vocal) {
       path = Path::Vocal;  // vocal is nested inside led in current format
-    } else if (parent.path == Path::Led && lastKey_ == "samplerPads") {
+    } else if (parent.path == Path::Led && key_ == Key::SamplerPads) {
       path = Path::SamplerPads; // samplerPads can be inside led in some versions
     } else if (parent.path == Path::Songs) {
       path = Path::Song;
-    } else if (parent.path == Path::DrumPatternSet && lastKey_ == "grv") {
+    } else if (parent.path == Path::DrumPatternSet && key_ == Key::Grv) {
       path = Path::DrumGroove;
     }
   }
   pushContext(Context::Type::Object, path);
   if (path == Path::Unknown) {
     Serial.printf("[Parser] WARNING: Unknown object path, lastKey='%s', parent_path=%d, stackSize=%d (skipping)\n", 
-                  lastKey_.c_str(), stackSize_ > 1 ? static_cast<int>(stack_[stackSize_-2].path) : -1, stackSize_);
+                  keyText_, stackSize_ > 1 ? static_cast<int>(stack_[stackSize_-2].path) : -1, stackSize_);
     // Don't set error_ = true, just skip this unknown object
   }
 }
@@ -699,44 +892,44 @@ void SceneJsonObserver::onArrayStart() {
     const Context& parent = stack_[stackSize_ - 1];
     if (parent.type == Context::Type::Object) {
       if (parent.path == Path::Root || parent.path == Path::State) {
-        if (lastKey_ == "drumBanks") path = Path::DrumBanks;
-        else if (lastKey_ == "synthABanks") path = Path::SynthABanks;
-        else if (lastKey_ == "synthBBanks") path = Path::SynthBBanks;
-        else if (lastKey_ == "songs") path = Path::Songs;
-        else if (lastKey_ == "samplerPads") path = Path::SamplerPads;
-        else if (lastKey_ == "customPhrases") path = Path::CustomPhrases;
-        else if (lastKey_ == "synthPatternIndex") path = Path::SynthPatternIndex;
-        else if (lastKey_ == "synthBankIndex") path = Path::SynthBankIndex;
-        else if (lastKey_ == "synthEngines") path = Path::SynthEngines;
-        else if (lastKey_ == "synthDistortion") path = Path::SynthDistortion;
-        else if (lastKey_ == "synthDelay") path = Path::SynthDelay;
-        else if (lastKey_ == "synthParams") path = Path::SynthParams;
-        else if (lastKey_ == "trackVolumes") path = Path::TrackVolumes;
-        else if (lastKey_ == "bpm") path = Path::Unknown;
+        if (key_ == Key::DrumBanks) path = Path::DrumBanks;
+        else if (key_ == Key::SynthABanks) path = Path::SynthABanks;
+        else if (key_ == Key::SynthBBanks) path = Path::SynthBBanks;
+        else if (key_ == Key::Songs) path = Path::Songs;
+        else if (key_ == Key::SamplerPads) path = Path::SamplerPads;
+        else if (key_ == Key::CustomPhrases) path = Path::CustomPhrases;
+        else if (key_ == Key::SynthPatternIndex) path = Path::SynthPatternIndex;
+        else if (key_ == Key::SynthBankIndex) path = Path::SynthBankIndex;
+        else if (key_ == Key::SynthEngines) path = Path::SynthEngines;
+        else if (key_ == Key::SynthDistortion) path = Path::SynthDistortion;
+        else if (key_ == Key::SynthDelay) path = Path::SynthDelay;
+        else if (key_ == Key::SynthParams) path = Path::SynthParams;
+        else if (key_ == Key::TrackVolumes) path = Path::TrackVolumes;
+        else if (key_ == Key::Bpm) path = Path::Unknown;
       } else if (parent.path == Path::Song) {
-        if (lastKey_ == "positions") path = Path::SongPositions;
+        if (key_ == Key::Positions) path = Path::SongPositions;
       } else if (parent.path == Path::Songs) {
         // Should not happen for array of objects? 
         // Songs is array of Song objects. 
       } else if (parent.path == Path::Led) {
-        if (lastKey_ == "clr") {
+        if (key_ == Key::Clr) {
             path = Path::LedColorArray;
         }
-        else if (lastKey_ == "customPhrases") path = Path::CustomPhrases;
+        else if (key_ == Key::CustomPhrases) path = Path::CustomPhrases;
       } else if (parent.path == Path::DrumPatternSet) {
-        if (lastKey_ == "v") path = Path::DrumPatternSet;
-        else if (lastKey_ == "lanes") path = Path::DrumLanes;
+        if (key_ == Key::V) path = Path::DrumPatternSet;
+        else if (key_ == Key::Lanes) path = Path::DrumLanes;
       } else if (parent.path == Path::DrumLane) {
-        if (lastKey_ == "n") path = Path::DrumLaneNodes;
+        if (key_ == Key::N) path = Path::DrumLaneNodes;
       } else if (parent.path == Path::DrumVoice) {
-        if (lastKey_ == "hit") path = Path::DrumHitArray;
-        else if (lastKey_ == "accent") path = Path::DrumAccentArray;
-        else if (lastKey_ == "prb") path = Path::DrumProbabilityArray;
-        else if (lastKey_ == "fx") path = Path::DrumFxArray;
-        else if (lastKey_ == "fxp") path = Path::DrumFxParamArray;
+        if (key_ == Key::Hit) path = Path::DrumHitArray;
+        else if (key_ == Key::Accent) path = Path::DrumAccentArray;
+        else if (key_ == Key::Prb) path = Path::DrumProbabilityArray;
+        else if (key_ == Key::Fx) path = Path::DrumFxArray;
+        else if (key_ == Key::Fxp) path = Path::DrumFxParamArray;
       } else if (parent.path == Path::Mute) {
-        if (lastKey_ == "drums") path = Path::MuteDrums;
-        else if (lastKey_ == "synth") path = Path::MuteSynth;
+        if (key_ == Key::Drums) path = Path::MuteDrums;
+        else if (key_ == Key::Synth) path = Path::MuteSynth;
       }
     } else if (parent.type == Context::Type::Array) {
       path = deduceArrayPath(parent);
@@ -745,7 +938,7 @@ void SceneJsonObserver::onArrayStart() {
   pushContext(Context::Type::Array, path);
   if (path == Path::Unknown) {
     Serial.printf("[Parser] WARNING: Unknown array path, lastKey='%s', parent_path=%d, stackSize=%d (skipping)\n", 
-                  lastKey_.c_str(), stackSize_ > 1 ? static_cast<int>(stack_[stackSize_-2].path) : -1, stackSize_);
+                  keyText_, stackSize_ > 1 ? static_cast<int>(stack_[stackSize_-2].path) : -1, stackSize_);
     // Don't set error_ = true, just skip this unknown array
   }
 }
@@ -761,7 +954,7 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
   if (error_ || stackSize_ == 0) return;
   Path path = stack_[stackSize_ - 1].path;
   if (path == Path::Song) {
-    if (lastKey_ == "length") {
+    if (key_ == Key::Length) {
       // Determine which song slot we are in
       int songIdx = 0;
       if (stackSize_ >= 2 && stack_[stackSize_-2].path == Path::Songs) {
@@ -782,21 +975,21 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
   }
   if (path == Path::Feel) {
     int v = static_cast<int>(value);
-    if (lastKey_ == "grid") {
+    if (key_ == Key::Grid) {
       if (v != 8 && v != 16 && v != 32) v = 16;
       target_.feel.gridSteps = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "tb") {
+    } else if (key_ == Key::Tb) {
       if (v < 0) v = 0;
       if (v > 2) v = 2;
       target_.feel.timebase = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "bars") {
+    } else if (key_ == Key::Bars) {
       if (v != 1 && v != 2 && v != 4 && v != 8) v = 1;
       target_.feel.patternBars = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "lofiAmt") {
+    } else if (key_ == Key::LofiAmt) {
       if (v < 0) v = 0;
       if (v > 100) v = 100;
       target_.feel.lofiAmount = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "driveAmt") {
+    } else if (key_ == Key::DriveAmt) {
       if (v < 0) v = 0;
       if (v > 100) v = 100;
       target_.feel.driveAmount = static_cast<uint8_t>(v);
@@ -805,27 +998,27 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
   }
   if (path == Path::Genre) {
     int v = static_cast<int>(value);
-    if (lastKey_ == "gen") {
+    if (key_ == Key::Gen) {
       if (v < 0) v = 0;
       if (v >= kGenerativeModeCount) v = 0;
       target_.genre.generativeMode = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "tex") {
+    } else if (key_ == Key::Tex) {
       if (v < 0) v = 0;
       if (v >= kTextureModeCount) v = 0;
       target_.genre.textureMode = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "amt") {
+    } else if (key_ == Key::Amt) {
       if (v < 0) v = 0;
       if (v > 100) v = 100;
       target_.genre.textureAmount = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "rcp") {
+    } else if (key_ == Key::Rcp) {
       if (v < 0) v = 0;
       if (v > 255) v = 255;
       target_.genre.recipe = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "mto") {
+    } else if (key_ == Key::Mto) {
       if (v < 0) v = 0;
       if (v > 255) v = 255;
       target_.genre.morphTarget = static_cast<uint8_t>(v);
-    } else if (lastKey_ == "mam") {
+    } else if (key_ == Key::Mam) {
       if (v < 0) v = 0;
       if (v > 255) v = 255;
       target_.genre.morphAmount = static_cast<uint8_t>(v);
@@ -836,10 +1029,10 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
     int posIdx = currentIndexFor(Path::SongPositions);
     if (posIdx < 0 || posIdx >= Song::kMaxPositions) return;
     int trackIdx = -1;
-    if (lastKey_ == "a") trackIdx = 0;
-    else if (lastKey_ == "b") trackIdx = 1;
-    else if (lastKey_ == "drums") trackIdx = 2;
-    else if (lastKey_ == "voice") trackIdx = 3;
+    if (key_ == Key::A) trackIdx = 0;
+    else if (key_ == Key::B) trackIdx = 1;
+    else if (key_ == Key::Drums) trackIdx = 2;
+    else if (key_ == Key::Voice) trackIdx = 3;
     if (trackIdx >= 0 && trackIdx < SongPosition::kTrackCount) {
       int songIdx = 0;
       // stack: ..., Songs(Array), Song(Object), SongPositions(Array), SongPosition(Object)
@@ -894,7 +1087,7 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
       return;
     }
     AutomationLane& lane = target_.drumBanks[bankIdx].patterns[patternIdx].lanes[laneIdx];
-    if (lastKey_ == "t") {
+    if (key_ == Key::T) {
       int target = static_cast<int>(value);
       if (target < 0) target = 0;
       if (target > DRUM_AUTOMATION_ENGINE_SWITCH && target != DRUM_AUTOMATION_NONE) {
@@ -921,17 +1114,17 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
       lane.nodeCount = static_cast<uint8_t>(nodeIdx + 1);
     }
     AutomationNode& node = lane.nodes[nodeIdx];
-    if (lastKey_ == "s") {
+    if (key_ == Key::S) {
       int step = static_cast<int>(value);
       if (step < 0) step = 0;
       if (step > 15) step = 15;
       node.step = static_cast<uint8_t>(step);
-    } else if (lastKey_ == "v") {
+    } else if (key_ == Key::V) {
       float v = static_cast<float>(value);
       if (v < 0.0f) v = 0.0f;
       if (v > 1.0f) v = 1.0f;
       node.value = v;
-    } else if (lastKey_ == "c") {
+    } else if (key_ == Key::C) {
       int curve = static_cast<int>(value);
       if (curve < 0) curve = 0;
       if (curve > 2) curve = 2;
@@ -948,12 +1141,12 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
       return;
     }
     PatternGroove& groove = target_.drumBanks[bankIdx].patterns[patternIdx].groove;
-    if (lastKey_ == "sw") {
+    if (key_ == Key::Sw) {
       float swing = static_cast<float>(value);
       if (swing < 0.0f) swing = -1.0f;
       if (swing > 0.66f) swing = 0.66f;
       groove.swing = swing;
-    } else if (lastKey_ == "hz") {
+    } else if (key_ == Key::Hz) {
       float humanize = static_cast<float>(value);
       if (humanize < 0.0f) humanize = -1.0f;
       if (humanize > 1.0f) humanize = 1.0f;
@@ -982,47 +1175,47 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
         bankIdx < 0 || bankIdx >= kBankCount) return;
     SynthPattern& pattern = useBankB ? target_.synthBBanks[bankIdx].patterns[patternIdx]
                                      : target_.synthABanks[bankIdx].patterns[patternIdx];
-    if (lastKey_ == "note") {
+    if (key_ == Key::Note) {
       pattern.steps[stepIdx].note = static_cast<int>(value);
-    } else if (lastKey_ == "slide") {
+    } else if (key_ == Key::Slide) {
       pattern.steps[stepIdx].slide = value != 0;
-    } else if (lastKey_ == "accent") {
+    } else if (key_ == Key::Accent) {
       pattern.steps[stepIdx].accent = value != 0;
-    } else if (lastKey_ == "prb") {
+    } else if (key_ == Key::Prb) {
       pattern.steps[stepIdx].probability = clampProbability(static_cast<int>(value));
-    } else if (lastKey_ == "fx") {
+    } else if (key_ == Key::Fx) {
       pattern.steps[stepIdx].fx = static_cast<uint8_t>(value);
-    } else if (lastKey_ == "fxp") {
+    } else if (key_ == Key::Fxp) {
       pattern.steps[stepIdx].fxParam = static_cast<uint8_t>(value);
     }
     return;
   }
   if (path == Path::GeneratorParams) {
-    if (lastKey_ == "minNotes") target_.generatorParams.minNotes = static_cast<int>(value);
-    else if (lastKey_ == "maxNotes") target_.generatorParams.maxNotes = static_cast<int>(value);
-    else if (lastKey_ == "minOctave") target_.generatorParams.minOctave = static_cast<int>(value);
-    else if (lastKey_ == "maxOctave") target_.generatorParams.maxOctave = static_cast<int>(value);
-    else if (lastKey_ == "swingAmount") target_.generatorParams.swingAmount = static_cast<float>(value);
-    else if (lastKey_ == "velocityRange") target_.generatorParams.velocityRange = static_cast<float>(value);
-    else if (lastKey_ == "ghostNoteProbability") target_.generatorParams.ghostNoteProbability = static_cast<float>(value);
-    else if (lastKey_ == "microTimingAmount") target_.generatorParams.microTimingAmount = static_cast<float>(value);
-    else if (lastKey_ == "scaleRoot") target_.generatorParams.scaleRoot = static_cast<int>(value);
-    else if (lastKey_ == "scale") target_.generatorParams.scale = static_cast<ScaleType>(static_cast<int>(value));
+    if (key_ == Key::MinNotes) target_.generatorParams.minNotes = static_cast<int>(value);
+    else if (key_ == Key::MaxNotes) target_.generatorParams.maxNotes = static_cast<int>(value);
+    else if (key_ == Key::MinOctave) target_.generatorParams.minOctave = static_cast<int>(value);
+    else if (key_ == Key::MaxOctave) target_.generatorParams.maxOctave = static_cast<int>(value);
+    else if (key_ == Key::SwingAmount) target_.generatorParams.swingAmount = static_cast<float>(value);
+    else if (key_ == Key::VelocityRange) target_.generatorParams.velocityRange = static_cast<float>(value);
+    else if (key_ == Key::GhostNoteProbability) target_.generatorParams.ghostNoteProbability = static_cast<float>(value);
+    else if (key_ == Key::MicroTimingAmount) target_.generatorParams.microTimingAmount = static_cast<float>(value);
+    else if (key_ == Key::ScaleRoot) target_.generatorParams.scaleRoot = static_cast<int>(value);
+    else if (key_ == Key::Scale) target_.generatorParams.scale = static_cast<ScaleType>(static_cast<int>(value));
     return;
   }
   if (path == Path::SynthParam) {
     int synthIdx = currentIndexFor(Path::SynthParams);
     if (synthIdx < 0 || synthIdx >= 2) return;
     float fval = static_cast<float>(value);
-    if (lastKey_ == "cutoff") {
+    if (key_ == Key::Cutoff) {
       synthParameters_[synthIdx].cutoff = fval;
-    } else if (lastKey_ == "resonance") {
+    } else if (key_ == Key::Resonance) {
       synthParameters_[synthIdx].resonance = fval;
-    } else if (lastKey_ == "envAmount") {
+    } else if (key_ == Key::EnvAmount) {
       synthParameters_[synthIdx].envAmount = fval;
-    } else if (lastKey_ == "envDecay") {
+    } else if (key_ == Key::EnvDecay) {
       synthParameters_[synthIdx].envDecay = fval;
-    } else if (lastKey_ == "oscType") {
+    } else if (key_ == Key::OscType) {
       synthParameters_[synthIdx].oscType = static_cast<int>(value);
     }
     return;
@@ -1035,108 +1228,108 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
     return;
   }
   if (path == Path::State) {
-    if (lastKey_ == "bpm") {
+    if (key_ == Key::Bpm) {
       bpm_ = static_cast<float>(value);
       return;
     }
-    if (lastKey_ == "songPosition") {
+    if (key_ == Key::SongPosition) {
       songPosition_ = static_cast<int>(value);
       return;
     }
-    if (lastKey_ == "songMode") {
+    if (key_ == Key::SongMode) {
       songMode_ = value != 0;
       return;
     }
-    if (lastKey_ == "loopStart") {
+    if (key_ == Key::LoopStart) {
       loopStartRow_ = static_cast<int>(value);
       return;
     }
-    if (lastKey_ == "loopEnd") {
+    if (key_ == Key::LoopEnd) {
       loopEndRow_ = static_cast<int>(value);
       return;
     }
-    if (lastKey_ == "masterVolume") {
+    if (key_ == Key::MasterVolume) {
       target_.masterVolume = static_cast<float>(value);
       return;
     }
     int intValue = static_cast<int>(value);
-    if (lastKey_ == "drumPatternIndex") {
+    if (key_ == Key::DrumPatternIndex) {
       drumPatternIndex_ = intValue;
-    } else if (lastKey_ == "drumBankIndex") {
+    } else if (key_ == Key::DrumBankIndex) {
       drumBankIndex_ = intValue;
-    } else if (lastKey_ == "synthPatternIndex") {
+    } else if (key_ == Key::SynthPatternIndex) {
       synthPatternIndex_[0] = intValue;
-    } else if (lastKey_ == "activeSongSlot") {
+    } else if (key_ == Key::ActiveSongSlot) {
       target_.activeSongSlot = intValue;
       if (target_.activeSongSlot < 0) target_.activeSongSlot = 0;
       if (target_.activeSongSlot > 1) target_.activeSongSlot = 1;
-    } else if (lastKey_ == "synthBankIndex") {
+    } else if (key_ == Key::SynthBankIndex) {
       synthBankIndex_[0] = intValue;
     }
     return;
   }
   if (path == Path::DrumFX) {
     float f = static_cast<float>(value);
-    if (lastKey_ == "comp") target_.drumFX.compression = f;
-    else if (lastKey_ == "tAtt") target_.drumFX.transientAttack = f;
-    else if (lastKey_ == "tSus") target_.drumFX.transientSustain = f;
-    else if (lastKey_ == "rMix") target_.drumFX.reverbMix = f;
-    else if (lastKey_ == "rDec") target_.drumFX.reverbDecay = f;
+    if (key_ == Key::Comp) target_.drumFX.compression = f;
+    else if (key_ == Key::TAtt) target_.drumFX.transientAttack = f;
+    else if (key_ == Key::TSus) target_.drumFX.transientSustain = f;
+    else if (key_ == Key::RMix) target_.drumFX.reverbMix = f;
+    else if (key_ == Key::RDec) target_.drumFX.reverbDecay = f;
     return;
   }
   if (path == Path::Vocal) {
-    if (lastKey_ == "pch") target_.vocal.pitch = static_cast<float>(value);
-    else if (lastKey_ == "spd") target_.vocal.speed = static_cast<float>(value);
-    else if (lastKey_ == "rob") target_.vocal.robotness = static_cast<float>(value);
-    else if (lastKey_ == "vol") target_.vocal.volume = static_cast<float>(value);
+    if (key_ == Key::Pch) target_.vocal.pitch = static_cast<float>(value);
+    else if (key_ == Key::Spd) target_.vocal.speed = static_cast<float>(value);
+    else if (key_ == Key::Rob) target_.vocal.robotness = static_cast<float>(value);
+    else if (key_ == Key::Vol) target_.vocal.volume = static_cast<float>(value);
     return;
   }
   if (path == Path::SamplerPad) {
     int padIdx = currentIndexFor(Path::SamplerPads);
     if (padIdx >= 0 && padIdx < 16) {
-      if (lastKey_ == "id") target_.samplerPads[padIdx].sampleId = static_cast<uint32_t>(value);
-      else if (lastKey_ == "vol") target_.samplerPads[padIdx].volume = static_cast<float>(value);
-      else if (lastKey_ == "pch") target_.samplerPads[padIdx].pitch = static_cast<float>(value);
-      else if (lastKey_ == "str") target_.samplerPads[padIdx].startFrame = static_cast<uint32_t>(value);
-      else if (lastKey_ == "end") target_.samplerPads[padIdx].endFrame = static_cast<uint32_t>(value);
-      else if (lastKey_ == "chk") target_.samplerPads[padIdx].chokeGroup = static_cast<uint8_t>(value);
+      if (key_ == Key::Id) target_.samplerPads[padIdx].sampleId = static_cast<uint32_t>(value);
+      else if (key_ == Key::Vol) target_.samplerPads[padIdx].volume = static_cast<float>(value);
+      else if (key_ == Key::Pch) target_.samplerPads[padIdx].pitch = static_cast<float>(value);
+      else if (key_ == Key::Str) target_.samplerPads[padIdx].startFrame = static_cast<uint32_t>(value);
+      else if (key_ == Key::End) target_.samplerPads[padIdx].endFrame = static_cast<uint32_t>(value);
+      else if (key_ == Key::Chk) target_.samplerPads[padIdx].chokeGroup = static_cast<uint8_t>(value);
     }
     return;
   }
   if (path == Path::Tape) {
-    if (lastKey_ == "mode") {
+    if (key_ == Key::Mode) {
       int m = static_cast<int>(value);
       if (m >= 0 && m <= 3) target_.tape.mode = static_cast<TapeMode>(m);
-    } else if (lastKey_ == "preset") {
+    } else if (key_ == Key::Preset) {
       int p = static_cast<int>(value);
       if (p >= 0 && p < static_cast<int>(TapePreset::Count)) {
         target_.tape.preset = static_cast<TapePreset>(p);
       }
-    } else if (lastKey_ == "speed") {
+    } else if (key_ == Key::Speed) {
       int s = static_cast<int>(value);
       if (s >= 0 && s <= 2) target_.tape.speed = static_cast<uint8_t>(s);
-    } else if (lastKey_ == "wow") {
+    } else if (key_ == Key::Wow) {
       int v = static_cast<int>(value);
       target_.tape.macro.wow = static_cast<uint8_t>(v < 0 ? 0 : v > 100 ? 100 : v);
-    } else if (lastKey_ == "age") {
+    } else if (key_ == Key::Age) {
       int v = static_cast<int>(value);
       target_.tape.macro.age = static_cast<uint8_t>(v < 0 ? 0 : v > 100 ? 100 : v);
-    } else if (lastKey_ == "sat") {
+    } else if (key_ == Key::Sat) {
       int v = static_cast<int>(value);
       target_.tape.macro.sat = static_cast<uint8_t>(v < 0 ? 0 : v > 100 ? 100 : v);
-    } else if (lastKey_ == "tone") {
+    } else if (key_ == Key::Tone) {
       int v = static_cast<int>(value);
       target_.tape.macro.tone = static_cast<uint8_t>(v < 0 ? 0 : v > 100 ? 100 : v);
-    } else if (lastKey_ == "crush") {
+    } else if (key_ == Key::Crush) {
       int v = static_cast<int>(value);
       target_.tape.macro.crush = static_cast<uint8_t>(v < 0 ? 0 : v > 3 ? 3 : v);
-    } else if (lastKey_ == "vol") {
+    } else if (key_ == Key::Vol) {
       target_.tape.looperVolume = static_cast<float>(value);
-    } else if (lastKey_ == "space") {
+    } else if (key_ == Key::Space) {
       target_.tape.space = static_cast<uint8_t>(value);
-    } else if (lastKey_ == "movement") {
+    } else if (key_ == Key::Movement) {
       target_.tape.movement = static_cast<uint8_t>(value);
-    } else if (lastKey_ == "groove") {
+    } else if (key_ == Key::Groove) {
       target_.tape.groove = static_cast<uint8_t>(value);
     }
     return;
@@ -1149,22 +1342,22 @@ void SceneJsonObserver::handlePrimitiveNumber(double value, bool isInteger) {
     return;
   }
   if (path == Path::Led) {
-    if (lastKey_ == "mode") target_.led.mode = static_cast<LedMode>(static_cast<int>(value));
-    else if (lastKey_ == "src") target_.led.source = static_cast<LedSource>(static_cast<int>(value));
-    else if (lastKey_ == "bri") target_.led.brightness = static_cast<uint8_t>(value);
-    else if (lastKey_ == "fls") target_.led.flashMs = static_cast<uint16_t>(value);
+    if (key_ == Key::Mode) target_.led.mode = static_cast<LedMode>(static_cast<int>(value));
+    else if (key_ == Key::Src) target_.led.source = static_cast<LedSource>(static_cast<int>(value));
+    else if (key_ == Key::Bri) target_.led.brightness = static_cast<uint8_t>(value);
+    else if (key_ == Key::Fls) target_.led.flashMs = static_cast<uint16_t>(value);
   } else if (path == Path::Vocal) {
-    if (lastKey_ == "pch") target_.vocal.pitch = value;
-    else if (lastKey_ == "spd") target_.vocal.speed = value;
-    else if (lastKey_ == "rob") target_.vocal.robotness = value;
-    else if (lastKey_ == "vol") target_.vocal.volume = value;
+    if (key_ == Key::Pch) target_.vocal.pitch = value;
+    else if (key_ == Key::Spd) target_.vocal.speed = value;
+    else if (key_ == Key::Rob) target_.vocal.robotness = value;
+    else if (key_ == Key::Vol) target_.vocal.volume = value;
   } else if (path == Path::Root) {
-    if (lastKey_ == "mode") {
+    if (key_ == Key::Mode) {
       int m = static_cast<int>(value);
       if (m < 0) m = 0;
       if (m > 4) m = 4;
       target_.mode = static_cast<GrooveboxMode>(m);
-    } else if (lastKey_ == "flv") {
+    } else if (key_ == Key::Flv) {
       int v = static_cast<int>(value);
       if (v < 0) v = 0;
       if (v > 4) v = 4;
@@ -1178,7 +1371,7 @@ void SceneJsonObserver::handlePrimitiveBool(bool value) {
   if (error_ || stackSize_ == 0) return;
   Path path = stack_[stackSize_ - 1].path;
   if (path == Path::Song) {
-      if (lastKey_ == "reverse") {
+      if (key_ == Key::Reverse) {
           int songIdx = 0;
           if (stackSize_ >= 2 && stack_[stackSize_-2].path == Path::Songs) {
               songIdx = stack_[stackSize_-2].index;
@@ -1190,21 +1383,21 @@ void SceneJsonObserver::handlePrimitiveBool(bool value) {
       return;
   }
   if (path == Path::Feel) {
-    if (lastKey_ == "lofi") target_.feel.lofiEnabled = value;
-    else if (lastKey_ == "drive") target_.feel.driveEnabled = value;
-    else if (lastKey_ == "tape") target_.feel.tapeEnabled = value;
+    if (key_ == Key::Lofi) target_.feel.lofiEnabled = value;
+    else if (key_ == Key::Drive) target_.feel.driveEnabled = value;
+    else if (key_ == Key::Tape) target_.feel.tapeEnabled = value;
     return;
   }
   if (path == Path::Genre) {
-    if (lastKey_ == "regen") target_.genre.regenerateOnApply = value;
-    else if (lastKey_ == "tempo") target_.genre.applyTempoOnApply = value;
-    else if (lastKey_ == "cur") target_.genre.curatedMode = value;
-    else if (lastKey_ == "sound") target_.genre.applySoundMacros = value;
+    if (key_ == Key::Regen) target_.genre.regenerateOnApply = value;
+    else if (key_ == Key::Tempo) target_.genre.applyTempoOnApply = value;
+    else if (key_ == Key::Cur) target_.genre.curatedMode = value;
+    else if (key_ == Key::Sound) target_.genre.applySoundMacros = value;
     return;
   }
   if (path == Path::GeneratorParams) {
-    if (lastKey_ == "preferDownbeats") target_.generatorParams.preferDownbeats = value;
-    else if (lastKey_ == "scaleQuantize") target_.generatorParams.scaleQuantize = value;
+    if (key_ == Key::PreferDownbeats) target_.generatorParams.preferDownbeats = value;
+    else if (key_ == Key::ScaleQuantize) target_.generatorParams.scaleQuantize = value;
     return;
   }
   if (path == Path::DrumHitArray || path == Path::DrumAccentArray) {
@@ -1263,25 +1456,25 @@ void SceneJsonObserver::handlePrimitiveBool(bool value) {
         bankIdx < 0 || bankIdx >= kBankCount) return;
     SynthPattern& pattern = useBankB ? target_.synthBBanks[bankIdx].patterns[patternIdx]
                                      : target_.synthABanks[bankIdx].patterns[patternIdx];
-    if (lastKey_ == "slide") {
+    if (key_ == Key::Slide) {
       pattern.steps[stepIdx].slide = value;
-    } else if (lastKey_ == "accent") {
+    } else if (key_ == Key::Accent) {
       pattern.steps[stepIdx].accent = value;
     }
     return;
   }
 
-  if (path == Path::State && lastKey_ == "songMode") {
+  if (path == Path::State && key_ == Key::SongMode) {
     songMode_ = value;
-  } else if (path == Path::State && lastKey_ == "loopMode") {
+  } else if (path == Path::State && key_ == Key::LoopMode) {
     loopMode_ = value;
   }
 
   if (path == Path::SamplerPad) {
     int padIdx = currentIndexFor(Path::SamplerPads);
     if (padIdx >= 0 && padIdx < 16) {
-      if (lastKey_ == "rev") target_.samplerPads[padIdx].reverse = value;
-      else if (lastKey_ == "lop") target_.samplerPads[padIdx].loop = value;
+      if (key_ == Key::Rev) target_.samplerPads[padIdx].reverse = value;
+      else if (key_ == Key::Lop) target_.samplerPads[padIdx].loop = value;
     }
   }
 }
@@ -1299,7 +1492,7 @@ void SceneJsonObserver::onString(const std::string& value) {
   const Context& context = stack_[stackSize_ - 1];
   if (context.type == Context::Type::Object) {
     // Handle object keys that expect string values
-    if (context.path == Path::State && lastKey_ == "drumEngine") {
+    if (context.path == Path::State && key_ == Key::DrumEngine) {
       drumEngineName_ = value;
     } else if (context.path == Path::CustomPhrase) { // This path is for individual custom phrases, not an array
       int idx = context.index; // This index would be from a parent array, if CustomPhrase was an array of objects
@@ -1325,7 +1518,12 @@ void SceneJsonObserver::onString(const std::string& value) {
   }
 }
 
-void SceneJsonObserver::onObjectKey(const std::string& key) { lastKey_ = key; }
+void SceneJsonObserver::onObjectKey(const std::string& key) {
+  key_ = internKey(key.data(), key.size());
+  size_t len = std::min(key.size(), sizeof(keyText_) - 1);
+  std::memcpy(keyText_, key.data(), len);
+  keyText_[len] = '\0';
+}
 
 void SceneJsonObserver::onObjectValueStart() {}
 
@@ -2028,14 +2226,25 @@ bool SceneManager::isSongReverseAtSlot(int slot) const {
 }
 
 void SceneManager::mergeSongs() {
+  buildMergedSong(scene_->songs[scene_->activeSongSlot]);
+  trimSongLength();
+}
+
+void SceneManager::alternateSongs() {
+  buildAlternatedSong(scene_->songs[scene_->activeSongSlot]);
+  trimSongLength();
+}
+
+void SceneManager::buildMergedSong(Song& out) const {
   // Per-track merge: for each (row, track), prefer Active if it has data,
   // fall back to Other otherwise. This way a row with drums in A but no
   // bass still picks up B's bass, instead of skipping the whole row.
   int active = scene_->activeSongSlot;
   int other  = (active == 0) ? 1 : 0;
 
-  Song&       a = scene_->songs[active];
+  const Song& a = scene_->songs[active];
   const Song& b = scene_->songs[other];
+  if (&out != &a) out = a;
 
   int newLen = std::max(a.length, b.length);
   if (newLen > Song::kMaxPositions) newLen = Song::kMaxPositions;
@@ -2043,50 +2252,60 @@ void SceneManager::mergeSongs() {
   for (int i = 0; i < newLen; ++i) {
     for (int t = 0; t < SongPosition::kTrackCount; ++t) {
       // Only write B's track data when A genuinely has nothing there.
-      if (a.positions[i].patterns[t] < 0 && i < b.length) {
-        a.positions[i].patterns[t] = b.positions[i].patterns[t];
+      if (out.positions[i].patterns[t] < 0 && i < b.length) {
+        out.positions[i].patterns[t] = b.positions[i].patterns[t];
       }
     }
   }
 
-  a.length = newLen;
-  trimSongLength();
+  out.length = newLen;
+  out.length = clampSongLength(usedSongLength(out));
 }
 
-void SceneManager::alternateSongs() {
+void SceneManager::buildAlternatedSong(Song& out) const {
   // True interleave: weave A and B into a new sequence that is up to 2x
   // longer. Result[0]=A[0], Result[1]=B[0], Result[2]=A[1], Result[3]=B[1]…
   // This preserves the musical content of both slots in playback order.
   int active = scene_->activeSongSlot;
   int other  = (active == 0) ? 1 : 0;
 
-  const Song a = scene_->songs[active]; // snapshot before we overwrite
+  const Song a = scene_->songs[active]; // snapshot: `out` may be the active song
   const Song& b = scene_->songs[other];
 
   int steps   = std::max(a.length, b.length);
   int newLen  = std::min(steps * 2, Song::kMaxPositions);
 
-  Song& target = scene_->songs[active];
-
+  out = a;
   for (int i = 0; i < steps; ++i) {
     int slotA = i * 2;       // even positions  → A's rows
     int slotB = i * 2 + 1;  // odd  positions  → B's rows
 
     if (slotA < Song::kMaxPositions) {
-      target.positions[slotA] = (i < a.length)
+      out.positions[slotA] = (i < a.length)
           ? a.positions[i]
           : SongPosition{};  // pad with empty if A is shorter
     }
 
     if (slotB < Song::kMaxPositions) {
-      target.positions[slotB] = (i < b.length)
+      out.positions[slotB] = (i < b.length)
           ? b.positions[i]
           : SongPosition{};  // pad with empty if B is shorter
     }
   }
 
-  target.length = newLen;
-  trimSongLength();
+  out.length = newLen;
+  out.length = clampSongLength(usedSongLength(out));
+}
+
+void SceneManager::swapSong(int slot, Song& song) {
+  if (slot < 0) slot = 0;
+  if (slot > 1) slot = 1;
+  // Row by row, so the audio thread never holds a whole Song on its stack.
+  Song& target = scene_->songs[slot];
+  std::swap_ranges(target.positions, target.positions + Song::kMaxPositions, song.positions);
+  std::swap(target.length, song.length);
+  std::swap(target.reverse, song.reverse);
+  if (slot == scene_->activeSongSlot) setSongLength(target.length);
 }
 
 void SceneManager::insertSongRow(int position) {
@@ -2750,12 +2969,23 @@ std::string SceneManager::dumpCurrentScene() const {
 }
 
 bool SceneManager::loadScene(const std::string& json) {
-  size_t idx = 0;
-  JsonVisitor::NextChar nextChar = [&json, &idx]() -> int {
-    if (idx >= json.size()) return -1;
-    return static_cast<unsigned char>(json[idx++]);
+  if (scene_binary::isBinaryScene(json.data(), json.size())) {
+    size_t offset = 0;
+    return loadSceneBinaryWithReader([&json, &offset](void* dst, size_t len) -> size_t {
+      size_t n = std::min(len, json.size() - offset);
+      std::memcpy(dst, json.data() + offset, n);
+      offset += n;
+      return n;
+    });
+  }
+  size_t offset = 0;
+  auto readBlock = [&json, &offset](char* dst, size_t cap) -> size_t {
+    size_t n = std::min(cap, json.size() - offset);
+    std::memcpy(dst, json.data() + offset, n);
+    offset += n;
+    return n;
   };
-  if (loadSceneEventedWithReader(nextChar)) return true;
+  if (loadSceneEventedWithReader(readBlock)) return true;
   
   // DISABLED: ArduinoJson fallback causes abort() on ESP32 due to insufficient DRAM
   // return loadSceneJson(json);
@@ -2768,7 +2998,7 @@ bool SceneManager::loadScene(const std::string& json) {
 // Static buffer to avoid heap fragmentation during loading
 static Scene s_tempLoadScene;
 
-bool SceneManager::loadSceneEventedWithReader(JsonVisitor::NextChar nextChar) {
+bool SceneManager::loadSceneEventedWithReader(const JsonVisitor::ReadBlock& readBlock) {
 #ifdef ARDUINO
   Serial.println("  - loadSceneEventedWithReader: Using static loading buffer...");
 #endif
@@ -2782,15 +3012,9 @@ bool SceneManager::loadSceneEventedWithReader(JsonVisitor::NextChar nextChar) {
 #ifdef ARDUINO
   Serial.println("  - loadSceneEventedWithReader: Starting Parse...");
 #endif
-  struct NextCharStream {
-    JsonVisitor::NextChar next;
-    int read() { return next(); }
-  };
-
-  NextCharStream stream{std::move(nextChar)};
   JsonVisitor visitor;
   SceneJsonObserver observer(*loaded, bpm_);
-  bool parsed = visitor.parse(stream, observer);
+  bool parsed = visitor.parseBlocks(readBlock, observer);
 #ifdef ARDUINO
   Serial.printf("  - loadSceneEventedWithReader: Parse done, result=%d, error=%d\n", (int)parsed, (int)observer.hadError());
 #endif
@@ -2863,6 +3087,247 @@ bool SceneManager::loadSceneEventedWithReader(JsonVisitor::NextChar nextChar) {
   return true;
 }
 
+void SceneManager::fillStateRecord(SceneStateRecord& state) const {
+  state = SceneStateRecord{};
+  state.drumPatternIndex = drumPatternIndex_;
+  state.synthPatternIndex[0] = synthPatternIndex_[0];
+  state.synthPatternIndex[1] = synthPatternIndex_[1];
+  state.drumBankIndex = drumBankIndex_;
+  state.synthBankIndex[0] = synthBankIndex_[0];
+  state.synthBankIndex[1] = synthBankIndex_[1];
+  state.songPosition = clampSongPosition(songPosition_);
+  state.loopStartRow = loopStartRow_;
+  state.loopEndRow = loopEndRow_;
+  state.activeSongSlot = scene_->activeSongSlot;
+  state.bpm = bpm_;
+  state.masterVolume = scene_->masterVolume;
+  state.synthParams[0] = synthParameters_[0];
+  state.synthParams[1] = synthParameters_[1];
+  for (int i = 0; i < DrumPatternSet::kVoices; ++i) state.drumMute[i] = drumMute_[i] ? 1 : 0;
+  for (int i = 0; i < 2; ++i) {
+    state.synthMute[i] = synthMute_[i] ? 1 : 0;
+    state.synthDistortion[i] = synthDistortion_[i] ? 1 : 0;
+    state.synthDelay[i] = synthDelay_[i] ? 1 : 0;
+  }
+  state.songMode = songMode_ ? 1 : 0;
+  state.loopMode = loopMode_ ? 1 : 0;
+  state.mode = static_cast<uint8_t>(mode_);
+  state.grooveFlavor = static_cast<uint8_t>(grooveFlavor_);
+}
+
+size_t SceneManager::fillEngineRecord(uint8_t* engines) const {
+  // Three length-prefixed strings.
+  size_t size = 0;
+  const std::string* names[3] = {&drumEngineName_, &synthEngineNames_[0], &synthEngineNames_[1]};
+  for (const std::string* name : names) {
+    size_t len = std::min(name->size(), kMaxEngineNameLength);
+    engines[size++] = static_cast<uint8_t>(len);
+    std::memcpy(engines + size, name->data(), len);
+    size += len;
+  }
+  return size;
+}
+
+bool SceneManager::writeSceneBinaryWithWriter(const BinaryWrite& write) const {
+  using namespace scene_binary;
+
+  SceneStateRecord state;
+  fillStateRecord(state);
+  uint8_t engines[kEngineRecordBytes];
+  size_t enginesSize = fillEngineRecord(engines);
+
+  struct Section {
+    uint32_t tag;
+    uint16_t version;
+    const void* data;
+    size_t size;
+  };
+  const Section sections[] = {
+      {kTagState, SceneStateRecord::kBinaryVersion, &state, sizeof(state)},
+      {kTagDrumBanks, DrumPatternSet::kBinaryVersion, scene_->drumBanks, sizeof(scene_->drumBanks)},
+      {kTagSynthABanks, SynthPattern::kBinaryVersion, scene_->synthABanks, sizeof(scene_->synthABanks)},
+      {kTagSynthBBanks, SynthPattern::kBinaryVersion, scene_->synthBBanks, sizeof(scene_->synthBBanks)},
+      {kTagSongs, Song::kBinaryVersion, scene_->songs, sizeof(scene_->songs)},
+      {kTagEngines, kEnginesSectionVersion, engines, enginesSize},
+      {kTagSamplerPads, SamplerPadState::kBinaryVersion, scene_->samplerPads, sizeof(scene_->samplerPads)},
+      {kTagTape, TapeState::kBinaryVersion, &scene_->tape, sizeof(scene_->tape)},
+      {kTagFeel, FeelSettings::kBinaryVersion, &scene_->feel, sizeof(scene_->feel)},
+      {kTagGenre, GenreSettings::kBinaryVersion, &scene_->genre, sizeof(scene_->genre)},
+      {kTagDrumFx, DrumFX::kBinaryVersion, &scene_->drumFX, sizeof(scene_->drumFX)},
+      {kTagGenerator, GeneratorParams::kBinaryVersion, &scene_->generatorParams, sizeof(scene_->generatorParams)},
+      {kTagVocal, VocalSettings::kBinaryVersion, &scene_->vocal, sizeof(scene_->vocal)},
+      {kTagLed, LedSettings::kBinaryVersion, &scene_->led, sizeof(scene_->led)},
+      {kTagTrackVolumes, Scene::kTrackVolumesBinaryVersion, scene_->trackVolumes, sizeof(scene_->trackVolumes)},
+      {kTagPhrases, Scene::kPhrasesBinaryVersion, scene_->customPhrases, sizeof(scene_->customPhrases)},
+  };
+  constexpr size_t kSectionCount = sizeof(sections) / sizeof(sections[0]);
+
+  FileHeader header{kMagic, kFormatVersion, static_cast<uint16_t>(kSectionCount)};
+  if (!write(&header, sizeof(header))) return false;
+  for (const Section& section : sections) {
+    SectionHeader sh{section.tag, section.version, 0, static_cast<uint32_t>(section.size),
+                     crc32(section.data, section.size)};
+    if (!write(&sh, sizeof(sh))) return false;
+    if (!write(section.data, section.size)) return false;
+  }
+  return true;
+}
+
+bool SceneManager::loadSceneBinaryWithReader(const BinaryRead& read) {
+  using namespace scene_binary;
+
+  auto readExact = [&read](void* dst, size_t len) -> bool {
+    return read(dst, len) == len;
+  };
+  auto skip = [&read](size_t len) -> bool {
+    uint8_t scratch[64];
+    while (len > 0) {
+      size_t n = std::min(len, sizeof(scratch));
+      if (read(scratch, n) != n) return false;
+      len -= n;
+    }
+    return true;
+  };
+
+  FileHeader header;
+  if (!readExact(&header, sizeof(header))) return false;
+  if (header.magic != kMagic || header.version > kFormatVersion) return false;
+
+  // Same staging buffer as the JSON loader: nothing changes unless the whole
+  // file checks out.
+  Scene* loaded = &s_tempLoadScene;
+  clearSceneData(*loaded);
+  SceneStateRecord state{};
+  std::string engineNames[3] = {drumEngineName_, synthEngineNames_[0], synthEngineNames_[1]};
+  uint32_t have = 0;
+
+  for (uint16_t i = 0; i < header.sectionCount; ++i) {
+    SectionHeader sh;
+    if (!readExact(&sh, sizeof(sh))) return false;
+
+    if (sh.tag == kTagEngines) {
+      uint8_t engines[kEngineRecordBytes];
+      if (sh.version != kEnginesSectionVersion || sh.size > sizeof(engines)) {
+        if (!skip(sh.size)) return false;
+        continue;
+      }
+      if (!readExact(engines, sh.size)) return false;
+      if (crc32(engines, sh.size) != sh.crc) return false;
+      if (!parseEngineNames(engines, sh.size, engineNames)) return false;
+      continue;
+    }
+
+    SectionSlot slot;
+    if (!sectionSlot(sh.tag, *loaded, state, slot) || sh.version != slot.version || sh.size != slot.size) {
+      // Unknown tag, or a layout this build cannot read as-is.
+      if (slot.flag) return false;
+      if (!skip(sh.size)) return false;
+      continue;
+    }
+    if (!readExact(slot.dst, slot.size)) return false;
+    if (crc32(slot.dst, slot.size) != sh.crc) return false;
+    have |= slot.flag;
+  }
+  if ((have & kHaveRequired) != kHaveRequired) return false;
+  applyStagedScene(*loaded, state, engineNames);
+  return true;
+}
+
+void SceneManager::applyStagedScene(Scene& loaded, const SceneStateRecord& state,
+                                    const std::string engineNames[3]) {
+  // Raw images are trusted for layout, not for range.
+  for (int s = 0; s < 2; ++s) {
+    Song& song = loaded.songs[s];
+    song.length = clampSongLength(song.length);
+    for (int p = 0; p < Song::kMaxPositions; ++p) {
+      for (int t = 0; t < SongPosition::kTrackCount; ++t) {
+        song.positions[p].patterns[t] = static_cast<int16_t>(clampSongPatternIndex(song.positions[p].patterns[t]));
+      }
+    }
+  }
+  for (int b = 0; b < kBankCount; ++b) {
+    for (int p = 0; p < Bank<DrumPatternSet>::kPatterns; ++p) {
+      for (int l = 0; l < DrumPatternSet::kMaxLanes; ++l) {
+        AutomationLane& lane = loaded.drumBanks[b].patterns[p].lanes[l];
+        if (lane.nodeCount > AutomationLane::kMaxNodes) lane.nodeCount = AutomationLane::kMaxNodes;
+      }
+    }
+  }
+  for (int i = 0; i < Scene::kMaxCustomPhrases; ++i) {
+    loaded.customPhrases[i][Scene::kMaxPhraseLength - 1] = '\0';
+  }
+  loaded.activeSongSlot = clampIndex(state.activeSongSlot, 2);
+  loaded.masterVolume = state.masterVolume;
+
+  *scene_ = loaded;
+  drumPatternIndex_ = clampPatternIndex(state.drumPatternIndex);
+  synthPatternIndex_[0] = clampPatternIndex(state.synthPatternIndex[0]);
+  synthPatternIndex_[1] = clampPatternIndex(state.synthPatternIndex[1]);
+  drumBankIndex_ = clampIndex(state.drumBankIndex, kBankCount);
+  synthBankIndex_[0] = clampIndex(state.synthBankIndex[0], kBankCount);
+  synthBankIndex_[1] = clampIndex(state.synthBankIndex[1], kBankCount);
+  for (int i = 0; i < DrumPatternSet::kVoices; ++i) {
+    drumMute_[i] = state.drumMute[i] != 0;
+  }
+  for (int i = 0; i < 2; ++i) {
+    synthMute_[i] = state.synthMute[i] != 0;
+    synthDistortion_[i] = state.synthDistortion[i] != 0;
+    synthDelay_[i] = state.synthDelay[i] != 0;
+    synthParameters_[i] = state.synthParams[i];
+  }
+  drumEngineName_ = engineNames[0];
+  synthEngineNames_[0] = engineNames[1];
+  synthEngineNames_[1] = engineNames[2];
+  setSongLength(scene_->songs[scene_->activeSongSlot].length);
+  songPosition_ = clampSongPosition(state.songPosition);
+  songMode_ = state.songMode != 0;
+  loopMode_ = state.loopMode != 0;
+  loopStartRow_ = state.loopStartRow;
+  loopEndRow_ = state.loopEndRow;
+  clampLoopRange();
+  setBpm(state.bpm);
+  setMode(static_cast<GrooveboxMode>(state.mode));
+  setGrooveFlavor(state.grooveFlavor);
+}
+
+// Journal replay stages in the loaders' buffer too; the STAT and ENGN
+// payloads are kept next to it.
+static SceneStateRecord s_patchState;
+static uint8_t s_patchEngines[SceneManager::kEngineRecordBytes];
+static size_t s_patchEnginesSize = 0;
+
+void SceneManager::beginSectionPatch() {
+  s_tempLoadScene = *scene_;
+  fillStateRecord(s_patchState);
+  s_patchEnginesSize = fillEngineRecord(s_patchEngines);
+}
+
+bool SceneManager::patchSection(uint32_t tag, uint16_t version, uint32_t sectionSize, uint32_t offset,
+                                const void* data, size_t len) {
+  if (offset > sectionSize || sectionSize - offset < len) return false;
+  if (tag == scene_binary::kTagEngines) {
+    if (version != kEnginesSectionVersion || sectionSize > sizeof(s_patchEngines)) return false;
+    if (sectionSize > s_patchEnginesSize) {
+      std::memset(s_patchEngines + s_patchEnginesSize, 0, sectionSize - s_patchEnginesSize);
+    }
+    s_patchEnginesSize = sectionSize;
+    std::memcpy(s_patchEngines + offset, data, len);
+    return true;
+  }
+  SectionSlot slot;
+  if (!sectionSlot(tag, s_tempLoadScene, s_patchState, slot)) return false;
+  if (version != slot.version || sectionSize != slot.size) return false;
+  std::memcpy(static_cast<uint8_t*>(slot.dst) + offset, data, len);
+  return true;
+}
+
+bool SceneManager::commitSectionPatch() {
+  std::string engineNames[3] = {drumEngineName_, synthEngineNames_[0], synthEngineNames_[1]};
+  if (!parseEngineNames(s_patchEngines, s_patchEnginesSize, engineNames)) return false;
+  applyStagedScene(s_tempLoadScene, s_patchState, engineNames);
+  return true;
+}
+
 int SceneManager::clampPatternIndex(int idx) const {
   return clampIndex(idx, Bank<DrumPatternSet>::kPatterns);
 }
@@ -2903,23 +3368,8 @@ int SceneManager::songTrackToIndex(SongTrack track) const {
 }
 
 void SceneManager::trimSongLength() {
-  int lastUsed = -1;
   Song& s = scene_->songs[scene_->activeSongSlot];
-  for (int pos = s.length - 1; pos >= 0; --pos) {
-    bool hasData = false;
-    for (int t = 0; t < SongPosition::kTrackCount; ++t) {
-      if (s.positions[pos].patterns[t] >= 0) {
-        hasData = true;
-        break;
-      }
-    }
-    if (hasData) {
-      lastUsed = pos;
-      break;
-    }
-  }
-  int newLength = lastUsed >= 0 ? lastUsed + 1 : 1;
-  s.length = clampSongLength(newLength);
+  s.length = clampSongLength(usedSongLength(s));
   if (songPosition_ >= s.length) songPosition_ = s.length - 1;
   clampLoopRange();
 }
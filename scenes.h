@@ -3,8 +3,12 @@
 
 
 #include <stdint.h>
+#include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <functional>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -46,6 +50,58 @@ template <typename Writer>
 bool writeChunk(Writer& writer, const char* data, size_t len) {
   return writeChunkImpl(writer, data, len, 0);
 }
+
+// Gathers the many small fragments writeSceneJson emits into kBlockSize
+// writes, so an SD File sees a few dozen write() calls instead of one per
+// token. Without a block (heap exhausted) it writes straight through.
+template <typename Writer>
+class BufferedWriter {
+public:
+  static constexpr size_t kBlockSize = 4096;
+
+  explicit BufferedWriter(Writer& out) : out_(out), buffer_(new (std::nothrow) char[kBlockSize]) {}
+  ~BufferedWriter() { delete[] buffer_; }
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+  bool write(const char* data, size_t len) {
+    if (!buffer_) return writeChunk(out_, data, len);
+    if (len > kBlockSize - used_) {
+      if (!flush()) return false;
+      if (len >= kBlockSize) return writeChunk(out_, data, len);
+    }
+    std::memcpy(buffer_ + used_, data, len);
+    used_ += len;
+    return true;
+  }
+
+  bool flush() {
+    if (used_ == 0) return true;
+    bool ok = writeChunk(out_, buffer_, used_);
+    used_ = 0;
+    return ok;
+  }
+
+private:
+  Writer& out_;
+  char* buffer_;
+  size_t used_ = 0;
+};
+
+// A std::string is already an in-memory buffer.
+template <>
+class BufferedWriter<std::string> {
+public:
+  explicit BufferedWriter(std::string& out) : out_(out) {}
+  bool write(const char* data, size_t len) {
+    out_.append(data, len);
+    return true;
+  }
+  bool flush() { return true; }
+
+private:
+  std::string& out_;
+};
 } // namespace scene_json_detail
 
 enum DrumStepFX : uint8_t {
@@ -69,6 +125,11 @@ struct DrumStep {
   uint8_t probability = 100;
 };
 
+// The binary scene format (scene_binary.h) stores the structs below as raw
+// images. The static_asserts pin their layouts: a change that trips one must
+// bump the kBinaryVersion of the section struct that contains it.
+static_assert(sizeof(DrumStep) == 6, "DrumStep layout is part of the .gps format");
+
 struct DrumPattern {
   static constexpr int kSteps = 16;
   DrumStep steps[kSteps];
@@ -88,6 +149,11 @@ struct AutomationLane {
   uint8_t nodeCount = 0;
 };
 
+static_assert(sizeof(AutomationNode) == 12 && offsetof(AutomationNode, value) == 4,
+              "AutomationNode layout is part of the .gps format");
+static_assert(sizeof(AutomationLane) == 104 && offsetof(AutomationLane, nodeCount) == 100,
+              "AutomationLane layout is part of the .gps format");
+
 enum DrumAutomationTarget : uint8_t {
   DRUM_AUTOMATION_REVERB_MIX = 0,
   DRUM_AUTOMATION_COMPRESSION = 1,
@@ -104,12 +170,17 @@ struct PatternGroove {
 struct DrumPatternSet {
   static constexpr int kVoices = 8;
   static constexpr int kMaxLanes = 4; // Reverb, Compression, TransientAttack, EngineSwitch
+  static constexpr uint16_t kBinaryVersion = 1; // .gps DRMB section
   DrumPattern voices[kVoices];
   AutomationLane lanes[kMaxLanes];
   PatternGroove groove;
   bool isEmpty() const;
 };
 
+static_assert(sizeof(DrumPatternSet) == 1192 && offsetof(DrumPatternSet, lanes) == 768 &&
+                  offsetof(DrumPatternSet, groove) == 1184,
+              "DrumPatternSet layout is part of the .gps format");
+
 struct SynthStep {
   int8_t note = -1;
   uint8_t slide : 1 {0};
@@ -125,10 +196,15 @@ struct SynthStep {
 
 struct SynthPattern {
   static constexpr int kSteps = 16;
+  static constexpr uint16_t kBinaryVersion = 1; // .gps SYNA/SYNB sections
   SynthStep steps[kSteps];
   bool isEmpty() const;
 };
 
+static_assert(sizeof(SynthStep) == 7 && offsetof(SynthStep, velocity) == 2,
+              "SynthStep layout is part of the .gps format");
+static_assert(sizeof(SynthPattern) == 112, "SynthPattern layout is part of the .gps format");
+
 struct SynthParameters {
   float cutoff = 800.0f;
   float resonance = 0.6f;
@@ -137,6 +213,8 @@ struct SynthParameters {
   int oscType = 0;
 };
 
+static_assert(sizeof(SynthParameters) == 20, "SynthParameters layout is part of the .gps format");
+
 enum class SongTrack : uint8_t {
   SynthA = 0,
   SynthB = 1,
@@ -151,11 +229,16 @@ struct SongPosition {
 
 struct Song {
   static constexpr int kMaxPositions = 128;
+  static constexpr uint16_t kBinaryVersion = 1; // .gps SONG section
   SongPosition positions[kMaxPositions];
   int length = 1;
   bool reverse = false;
 };
 
+static_assert(sizeof(SongPosition) == 8, "SongPosition layout is part of the .gps format");
+static_assert(sizeof(Song) == 1032 && offsetof(Song, length) == 1024 && offsetof(Song, reverse) == 1028,
+              "Song layout is part of the .gps format");
+
 template <typename PatternType>
 struct Bank {
   static constexpr int kPatterns = 8;
@@ -190,6 +273,7 @@ struct Rgb8 {
 };
 
 struct LedSettings {
+  static constexpr uint16_t kBinaryVersion = 1; // .gps LED section
   LedMode mode = LedMode::Off;
   LedSource source = LedSource::SynthA;
   Rgb8 color = {255, 128, 0}; // Amber
@@ -197,6 +281,9 @@ struct LedSettings {
   uint16_t flashMs = 40;
 };
 
+static_assert(sizeof(LedSettings) == 8 && offsetof(LedSettings, flashMs) == 6,
+              "LedSettings layout is part of the .gps format");
+
 static constexpr int kBankCount = 2;
 static constexpr int kPatternsPerPage = kBankCount * Bank<SynthPattern>::kPatterns; // 16
 static constexpr int kMaxPages = 16;
@@ -237,6 +324,7 @@ inline int songPatternFromBank(int bankIndex, int patternIndex) {
 }
 
 struct SamplerPadState {
+  static constexpr uint16_t kBinaryVersion = 1; // .gps SMPL section
   uint32_t sampleId = 0;
   float volume = 1.0f;
   float pitch = 1.0f;
@@ -247,6 +335,10 @@ struct SamplerPadState {
   bool loop = false;
 };
 
+static_assert(sizeof(SamplerPadState) == 24 && offsetof(SamplerPadState, startFrame) == 12 &&
+                  offsetof(SamplerPadState, loop) == 22,
+              "SamplerPadState layout is part of the .gps format");
+
 // FX Types
 enum class StepFx : uint8_t { 
   None = 0, 
@@ -262,6 +354,8 @@ enum class StepFx : uint8_t {
 #include "src/dsp/tape_defs.h"
 
 struct TapeState {
+    static constexpr uint16_t kBinaryVersion = 1; // .gps TAPE section
+
     // Mode & control
     TapeMode mode = TapeMode::Stop;
     TapePreset preset = TapePreset::Warm;
@@ -280,6 +374,11 @@ struct TapeState {
     uint8_t groove = 0;   // 0..100
 };
 
+static_assert(sizeof(TapeMacro) == 5, "TapeMacro layout is part of the .gps format");
+static_assert(sizeof(TapeState) == 20 && offsetof(TapeState, macro) == 4 &&
+                  offsetof(TapeState, looperVolume) == 12 && offsetof(TapeState, groove) == 18,
+              "TapeState layout is part of the .gps format");
+
 enum ScaleType {
     MINOR,
     MAJOR,
@@ -294,6 +393,8 @@ enum ScaleType {
 };
 
 struct GeneratorParams {
+    static constexpr uint16_t kBinaryVersion = 1; // .gps GENP section
+
     // Basic
     int minNotes = 4;
     int maxNotes = 12;
@@ -313,14 +414,22 @@ struct GeneratorParams {
     ScaleType scale = DORIAN;         
 };
 
+static_assert(sizeof(GeneratorParams) == 44 && offsetof(GeneratorParams, preferDownbeats) == 32 &&
+                  offsetof(GeneratorParams, scale) == 40,
+              "GeneratorParams layout is part of the .gps format");
+
 struct VocalSettings {
+    static constexpr uint16_t kBinaryVersion = 1; // .gps VOCL section
     float pitch = 120.0f;
     float speed = 1.0f;
     float robotness = 0.8f;
     float volume = 1.0f;
 };
 
+static_assert(sizeof(VocalSettings) == 16, "VocalSettings layout is part of the .gps format");
+
 struct FeelSettings {
+    static constexpr uint16_t kBinaryVersion = 1; // .gps FEEL section
     uint8_t gridSteps = 16;   // 8,16,32
     uint8_t timebase = 1;     // 0=Half, 1=Normal, 2=Double
     uint8_t patternBars = 1;  // 1,2,4,8
@@ -333,7 +442,12 @@ struct FeelSettings {
     bool tapeEnabled = false;
 };
 
+static_assert(sizeof(FeelSettings) == 12 && offsetof(FeelSettings, swingMask) == 4 &&
+                  offsetof(FeelSettings, tapeEnabled) == 10,
+              "FeelSettings layout is part of the .gps format");
+
 struct GenreSettings {
+    static constexpr uint16_t kBinaryVersion = 1; // .gps GENR section
     uint8_t generativeMode = 0;   // GenerativeMode enum value
     uint8_t textureMode = 0;      // TextureMode enum value
     uint8_t textureAmount = 70;   // 0..100 intensity
@@ -346,7 +460,10 @@ struct GenreSettings {
     bool applySoundMacros = false; // true: Flavor change overwrites 303/Tape
 };
 
+static_assert(sizeof(GenreSettings) == 10, "GenreSettings layout is part of the .gps format");
+
 struct DrumFX {
+    static constexpr uint16_t kBinaryVersion = 1; // .gps DFX section
     float compression = 0.0f;
     float transientAttack = 0.0f;
     float transientSustain = 0.0f;
@@ -354,6 +471,8 @@ struct DrumFX {
     float reverbDecay = 0.5f;
 };
 
+static_assert(sizeof(DrumFX) == 20, "DrumFX layout is part of the .gps format");
+
 struct Scene {
   Bank<DrumPatternSet> drumBanks[kBankCount];
   Bank<SynthPattern> synthABanks[kBankCount];
@@ -373,6 +492,8 @@ struct Scene {
   
   static constexpr int kMaxCustomPhrases = 16;
   static constexpr int kMaxPhraseLength = 32;
+  static constexpr uint16_t kPhrasesBinaryVersion = 1;      // .gps PHRS section
+  static constexpr uint16_t kTrackVolumesBinaryVersion = 1; // .gps TVOL section
   char customPhrases[kMaxCustomPhrases][kMaxPhraseLength];
     
   LedSettings led;
@@ -423,6 +544,8 @@ public:
   GrooveboxMode mode() const;
 
 private:
+  enum class Key : uint8_t;  // defined in scenes.cpp with the key table
+
   enum class Path {
     Root,
     DrumBanks,
@@ -492,11 +615,13 @@ private:
   void popContext();
   void handlePrimitiveNumber(double value, bool isInteger);
   void handlePrimitiveBool(bool value);
+  static Key internKey(const char* text, size_t len);
 
   static constexpr int kMaxStack = 16;
   Context stack_[kMaxStack];
   int stackSize_ = 0;
-  std::string lastKey_;
+  Key key_{};
+  char keyText_[24] = {};  // raw key, only for parse warnings
   Scene& target_;
   bool error_ = false;
   int drumPatternIndex_ = 0;
@@ -520,6 +645,8 @@ private:
   std::string synthEngineNames_[2] = {"TB303", "TB303"};
 };
 
+struct SceneStateRecord;
+
 class SceneManager {
 public:
   SceneManager();
@@ -606,6 +733,13 @@ public:
   bool isSongReverseAtSlot(int slot) const;
   void mergeSongs();
   void alternateSongs();
+  // mergeSongs()/alternateSongs() results, written to `out` instead of the
+  // active slot (so they can be built off the audio thread).
+  void buildMergedSong(Song& out) const;
+  void buildAlternatedSong(Song& out) const;
+  // Swaps `song` with the slot's song (`song` gets the old one); for the
+  // active slot, clamps the song position and loop range to the new length.
+  void swapSong(int slot, Song& song);
   
   // Song row manipulation
   void insertSongRow(int position);
@@ -624,6 +758,27 @@ public:
   template <typename TReader>
   bool loadSceneEvented(TReader&& reader);
 
+  // Binary scene container (scene_binary.h). The writer needs
+  // write(const uint8_t*, size_t) or the like (see writeSceneJson); the
+  // reader needs read(uint8_t*, size_t) returning the bytes read.
+  template <typename TWriter>
+  bool writeSceneBinary(TWriter&& writer) const;
+  template <typename TReader>
+  bool loadSceneBinary(TReader&& reader);
+
+  // Journal replay (scene_journal.h): stages a copy of the current scene,
+  // overwrites slices of its binary sections in place and loads the result
+  // as loadSceneBinary() would. Uses the loaders' staging scene, so nothing
+  // is allocated and nothing changes until commitSectionPatch().
+  // patchSection() returns false for a slice this build cannot place (tag,
+  // version or section size differ), which is then left to the snapshot.
+  void beginSectionPatch();
+  bool patchSection(uint32_t tag, uint16_t version, uint32_t sectionSize, uint32_t offset,
+                    const void* data, size_t len);
+  bool commitSectionPatch();
+
+  static constexpr size_t kEngineRecordBytes = 3 * (1 + 32); // ENGN section, at most
+
   // static constexpr size_t sceneJsonCapacity();
 
 private:
@@ -638,7 +793,14 @@ private:
   void clearSongData(Song& song) const;
   void buildSceneDocument(ArduinoJson::JsonDocument& doc) const;
   bool applySceneDocument(const ArduinoJson::JsonDocument& doc);
-  bool loadSceneEventedWithReader(JsonVisitor::NextChar nextChar);
+  bool loadSceneEventedWithReader(const JsonVisitor::ReadBlock& readBlock);
+  using BinaryWrite = std::function<bool(const void* data, size_t len)>;
+  using BinaryRead = std::function<size_t(void* dst, size_t len)>;
+  bool writeSceneBinaryWithWriter(const BinaryWrite& write) const;
+  bool loadSceneBinaryWithReader(const BinaryRead& read);
+  void fillStateRecord(SceneStateRecord& state) const;
+  size_t fillEngineRecord(uint8_t* engines) const;
+  void applyStagedScene(Scene& loaded, const SceneStateRecord& state, const std::string engineNames[3]);
 
   Scene* scene_;
   int drumPatternIndex_ = 0;
@@ -686,8 +848,9 @@ bool SceneManager::writeSceneJson(TWriter&& writer) const {
   using WriterType = typename std::remove_reference<TWriter>::type;
   WriterType& out = writer;
 
+  scene_json_detail::BufferedWriter<WriterType> buffered(out);
   auto writeChunk = [&](const char* data, size_t len) -> bool {
-    return scene_json_detail::writeChunk(out, data, len);
+    return buffered.write(data, len);
   };
   auto writeLiteral = [&](const char* literal) -> bool {
     return writeChunk(literal, std::strlen(literal));
@@ -699,12 +862,24 @@ bool SceneManager::writeSceneJson(TWriter&& writer) const {
     return writeLiteral(value ? "true" : "false");
   };
   auto writeInt = [&](int value) -> bool {
-    char buffer[16];
-    int written = std::snprintf(buffer, sizeof(buffer), "%d", value);
-    if (written < 0 || written >= static_cast<int>(sizeof(buffer))) return false;
-    return writeChunk(buffer, static_cast<size_t>(written));
+    // Most of a scene is small integers; format them without snprintf.
+    char buffer[12];
+    char* end = buffer + sizeof(buffer);
+    char* p = end;
+    unsigned int magnitude = value < 0 ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+    do {
+      *--p = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) *--p = '-';
+    return writeChunk(p, static_cast<size_t>(end - p));
   };
   auto writeFloat = [&](float value) -> bool {
+    // Whole values print the same under %.6g as under %d (except -0).
+    if (value > -1e6f && value < 1e6f && value == static_cast<float>(static_cast<int>(value)) &&
+        !(value == 0.0f && std::signbit(value))) {
+      return writeInt(static_cast<int>(value));
+    }
     char buffer[24];
     int written = std::snprintf(buffer, sizeof(buffer), "%.6g", static_cast<double>(value));
     if (written < 0 || written >= static_cast<int>(sizeof(buffer))) return false;
@@ -1131,7 +1306,7 @@ bool SceneManager::writeSceneJson(TWriter&& writer) const {
   }
   if (!writeChar(']')) return false;
   
-  bool finalOk = writeLiteral("}}");  // Close state and root
+  bool finalOk = writeLiteral("}}") && buffered.flush();  // Close state and root
   // if (finalOk) Serial.println(" Done.");
   // else Serial.println(" FAILED at final literal.");
   return finalOk;
@@ -1147,13 +1322,24 @@ bool SceneManager::loadSceneJson(TReader&& reader) {
 
 template <typename TReader>
 bool SceneManager::loadSceneEvented(TReader&& reader) {
-  static size_t bytesRead = 0;
-  bytesRead = 0;
-  JsonVisitor::NextChar nextChar = [&reader]() -> int { 
-    int c = reader.read();
-    if (c >= 0) bytesRead++;
-    return c; 
-  };
-  return loadSceneEventedWithReader(nextChar);
+  return loadSceneEventedWithReader([&reader](char* dst, size_t cap) -> size_t {
+    return json_detail::readBlock(reader, dst, cap);
+  });
+}
+
+template <typename TWriter>
+bool SceneManager::writeSceneBinary(TWriter&& writer) const {
+  using WriterType = typename std::remove_reference<TWriter>::type;
+  WriterType& out = writer;
+  return writeSceneBinaryWithWriter([&out](const void* data, size_t len) -> bool {
+    return scene_json_detail::writeChunk(out, static_cast<const char*>(data), len);
+  });
+}
+
+template <typename TReader>
+bool SceneManager::loadSceneBinary(TReader&& reader) {
+  return loadSceneBinaryWithReader([&reader](void* dst, size_t len) -> size_t {
+    return reader.read(static_cast<uint8_t*>(dst), len);
+  });
 }
 #endif // SCENES_H
@@ -5,14 +5,77 @@
 // All DSP code must use these constants.
 
 // Stable hardware default for Cardputer DRAM-only builds.
-// 44.1 kHz can be re-enabled later, but it noticeably increases CPU pressure.
+// 44.1 kHz can be selected at runtime (see AudioConfig), but it noticeably
+// increases CPU pressure and is only practical on PSRAM units.
 static constexpr uint32_t kSampleRate = 22050;
-// static constexpr uint32_t kSampleRate = 44100; // Optional high-quality mode
 
-// Block size for processing (usually 128 or 256)
+// Default block size for processing.
 // 512 keeps audio robust while avoiding the "sluggish controls" feel of 1024.
 static constexpr uint32_t kBlockFrames = 512;
-// static constexpr uint32_t kBlockFrames = 1024; // Optional extra underrun headroom
+
+// Runtime-selectable range. Scratch and waveform buffers are sized for the
+// maximum so switching never reallocates engine memory.
+static constexpr uint32_t kSupportedSampleRates[] = {22050, 32000, 44100};
+static constexpr int kSupportedSampleRateCount = 3;
+static constexpr uint32_t kMaxSampleRate = 44100;
+static constexpr uint32_t kMinBlockFrames = 128;
+static constexpr uint32_t kMaxBlockFrames = 1024;
 
 // 2ms fade time to prevent clicks
-static constexpr uint32_t kFadeFrames = (kSampleRate * 2) / 1000;
+static constexpr uint32_t fadeFramesFor(uint32_t sampleRate) { return (sampleRate * 2) / 1000; }
+static constexpr uint32_t kFadeFrames = fadeFramesFor(kSampleRate);
+
+// Active audio configuration. The platform owns the output device and applies
+// a new config between blocks; DSP objects are re-initialized by
+// MiniAcid::applyAudioConfig().
+struct AudioConfig {
+  uint32_t sampleRate = kSampleRate;
+  uint32_t blockFrames = kBlockFrames;
+  bool autoTune = false; // let the engine pick the smallest stable block size
+  // Render the drum kit and drum bus one block ahead on the second core.
+  // Adds one block of output latency.
+  bool dualCore = false;
+
+  // Real-time budget for one block in microseconds.
+  uint32_t blockBudgetUs() const {
+    return static_cast<uint32_t>((1000000ULL * blockFrames) / sampleRate);
+  }
+
+  bool operator==(const AudioConfig& o) const {
+    return sampleRate == o.sampleRate && blockFrames == o.blockFrames && autoTune == o.autoTune &&
+           dualCore == o.dualCore;
+  }
+  bool operator!=(const AudioConfig& o) const { return !(*this == o); }
+
+  // Snaps to a supported rate and a power-of-two block size in range.
+  AudioConfig sanitized() const {
+    AudioConfig c = *this;
+    uint32_t best = kSupportedSampleRates[0];
+    for (int i = 1; i < kSupportedSampleRateCount; ++i) {
+      uint32_t r = kSupportedSampleRates[i];
+      uint32_t dBest = best > sampleRate ? best - sampleRate : sampleRate - best;
+      uint32_t d = r > sampleRate ? r - sampleRate : sampleRate - r;
+      if (d < dBest) best = r;
+    }
+    c.sampleRate = best;
+    uint32_t frames = kMinBlockFrames;
+    while (frames < kMaxBlockFrames && frames < blockFrames) frames <<= 1;
+    c.blockFrames = frames;
+    return c;
+  }
+
+  // Packs into one word so a request can cross threads through a single atomic.
+  // Bit 31 flags a valid request; rate fits in 16 bits, frames in 11.
+  uint32_t pack() const {
+    return 0x80000000u | (autoTune ? 0x40000000u : 0u) | (dualCore ? 0x20000000u : 0u) |
+           ((blockFrames & 0x7FFu) << 16) | (sampleRate & 0xFFFFu);
+  }
+  static AudioConfig unpack(uint32_t word) {
+    AudioConfig c;
+    c.sampleRate = word & 0xFFFFu;
+    c.blockFrames = (word >> 16) & 0x7FFu;
+    c.autoTune = (word & 0x40000000u) != 0;
+    c.dualCore = (word & 0x20000000u) != 0;
+    return c;
+  }
+};
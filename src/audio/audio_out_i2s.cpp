@@ -11,11 +11,15 @@ static const int I2S_LRCLK = 43;
 static const int I2S_DOUT = 42;
 static const int I2S_MCLK = 0;   // GPIO 0 on Cardputer (optional MCLK output)
 static constexpr bool kEnableHardwareMclk = false;
+// Let the I2S controller put each mono sample on both slots instead of
+// interleaving an L=R copy. Set false to force the interleaved stereo path.
+static constexpr bool kUseMonoSlot = true;
 // static constexpr bool kEnableHardwareMclk = true; // Optional 44.1k experiments
 
 AudioOutI2S::AudioOutI2S() 
   : sampleRate_(0)
   , bufferFrames_(0)
+  , monoSlot_(false)
   , stereoBuffer_(nullptr)
   , tx_handle_(nullptr)
 {
@@ -34,33 +38,53 @@ bool AudioOutI2S::begin(uint32_t sampleRate, size_t bufferFrames) {
   sampleRate_ = sampleRate;
   bufferFrames_ = bufferFrames;
   
-  // Allocate stereo buffer in INTERNAL RAM (critical for DMA!)
-  stereoBuffer_ = (int16_t*)heap_caps_malloc(
-    bufferFrames * 2 * sizeof(int16_t),
-    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT
-  );
-  
-  if (stereoBuffer_) {
-    memset(stereoBuffer_, 0, bufferFrames * 2 * sizeof(int16_t));
-  }
-  
-  if (!stereoBuffer_) {
-    Serial.println("[AudioOutI2S] Failed to allocate stereo buffer");
-    return false;
+  // Mono slot mode: the engine's block is written to DMA as is, no L=R
+  // interleave copy, and the DMA ring is half the size.
+  monoSlot_ = kUseMonoSlot && openChannel(true);
+  if (!monoSlot_) {
+    // Allocate stereo buffer in INTERNAL RAM (critical for DMA!)
+    stereoBuffer_ = (int16_t*)heap_caps_malloc(
+      bufferFrames * 2 * sizeof(int16_t),
+      MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT
+    );
+    
+    if (stereoBuffer_) {
+      memset(stereoBuffer_, 0, bufferFrames * 2 * sizeof(int16_t));
+    }
+    
+    if (!stereoBuffer_) {
+      Serial.println("[AudioOutI2S] Failed to allocate stereo buffer");
+      return false;
+    }
+    if (!openChannel(false)) {
+      heap_caps_free(stereoBuffer_);
+      stereoBuffer_ = nullptr;
+      return false;
+    }
   }
   
+  Serial.printf("[AudioOutI2S] Initialized on I2S_NUM_0: %u Hz, %u frames, %s, MCLK=%s\n",
+                sampleRate, (unsigned)bufferFrames, monoSlot_ ? "mono slot" : "stereo",
+                kEnableHardwareMclk ? "ON" : "OFF");
+  return true;
+}
+
+bool AudioOutI2S::openChannel(bool mono) {
   // 1. Create I2S Channel (Standard Mode)
   // Use I2S_NUM_0 to avoid conflicts with M5.Speaker and ESP32-audioI2S on port 0
   i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_0, I2S_ROLE_MASTER);
-  chan_cfg.dma_desc_num = 8;         // Matches working test config
-  chan_cfg.dma_frame_num = 512;      // Matches working test config
+  // One DMA descriptor per block (capped at 512 frames: a descriptor holds at
+  // most 4092 bytes of 16-bit stereo), 8 blocks in flight as in the original
+  // 512-frame test config. Smaller blocks therefore also mean lower latency.
+  const size_t dmaFrames = bufferFrames_ < 512 ? bufferFrames_ : 512;
+  chan_cfg.dma_frame_num = dmaFrames;
+  chan_cfg.dma_desc_num = 8 * ((bufferFrames_ + dmaFrames - 1) / dmaFrames);
   chan_cfg.auto_clear = true;        // Silence on underrun
   
   esp_err_t err = i2s_new_channel(&chan_cfg, &tx_handle_, NULL);
   if (err != ESP_OK) {
     Serial.printf("[AudioOutI2S] i2s_new_channel failed: %d\n", (int)err);
-    heap_caps_free(stereoBuffer_);
-    stereoBuffer_ = nullptr;
+    tx_handle_ = nullptr;
     return false;
   }
   
@@ -68,7 +92,7 @@ bool AudioOutI2S::begin(uint32_t sampleRate, size_t bufferFrames) {
   i2s_std_config_t std_cfg = {};
   
   // Clock: Use default source (usually PLL or XTAL)
-  std_cfg.clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(sampleRate);
+  std_cfg.clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(sampleRate_);
   std_cfg.clk_cfg.clk_src = I2S_CLK_SRC_DEFAULT;
   if (kEnableHardwareMclk) {
     std_cfg.clk_cfg.mclk_multiple = I2S_MCLK_MULTIPLE_256;
@@ -76,7 +100,10 @@ bool AudioOutI2S::begin(uint32_t sampleRate, size_t bufferFrames) {
 
   
   // Slot: Standard Philips I2S (Option B from before, matching i2s_test.ino)
-  std_cfg.slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO);
+  std_cfg.slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(
+    I2S_DATA_BIT_WIDTH_16BIT, mono ? I2S_SLOT_MODE_MONO : I2S_SLOT_MODE_STEREO);
+  // Mono data on both slots, so the codec hears it whichever slot it reads.
+  if (mono) std_cfg.slot_cfg.slot_mask = I2S_STD_SLOT_BOTH;
   
   // GPIOs
   std_cfg.gpio_cfg.mclk = kEnableHardwareMclk ? (gpio_num_t)I2S_MCLK : I2S_GPIO_UNUSED;
@@ -90,11 +117,10 @@ bool AudioOutI2S::begin(uint32_t sampleRate, size_t bufferFrames) {
 
   err = i2s_channel_init_std_mode(tx_handle_, &std_cfg);
   if (err != ESP_OK) {
-    Serial.printf("[AudioOutI2S] i2s_channel_init_std_mode failed: %d\n", (int)err);
+    Serial.printf("[AudioOutI2S] i2s_channel_init_std_mode (%s) failed: %d\n",
+                  mono ? "mono" : "stereo", (int)err);
     i2s_del_channel(tx_handle_);
     tx_handle_ = nullptr;
-    heap_caps_free(stereoBuffer_);
-    stereoBuffer_ = nullptr;
     return false;
   }
   
@@ -104,18 +130,13 @@ bool AudioOutI2S::begin(uint32_t sampleRate, size_t bufferFrames) {
     Serial.printf("[AudioOutI2S] i2s_channel_enable failed: %d\n", (int)err);
     i2s_del_channel(tx_handle_);
     tx_handle_ = nullptr;
-    heap_caps_free(stereoBuffer_);
-    stereoBuffer_ = nullptr;
     return false;
   }
-  
-  Serial.printf("[AudioOutI2S] Initialized on I2S_NUM_0: %u Hz, %u frames, MCLK=%s\n",
-                sampleRate, (unsigned)bufferFrames, kEnableHardwareMclk ? "ON" : "OFF");
   return true;
 }
 
 bool AudioOutI2S::writeMono16(const int16_t* monoBuffer, size_t frames) {
-  if (!tx_handle_ || !stereoBuffer_ || !monoBuffer) {
+  if (!tx_handle_ || !monoBuffer || (!monoSlot_ && !stereoBuffer_)) {
     return false;
   }
   
@@ -123,23 +144,29 @@ bool AudioOutI2S::writeMono16(const int16_t* monoBuffer, size_t frames) {
     frames = bufferFrames_;
   }
   
-  // Convert mono to stereo (L=R duplication)
-  for (size_t i = 0; i < frames; i++) {
-    int16_t sample = monoBuffer[i];
-    stereoBuffer_[i * 2 + 0] = sample;
-    stereoBuffer_[i * 2 + 1] = sample;
+  const int16_t* data = monoBuffer;
+  size_t bytes = frames * sizeof(int16_t);
+  if (!monoSlot_) {
+    // Convert mono to stereo (L=R duplication)
+    for (size_t i = 0; i < frames; i++) {
+      int16_t sample = monoBuffer[i];
+      stereoBuffer_[i * 2 + 0] = sample;
+      stereoBuffer_[i * 2 + 1] = sample;
+    }
+    data = stereoBuffer_;
+    bytes *= 2;
   }
   
   size_t bytesWritten = 0;
   esp_err_t err = i2s_channel_write(
     tx_handle_,
-    stereoBuffer_,
-    frames * 2 * sizeof(int16_t),
+    data,
+    bytes,
     &bytesWritten,
     pdMS_TO_TICKS(100) // Avoid indefinite hang
   );
   
-  if (err != ESP_OK || bytesWritten != frames * 2 * sizeof(int16_t)) {
+  if (err != ESP_OK || bytesWritten != bytes) {
     // Treat regular timeouts as silent failures (underruns)
     return false;
   }
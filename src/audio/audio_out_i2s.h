@@ -18,16 +18,22 @@ public:
   // bufferFrames: frames per write call (e.g., 512)
   bool begin(uint32_t sampleRate, size_t bufferFrames);
   
-  // Write mono audio buffer (will be duplicated to stereo L=R)
+  // Write mono audio buffer. In mono slot mode it goes to the DMA buffers as
+  // is (the controller sends each sample on both slots); in the stereo
+  // fallback it is first duplicated to L=R.
   // Returns true on success
   bool writeMono16(const int16_t* monoBuffer, size_t frames);
+  bool monoSlot() const { return monoSlot_; }
   
   // Stop and cleanup I2S driver
   void end();
   
 private:
+  bool openChannel(bool mono);
+
   uint32_t sampleRate_;
   size_t bufferFrames_;
-  int16_t* stereoBuffer_;  // Internal stereo conversion buffer
+  bool monoSlot_;
+  int16_t* stereoBuffer_;  // Stereo conversion buffer (stereo fallback only)
   i2s_chan_handle_t tx_handle_; // New driver handle
 };
@@ -14,4 +14,6 @@ class IAudioRecorder {
   virtual bool isRecording() const = 0;
   virtual void writeSamples(const int16_t* samples, size_t sampleCount) = 0;
   virtual const std::string& filename() const = 0;
+  // Samples dropped because the writer fell behind (0 for synchronous recorders).
+  virtual std::uint32_t droppedSamples() const { return 0; }
 };
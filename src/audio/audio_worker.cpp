@@ -0,0 +1,103 @@
+#include "audio_worker.h"
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+
+#include "../platform/log.h"
+
+AudioWorker::~AudioWorker() {
+#if !defined(ARDUINO)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.store(false, std::memory_order_release);
+    }
+    wake_.notify_one();
+    if (worker_.joinable()) worker_.join();
+#endif
+}
+
+bool AudioWorker::begin() {
+    if (running_.load(std::memory_order_acquire)) return true;
+    running_.store(true, std::memory_order_release);
+#if defined(ARDUINO)
+    // Same priority as the audio task, on the UI core: a block's drum render
+    // must preempt loop() or the pipeline falls behind.
+    BaseType_t ok = xTaskCreatePinnedToCore(workerTask_, "AudioWorker", 6144, this, 3, &worker_, 0);
+    if (ok != pdPASS) {
+        running_.store(false, std::memory_order_release);
+        worker_ = nullptr;
+        LOG_PRINTLN("[Audio] Worker disabled: task create failed");
+        return false;
+    }
+#else
+    worker_ = std::thread(&AudioWorker::workerLoop_, this);
+#endif
+    return true;
+}
+
+bool AudioWorker::post(Job job, void* ctx) {
+    if (!job || !running_.load(std::memory_order_acquire)) return false;
+    if (busy_.load(std::memory_order_acquire)) return false;
+    job_ = job;
+    ctx_ = ctx;
+#if defined(ARDUINO)
+    waiter_ = xTaskGetCurrentTaskHandle();
+    busy_.store(true, std::memory_order_release);
+    xTaskNotifyGive(worker_);
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        busy_.store(true, std::memory_order_release);
+    }
+    wake_.notify_one();
+#endif
+    return true;
+}
+
+void AudioWorker::wait() {
+#if defined(ARDUINO)
+    // The worker notifies the posting task; anyone else polls once per tick.
+    while (busy_.load(std::memory_order_acquire)) {
+        ulTaskNotifyTake(pdTRUE, 1);
+    }
+#else
+    if (!busy_.load(std::memory_order_acquire)) return;
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return !busy_.load(std::memory_order_acquire); });
+#endif
+}
+
+void AudioWorker::workerLoop_() {
+    while (running_.load(std::memory_order_acquire)) {
+#if defined(ARDUINO)
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!busy_.load(std::memory_order_acquire)) continue;
+        job_(ctx_);
+        TaskHandle_t waiter = waiter_;
+        busy_.store(false, std::memory_order_release);
+        if (waiter) xTaskNotifyGive(waiter);
+#else
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] {
+                return busy_.load(std::memory_order_acquire) || !running_.load(std::memory_order_acquire);
+            });
+        }
+        if (!busy_.load(std::memory_order_acquire)) continue;
+        job_(ctx_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_.store(false, std::memory_order_release);
+        }
+        done_.notify_all();
+#endif
+    }
+}
+
+#if defined(ARDUINO)
+void AudioWorker::workerTask_(void* arg) {
+    static_cast<AudioWorker*>(arg)->workerLoop_();
+    vTaskDelete(nullptr);
+}
+#endif
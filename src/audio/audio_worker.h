@@ -0,0 +1,61 @@
+#ifndef AUDIO_WORKER_H
+#define AUDIO_WORKER_H
+
+#include <atomic>
+#include <stdint.h>
+
+#if defined(ARDUINO)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// Runs one audio job at a time on a second core. The audio thread posts a
+// job, keeps rendering its own share of the block and calls wait() before it
+// touches anything the job uses. The job must not allocate or block.
+//
+// Threading: post() and wait() belong to the audio thread (wait() may also be
+// called by a thread that has just taken the audio role over, e.g. while the
+// platform re-opens the device); the job runs on the worker.
+class AudioWorker {
+public:
+    typedef void (*Job)(void* ctx);
+
+    AudioWorker() = default;
+    ~AudioWorker();
+
+    // Starts the worker (pinned to core 0 on ESP32). Safe to call twice.
+    bool begin();
+    bool running() const { return running_.load(std::memory_order_acquire); }
+
+    // Hands a job to the worker. Returns false (and runs nothing) if the
+    // worker is not running or still busy with the previous job.
+    bool post(Job job, void* ctx);
+
+    // Blocks until the posted job, if any, has finished.
+    void wait();
+    bool busy() const { return busy_.load(std::memory_order_acquire); }
+
+private:
+    void workerLoop_();
+#if defined(ARDUINO)
+    static void workerTask_(void* arg);
+    TaskHandle_t worker_ = nullptr;
+    TaskHandle_t waiter_ = nullptr;
+#else
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+#endif
+
+    Job job_ = nullptr;
+    void* ctx_ = nullptr;
+    std::atomic<bool> busy_{false};
+    std::atomic<bool> running_{false};
+};
+
+#endif // AUDIO_WORKER_H
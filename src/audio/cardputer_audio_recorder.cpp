@@ -4,9 +4,21 @@
 
 #include <cstring>
 #include <M5Cardputer.h>
+#include <esp_heap_caps.h>
 
 namespace {
 
+// The writer only touches the card in whole chunks (except for the final
+// flush). With the header padded to one sector, every data write starts on
+// a sector boundary and FATFS can skip its read-modify-write buffer.
+constexpr std::uint32_t kChunkSamples = 2048;        // 4 KB
+constexpr std::uint32_t kHeaderBytes = 512;
+constexpr std::uint32_t kDataSizeOffset = kHeaderBytes - 4;
+// ~3 s at 22050 Hz mono in PSRAM, ~0.7 s when only internal RAM is left.
+constexpr std::uint32_t kRingSamplesPsram = 65536;
+constexpr std::uint32_t kRingSamplesInternal = 16384;
+constexpr TickType_t kWriterPollTicks = pdMS_TO_TICKS(20);
+
 void writeLE16(std::uint8_t* dst, std::uint16_t value) {
   dst[0] = static_cast<std::uint8_t>(value & 0xFF);
   dst[1] = static_cast<std::uint8_t>((value >> 8) & 0xFF);
@@ -38,12 +50,18 @@ bool CardputerAudioRecorder::start(int sampleRate, int channels) {
     return false;
   }
 
+  if (!allocateRing()) {
+    Serial.println("Recording disabled: no memory for ring buffer");
+    return false;
+  }
+
   filename_ = generateTimestampFilename();
   file_ = SD.open(filename_.c_str(), FILE_WRITE);
   if (!file_) {
     Serial.print("Failed to open file for recording: ");
     Serial.println(filename_.c_str());
     filename_.clear();
+    releaseRing();
     return false;
   }
 
@@ -51,7 +69,27 @@ bool CardputerAudioRecorder::start(int sampleRate, int channels) {
   channels_ = channels;
   dataBytes_ = 0;
   writeHeaderPlaceholder();
-  
+
+  ringHead_.store(0, std::memory_order_relaxed);
+  ringTail_.store(0, std::memory_order_relaxed);
+  dropped_.store(0, std::memory_order_relaxed);
+  stopRequested_.store(false, std::memory_order_relaxed);
+  if (!writerDone_) {
+    writerDone_ = xSemaphoreCreateBinary();
+  }
+  // Below loop() and the page prefetcher: the ring absorbs the slack.
+  if (!writerDone_ ||
+      xTaskCreatePinnedToCore(writerTask, "RecWriter", 4096, this, 1, &writer_, 0) != pdPASS) {
+    writer_ = nullptr;
+    file_.close();
+    SD.remove(filename_.c_str());
+    filename_.clear();
+    releaseRing();
+    Serial.println("Recording disabled: writer task create failed");
+    return false;
+  }
+  accepting_.store(true, std::memory_order_release);
+
   Serial.print("Recording started: ");
   Serial.println(filename_.c_str());
   return true;
@@ -62,26 +100,64 @@ void CardputerAudioRecorder::stop() {
     return;
   }
 
+  // Close the door, then wait out a writeSamples() that got in before it.
+  accepting_.store(false, std::memory_order_seq_cst);
+  while (producers_.load(std::memory_order_seq_cst) != 0) {
+    vTaskDelay(1);
+  }
+
+  stopRequested_.store(true, std::memory_order_release);
+  if (writer_) {
+    xSemaphoreTake(writerDone_, portMAX_DELAY);
+    writer_ = nullptr;
+  }
+
   finalizeHeader();
   file_.close();
   dataBytes_ = 0;
-  
+  releaseRing();
+
   Serial.print("Recording stopped: ");
   Serial.println(filename_.c_str());
+  std::uint32_t dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped) {
+    Serial.printf("Recording dropped %u samples (SD too slow)\n", (unsigned)dropped);
+  }
 }
 
 bool CardputerAudioRecorder::isRecording() const {
-  return file_ ? true : false;
+  return accepting_.load(std::memory_order_acquire);
 }
 
 void CardputerAudioRecorder::writeSamples(const int16_t* samples, size_t sampleCount) {
-  if (!file_ || !samples || sampleCount == 0) {
+  if (!samples || sampleCount == 0 || !accepting_.load(std::memory_order_acquire)) {
     return;
   }
 
-  size_t written = file_.write(reinterpret_cast<const uint8_t*>(samples), 
-                                sampleCount * sizeof(int16_t));
-  dataBytes_ += static_cast<std::uint32_t>(written);
+  producers_.fetch_add(1, std::memory_order_seq_cst);
+  if (accepting_.load(std::memory_order_seq_cst)) {
+    std::uint32_t tail = ringTail_.load(std::memory_order_relaxed);
+    std::uint32_t head = ringHead_.load(std::memory_order_acquire);
+    std::uint32_t count = static_cast<std::uint32_t>(sampleCount);
+    if (count > ringSamples_ - (tail - head)) {
+      // Drop the whole block rather than splice a partial one into the file.
+      dropped_.fetch_add(count, std::memory_order_relaxed);
+    } else {
+      std::uint32_t pos = tail & (ringSamples_ - 1);
+      std::uint32_t first = ringSamples_ - pos;
+      if (first > count) first = count;
+      std::memcpy(ring_ + pos, samples, first * sizeof(int16_t));
+      if (count > first) {
+        std::memcpy(ring_, samples + first, (count - first) * sizeof(int16_t));
+      }
+      ringTail_.store(tail + count, std::memory_order_release);
+    }
+  }
+  producers_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+std::uint32_t CardputerAudioRecorder::droppedSamples() const {
+  return dropped_.load(std::memory_order_relaxed);
 }
 
 const std::string& CardputerAudioRecorder::filename() const {
@@ -101,9 +177,11 @@ std::string CardputerAudioRecorder::generateTimestampFilename() const {
 }
 
 void CardputerAudioRecorder::writeHeaderPlaceholder() {
-  std::uint8_t header[44];
+  // RIFF + fmt (36 bytes), a JUNK chunk, then "data" ending on byte 512.
+  std::uint8_t header[kHeaderBytes];
+  std::memset(header, 0, sizeof(header));
   std::memcpy(header, "RIFF", 4);
-  writeLE32(header + 4, 36 + dataBytes_);
+  writeLE32(header + 4, kHeaderBytes - 8 + dataBytes_);
   std::memcpy(header + 8, "WAVE", 4);
   std::memcpy(header + 12, "fmt ", 4);
   writeLE32(header + 16, 16);
@@ -115,23 +193,84 @@ void CardputerAudioRecorder::writeHeaderPlaceholder() {
   std::uint16_t blockAlign = static_cast<std::uint16_t>(channels_ * sizeof(int16_t));
   writeLE16(header + 32, blockAlign);
   writeLE16(header + 34, 16);
-  std::memcpy(header + 36, "data", 4);
-  writeLE32(header + 40, dataBytes_);
+  std::memcpy(header + 36, "JUNK", 4);
+  writeLE32(header + 40, kHeaderBytes - 36 - 8 - 8);
+  std::memcpy(header + kDataSizeOffset - 4, "data", 4);
+  writeLE32(header + kDataSizeOffset, dataBytes_);
 
   file_.write(header, sizeof(header));
 }
 
 void CardputerAudioRecorder::finalizeHeader() {
   std::uint8_t sizeField[4];
-  writeLE32(sizeField, 36 + dataBytes_);
+  writeLE32(sizeField, kHeaderBytes - 8 + dataBytes_);
   file_.seek(4);
   file_.write(sizeField, sizeof(sizeField));
 
   writeLE32(sizeField, dataBytes_);
-  file_.seek(40);
+  file_.seek(kDataSizeOffset);
   file_.write(sizeField, sizeof(sizeField));
 
   file_.flush();
 }
 
+bool CardputerAudioRecorder::allocateRing() {
+  if (ring_) {
+    return true;
+  }
+  ringSamples_ = kRingSamplesPsram;
+  ring_ = static_cast<int16_t*>(
+      heap_caps_malloc(ringSamples_ * sizeof(int16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!ring_) {
+    ringSamples_ = kRingSamplesInternal;
+    ring_ = static_cast<int16_t*>(
+        heap_caps_malloc(ringSamples_ * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+  }
+  if (!ring_) {
+    ringSamples_ = 0;
+    return false;
+  }
+  return true;
+}
+
+void CardputerAudioRecorder::releaseRing() {
+  heap_caps_free(ring_);
+  ring_ = nullptr;
+  ringSamples_ = 0;
+}
+
+void CardputerAudioRecorder::writerTask(void* arg) {
+  auto* self = static_cast<CardputerAudioRecorder*>(arg);
+  self->writerLoop();
+  xSemaphoreGive(self->writerDone_);
+  vTaskDelete(nullptr);
+}
+
+void CardputerAudioRecorder::writerLoop() {
+  while (true) {
+    // Read the stop flag first so the drain below sees every sample queued
+    // before stop() closed the door.
+    bool stopping = stopRequested_.load(std::memory_order_acquire);
+    std::uint32_t head = ringHead_.load(std::memory_order_relaxed);
+    std::uint32_t avail = ringTail_.load(std::memory_order_acquire) - head;
+
+    if (avail >= kChunkSamples || (stopping && avail > 0)) {
+      // head only moves in whole chunks until the final flush, and the ring
+      // is a multiple of the chunk size, so a chunk never wraps.
+      std::uint32_t pos = head & (ringSamples_ - 1);
+      std::uint32_t count = avail < kChunkSamples ? avail : kChunkSamples;
+      if (count > ringSamples_ - pos) count = ringSamples_ - pos;
+      size_t written = file_.write(reinterpret_cast<const uint8_t*>(ring_ + pos),
+                                   count * sizeof(int16_t));
+      dataBytes_ += static_cast<std::uint32_t>(written);
+      ringHead_.store(head + count, std::memory_order_release);
+      continue;
+    }
+    if (stopping) {
+      break;
+    }
+    vTaskDelay(kWriterPollTicks);
+  }
+}
+
 #endif // ARDUINO
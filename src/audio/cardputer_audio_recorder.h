@@ -5,8 +5,19 @@
 #if defined(ARDUINO)
 #include <SD.h>
 #include <FS.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 
-// Cardputer implementation that streams WAV to SD card
+// Cardputer implementation that streams WAV to SD card.
+//
+// writeSamples() runs on the audio task and only copies into a lock-free
+// ring; a low-priority writer task on core 0 moves it to the card in
+// sector-aligned chunks, so SD latency spikes never reach the audio
+// deadline. If the card falls a full ring behind, whole blocks are dropped
+// and counted (droppedSamples()). start()/stop() belong to the UI thread;
+// stop() drains the ring and then finalizes the WAV header.
 class CardputerAudioRecorder : public IAudioRecorder {
  public:
   CardputerAudioRecorder();
@@ -17,17 +28,33 @@ class CardputerAudioRecorder : public IAudioRecorder {
   bool isRecording() const override;
   void writeSamples(const int16_t* samples, size_t sampleCount) override;
   const std::string& filename() const override;
+  std::uint32_t droppedSamples() const override;
 
  private:
   std::string generateTimestampFilename() const;
   void writeHeaderPlaceholder();
   void finalizeHeader();
+  bool allocateRing();
+  void releaseRing();
+  static void writerTask(void* arg);
+  void writerLoop();
 
   File file_;
   std::string filename_;
-  std::uint32_t dataBytes_ = 0;
+  std::uint32_t dataBytes_ = 0; // writer task while recording
   int sampleRate_ = 0;
   int channels_ = 0;
+
+  int16_t* ring_ = nullptr;
+  std::uint32_t ringSamples_ = 0; // power of two, multiple of the chunk size
+  std::atomic<std::uint32_t> ringHead_{0}; // samples written to the card
+  std::atomic<std::uint32_t> ringTail_{0}; // samples queued by the audio task
+  std::atomic<bool> accepting_{false};
+  std::atomic<int> producers_{0};          // audio task inside writeSamples()
+  std::atomic<bool> stopRequested_{false};
+  std::atomic<std::uint32_t> dropped_{0};
+  TaskHandle_t writer_ = nullptr;
+  SemaphoreHandle_t writerDone_ = nullptr;
 };
 
 #endif // ARDUINO
@@ -0,0 +1,144 @@
+#include "page_prefetcher.h"
+
+#include <new>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <chrono>
+#endif
+
+#include "../platform/log.h"
+
+static constexpr uint32_t kWorkerIdleMs = 5;
+
+PagePrefetcher::~PagePrefetcher() {
+#if !defined(ARDUINO)
+    running_.store(false, std::memory_order_release);
+    if (worker_.joinable()) worker_.join();
+#endif
+}
+
+bool PagePrefetcher::begin() {
+    if (running_.load(std::memory_order_acquire)) return true;
+    if (!shadow_) {
+        shadow_.reset(new (std::nothrow) PatternPage());
+        if (!shadow_) {
+            LOG_PRINTLN("[Page] Prefetch disabled: no memory for shadow page");
+            return false;
+        }
+    }
+    running_.store(true, std::memory_order_release);
+#if defined(ARDUINO)
+    // Low priority on the UI core: SD reads must never compete with the audio task.
+    BaseType_t ok = xTaskCreatePinnedToCore(workerTask_, "PagePrefetch", 6144, this, 1, nullptr, 0);
+    if (ok != pdPASS) {
+        running_.store(false, std::memory_order_release);
+        LOG_PRINTLN("[Page] Prefetch disabled: worker task create failed");
+        return false;
+    }
+#else
+    worker_ = std::thread(&PagePrefetcher::workerLoop_, this);
+#endif
+    return true;
+}
+
+void PagePrefetcher::prefetch(int pageIndex) {
+    if (pageIndex < 0 || pageIndex >= kMaxPages) return;
+    wantedPage_.store(static_cast<int8_t>(pageIndex), std::memory_order_release);
+}
+
+bool PagePrefetcher::isReady(int pageIndex) const {
+    return state_.load(std::memory_order_acquire) == Ready &&
+           shadowPage_.load(std::memory_order_acquire) == pageIndex;
+}
+
+bool PagePrefetcher::trySwapIn(int pageIndex, int residentPage, Scene& scene) {
+    if (!running_.load(std::memory_order_acquire)) return false;
+    if (shadowPage_.load(std::memory_order_acquire) != pageIndex) return false;
+    uint8_t expected = Ready;
+    if (!state_.compare_exchange_strong(expected, Swapping, std::memory_order_acq_rel)) return false;
+    // The worker may have reloaded the shadow between the check and the claim.
+    if (shadowPage_.load(std::memory_order_acquire) != pageIndex) {
+        state_.store(Ready, std::memory_order_release);
+        return false;
+    }
+
+    PatternPagingService::swapWithScene(scene, *shadow_);
+
+    writeBackPage_ = static_cast<int8_t>(residentPage);
+    writeBackHash_ = residentHash_;
+    writeBackHashValid_ = residentHashValid_.load(std::memory_order_acquire);
+    residentHash_ = shadowHash_;
+    residentHashValid_.store(true, std::memory_order_release);
+    shadowPage_.store(-1, std::memory_order_release);
+
+    int8_t wanted = static_cast<int8_t>(pageIndex);
+    wantedPage_.compare_exchange_strong(wanted, -1, std::memory_order_acq_rel);
+    state_.store(Saving, std::memory_order_release);
+    return true;
+}
+
+void PagePrefetcher::invalidate() {
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    wantedPage_.store(-1, std::memory_order_release);
+    residentHashValid_.store(false, std::memory_order_release);
+    uint8_t expected = Ready;
+    state_.compare_exchange_strong(expected, Idle, std::memory_order_acq_rel);
+}
+
+// One unit of worker work. Returns false when there was nothing to do.
+bool PagePrefetcher::step_() {
+    uint8_t state = state_.load(std::memory_order_acquire);
+
+    if (state == Saving) {
+        uint32_t gen = generation_.load(std::memory_order_acquire);
+        uint32_t hash = PatternPagingService::checksum(*shadow_);
+        if (!writeBackHashValid_ || hash != writeBackHash_) {
+            if (!PatternPagingService::savePage(writeBackPage_, *shadow_)) {
+                LOG_DEBUG("[Page] Write-back of page %d failed\n", (int)writeBackPage_);
+            }
+        }
+        // The shadow now mirrors that page, so switching straight back needs no reload.
+        shadowHash_ = hash;
+        shadowPage_.store(writeBackPage_, std::memory_order_release);
+        bool current = gen == generation_.load(std::memory_order_acquire);
+        state_.store(current ? Ready : Idle, std::memory_order_release);
+        return true;
+    }
+
+    int wanted = wantedPage_.load(std::memory_order_acquire);
+    if (wanted < 0) return false;
+    if (state != Idle && state != Ready) return false;
+    if (state == Ready && shadowPage_.load(std::memory_order_acquire) == wanted) return false;
+    if (!state_.compare_exchange_strong(state, Loading, std::memory_order_acq_rel)) return true;
+
+    uint32_t gen = generation_.load(std::memory_order_acquire);
+    PatternPagingService::loadPage(wanted, *shadow_);
+    shadowHash_ = PatternPagingService::checksum(*shadow_);
+    shadowPage_.store(static_cast<int8_t>(wanted), std::memory_order_release);
+    bool current = gen == generation_.load(std::memory_order_acquire);
+    state_.store(current ? Ready : Idle, std::memory_order_release);
+    return true;
+}
+
+void PagePrefetcher::workerLoop_() {
+    while (running_.load(std::memory_order_acquire)) {
+        if (!step_()) {
+#if defined(ARDUINO)
+            vTaskDelay(pdMS_TO_TICKS(kWorkerIdleMs));
+#else
+            std::this_thread::sleep_for(std::chrono::milliseconds(kWorkerIdleMs));
+#endif
+        }
+    }
+}
+
+#if defined(ARDUINO)
+void PagePrefetcher::workerTask_(void* arg) {
+    static_cast<PagePrefetcher*>(arg)->workerLoop_();
+    vTaskDelete(nullptr);
+}
+#endif
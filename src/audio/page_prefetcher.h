@@ -0,0 +1,74 @@
+#ifndef PAGE_PREFETCHER_H
+#define PAGE_PREFETCHER_H
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+#if !defined(ARDUINO)
+#include <thread>
+#endif
+
+#include "pattern_paging.h"
+
+// Loads pattern pages from SD into a shadow PatternPage on a background
+// worker, so a page switch becomes an in-memory swap instead of blocking on
+// file I/O. The page swapped out takes the shadow's place and is written back
+// by the worker, skipped when it is unchanged since it was loaded.
+//
+// Threading: prefetch() and invalidate() may be called from any thread;
+// trySwapIn() must only be called from the thread that edits the scene's
+// banks (the UI thread), since it rewrites them in place. The shadow buffer
+// is owned by whoever holds the current state, so no locks are taken.
+class PagePrefetcher {
+public:
+    PagePrefetcher() = default;
+    ~PagePrefetcher();
+
+    // Allocates the shadow page and starts the worker. Safe to call twice.
+    bool begin();
+
+    // Asks the worker to load pageIndex into the shadow. Non-blocking.
+    void prefetch(int pageIndex);
+
+    // If pageIndex is loaded, swaps it into the scene and queues the
+    // outgoing residentPage for write-back. Returns false if not ready yet.
+    bool trySwapIn(int pageIndex, int residentPage, Scene& scene);
+
+    // Drops any prefetched data, e.g. after a scene load replaced the banks
+    // or page files were rewritten behind our back.
+    void invalidate();
+
+    bool isReady(int pageIndex) const;
+    bool running() const { return running_.load(std::memory_order_acquire); }
+
+private:
+    enum State : uint8_t { Idle = 0, Loading, Ready, Swapping, Saving };
+
+    bool step_();
+    void workerLoop_();
+#if defined(ARDUINO)
+    static void workerTask_(void* arg);
+#endif
+
+    std::unique_ptr<PatternPage> shadow_;
+    std::atomic<uint8_t> state_{Idle};
+    std::atomic<int8_t> wantedPage_{-1};
+    std::atomic<uint32_t> generation_{0};
+    std::atomic<bool> residentHashValid_{false};
+
+    // Written by the owner of the current state before handing it over.
+    std::atomic<int8_t> shadowPage_{-1};
+    uint32_t shadowHash_ = 0;
+    uint32_t residentHash_ = 0;
+    int8_t writeBackPage_ = -1;
+    uint32_t writeBackHash_ = 0;
+    bool writeBackHashValid_ = false;
+
+    std::atomic<bool> running_{false};
+#if !defined(ARDUINO)
+    std::thread worker_;
+#endif
+};
+
+#endif // PAGE_PREFETCHER_H
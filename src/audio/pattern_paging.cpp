@@ -30,7 +30,14 @@ std::string PatternPagingService::getDrumsPath(int pageIndex) {
     return std::string(buf);
 }
 
-bool PatternPagingService::savePage(int pageIndex, const Scene& scene) {
+static constexpr size_t kSynthBanksSize = sizeof(PatternPage::synthABanks);
+static constexpr size_t kDrumBanksSize = sizeof(PatternPage::drumBanks);
+
+static_assert(sizeof(Scene::synthABanks) == kSynthBanksSize, "PatternPage must mirror Scene banks");
+static_assert(sizeof(Scene::synthBBanks) == kSynthBanksSize, "PatternPage must mirror Scene banks");
+static_assert(sizeof(Scene::drumBanks) == kDrumBanksSize, "PatternPage must mirror Scene banks");
+
+bool PatternPagingService::saveBanks(int pageIndex, const void* synthA, const void* synthB, const void* drums) {
     if (!ensureDirectory()) return false;
 
     auto saveFile = [&](const std::string& path, const void* data, size_t size) {
@@ -44,14 +51,14 @@ bool PatternPagingService::savePage(int pageIndex, const Scene& scene) {
     };
 
     bool ok = true;
-    ok &= saveFile(getSynthAPath(pageIndex), &scene.synthABanks, sizeof(scene.synthABanks));
-    ok &= saveFile(getSynthBPath(pageIndex), &scene.synthBBanks, sizeof(scene.synthBBanks));
-    ok &= saveFile(getDrumsPath(pageIndex), &scene.drumBanks, sizeof(scene.drumBanks));
+    ok &= saveFile(getSynthAPath(pageIndex), synthA, kSynthBanksSize);
+    ok &= saveFile(getSynthBPath(pageIndex), synthB, kSynthBanksSize);
+    ok &= saveFile(getDrumsPath(pageIndex), drums, kDrumBanksSize);
 
     return ok;
 }
 
-bool PatternPagingService::loadPage(int pageIndex, Scene& scene) {
+bool PatternPagingService::loadBanks(int pageIndex, void* synthA, void* synthB, void* drums) {
     auto loadFile = [&](const std::string& path, void* data, size_t size) {
         if (!SD.exists(path.c_str())) return false;
         File f = SD.open(path.c_str(), FILE_READ);
@@ -78,18 +85,65 @@ bool PatternPagingService::loadPage(int pageIndex, Scene& scene) {
     // If files don't exist, we just leave the current patterns or clear them?
     // The plan says "load requested page, or clear if missing".
     
-    if (!loadFile(getSynthAPath(pageIndex), &scene.synthABanks, sizeof(scene.synthABanks))) {
-        memset(&scene.synthABanks, 0, sizeof(scene.synthABanks));
+    if (!loadFile(getSynthAPath(pageIndex), synthA, kSynthBanksSize)) {
+        memset(synthA, 0, kSynthBanksSize);
         ok = false;
     }
-    if (!loadFile(getSynthBPath(pageIndex), &scene.synthBBanks, sizeof(scene.synthBBanks))) {
-        memset(&scene.synthBBanks, 0, sizeof(scene.synthBBanks));
+    if (!loadFile(getSynthBPath(pageIndex), synthB, kSynthBanksSize)) {
+        memset(synthB, 0, kSynthBanksSize);
         ok = false;
     }
-    if (!loadFile(getDrumsPath(pageIndex), &scene.drumBanks, sizeof(scene.drumBanks))) {
-        memset(&scene.drumBanks, 0, sizeof(scene.drumBanks));
+    if (!loadFile(getDrumsPath(pageIndex), drums, kDrumBanksSize)) {
+        memset(drums, 0, kDrumBanksSize);
         ok = false;
     }
 
     return ok;
 }
+
+bool PatternPagingService::savePage(int pageIndex, const Scene& scene) {
+    return saveBanks(pageIndex, &scene.synthABanks, &scene.synthBBanks, &scene.drumBanks);
+}
+
+bool PatternPagingService::loadPage(int pageIndex, Scene& scene) {
+    return loadBanks(pageIndex, &scene.synthABanks, &scene.synthBBanks, &scene.drumBanks);
+}
+
+bool PatternPagingService::savePage(int pageIndex, const PatternPage& page) {
+    return saveBanks(pageIndex, &page.synthABanks, &page.synthBBanks, &page.drumBanks);
+}
+
+bool PatternPagingService::loadPage(int pageIndex, PatternPage& page) {
+    return loadBanks(pageIndex, &page.synthABanks, &page.synthBBanks, &page.drumBanks);
+}
+
+static void swapBytes(void* a, void* b, size_t size) {
+    uint8_t* pa = static_cast<uint8_t*>(a);
+    uint8_t* pb = static_cast<uint8_t*>(b);
+    uint8_t tmp[64];
+    while (size > 0) {
+        size_t n = size < sizeof(tmp) ? size : sizeof(tmp);
+        memcpy(tmp, pa, n);
+        memcpy(pa, pb, n);
+        memcpy(pb, tmp, n);
+        pa += n;
+        pb += n;
+        size -= n;
+    }
+}
+
+void PatternPagingService::swapWithScene(Scene& scene, PatternPage& page) {
+    swapBytes(&scene.synthABanks, &page.synthABanks, kSynthBanksSize);
+    swapBytes(&scene.synthBBanks, &page.synthBBanks, kSynthBanksSize);
+    swapBytes(&scene.drumBanks, &page.drumBanks, kDrumBanksSize);
+}
+
+uint32_t PatternPagingService::checksum(const PatternPage& page) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&page);
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < sizeof(PatternPage); ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
@@ -4,13 +4,30 @@
 #include <string>
 #include "../../scenes.h"
 
+// The paged part of a Scene: one page worth of pattern banks, laid out like
+// the matching Scene members so it can be saved, loaded or swapped in place.
+struct PatternPage {
+    Bank<DrumPatternSet> drumBanks[kBankCount];
+    Bank<SynthPattern> synthABanks[kBankCount];
+    Bank<SynthPattern> synthBBanks[kBankCount];
+};
+
 class PatternPagingService {
 public:
     static bool savePage(int pageIndex, const Scene& scene);
     static bool loadPage(int pageIndex, Scene& scene);
+    static bool savePage(int pageIndex, const PatternPage& page);
+    static bool loadPage(int pageIndex, PatternPage& page);
     static bool ensureDirectory();
 
+    // Exchanges the scene's banks with the page's, without heap or large stack use.
+    static void swapWithScene(Scene& scene, PatternPage& page);
+    // FNV-1a over the page contents, used to skip writing back unchanged pages.
+    static uint32_t checksum(const PatternPage& page);
+
 private:
+    static bool saveBanks(int pageIndex, const void* synthA, const void* synthB, const void* drums);
+    static bool loadBanks(int pageIndex, void* synthA, void* synthB, void* drums);
     static std::string getSynthAPath(int pageIndex);
     static std::string getSynthBPath(int pageIndex);
     static std::string getDrumsPath(int pageIndex);
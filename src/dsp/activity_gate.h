@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Sleep tracking for an FX chain. The chain runs while its input is live and
+// for tailSamples after the input goes quiet (delay repeats, reverb decay,
+// filter ring-out); after that it can be skipped until the input wakes it
+// again. Fed once per rendered segment; audio thread only.
+class ActivityGate {
+public:
+  // Returns true when the chain must run for this segment. The segment that
+  // exhausts the tail still runs and raises justSlept() so the caller can
+  // clear the chain's state before it sleeps.
+  bool update(bool inputLive, size_t n, uint32_t tailSamples) {
+    justSlept_ = false;
+    if (inputLive) {
+      tail_ = tailSamples;
+      awake_ = true;
+      return true;
+    }
+    if (!awake_) return false;
+    if (tail_ > n) {
+      tail_ -= static_cast<uint32_t>(n);
+      return true;
+    }
+    tail_ = 0;
+    awake_ = false;
+    justSlept_ = true;
+    return true;
+  }
+
+  void reset() {
+    tail_ = 0;
+    awake_ = false;
+    justSlept_ = false;
+  }
+
+  bool awake() const { return awake_; }
+  bool justSlept() const { return justSlept_; }
+
+private:
+  uint32_t tail_ = 0;
+  bool awake_ = false;
+  bool justSlept_ = false;
+};
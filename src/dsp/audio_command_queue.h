@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Mutations posted by the UI thread and applied by the audio thread at the top
+// of generateAudioBuffer. Each entry mirrors one public MiniAcid setter.
+// Transport and song edits come first: the producer never gives up on those
+// while the audio thread is draining (MiniAcid::pushCommand_).
+enum class AudioCommandType : uint8_t {
+  Start = 0,
+  Stop,
+  SetBpm,              // value = bpm
+  SetSongMode,         // a = enabled
+  ToggleSongMode,
+  SetLoopMode,         // a = enabled
+  SetSongPosition,     // a = position
+  SetLiveMixMode,      // a = enabled
+  ToggleLiveMixMode,
+  SetLoopRange,        // a = start row, b = end row
+  SetSongLength,       // a = length
+  SetSongPattern,      // a = position, b = SongTrack, value = pattern index
+  ClearSongPattern,    // a = position, b = SongTrack
+  SetActiveSongSlot,   // a = slot
+  SetSongPlaybackSlot, // a = slot
+  ReplaceSong,         // a = slot, ptr = new Song (ownership moves)
+  InsertSongRow,       // a = position
+  DeleteSongRow,       // a = position
+  SetSongReverse,      // a = reverse
+  QueueSongReverseToggle,
+  SetSynthEngine,      // a = voice, b = SynthEngineType
+  SetDrumEngine,       // b = engine index (kit is pre-built in the pool)
+  ToggleMute,          // a = track (isTrackActive numbering)
+  SetMute303,          // a = voice, b = muted
+  SetTrackVolume,      // a = VoiceId, value = volume
+  ToggleDelay303,      // a = voice
+  ToggleDistortion303, // a = voice
+  Set303Delay,         // a = voice, b = enabled
+  Set303Distortion,    // a = voice, b = enabled
+  SetDrumPatternIndex, // a = pattern
+  ShiftDrumPatternIndex, // a = delta
+  SetDrumBankIndex,    // a = bank
+  Set303PatternIndex,  // a = voice, b = pattern
+  Shift303PatternIndex, // a = voice, b = delta
+  Set303BankIndex,     // a = voice, b = bank
+  Adjust303Parameter,  // a = voice, b = TB303ParamId, value = steps
+  Set303Parameter,     // a = voice, b = TB303ParamId, value
+  Set303ParameterNormalized, // a = voice, b = TB303ParamId, value = 0..1
+  AdjustSynthParameter, // a = voice, b = knob, value = steps
+  DrumCompression,     // value
+  DrumTransientAttack, // value
+  DrumTransientSustain, // value
+  DrumReverbMix,       // value
+  DrumReverbDecay,     // value
+  SetGrooveboxMode,    // a = GrooveboxMode
+  ToggleGrooveboxMode,
+  SetGrooveFlavor,     // a = flavor
+  ShiftGrooveFlavor,   // a = delta
+  SetParameter,        // a = MiniAcidParamId, value
+  AdjustParameter,     // a = MiniAcidParamId, b = steps
+  SetTestTone,         // a = enabled
+  SetVoiceTrackMute,   // a = muted
+  ToggleVoiceTrackMute,
+  SetTapeMode,         // a = TapeMode, b = dub auto-exit
+  ClearTapeLoop,
+  EjectTape,
+  ToggleTapeStutter,
+  StageGenrePatterns,  // ptr = new GenreStage (ownership moves), applied at the next bar
+};
+
+struct AudioCommand {
+  AudioCommandType type = AudioCommandType::Start;
+  int16_t a = 0;
+  int16_t b = 0;
+  float value = 0.0f;
+  void* ptr = nullptr;
+};
+
+// Wait-free single-producer/single-consumer ring. N must be a power of two.
+// push() is called from exactly one thread and pop() from exactly one other;
+// neither ever blocks or allocates.
+template <typename T, uint32_t N>
+class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+  bool push(const T& item) {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    uint32_t head = head_.load(std::memory_order_acquire);
+    if (tail - head == N) return false;
+    slots_[tail & (N - 1)] = item;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& out) {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    uint32_t tail = tail_.load(std::memory_order_acquire);
+    if (head == tail) return false;
+    out = slots_[head & (N - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Items popped so far; lets a producer tell a slow consumer from a stalled one.
+  uint32_t popCount() const { return head_.load(std::memory_order_acquire); }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+private:
+  T slots_[N];
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+};
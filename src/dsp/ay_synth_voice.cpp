@@ -85,63 +85,85 @@ float AySynthVoice::genNoise() {
 }
 
 float AySynthVoice::process() {
-  if (!gate_ && env_ <= 0.0001f) return 0.0f;
+  float out = 0.0f;
+  processBlock(&out, 1);
+  return out;
+}
+
+void AySynthVoice::processBlock(float* out, size_t n) {
+  if (!out || n == 0) return;
+  if (!gate_ && env_ <= 0.0001f) {
+    std::fill(out, out + n, 0.0f);
+    return;
+  }
 
+  // Parameters only change between blocks, so derive rates and envelope
+  // coefficients once instead of per sample.
   const float chorus = params_[2].value();
   const float detune = chorus * 0.018f;
   const float aHz = freqHz_;
   const float bHz = freqHz_ * (1.0f + detune);
   const float cHz = freqHz_ * (0.5f - detune * 0.25f);
-
-  phaseA_ = nextPhase(phaseA_, aHz);
-  phaseB_ = nextPhase(phaseB_, bHz);
-  phaseC_ = nextPhase(phaseC_, cHz);
-
-  const float osc = (square(phaseA_) + 0.65f * square(phaseB_) + 0.45f * square(phaseC_)) * (1.0f / 2.1f);
-  const float noise = genNoise();
-
   const float noiseMix = params_[0].value();
-  float mixed = osc * (1.0f - noiseMix) + noise * (noiseMix * 0.85f);
 
   const int envShape = params_[3].optionIndex();
   const float decayMs = params_[1].value();
   float coef = expDecayCoef(sampleRate_, decayMs);
-
   if (envShape == 2) {
     coef = expDecayCoef(sampleRate_, decayMs * 0.35f);  // Pluck
   } else if (envShape == 3) {
     coef = gate_ ? expDecayCoef(sampleRate_, 4000.0f) : expDecayCoef(sampleRate_, 35.0f); // Gate-like
   }
+  const bool hold = (envShape == 0 && gate_);
+  const float slewRate = 1000.0f / sampleRate_;
 
-  if (envShape == 0 && gate_) {
-    env_ = 1.0f; // Hold
-  } else {
-    env_ *= coef;
+  float modeGain = 1.0f;
+  if (mode_ == GrooveboxMode::Dub) {
+    modeGain = 0.9f;
+  } else if (mode_ == GrooveboxMode::Electro) {
+    modeGain = 1.05f;
   }
-  if (!gate_ && env_ < 0.0001f) env_ = 0.0f;
+  const bool crunch = loFiAmount_ > 0.001f;
+  const float levels = 128.0f - loFiAmount_ * 96.0f;
 
-  // AY volume is quantized (4-bit style).
-  const float v4 = std::floor(env_ * 15.0f + 0.5f) * (1.0f / 15.0f);
-  
-  // 1-2ms anti-click smoothing on the quantized amplitude step
-  const float targetAmp = v4 * velocityGain_ * 0.30f;
-  ampSlew_ += (targetAmp - ampSlew_) * (1000.0f / sampleRate_);
+  for (size_t i = 0; i < n; ++i) {
+    if (!gate_ && env_ <= 0.0001f) {
+      out[i] = 0.0f;
+      continue;
+    }
 
-  float out = mixed * ampSlew_;
+    phaseA_ = nextPhase(phaseA_, aHz);
+    phaseB_ = nextPhase(phaseB_, bHz);
+    phaseC_ = nextPhase(phaseC_, cHz);
 
-  // Optional light extra crunch from global lo-fi amount.
-  if (loFiAmount_ > 0.001f) {
-    const float levels = 128.0f - loFiAmount_ * 96.0f;
-    out = std::floor(out * levels + 0.5f) / levels;
-  }
+    const float osc = (square(phaseA_) + 0.65f * square(phaseB_) + 0.45f * square(phaseC_)) * (1.0f / 2.1f);
+    const float noise = genNoise();
 
-  if (mode_ == GrooveboxMode::Dub) {
-    out *= 0.9f;
-  } else if (mode_ == GrooveboxMode::Electro) {
-    out *= 1.05f;
-  }
+    float mixed = osc * (1.0f - noiseMix) + noise * (noiseMix * 0.85f);
 
-  return out;
+    if (hold) {
+      env_ = 1.0f; // Hold
+    } else {
+      env_ *= coef;
+    }
+    if (!gate_ && env_ < 0.0001f) env_ = 0.0f;
+
+    // AY volume is quantized (4-bit style).
+    const float v4 = std::floor(env_ * 15.0f + 0.5f) * (1.0f / 15.0f);
+
+    // 1-2ms anti-click smoothing on the quantized amplitude step
+    const float targetAmp = v4 * velocityGain_ * 0.30f;
+    ampSlew_ += (targetAmp - ampSlew_) * slewRate;
+
+    float sample = mixed * ampSlew_;
+
+    // Optional light extra crunch from global lo-fi amount.
+    if (crunch) {
+      sample = std::floor(sample * levels + 0.5f) / levels;
+    }
+
+    out[i] = sample * modeGain;
+  }
 }
 
 void AySynthVoice::setParameterNormalized(uint8_t index, float norm) {
@@ -14,6 +14,8 @@ public:
   void startNote(float freqHz, bool accent, bool slideFlag, uint8_t velocity = 100) override;
   void release() override;
   float process() override;
+  void processBlock(float* out, size_t n) override;
+  bool isIdle() const override { return !gate_ && env_ <= 0.0001f; }
 
   uint8_t parameterCount() const override { return 4; }
   void setParameterNormalized(uint8_t index, float norm) override;
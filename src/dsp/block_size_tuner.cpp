@@ -0,0 +1,58 @@
+#include "block_size_tuner.h"
+
+#include "../audio/audio_config.h"
+
+namespace {
+constexpr float kTargetLoad = 0.70f;     // stay under this; below the governor's 0.85 escalation
+constexpr float kShrinkLoad = 0.55f;     // only try a smaller block with this much headroom
+constexpr float kLoadSmoothing = 0.1f;   // EMA weight of the newest block
+constexpr float kProbeUs = 1500000.0f;   // audio time a size must survive before shrinking
+constexpr float kSettleUs = 200000.0f;   // ignore load until the EMA has settled after a switch
+} // namespace
+
+void BlockSizeTuner::reset(uint32_t blockFrames) {
+  frames_ = blockFrames;
+  failedFrames_ = 0;
+  load_ = 0.0f;
+  probeUs_ = 0.0f;
+  settled_ = false;
+}
+
+void BlockSizeTuner::step(uint32_t frames) {
+  frames_ = frames;
+  load_ = 0.0f;
+  probeUs_ = 0.0f;
+}
+
+uint32_t BlockSizeTuner::update(uint32_t runningFrames, uint32_t dspUs, float budgetUs,
+                                bool underrun, bool degraded) {
+  if (budgetUs <= 0.0f || frames_ == 0) return frames_;
+  // The last step is still waiting for the platform; these blocks say nothing about it.
+  if (runningFrames != frames_) return frames_;
+
+  const float load = static_cast<float>(dspUs) / budgetUs;
+  load_ = (probeUs_ == 0.0f) ? load : load_ + kLoadSmoothing * (load - load_);
+  probeUs_ += budgetUs;
+
+  // The switch itself can underrun, and the governor needs a while to climb
+  // back to Full; only a size that has settled is blamed.
+  if (probeUs_ < kSettleUs) return frames_;
+
+  if (underrun || degraded || load_ > kTargetLoad) {
+    // This size does not hold for the scene: back off and never retry it.
+    if (frames_ > failedFrames_) failedFrames_ = frames_;
+    if (frames_ < kMaxBlockFrames) step(frames_ * 2);
+    settled_ = true;
+    return frames_;
+  }
+
+  if (!settled_ && probeUs_ >= kProbeUs) {
+    const uint32_t smaller = frames_ / 2;
+    if (smaller >= kMinBlockFrames && smaller > failedFrames_ && load_ < kShrinkLoad) {
+      step(smaller);
+    } else {
+      settled_ = true;
+    }
+  }
+  return frames_;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+// Searches for the smallest block size that keeps the engine under a target
+// load for the current scene. Starts from the configured size, halves it
+// after each probe window that stays comfortably under target, and doubles
+// it back (remembering the failure) on an underrun, a quality-tier drop or a
+// sustained overload. A new size is judged only once the platform runs at it
+// and the settle window has passed, so one bad stretch backs off one step.
+// Fed once per audio block; audio thread only.
+class BlockSizeTuner {
+public:
+  // Restart the search from blockFrames (new scene, new sample rate, ...).
+  void reset(uint32_t blockFrames);
+
+  // runningFrames: the block size the platform is applying now. dspUs: this
+  // block's DSP time. degraded: the quality governor has left Full.
+  // Returns the block size the engine should run at; differs from the current
+  // size when the tuner wants the platform to switch.
+  uint32_t update(uint32_t runningFrames, uint32_t dspUs, float budgetUs, bool underrun,
+                  bool degraded);
+
+  uint32_t blockFrames() const { return frames_; }
+  bool settled() const { return settled_; }
+
+private:
+  void step(uint32_t frames);
+
+  uint32_t frames_ = 0;
+  uint32_t failedFrames_ = 0; // largest size seen to fail; never probe at or below it
+  float load_ = 0.0f;         // EMA of DSP time / budget
+  float probeUs_ = 0.0f;      // audio time covered by the current probe window
+  bool settled_ = false;
+};
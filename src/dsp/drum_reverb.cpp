@@ -95,18 +95,38 @@ void DrumReverb::reset() {
     allpass_[i].reset();
   }
   predelay_.reset();
+  halfPhase_ = false;
+  halfInput_ = 0.0f;
+  halfWet_ = 0.0f;
 }
 
 void DrumReverb::setSampleRate(float sr) {
   if (sr <= 0.0f) return;
   sampleRate_ = sr;
-  inputHpf_.setCutoff(3000.0f, sampleRate_);
-  outputHpf_.setCutoff(2000.0f, sampleRate_);
-  outputLpf_.setCutoff(12000.0f, sampleRate_);
+  updateFilters();
   updateDecay();
   updateMix();
 }
 
+void DrumReverb::setHalfRate(bool enabled) {
+  if (enabled == halfRate_) return;
+  halfRate_ = enabled;
+  halfPhase_ = false;
+  halfInput_ = 0.0f;
+  halfWet_ = 0.0f;
+  // Delay lengths stay in samples, so feedback and filters are re-derived for
+  // the tank rate to keep RT60 and tone roughly where they were.
+  updateFilters();
+  updateDecay();
+}
+
+void DrumReverb::updateFilters() {
+  const float rate = tankRate();
+  inputHpf_.setCutoff(3000.0f, rate);
+  outputHpf_.setCutoff(2000.0f, rate);
+  outputLpf_.setCutoff(12000.0f, rate);
+}
+
 void DrumReverb::setMix(float mix) {
   mix_ = clampf(mix, 0.0f, 1.0f);
   updateMix();
@@ -129,13 +149,14 @@ void DrumReverb::updateDecay() {
   float shaped = std::pow(decay_, 2.5f);
   float rt60 = 0.03f + (15.0f - 0.03f) * shaped;
   if (rt60 < 0.02f) rt60 = 0.02f;
+  rt60_ = rt60;
   for (int i = 0; i < 4; ++i) {
-    float delaySeconds = static_cast<float>(combDelay_[i].size()) / sampleRate_;
+    float delaySeconds = static_cast<float>(combDelay_[i].size()) / tankRate();
     combFeedback_[i] = std::pow(10.0f, -3.0f * delaySeconds / rt60);
   }
   float dampCutoff = 12000.0f + (5500.0f - 12000.0f) * decay_;
   for (int i = 0; i < 4; ++i) {
-    combDamp_[i].setCutoff(dampCutoff, sampleRate_);
+    combDamp_[i].setCutoff(dampCutoff, tankRate());
   }
   allpassK_ = 0.65f + (0.75f - 0.65f) * decay_;
 }
@@ -144,7 +165,24 @@ float DrumReverb::process(float input) {
   if (wet_ <= 0.0001f) {
     return input;
   }
+  if (!halfRate_) {
+    return dry_ * input + wet_ * processTank(input);
+  }
 
+  // Half rate: the tank sees the average of each input pair; the held output
+  // is linearly interpolated across the pair (one sample of extra latency).
+  if (!halfPhase_) {
+    halfPhase_ = true;
+    halfInput_ = input;
+    return dry_ * input + wet_ * halfWet_;
+  }
+  halfPhase_ = false;
+  const float prevWet = halfWet_;
+  halfWet_ = processTank((halfInput_ + input) * 0.5f);
+  return dry_ * input + wet_ * 0.5f * (prevWet + halfWet_);
+}
+
+float DrumReverb::processTank(float input) {
   float hf = inputHpf_.process(input);
   float revIn = hf;
   if (hasPredelay_) {
@@ -171,7 +209,21 @@ float DrumReverb::process(float input) {
   wet = outputLpf_.process(wet);
 
   // Boost wet signal so decay changes are clearly audible.
-  float wet_amplified = wet * 3.0f;
+  return wet * 3.0f;
+}
+
+uint32_t DrumReverb::tailSamples() const {
+  if (wet_ <= 0.0001f) return 0;
+  // RT60 scaled to -100 dB, plus the predelay (doubled at half rate).
+  const float decaySamples = rt60_ * (100.0f / 60.0f) * sampleRate_;
+  return static_cast<uint32_t>(decaySamples) + 2u * kPredelaySamples;
+}
 
-  return dry_ * input + (wet_ * wet_amplified);
+void DrumReverb::processBlock(float* buf, size_t n) {
+  if (wet_ <= 0.0001f) {
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    buf[i] = process(buf[i]);
+  }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 class DrumReverb {
@@ -11,8 +12,15 @@ public:
   void setSampleRate(float sr);
   void setMix(float mix);
   void setDecay(float decay);
+  // Economy mode: run the tank at half the sample rate on a 2:1 decimated
+  // input, with the wet output interpolated back up. Roughly halves the cost.
+  void setHalfRate(bool enabled);
+  bool halfRate() const { return halfRate_; }
 
   float process(float input);
+  void processBlock(float* buf, size_t n);
+  // Samples until the tank has decayed by 100 dB (0 while bypassed).
+  uint32_t tailSamples() const;
 
 private:
   struct OnePoleLP {
@@ -71,6 +79,9 @@ private:
 
   void updateMix();
   void updateDecay();
+  void updateFilters();
+  float tankRate() const { return halfRate_ ? sampleRate_ * 0.5f : sampleRate_; }
+  float processTank(float input);
 
   static constexpr int kCombDelaySamples[4] = {326, 392, 465, 529};
   static constexpr int kAllpassDelaySamples[2] = {52, 79};
@@ -82,6 +93,7 @@ private:
   float sampleRate_ = 44100.0f;
   float mix_ = 0.0f;
   float decay_ = 0.3f;
+  float rt60_ = 0.0f;
   float wet_ = 0.0f;
   float dry_ = 1.0f;
   float combFeedback_[4] = {0.0f, 0.0f, 0.0f, 0.0f};
@@ -94,5 +106,9 @@ private:
   OnePoleLP outputLpf_;
   DelayLine predelay_;
   bool hasPredelay_ = true;
+  bool halfRate_ = false;
+  bool halfPhase_ = false;  // true when one input of the current pair is held
+  float halfInput_ = 0.0f;
+  float halfWet_ = 0.0f;    // last tank output
   std::array<int16_t, kTotalDelaySamples> delayMemory_{};
 };
@@ -23,57 +23,109 @@ void ChamberlinFilter::setSampleRate(float sr) {
   _sampleRate = sr;
 }
 
-float ChamberlinFilter::process(float input, float cutoffHz, float resonance) {
-  float f = 2.0f * sinf(3.14159265f * cutoffHz / _sampleRate);
-  if (!isfinite(f))
-    f = 0.0f;
-  float q = 1.0f / (1.0f + resonance * 4.0f);
-  if (q < 0.06f)
-    q = 0.06f;
-
-  float hp = input - _lp - q * _bp;
-  _bp += f * hp;
-  _lp += f * _bp;
-
-  _bp = fastSaturate(_bp * 1.3f);
+FilterCoeffs ChamberlinFilter::coeffs(float cutoffHz, float resonance) const {
+  FilterCoeffs c;
+  c.f = 2.0f * sinf(3.14159265f * cutoffHz / _sampleRate);
+  if (!isfinite(c.f))
+    c.f = 0.0f;
+  // k is the damping term (1/Q).
+  c.k = 1.0f / (1.0f + resonance * 4.0f);
+  if (c.k < 0.06f)
+    c.k = 0.06f;
+  return c;
+}
 
+void ChamberlinFilter::processRamp(float* buf, size_t n, FilterCoeffs& c, const FilterCoeffs& step) {
   // Keep states bounded to avoid numeric blowups
   const float kStateLimit = 50.0f;
-  if (_lp > kStateLimit) _lp = kStateLimit;
-  if (_lp < -kStateLimit) _lp = -kStateLimit;
-  if (_bp > kStateLimit) _bp = kStateLimit;
-  if (_bp < -kStateLimit) _bp = -kStateLimit;
+  float f = c.f;
+  float q = c.k;
+  float lp = _lp;
+  float bp = _bp;
+  for (size_t i = 0; i < n; ++i) {
+    f += step.f;
+    q += step.k;
+
+    float hp = buf[i] - lp - q * bp;
+    bp += f * hp;
+    lp += f * bp;
+
+    bp = fastSaturate(bp * 1.3f);
 
-  return _lp;
+    if (lp > kStateLimit) lp = kStateLimit;
+    if (lp < -kStateLimit) lp = -kStateLimit;
+    if (bp > kStateLimit) bp = kStateLimit;
+    if (bp < -kStateLimit) bp = -kStateLimit;
+
+    buf[i] = lp;
+  }
+  _lp = lp;
+  _bp = bp;
+  c.f = f;
+  c.k = q;
 }
 
 // === DIODE FILTER (Classic Acid) ===
 DiodeFilter::DiodeFilter(float sampleRate) : _sampleRate(sampleRate) { reset(); }
 void DiodeFilter::reset() { for (int i=0; i<4; ++i) _s[i] = 0; }
 void DiodeFilter::setSampleRate(float sr) { _sampleRate = sr; }
-float DiodeFilter::process(float input, float cutoffHz, float resonance) {
-  float f = (cutoffHz * 2.0f) / _sampleRate;
-  if (f > 0.95f) f = 0.95f;
-  float k = resonance * 17.0f; // Scale resonance to diode ranges
-  for (int i=0; i<4; ++i) {
-    float prev = (i == 0) ? (input - k * _s[3]) : _s[i-1];
-    _s[i] += f * (fastSaturate(prev) - fastSaturate(_s[i]));
+FilterCoeffs DiodeFilter::coeffs(float cutoffHz, float resonance) const {
+  FilterCoeffs c;
+  c.f = (cutoffHz * 2.0f) / _sampleRate;
+  if (c.f > 0.95f) c.f = 0.95f;
+  c.k = resonance * 17.0f; // Scale resonance to diode ranges
+  return c;
+}
+void DiodeFilter::processRamp(float* buf, size_t n, FilterCoeffs& c, const FilterCoeffs& step) {
+  float f = c.f;
+  float k = c.k;
+  float s0 = _s[0], s1 = _s[1], s2 = _s[2], s3 = _s[3];
+  // Each stage's saturated state feeds the next stage now and its own stage on
+  // the next sample, so carry it instead of saturating twice.
+  float t0 = fastSaturate(s0), t1 = fastSaturate(s1), t2 = fastSaturate(s2), t3 = fastSaturate(s3);
+  for (size_t i = 0; i < n; ++i) {
+    f += step.f;
+    k += step.k;
+    s0 += f * (fastSaturate(buf[i] - k * s3) - t0);
+    t0 = fastSaturate(s0);
+    s1 += f * (t0 - t1);
+    t1 = fastSaturate(s1);
+    s2 += f * (t1 - t2);
+    t2 = fastSaturate(s2);
+    s3 += f * (t2 - t3);
+    t3 = fastSaturate(s3);
+    buf[i] = s3;
   }
-  return _s[3];
+  _s[0] = s0; _s[1] = s1; _s[2] = s2; _s[3] = s3;
+  c.f = f;
+  c.k = k;
 }
 
 // === LADDER FILTER (Moog Style) ===
 LadderFilter::LadderFilter(float sampleRate) : _sampleRate(sampleRate) { reset(); }
 void LadderFilter::reset() { for (int i=0; i<4; ++i) _s[i] = 0; }
 void LadderFilter::setSampleRate(float sr) { _sampleRate = sr; }
-float LadderFilter::process(float input, float cutoffHz, float resonance) {
-  float f = (cutoffHz * 2.0f) / _sampleRate;
-  if (f > 0.95f) f = 0.95f;
-  float k = resonance * 4.0f;
-  float sum = input - k * _s[3];
-  for (int i=0; i<4; ++i) {
-    _s[i] += f * (sum - _s[i]);
-    sum = _s[i];
+FilterCoeffs LadderFilter::coeffs(float cutoffHz, float resonance) const {
+  FilterCoeffs c;
+  c.f = (cutoffHz * 2.0f) / _sampleRate;
+  if (c.f > 0.95f) c.f = 0.95f;
+  c.k = resonance * 4.0f;
+  return c;
+}
+void LadderFilter::processRamp(float* buf, size_t n, FilterCoeffs& c, const FilterCoeffs& step) {
+  float f = c.f;
+  float k = c.k;
+  float s0 = _s[0], s1 = _s[1], s2 = _s[2], s3 = _s[3];
+  for (size_t i = 0; i < n; ++i) {
+    f += step.f;
+    k += step.k;
+    s0 += f * (buf[i] - k * s3 - s0);
+    s1 += f * (s0 - s1);
+    s2 += f * (s1 - s2);
+    s3 += f * (s2 - s3);
+    buf[i] = s3;
   }
-  return _s[3];
+  _s[0] = s0; _s[1] = s1; _s[2] = s2; _s[3] = s3;
+  c.f = f;
+  c.k = k;
 }
@@ -1,12 +1,35 @@
 #pragma once
 
+#include <stddef.h>
+
+// Per-core coefficients for one cutoff/resonance pair. `f` is the frequency
+// coefficient and `k` the feedback (or damping) term. Both are cheap to
+// interpolate, so callers evaluate them at control rate and ramp in between.
+struct FilterCoeffs {
+  float f = 0.0f;
+  float k = 0.0f;
+};
+
 class AudioFilter {
 public:
   virtual ~AudioFilter() = default;
 
   virtual void reset() = 0;
   virtual void setSampleRate(float sr) = 0;
-  virtual float process(float input, float cutoffHz, float resonance) = 0;
+
+  // Map cutoff (Hz) and resonance (0..1) to this core's coefficients.
+  virtual FilterCoeffs coeffs(float cutoffHz, float resonance) const = 0;
+
+  // Filter buf in place, stepping c by step before each sample. On return c
+  // holds the coefficients used for the last sample.
+  virtual void processRamp(float* buf, size_t n, FilterCoeffs& c, const FilterCoeffs& step) = 0;
+
+  // Single sample at a fixed cutoff, for callers without a control-rate layer.
+  float process(float input, float cutoffHz, float resonance) {
+    FilterCoeffs c = coeffs(cutoffHz, resonance);
+    processRamp(&input, 1, c, FilterCoeffs());
+    return input;
+  }
 };
 
 class ChamberlinFilter : public AudioFilter {
@@ -14,7 +37,8 @@ public:
   explicit ChamberlinFilter(float sampleRate);
   void reset() override;
   void setSampleRate(float sr) override;
-  float process(float input, float cutoffHz, float resonance) override;
+  FilterCoeffs coeffs(float cutoffHz, float resonance) const override;
+  void processRamp(float* buf, size_t n, FilterCoeffs& c, const FilterCoeffs& step) override;
 
 private:
   float _lp;
@@ -28,7 +52,8 @@ public:
   explicit DiodeFilter(float sampleRate);
   void reset() override;
   void setSampleRate(float sr) override;
-  float process(float input, float cutoffHz, float resonance) override;
+  FilterCoeffs coeffs(float cutoffHz, float resonance) const override;
+  void processRamp(float* buf, size_t n, FilterCoeffs& c, const FilterCoeffs& step) override;
 
 private:
   float _s[4];
@@ -40,10 +65,10 @@ public:
   explicit LadderFilter(float sampleRate);
   void reset() override;
   void setSampleRate(float sr) override;
-  float process(float input, float cutoffHz, float resonance) override;
+  FilterCoeffs coeffs(float cutoffHz, float resonance) const override;
+  void processRamp(float* buf, size_t n, FilterCoeffs& c, const FilterCoeffs& step) override;
 
 private:
   float _s[4];
   float _sampleRate;
 };
-
@@ -212,34 +212,6 @@ public:
         state_.updateCachedName();
         cachedDirty_ = true;
     }
-    void queueRecipe(GenreRecipeId recipe) {
-        pendingRecipe_ = recipe;
-        pendingRecipeDirty_ = true;
-    }
-    void queueMorphTarget(GenreRecipeId target) {
-        pendingMorphTarget_ = target;
-        pendingMorphDirty_ = true;
-    }
-    void queueMorphAmount(uint8_t amount) {
-        pendingMorphAmount_ = amount;
-        pendingMorphDirty_ = true;
-    }
-    bool commitPendingRecipe() {
-        bool changed = false;
-        if (pendingRecipeDirty_) {
-            state_.recipe = pendingRecipe_;
-            pendingRecipeDirty_ = false;
-            changed = true;
-        }
-        if (pendingMorphDirty_) {
-            state_.morphTarget = pendingMorphTarget_;
-            state_.morphAmount = pendingMorphAmount_;
-            pendingMorphDirty_ = false;
-            changed = true;
-        }
-        if (changed) cachedDirty_ = true;
-        return changed;
-    }
     
     // Getters
     GenerativeMode generativeMode() const { return state_.generative; }
@@ -318,11 +290,6 @@ public:
     
 private:
     GenreState state_;
-    GenreRecipeId pendingRecipe_ = 0;
-    bool pendingRecipeDirty_ = false;
-    GenreRecipeId pendingMorphTarget_ = 0;
-    uint8_t pendingMorphAmount_ = 0;
-    bool pendingMorphDirty_ = false;
     mutable bool cachedDirty_ = true;
     mutable GenerativeParams cachedGenerativeParams_{};
     mutable const DrumGenreTemplate* cachedDrumOverride_ = nullptr;
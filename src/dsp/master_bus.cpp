@@ -0,0 +1,169 @@
+#include "master_bus.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MASTER_BUS_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MASTER_BUS_NEON 1
+#endif
+
+namespace {
+constexpr uint32_t kLcgMul = 1664525u;
+constexpr uint32_t kLcgAdd = 1013904223u;
+
+// k steps of the dither LCG folded into one multiply-add, so four samples
+// (eight draws) can be taken from the same state in parallel.
+struct LcgJump {
+  uint32_t mul;
+  uint32_t add;
+};
+
+constexpr LcgJump lcgJump(int steps) {
+  uint32_t mul = 1u;
+  uint32_t add = 0u;
+  for (int i = 0; i < steps; ++i) {
+    mul *= kLcgMul;
+    add = add * kLcgMul + kLcgAdd;
+  }
+  return {mul, add};
+}
+
+// Sample j of a group draws r1 from step 2j+1 and r2 from step 2j+2.
+constexpr LcgJump kJump[9] = {lcgJump(0), lcgJump(1), lcgJump(2), lcgJump(3), lcgJump(4),
+                              lcgJump(5), lcgJump(6), lcgJump(7), lcgJump(8)};
+
+inline float clampVolume(float vol) {
+  if (vol < 0.0f) vol = 0.0f;
+  if (vol > 1.8f) vol = 1.8f;
+  return vol;
+}
+
+#if defined(MASTER_BUS_SSE2)
+// 32-bit lane multiply (pmulld is SSE4.1): a is a broadcast, b varies by lane.
+inline __m128i mulLo32(__m128i a, __m128i b) {
+  __m128i even = _mm_mul_epu32(a, b);
+  __m128i odd = _mm_mul_epu32(a, _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+inline __m128 softLimit4(__m128 x, __m128 one, __m128 signMask) {
+  return _mm_div_ps(x, _mm_add_ps(one, _mm_andnot_ps(signMask, x)));
+}
+#endif
+} // namespace
+
+void MasterBus::reset() {
+  lpState_ = 0.0f;
+  dcX1_ = 0.0f;
+  dcY1_ = 0.0f;
+}
+
+void MasterBus::filterBlock(float* mix, size_t n) {
+  float lp = lpState_;
+  const float alpha = lpAlpha_;
+  float x1 = dcX1_;
+  float y1 = dcY1_;
+  for (size_t i = 0; i < n; ++i) {
+    float sample = mix[i] * 0.65f;
+    lp += alpha * (sample - lp);
+    // DC blocker: y[n] = x[n] - x[n-1] + 0.995 * y[n-1]
+    float dcOut = lp - x1 + 0.995f * y1;
+    x1 = lp;
+    y1 = dcOut;
+    mix[i] = dcOut;
+  }
+  lpState_ = lp;
+  dcX1_ = x1;
+  dcY1_ = y1;
+}
+
+void MasterBus::limitBlockReference(const float* mix, int16_t* out, size_t n, float volume) {
+  const float vol = clampVolume(volume);
+  uint32_t dither = dither_;
+  for (size_t i = 0; i < n; ++i) {
+    float finalSample = softLimit(softLimit(mix[i]) * vol);
+    dither = dither * kLcgMul + kLcgAdd;
+    float r1 = (float)(dither & 65535) * (1.0f / 65536.0f);
+    dither = dither * kLcgMul + kLcgAdd;
+    float r2 = (float)(dither & 65535) * (1.0f / 65536.0f);
+    finalSample += (r1 - r2) * (1.0f / 32768.0f);
+    if (finalSample > 1.0f) finalSample = 1.0f;
+    if (finalSample < -1.0f) finalSample = -1.0f;
+    out[i] = (int16_t)(finalSample * 32767.0f);
+  }
+  dither_ = dither;
+}
+
+void MasterBus::limitBlock(const float* mix, int16_t* out, size_t n, float volume) {
+  size_t i = 0;
+#if defined(MASTER_BUS_SSE2)
+  const __m128 vol = _mm_set1_ps(clampVolume(volume));
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 negOne = _mm_set1_ps(-1.0f);
+  const __m128 signMask = _mm_set1_ps(-0.0f);
+  const __m128 unit16 = _mm_set1_ps(1.0f / 65536.0f);
+  const __m128 ditherScale = _mm_set1_ps(1.0f / 32768.0f);
+  const __m128 fullScale = _mm_set1_ps(32767.0f);
+  const __m128i low16 = _mm_set1_epi32(0xFFFF);
+  const __m128i mul1 = _mm_setr_epi32((int)kJump[1].mul, (int)kJump[3].mul, (int)kJump[5].mul, (int)kJump[7].mul);
+  const __m128i add1 = _mm_setr_epi32((int)kJump[1].add, (int)kJump[3].add, (int)kJump[5].add, (int)kJump[7].add);
+  const __m128i mul2 = _mm_setr_epi32((int)kJump[2].mul, (int)kJump[4].mul, (int)kJump[6].mul, (int)kJump[8].mul);
+  const __m128i add2 = _mm_setr_epi32((int)kJump[2].add, (int)kJump[4].add, (int)kJump[6].add, (int)kJump[8].add);
+  uint32_t dither = dither_;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = softLimit4(_mm_loadu_ps(mix + i), one, signMask);
+    x = softLimit4(_mm_mul_ps(x, vol), one, signMask);
+
+    const __m128i state = _mm_set1_epi32((int)dither);
+    __m128i s1 = _mm_add_epi32(mulLo32(state, mul1), add1);
+    __m128i s2 = _mm_add_epi32(mulLo32(state, mul2), add2);
+    dither = dither * kJump[8].mul + kJump[8].add;
+    __m128 r1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(s1, low16)), unit16);
+    __m128 r2 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(s2, low16)), unit16);
+    x = _mm_add_ps(x, _mm_mul_ps(_mm_sub_ps(r1, r2), ditherScale));
+
+    x = _mm_min_ps(_mm_max_ps(x, negOne), one);
+    __m128i pcm = _mm_cvttps_epi32(_mm_mul_ps(x, fullScale));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(pcm, pcm));
+  }
+  dither_ = dither;
+#elif defined(MASTER_BUS_NEON)
+  const float32x4_t vol = vdupq_n_f32(clampVolume(volume));
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  const float32x4_t negOne = vdupq_n_f32(-1.0f);
+  const float32x4_t unit16 = vdupq_n_f32(1.0f / 65536.0f);
+  const float32x4_t ditherScale = vdupq_n_f32(1.0f / 32768.0f);
+  const float32x4_t fullScale = vdupq_n_f32(32767.0f);
+  const uint32x4_t low16 = vdupq_n_u32(0xFFFFu);
+  const uint32_t mul1v[4] = {kJump[1].mul, kJump[3].mul, kJump[5].mul, kJump[7].mul};
+  const uint32_t add1v[4] = {kJump[1].add, kJump[3].add, kJump[5].add, kJump[7].add};
+  const uint32_t mul2v[4] = {kJump[2].mul, kJump[4].mul, kJump[6].mul, kJump[8].mul};
+  const uint32_t add2v[4] = {kJump[2].add, kJump[4].add, kJump[6].add, kJump[8].add};
+  const uint32x4_t mul1 = vld1q_u32(mul1v);
+  const uint32x4_t add1 = vld1q_u32(add1v);
+  const uint32x4_t mul2 = vld1q_u32(mul2v);
+  const uint32x4_t add2 = vld1q_u32(add2v);
+  uint32_t dither = dither_;
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t x = vld1q_f32(mix + i);
+    x = vdivq_f32(x, vaddq_f32(one, vabsq_f32(x)));
+    x = vmulq_f32(x, vol);
+    x = vdivq_f32(x, vaddq_f32(one, vabsq_f32(x)));
+
+    const uint32x4_t state = vdupq_n_u32(dither);
+    uint32x4_t s1 = vmlaq_u32(add1, state, mul1);
+    uint32x4_t s2 = vmlaq_u32(add2, state, mul2);
+    dither = dither * kJump[8].mul + kJump[8].add;
+    float32x4_t r1 = vmulq_f32(vcvtq_f32_u32(vandq_u32(s1, low16)), unit16);
+    float32x4_t r2 = vmulq_f32(vcvtq_f32_u32(vandq_u32(s2, low16)), unit16);
+    x = vaddq_f32(x, vmulq_f32(vsubq_f32(r1, r2), ditherScale));
+
+    x = vminq_f32(vmaxq_f32(x, negOne), one);
+    vst1_s16(out + i, vmovn_s32(vcvtq_s32_f32(vmulq_f32(x, fullScale))));
+  }
+  dither_ = dither;
+#endif
+  if (i < n) limitBlockReference(mix + i, out + i, n - i, volume);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Master output stage, run once per block over the float mix: headroom gain,
+// safety low-pass, DC blocker, soft limiter, main volume, a second limiter,
+// TPDF dither and the int16 pack. Audio thread only.
+//
+// limitBlock() has SSE2 and NEON (AArch64) paths; other targets, including
+// the ESP32-S3 whose PIE vector unit has no float lanes, run the scalar
+// reference. Both give bit-identical output for the same state.
+class MasterBus {
+public:
+  // Clears the filter state; the dither sequence carries on.
+  void reset();
+  void setLowPassAlpha(float alpha) { lpAlpha_ = alpha; }
+
+  // Gain, low-pass and DC blocker, in place. Both filters are recursive, so
+  // this stays scalar; afterwards mix[] holds what the limiter sees.
+  void filterBlock(float* mix, size_t n);
+
+  // Limiter, volume (0..1.8), dither, clip and int16 pack.
+  void limitBlock(const float* mix, int16_t* out, size_t n, float volume);
+  // Plain per-sample version of limitBlock(); the vector paths must match it.
+  void limitBlockReference(const float* mix, int16_t* out, size_t n, float volume);
+
+  static float softLimit(float x) {
+    float absX = (x > 0) ? x : -x;
+    return x / (1.0f + absX);
+  }
+
+private:
+  float lpState_ = 0.0f;
+  float lpAlpha_ = 1.0f;
+  float dcX1_ = 0.0f;
+  float dcY1_ = 0.0f;
+  uint32_t dither_ = 12345;
+};
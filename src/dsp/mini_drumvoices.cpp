@@ -12,6 +12,29 @@ static inline float fast_tanh(float x) {
   return x * (27.0f + x2) / (27.0f + 9.0f * x2);
 }
 
+// Sample-major kit render: the synthesized kits share noise/lo-fi state between
+// voices, so the per-sample call order of the old mixer is kept. Qualified
+// calls bypass the vtable and let the compiler inline each voice.
+template <typename Kit>
+static inline void renderKitSamples(Kit& kit, float* busOut, const float* vol, uint16_t live, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    float mix = 0.0f;
+    if (live & (1u << KICK))       mix += kit.Kit::processKick() * vol[KICK];
+    if (live & (1u << SNARE))      mix += kit.Kit::processSnare() * vol[SNARE];
+    if (live & (1u << CLOSED_HAT)) mix += kit.Kit::processHat() * vol[CLOSED_HAT];
+    if (live & (1u << OPEN_HAT))   mix += kit.Kit::processOpenHat() * vol[OPEN_HAT];
+    if (live & (1u << MID_TOM))    mix += kit.Kit::processMidTom() * vol[MID_TOM];
+    if (live & (1u << HIGH_TOM))   mix += kit.Kit::processHighTom() * vol[HIGH_TOM];
+    if (live & (1u << RIM))        mix += kit.Kit::processRim() * vol[RIM];
+    if (live & (1u << CLAP))       mix += kit.Kit::processClap() * vol[CLAP];
+    busOut[i] = mix;
+  }
+}
+
+static inline void clearBlock(float* busOut, size_t n) {
+  for (size_t i = 0; i < n; ++i) busOut[i] = 0.0f;
+}
+
 LoFiDrumFX::LoFiDrumFX() : noiseState_(12345) {}
 
 void LoFiDrumFX::setEnabled(bool enabled) { enabled_ = enabled; }
@@ -323,7 +346,8 @@ void TR808DrumSynthVoice::triggerCymbal(bool accent, uint8_t velocity) {
 }
 
 float TR808DrumSynthVoice::frand() {
-  return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  frandState = frandState * 1664525u + 1013904223u;
+  return ((frandState >> 16) & 0x7FFF) / 16384.0f - 1.0f;
 }
 
 float TR808DrumSynthVoice::applyAccentDistortion(float input, bool accent) {
@@ -705,6 +729,25 @@ float TR808DrumSynthVoice::processCymbal() {
   return lofiEnabled ? lofi.process(res, CYMBAL) : res;
 }
 
+bool TR808DrumSynthVoice::renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) {
+  uint16_t live = 0;
+  if (kickActive)    live |= 1u << KICK;
+  if (snareActive)   live |= 1u << SNARE;
+  if (hatActive)     live |= 1u << CLOSED_HAT;
+  if (openHatActive) live |= 1u << OPEN_HAT;
+  if (midTomActive)  live |= 1u << MID_TOM;
+  if (highTomActive) live |= 1u << HIGH_TOM;
+  if (rimActive)     live |= 1u << RIM;
+  if (clapActive)    live |= 1u << CLAP;
+  live &= ~muteMask;
+  if (!live) {
+    clearBlock(busOut, n);
+    return false;
+  }
+  renderKitSamples(*this, busOut, trackVolumes, live, n);
+  return true;
+}
+
 const Parameter& TR808DrumSynthVoice::parameter(DrumParamId id) const {
   return params[static_cast<int>(id)];
 }
@@ -1203,6 +1246,25 @@ float TR909DrumSynthVoice::processCymbal() {
   return applyAccentDistortion(out, cymbalAccentDistortion);
 }
 
+bool TR909DrumSynthVoice::renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) {
+  uint16_t live = 0;
+  if (kickActive)    live |= 1u << KICK;
+  if (snareActive)   live |= 1u << SNARE;
+  if (hatActive)     live |= 1u << CLOSED_HAT;
+  if (openHatActive) live |= 1u << OPEN_HAT;
+  if (midTomActive)  live |= 1u << MID_TOM;
+  if (highTomActive) live |= 1u << HIGH_TOM;
+  if (rimActive)     live |= 1u << RIM;
+  if (clapActive)    live |= 1u << CLAP;
+  live &= ~muteMask;
+  if (!live) {
+    clearBlock(busOut, n);
+    return false;
+  }
+  renderKitSamples(*this, busOut, trackVolumes, live, n);
+  return true;
+}
+
 const Parameter& TR909DrumSynthVoice::parameter(DrumParamId id) const {
   return params[static_cast<int>(id)];
 }
@@ -1528,6 +1590,25 @@ float TR606DrumSynthVoice::processClap() {
   return 0.0f;
 }
 
+bool TR606DrumSynthVoice::renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) {
+  // Kick also advances the accent envelope and metal bank the hats read, so it
+  // runs whenever it is unmuted. Clap is silent on this kit; rim is the cymbal.
+  uint16_t live = 1u << KICK;
+  if (snareActive)   live |= 1u << SNARE;
+  if (hatActive)     live |= 1u << CLOSED_HAT;
+  if (openHatActive) live |= 1u << OPEN_HAT;
+  if (midTomActive)  live |= 1u << MID_TOM;
+  if (highTomActive) live |= 1u << HIGH_TOM;
+  if (cymbalActive)  live |= 1u << RIM;
+  live &= ~muteMask;
+  if (!live) {
+    clearBlock(busOut, n);
+    return false;
+  }
+  renderKitSamples(*this, busOut, trackVolumes, live, n);
+  return true;
+}
+
 const Parameter& TR606DrumSynthVoice::parameter(DrumParamId id) const {
   return params[static_cast<int>(id)];
 }
@@ -1747,6 +1828,25 @@ float CR78DrumSynthVoice::processCymbal() {
   return out * cymbalEnv * 0.3f;
 }
 
+bool CR78DrumSynthVoice::renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) {
+  // Open hat re-enters processHat(), so both slots follow hatEnv.
+  uint16_t live = 0;
+  if (kickEnv >= 0.001f) live |= 1u << KICK;
+  if (snareEnv >= 0.001f || snareNoiseEnv >= 0.001f) live |= 1u << SNARE;
+  if (hatEnv >= 0.001f) live |= (1u << CLOSED_HAT) | (1u << OPEN_HAT);
+  if (tomEnv[0] >= 0.001f) live |= 1u << MID_TOM;
+  if (tomEnv[1] >= 0.001f) live |= 1u << HIGH_TOM;
+  if (rimEnv >= 0.001f) live |= 1u << RIM;
+  if (clapEnv >= 0.001f) live |= 1u << CLAP;
+  live &= ~muteMask;
+  if (!live) {
+    clearBlock(busOut, n);
+    return false;
+  }
+  renderKitSamples(*this, busOut, trackVolumes, live, n);
+  return true;
+}
+
 
 // -----------------------------------------------------------------------------
 // KPR-77 Implementation
@@ -1858,6 +1958,24 @@ float KPR77DrumSynthVoice::processClap() {
 }
 float KPR77DrumSynthVoice::processRim() { return 0.0f; } 
 float KPR77DrumSynthVoice::processCymbal() { return 0.0f; } 
+
+bool KPR77DrumSynthVoice::renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) {
+  // Hat and open hat share hatEnv; rim is silent on this kit.
+  uint16_t live = 0;
+  if (kickEnv >= 0.001f) live |= 1u << KICK;
+  if (snareEnva >= 0.001f || snareEnvb >= 0.001f) live |= 1u << SNARE;
+  if (hatEnv >= 0.001f) live |= (1u << CLOSED_HAT) | (1u << OPEN_HAT);
+  if (tomEnv[0] >= 0.001f) live |= 1u << MID_TOM;
+  if (tomEnv[1] >= 0.001f) live |= 1u << HIGH_TOM;
+  if (clapEnv >= 0.001f) live |= 1u << CLAP;
+  live &= ~muteMask;
+  if (!live) {
+    clearBlock(busOut, n);
+    return false;
+  }
+  renderKitSamples(*this, busOut, trackVolumes, live, n);
+  return true;
+}
 void KPR77DrumSynthVoice::triggerRim(bool a, uint8_t v) {}
 void KPR77DrumSynthVoice::triggerCymbal(bool a, uint8_t v) {}
 
@@ -2029,3 +2147,43 @@ float SP12DrumSynthVoice::processHighTom() { return processPCM(HIGH_TOM); }
 float SP12DrumSynthVoice::processRim() { return processPCM(RIM); }
 float SP12DrumSynthVoice::processClap() { return processPCM(CLAP); }
 float SP12DrumSynthVoice::processCymbal() { return processPCM(CYMBAL); }
+
+bool SP12DrumSynthVoice::renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) {
+  // PCM voices share no state, so each live voice renders its whole span in
+  // one pass; the bus still sums in KICK..CLAP order per sample.
+  clearBlock(busOut, n);
+  bool rendered = false;
+  for (int idx = KICK; idx <= CLAP; ++idx) {
+    if (muteMask & (1u << idx)) continue;
+    if (voices[idx].curPos < 0 || !voices[idx].curData) continue;
+    const float vol = trackVolumes[idx];
+    for (size_t i = 0; i < n; ++i) {
+      busOut[i] += processPCM(idx) * vol;
+    }
+    rendered = true;
+  }
+  return rendered;
+}
+
+DrumKitPool::DrumKitPool(float sampleRate)
+  : tr808_(sampleRate),
+    tr909_(sampleRate),
+    tr606_(sampleRate),
+    cr78_(sampleRate),
+    kpr77_(sampleRate),
+    sp12_(sampleRate) {}
+
+DrumSynthVoice* DrumKitPool::kit(int index) {
+  switch (index) {
+    case 1: return &tr909_;
+    case 2: return &tr606_;
+    case 3: return &cr78_;
+    case 4: return &kpr77_;
+    case 5: return &sp12_;
+    default: return &tr808_;
+  }
+}
+
+void DrumKitPool::setSampleRate(float sampleRate) {
+  for (int i = 0; i < kKitCount; ++i) kit(i)->setSampleRate(sampleRate);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "mini_dsp_params.h"
@@ -80,6 +81,13 @@ public:
   virtual float processClap() = 0;
   virtual float processCymbal() = 0;
 
+  // Render the eight sequenced voices (KICK..CLAP) into busOut, overwriting it.
+  // trackVolumes[0..7] scale each voice in DrumVoiceType order; a set bit in
+  // muteMask (1 << KICK, ...) leaves that voice unprocessed, as the per-sample
+  // mixer did. Voices that are idle at the start of the block are skipped.
+  // Returns false when no voice was live, i.e. busOut is all zeros.
+  virtual bool renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) = 0;
+
   virtual const Parameter& parameter(DrumParamId id) const = 0;
   virtual void setParameter(DrumParamId id, float value) = 0;
 
@@ -112,6 +120,7 @@ public:
   float processRim() override;
   float processClap() override;
   float processCymbal() override;
+  bool renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) override;
 
   const Parameter& parameter(DrumParamId id) const override;
   void setParameter(DrumParamId id, float value) override;
@@ -146,7 +155,10 @@ private:
     }
   };
 
+  // Own noise generator: global rand() is shared with the sequencer and,
+  // in dual-core mode, called from the other core.
   float frand();
+  uint32_t frandState = 24680;
   float applyAccentDistortion(float input, bool accent);
   void updateClapFilters(float accentAmount);
 
@@ -280,6 +292,7 @@ public:
   float processRim() override;
   float processClap() override;
   float processCymbal() override;
+  bool renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) override;
 
   const Parameter& parameter(DrumParamId id) const override;
   void setParameter(DrumParamId id, float value) override;
@@ -439,6 +452,7 @@ public:
   float processRim() override;
   float processClap() override;
   float processCymbal() override;
+  bool renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) override;
 
   const Parameter& parameter(DrumParamId id) const override;
   void setParameter(DrumParamId id, float value) override;
@@ -575,6 +589,7 @@ public:
   float processRim() override;
   float processClap() override;
   float processCymbal() override;
+  bool renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) override;
 
   const Parameter& parameter(DrumParamId id) const override;
   void setParameter(DrumParamId id, float value) override;
@@ -629,6 +644,7 @@ public:
   float processRim() override;
   float processClap() override;
   float processCymbal() override;
+  bool renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) override;
 
   const Parameter& parameter(DrumParamId id) const override;
   void setParameter(DrumParamId id, float value) override;
@@ -682,6 +698,7 @@ public:
   float processRim() override;
   float processClap() override;
   float processCymbal() override;
+  bool renderBlock(float* busOut, const float* trackVolumes, uint16_t muteMask, size_t n) override;
 
   const Parameter& parameter(DrumParamId id) const override;
   void setParameter(DrumParamId id, float value) override;
@@ -716,3 +733,24 @@ private:
 
   Parameter params[static_cast<int>(DrumParamId::Count)];
 };
+
+// One instance of every drum kit, built together with the engine so switching
+// kits (including from engine-switch automation on the audio thread) only
+// repoints the active kit. Indexed like MiniAcid::getAvailableDrumEngines().
+class DrumKitPool {
+public:
+  static constexpr int kKitCount = 6;
+
+  explicit DrumKitPool(float sampleRate);
+
+  DrumSynthVoice* kit(int index);
+  void setSampleRate(float sampleRate);
+
+private:
+  TR808DrumSynthVoice tr808_;
+  TR909DrumSynthVoice tr909_;
+  TR606DrumSynthVoice tr606_;
+  CR78DrumSynthVoice cr78_;
+  KPR77DrumSynthVoice kpr77_;
+  SP12DrumSynthVoice sp12_;
+};
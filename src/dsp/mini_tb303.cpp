@@ -62,8 +62,12 @@ const TB303Preset kLoFiMinimalPresets[] = {
 TB303Voice::TB303Voice(float sampleRate)
   : sampleRate(sampleRate),
     invSampleRate(0.0f),
+    phaseScale(0.0f),
     nyquist(0.0f),
-    filter(std::make_unique<ChamberlinFilter>(sampleRate)) {
+    chamberlin_(sampleRate),
+    diode_(sampleRate),
+    ladder_(sampleRate),
+    filter(&chamberlin_) {
   setSampleRate(sampleRate);
   reset();
 }
@@ -84,20 +88,29 @@ void TB303Voice::reset() {
   freq = 110.0f;
   targetFreq = 110.0f;
   slideSpeed = 0.001f;
+  slideKeep = powf(1.0f - slideSpeed, static_cast<float>(kControlInterval));
   env = 0.0f;
   gate = false;
   slide = false;
   amp = 0.3f;
   postLPF_ = 0.0f;
   filter->reset();
+  controlCountdown_ = 0;
+  coeffsStale_ = true;
+  freqStep_ = 0.0f;
 }
 
 void TB303Voice::setSampleRate(float sampleRateHz) {
   if (sampleRateHz <= 0.0f) sampleRateHz = 44100.0f;
   sampleRate = sampleRateHz;
   invSampleRate = 1.0f / sampleRate;
+  phaseScale = 4294967296.0f / sampleRate;
   nyquist = sampleRate * 0.5f;
-  filter->setSampleRate(sampleRate);
+  chamberlin_.setSampleRate(sampleRate);
+  diode_.setSampleRate(sampleRate);
+  ladder_.setSampleRate(sampleRate);
+  controlCountdown_ = 0;
+  coeffsStale_ = true;
 }
 
 void TB303Voice::startNote(float freqHz, bool accent, bool slideFlag, uint8_t velocity) {
@@ -110,6 +123,9 @@ void TB303Voice::startNote(float freqHz, bool accent, bool slideFlag, uint8_t ve
 
   gate = true;
   env = accent ? 2.0f : 1.0f;
+  // Restart the control segment so the new envelope peak and pitch land now.
+  controlCountdown_ = 0;
+  coeffsStale_ = true;
   
   // Velocity scaling (0.3f is base gain)
   amp = 0.3f * (velocity / 100.0f);
@@ -122,7 +138,7 @@ float TB303Voice::oscSaw() {
   float output = Wavetable::lookupSaw(phaseAcc_);
   
   // Advance phase using fixed-point for precision
-  uint32_t phaseInc = static_cast<uint32_t>(freq * (4294967296.0f / (float)kSampleRate)); 
+  uint32_t phaseInc = static_cast<uint32_t>(freq * phaseScale); 
   phaseAcc_ += phaseInc;
   
   return output;
@@ -136,7 +152,7 @@ float TB303Voice::oscPulse() {
   // Square wave lookup with 30% duty cycle
   float output = Wavetable::lookupSquare(phaseAcc_);
   
-  uint32_t phaseInc = static_cast<uint32_t>(freq * (4294967296.0f / (float)kSampleRate));
+  uint32_t phaseInc = static_cast<uint32_t>(freq * phaseScale);
   phaseAcc_ += phaseInc;
   
   return output;
@@ -147,12 +163,12 @@ float TB303Voice::oscSub() {
   float saw = Wavetable::lookupSaw(phaseAcc_);
   
   static uint32_t subPhase = 0;
-  uint32_t subInc = static_cast<uint32_t>((freq * 0.5f) * (4294967296.0f / (float)kSampleRate));
+  uint32_t subInc = static_cast<uint32_t>((freq * 0.5f) * phaseScale);
   subPhase += subInc;
   
   float sub = Wavetable::lookupSquare(subPhase);
   
-  uint32_t phaseInc = static_cast<uint32_t>(freq * 190359.1689f);
+  uint32_t phaseInc = static_cast<uint32_t>(freq * phaseScale);
   phaseAcc_ += phaseInc;
   
   return saw * 0.7f + sub * 0.3f;
@@ -166,19 +182,22 @@ float TB303Voice::oscSuperSaw() {
   // Main oscillator with wavetable
   float sum = Wavetable::lookupSaw(phaseAcc_);
   
-  uint32_t baseInc = static_cast<uint32_t>(freq * (4294967296.0f / (float)kSampleRate));
+  uint32_t baseInc = static_cast<uint32_t>(freq * phaseScale);
   phaseAcc_ += baseInc;
 
-  // Detuned oscillators
-  for (int i = 0; i < kSuperSawOscCount; ++i) {
+  // Detuned oscillators (lite mode keeps only the widest pair)
+  const int oscCount = liteMode_ ? 2 : kSuperSawOscCount;
+  for (int i = 0; i < oscCount; ++i) {
     float detunedFreq = freq * (1.0f + kSuperSawDetune[i]);
-    uint32_t detunedInc = static_cast<uint32_t>(detunedFreq * (4294967296.0f / (float)kSampleRate));
+    uint32_t detunedInc = static_cast<uint32_t>(detunedFreq * phaseScale);
     superPhasesAcc_[i] += detunedInc;
     sum += Wavetable::lookupSaw(superPhasesAcc_[i]);
   }
 
   constexpr float kGain = 1.0f / (TB303Voice::kSuperSawOscCount - 5);
-  return sum * kGain;
+  // Detuned saws add roughly in power: sqrt(7/3) keeps 3 oscillators near the level of 7.
+  constexpr float kLiteGain = 1.5275f;
+  return liteMode_ ? sum * (kGain * kLiteGain) : sum * kGain;
 }
 
 float TB303Voice::oscillatorSample() {
@@ -215,93 +234,161 @@ float TB303Voice::oscillatorSample() {
   return out;
 }
 
-float TB303Voice::svfProcess(float input) {
+TB303Voice::BlockControls TB303Voice::prepareBlockControls() {
   // Update filter model if needed
   updateFilterModel();
 
-  // Slide toward target frequency
-  freq += (targetFreq - freq) * slideSpeed;
-  if (!isfinite(freq))
-    freq = targetFreq;
-
-  // Envelope decay
-  if (gate || env > 0.0001f) {
-    float decayMs = parameterValue(TB303ParamId::EnvDecay);
-    float decaySamples = decayMs * sampleRate * 0.001f;
-    if (decaySamples < 1.0f)
-      decaySamples = 1.0f;
-    // 0.01 represents roughly -40 dB, a practical "off" point for the envelope.
-    constexpr float kDecayTargetLog = -4.60517019f; // ln(0.01f)
-    float decayCoeff = expf(kDecayTargetLog / decaySamples);
-    env *= decayCoeff;
-  }
+  BlockControls ctl;
+  float decayMs = parameterValue(TB303ParamId::EnvDecay);
+  float decaySamples = decayMs * sampleRate * 0.001f;
+  if (decaySamples < 1.0f)
+    decaySamples = 1.0f;
+  // 0.01 represents roughly -40 dB, a practical "off" point for the envelope.
+  constexpr float kDecayTargetLog = -4.60517019f; // ln(0.01f)
+  ctl.decayCoeff = expf(kDecayTargetLog * kControlInterval / decaySamples);
 
   // Hard cap: never let the filter cutoff above 8 kHz regardless of sample rate.
   // At 22050 Hz SR, nyquist*0.9 ≈ 9.9 kHz — too close to fold-back zone.
-  float maxCutoff = fminf(nyquist * 0.9f, 8000.0f);
+  ctl.maxCutoff = fminf(nyquist * 0.9f, 8000.0f);
+  ctl.baseCutoff = parameterValue(TB303ParamId::Cutoff);
+  ctl.envAmount = parameterValue(TB303ParamId::EnvAmount);
 
-  float baseCutoff = parameterValue(TB303ParamId::Cutoff);
-  float envMod = parameterValue(TB303ParamId::EnvAmount) * env;
+  const int fltType = params[static_cast<int>(TB303ParamId::FilterType)].optionIndex();
+  constexpr int kNumProfiles = sizeof(kFilterProfiles) / sizeof(kFilterProfiles[0]);
+  ctl.profileIndex = fltType < kNumProfiles ? fltType : 0;
+  const FilterProfile& prof = kFilterProfiles[ctl.profileIndex];
+
+  // Apply character from profile table.
+  float resonance = parameterValue(TB303ParamId::Resonance) * prof.resMul + prof.resOffset;
+  if (resonance < 0.0f) resonance = 0.0f;
+  if (resonance > 0.95f) resonance = 0.95f;
+  ctl.resonance = resonance;
+  return ctl;
+}
+
+float TB303Voice::cutoffForEnv(float envValue, const BlockControls& ctl) const {
+  const float maxCutoff = ctl.maxCutoff;
+  float envMod = ctl.envAmount * envValue;
 
   // Soft-scale envelope when base cutoff is already high to prevent
   // cutoff + env from slamming into the ceiling and creating harsh peaks.
-  float headroom = maxCutoff - baseCutoff;
+  float headroom = maxCutoff - ctl.baseCutoff;
   if (headroom > 0.0f && envMod > headroom * 0.7f) {
     // 4:1 compression above 70% of remaining headroom.
     envMod = headroom * 0.7f + (envMod - headroom * 0.7f) * 0.25f;
   }
 
-  float cutoffHz = baseCutoff + envMod;
+  float cutoffHz = ctl.baseCutoff + envMod;
   if (cutoffHz < 50.0f)
     cutoffHz = 50.0f;
   if (cutoffHz > maxCutoff)
     cutoffHz = maxCutoff;
-  
-  float resonance = parameterValue(TB303ParamId::Resonance);
-  const int fltType = params[static_cast<int>(TB303ParamId::FilterType)].optionIndex();
-  constexpr int kNumProfiles = sizeof(kFilterProfiles) / sizeof(kFilterProfiles[0]);
-  const FilterProfile& prof = kFilterProfiles[fltType < kNumProfiles ? fltType : 0];
 
-  // Apply character from profile table.
+  const FilterProfile& prof = kFilterProfiles[ctl.profileIndex];
   cutoffHz *= prof.cutoffMul;
-  resonance = resonance * prof.resMul + prof.resOffset;
-
   if (cutoffHz > maxCutoff) cutoffHz = maxCutoff;
   if (cutoffHz < 50.0f) cutoffHz = 50.0f;
-  if (resonance < 0.0f) resonance = 0.0f;
-  if (resonance > 0.95f) resonance = 0.95f;
+  return cutoffHz;
+}
+
+void TB303Voice::beginControlSegment(const BlockControls& ctl) {
+  if (coeffsStale_) {
+    coeffs_ = filter->coeffs(cutoffForEnv(env, ctl), ctl.resonance);
+    coeffsStale_ = false;
+  }
+
+  // Envelope decay and slide are both exponential, so their values at the end
+  // of the segment come out in closed form; the audio loop ramps toward them.
+  if (gate || env > 0.0001f) {
+    env *= ctl.decayCoeff;
+  }
+  float freqEnd = targetFreq + (freq - targetFreq) * slideKeep;
+  if (!isfinite(freqEnd))
+    freqEnd = targetFreq;
+
+  const FilterCoeffs end = filter->coeffs(cutoffForEnv(env, ctl), ctl.resonance);
+  constexpr float kInvInterval = 1.0f / kControlInterval;
+  coeffStep_.f = (end.f - coeffs_.f) * kInvInterval;
+  coeffStep_.k = (end.k - coeffs_.k) * kInvInterval;
+  freqStep_ = (freqEnd - freq) * kInvInterval;
+  controlCountdown_ = kControlInterval;
+}
+
+void TB303Voice::renderSegment(float* out, size_t n, const BlockControls& ctl) {
+  for (size_t i = 0; i < n; ++i) {
+    float mainOsc = oscillatorSample();
+
+    // === SUB OSCILLATOR (NEW) ===
+    float finalOsc = mainOsc;
+    if (subEnabled_) {
+      subPhase_ += (freq * 0.5f) * invSampleRate;
+      if (subPhase_ >= 1.0f) subPhase_ -= 1.0f;
+      float sub = (subPhase_ < 0.5f) ? 1.0f : -1.0f;
+
+      // Simple LPF for sub to avoid clicks
+      subLPF_prev_ += 0.2f * (sub - subLPF_prev_);
+      sub = subLPF_prev_;
+
+      finalOsc = mainOsc * (1.0f - subMix_) + sub * subMix_;
+    }
+    out[i] = finalOsc;
+
+    // Slide toward target frequency
+    freq += freqStep_;
+  }
+
+  const FilterProfile& prof = kFilterProfiles[ctl.profileIndex];
 
   // Pre-processing (saturation / quantization) before the filter.
   switch (prof.preType) {
     case PreProcessType::TanhDrive:
-      input = fastSaturate(input * prof.preDrive);
+      for (size_t i = 0; i < n; ++i) out[i] = fastSaturate(out[i] * prof.preDrive);
       break;
     case PreProcessType::Quantize: {
-      // Dither: tiny noise before quantize to soften staircase artifacts.
-      noiseState_ = noiseState_ * 1664525 + 1013904223;
-      float dither = ((noiseState_ >> 16) & 0x7FFF) / 32768.0f - 0.5f;
-      input += dither * (1.0f / prof.preDrive); // ±0.5 LSB
-      input = floorf(input * prof.preDrive + 0.5f) / prof.preDrive;
+      const float step = 1.0f / prof.preDrive;
+      for (size_t i = 0; i < n; ++i) {
+        // Dither: tiny noise before quantize to soften staircase artifacts.
+        noiseState_ = noiseState_ * 1664525 + 1013904223;
+        float dither = ((noiseState_ >> 16) & 0x7FFF) / 32768.0f - 0.5f;
+        float input = out[i] + dither * step; // ±0.5 LSB
+        out[i] = floorf(input * prof.preDrive + 0.5f) * step;
+      }
       break;
     }
     default:
       break;
   }
 
-  float filtered = filter->process(input, cutoffHz, resonance);
+  filter->processRamp(out, n, coeffs_, coeffStep_);
 
-  float makeup = prof.makeup;
+  for (size_t i = 0; i < n; ++i) {
+    // Soft-limit after makeup to avoid harsh clipping at high resonance.
+    float sample = fastSaturate(out[i] * prof.makeup);
 
-  // Soft-limit after makeup to avoid harsh clipping at high resonance.
-  float out = fastSaturate(filtered * makeup);
+    // Per-profile 1-pole post-filter to tame aliasing from nonlinearities.
+    // α=1.0 bypasses; α=0.9 ≈ 8 kHz; α=0.85 ≈ 6.6 kHz at 22050 Hz SR.
+    if (prof.postLpfAlpha < 1.0f) {
+      postLPF_ += prof.postLpfAlpha * (sample - postLPF_);
+      sample = postLPF_;
+    }
 
-  // Per-profile 1-pole post-filter to tame aliasing from nonlinearities.
-  // α=1.0 bypasses; α=0.9 ≈ 8 kHz; α=0.85 ≈ 6.6 kHz at 22050 Hz SR.
-  if (prof.postLpfAlpha < 1.0f) {
-    postLPF_ += prof.postLpfAlpha * (out - postLPF_);
-    out = postLPF_;
+    if (loFiAmount_ > 0.001f) {
+      sample = applyLoFiDegradation(sample);
+    }
+
+    // Minimal mode extra character: Noise + DC offset
+    if (noiseAmount_ > 0.001f) {
+      noiseState_ = noiseState_ * 1664525 + 1013904223;
+      float noise = (float)(int16_t(noiseState_ >> 16)) / 32768.0f;
+      sample += noise * noiseAmount_;
+      sample += 0.01f * noiseAmount_;
+    }
+
+    // === BASS BOOST (NEW) ===
+    sample = bassBoost_.process(sample);
+
+    out[i] = sample * amp;
   }
-  return out;
 }
 
 float TB303Voice::applyLoFiDegradation(float input) {
@@ -328,44 +415,34 @@ float TB303Voice::applyLoFiDegradation(float input) {
 }
 
 float TB303Voice::process() {
-  if (!gate && env < 0.0001f) {
-    return 0.0f;
-  }
-
-  float mainOsc = oscillatorSample();
-  
-  // === SUB OSCILLATOR (NEW) ===
-  float finalOsc = mainOsc;
-  if (subEnabled_) {
-    subPhase_ += (freq * 0.5f) * invSampleRate;
-    if (subPhase_ >= 1.0f) subPhase_ -= 1.0f;
-    float sub = (subPhase_ < 0.5f) ? 1.0f : -1.0f;
-    
-    // Simple LPF for sub to avoid clicks
-    subLPF_prev_ += 0.2f * (sub - subLPF_prev_);
-    sub = subLPF_prev_;
-    
-    finalOsc = mainOsc * (1.0f - subMix_) + sub * subMix_;
-  }
+  float out = 0.0f;
+  processBlock(&out, 1);
+  return out;
+}
 
-  float out = svfProcess(finalOsc);
-  
-  if (loFiAmount_ > 0.001f) {
-    out = applyLoFiDegradation(out);
+void TB303Voice::processBlock(float* out, size_t n) {
+  if (!out || n == 0) return;
+  if (!gate && env < 0.0001f) {
+    for (size_t i = 0; i < n; ++i) out[i] = 0.0f;
+    return;
   }
 
-  // Minimal mode extra character: Noise + DC offset
-  if (noiseAmount_ > 0.001f) {
-    noiseState_ = noiseState_ * 1664525 + 1013904223;
-    float noise = (float)(int16_t(noiseState_ >> 16)) / 32768.0f;
-    out += noise * noiseAmount_;
-    out += 0.01f * noiseAmount_;
+  const BlockControls ctl = prepareBlockControls();
+  size_t i = 0;
+  while (i < n) {
+    if (controlCountdown_ <= 0) {
+      if (!gate && env < 0.0001f) {
+        for (; i < n; ++i) out[i] = 0.0f;
+        return;
+      }
+      beginControlSegment(ctl);
+    }
+    size_t len = n - i;
+    if (len > static_cast<size_t>(controlCountdown_)) len = static_cast<size_t>(controlCountdown_);
+    renderSegment(out + i, len, ctl);
+    controlCountdown_ -= static_cast<int>(len);
+    i += len;
   }
-
-  // === BASS BOOST (NEW) ===
-  out = bassBoost_.process(out);
-
-  return out * amp;
 }
 
 uint8_t TB303Voice::parameterCount() const {
@@ -477,16 +554,25 @@ void TB303Voice::initParameters() {
 
 void TB303Voice::updateFilterModel() {
   int currentType = params[static_cast<int>(TB303ParamId::FilterType)].optionIndex();
-  if (currentType == lastFilterType_) return;
+  if (currentType == lastFilterType_ && liteMode_ == lastLiteMode_) return;
 
   constexpr int kNumProfiles = sizeof(kFilterProfiles) / sizeof(kFilterProfiles[0]);
   FilterCore core = kFilterProfiles[currentType < kNumProfiles ? currentType : 0].core;
+  // The diode core's per-stage saturators make it the priciest; lite swaps in Chamberlin.
+  if (liteMode_ && core == FilterCore::Diode) core = FilterCore::Chamberlin;
 
+  AudioFilter* next = &chamberlin_;
   switch (core) {
-    case FilterCore::Diode:      filter = std::make_unique<DiodeFilter>(sampleRate); break;
-    case FilterCore::Ladder:     filter = std::make_unique<LadderFilter>(sampleRate); break;
+    case FilterCore::Diode:      next = &diode_; break;
+    case FilterCore::Ladder:     next = &ladder_; break;
     case FilterCore::Chamberlin:
-    default:                     filter = std::make_unique<ChamberlinFilter>(sampleRate); break;
+    default:                     break;
   }
+  // A lite toggle that keeps the same core leaves the filter state alone.
+  if (next != filter || currentType != lastFilterType_) next->reset();
+  filter = next;
   lastFilterType_ = currentType;
+  lastLiteMode_ = liteMode_;
+  controlCountdown_ = 0;
+  coeffsStale_ = true;
 }
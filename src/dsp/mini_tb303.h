@@ -42,6 +42,8 @@ public:
   void startNote(float freqHz, bool accent, bool slideFlag, uint8_t velocity = 100) override;
   void release() override;
   float process() override;
+  void processBlock(float* out, size_t n) override;
+  bool isIdle() const override { return !gate && env < 0.0001f; }
   uint8_t parameterCount() const override;
   void setParameterNormalized(uint8_t index, float norm) override;
   float getParameterNormalized(uint8_t index) const override;
@@ -49,6 +51,8 @@ public:
   const char* getEngineName() const override { return "TB303"; }
   void setMode(GrooveboxMode mode) override;
   void setLoFiAmount(float amount) override; // 0..1 for various degradations
+  // Lite: 2 detuned supersaw oscillators instead of 6, Chamberlin core for diode profiles.
+  void setLiteMode(bool lite) override { liteMode_ = lite; }
 
   void adjustParameter(TB303ParamId id, int steps);
   float parameterValue(TB303ParamId id) const;
@@ -59,13 +63,33 @@ public:
   void setNoiseAmount(float amount);
 
 private:
+  // Samples between control-rate updates of envelope, slide and filter
+  // coefficients; the audio loop ramps linearly in between (~0.7 ms at 22 kHz).
+  // Against per-sample updates this moves the waveform (~43 LSB RMS on two
+  // audible voices, mostly resonance phase) but not the spectrum (band
+  // energies within 0.01 dB).
+  static constexpr int kControlInterval = 16;
+
+  // Values that only change between blocks (UI edits, filter type switches).
+  struct BlockControls {
+    float decayCoeff;  // envelope decay over one control interval
+    float maxCutoff;
+    float baseCutoff;
+    float envAmount;
+    float resonance;
+    int profileIndex;
+  };
+
+  BlockControls prepareBlockControls();
   float oscSaw();
   float oscSquare(float saw);
   float oscPulse();
   float oscSub();
   float oscSuperSaw();
   float oscillatorSample();
-  float svfProcess(float input);
+  float cutoffForEnv(float envValue, const BlockControls& ctl) const;
+  void beginControlSegment(const BlockControls& ctl);
+  void renderSegment(float* out, size_t n, const BlockControls& ctl);
   float applyLoFiDegradation(float input);
   void initParameters();
   void updateFilterModel();
@@ -83,6 +107,7 @@ private:
   float freq;       // current frequency (Hz)
   float targetFreq; // slide target
   float slideSpeed; // how fast we slide toward target
+  float slideKeep;  // (1 - slideSpeed)^kControlInterval
   float env;        // filter envelope value
   bool gate;        // note on/off
   bool slide;       // slide flag for next note
@@ -90,10 +115,24 @@ private:
 
   float sampleRate;
   float invSampleRate;
+  float phaseScale; // 2^32 / sampleRate: fixed-point phase increment per Hz
   float nyquist;
 
   Parameter params[static_cast<int>(TB303ParamId::Count)];
-  std::unique_ptr<AudioFilter> filter;
+  // All filter cores live in the voice; a filter type change only repoints
+  // `filter`, so it never allocates on the audio thread.
+  ChamberlinFilter chamberlin_;
+  DiodeFilter diode_;
+  LadderFilter ladder_;
+  AudioFilter* filter;
+
+  // Control-rate ramps. controlCountdown_ == 0 forces a fresh segment on the
+  // next sample; coeffsStale_ re-seeds the ramp start after a note or model change.
+  int controlCountdown_ = 0;
+  bool coeffsStale_ = true;
+  FilterCoeffs coeffs_;
+  FilterCoeffs coeffStep_;
+  float freqStep_ = 0.0f;
   
   GrooveboxMode mode_ = GrooveboxMode::Acid;
   float loFiAmount_ = 0.0f;
@@ -107,6 +146,8 @@ private:
   float noiseAmount_ = 0.0f;
 
   int lastFilterType_ = -1;
+  bool liteMode_ = false;
+  bool lastLiteMode_ = false;
   float postLPF_ = 0.0f;  // 1-pole anti-harshness post-filter state
   struct LowShelfEQ {
     float cutoff = 0.01f;
@@ -2,15 +2,14 @@
 
 #if defined(ARDUINO)
 #include <Arduino.h>
-#include <SD.h>
-#include "wav_header.h"
 #else
 #include "../../platform_sdl/arduino_compat.h"
-#include "wav_header.h"
 #endif
 #include <algorithm>
 #include <cmath>
 #include <cctype>
+#include <cstring>
+#include <new>
 #include <string>
 
 #include "../audio/audio_diagnostics.h"
@@ -24,6 +23,7 @@
 #endif
 
 #include "../platform/log.h"
+#include "../platform/thread_id.h"
 #include "swappable_synth_voice.h"
 #include "advanced_pattern_generator.h"
 
@@ -36,6 +36,8 @@ constexpr int kDrumMidTomVoice = 4;
 constexpr int kDrumHighTomVoice = 5;
 constexpr int kDrumRimVoice = 6;
 constexpr int kDrumClapVoice = 7;
+// Drum bus DC blocker ring-out: 0.995^n falls below -100 dB after ~2300 samples.
+constexpr uint32_t kDrumBusDcTailSamples = 2300;
 
 SynthPattern makeEmptySynthPattern() {
   SynthPattern pattern{};
@@ -67,6 +69,22 @@ std::string toLowerCopy(std::string value) {
   }
   return value;
 }
+
+// Same clamping SceneManager applies to the indices it stores.
+int clampSelectionBank(int bank) {
+  if (bank < 0) return 0;
+  return bank >= kBankCount ? kBankCount - 1 : bank;
+}
+
+int clampSelectionPattern(int pat) {
+  if (pat < 0) return 0;
+  return pat >= Bank<SynthPattern>::kPatterns ? Bank<SynthPattern>::kPatterns - 1 : pat;
+}
+
+int wrapSelectionPattern(int pat) {
+  if (pat < 0) return Bank<SynthPattern>::kPatterns - 1;
+  return pat >= Bank<SynthPattern>::kPatterns ? 0 : pat;
+}
 }
 
 TempoDelay::TempoDelay(float sampleRate)
@@ -185,6 +203,16 @@ void TempoDelay::setEnabled(bool on) { enabled = on; }
 
 bool TempoDelay::isEnabled() const { return enabled; }
 
+uint32_t TempoDelay::tailSamples() const {
+  if (!enabled || buffer.empty()) return 0;
+  // The feedback limiter only ever shrinks the repeats, so fb^k bounds them.
+  uint32_t repeats = 1;
+  if (feedback > 0.001f) {
+    repeats += static_cast<uint32_t>(ceilf(logf(1.0e-5f) / logf(feedback)));
+  }
+  return repeats * static_cast<uint32_t>(delaySamples);
+}
+
 float TempoDelay::process(float input) {
   if (!enabled || buffer.empty()) {
     return input;
@@ -207,10 +235,37 @@ float TempoDelay::process(float input) {
   return input + delayed * mix;
 }
 
+void TempoDelay::processBlock(float* buf, size_t n) {
+  if (!enabled || buffer.empty()) {
+    return;
+  }
+
+  float* line = buffer.data();
+  int w = writeIndex;
+  int r = w - delaySamples;
+  if (r < 0)
+    r += maxDelaySamples;
+  const float fb = feedback;
+  const float wet = mix;
+  for (size_t i = 0; i < n; ++i) {
+    float input = buf[i];
+    float delayed = line[r];
+    float fbSum = input + delayed * fb;
+    fbSum = fbSum / (1.0f + fabsf(fbSum) * 0.8f);
+    line[w] = fbSum;
+    if (++w >= maxDelaySamples)
+      w = 0;
+    if (++r >= maxDelaySamples)
+      r = 0;
+    buf[i] = input + delayed * wet;
+  }
+  writeIndex = w;
+}
+
 MiniAcid::MiniAcid(float sampleRate, SceneStorage* sceneStorage)
-  : drums(std::make_unique<TR808DrumSynthVoice>(sampleRate)),
+  : drumKits_(sampleRate),
+    drums(drumKits_.kit(0)),
     sampleRateValue(sampleRate),
-    drumEngineName_("808"),
     sceneStorage_(sceneStorage),
     samplerOutBuffer(std::make_unique<float[]>(AUDIO_BUFFER_SAMPLES)),
     samplerTrack(std::make_unique<DrumSamplerTrack>()),
@@ -256,6 +311,21 @@ MiniAcid::MiniAcid(float sampleRate, SceneStorage* sceneStorage)
   // Initialize Drum FX
   drumReverb.setSampleRate(sampleRateValue);
   drumTransientShaper.setSampleRate(sampleRateValue);
+
+  // Master-stage objects that used to assume kSampleRate
+  tapeFX->setSampleRate(sampleRateValue);
+  tapeLooper->setSampleRate(sampleRateValue); // buffer is allocated later in init()
+  samplerTrack->setSampleRate(sampleRateValue);
+  masterBass.setSampleRate(sampleRateValue);
+
+  audioConfig_.sampleRate = static_cast<uint32_t>(sampleRateValue);
+  activeAudioConfig_.store(audioConfig_.pack(), std::memory_order_relaxed);
+  blockTuner_.reset(audioConfig_.blockFrames);
+
+  // Block render scratch (never reallocated on the audio thread)
+  synthBusBuffer_ = std::make_unique<float[]>(AUDIO_BUFFER_SAMPLES);
+  synthVoiceBuffer_ = std::make_unique<float[]>(AUDIO_BUFFER_SAMPLES);
+  drumBusBuffer_ = std::make_unique<float[]>(AUDIO_BUFFER_SAMPLES);
   
   // NEW: Configure voice processing chain
   // HPF @ 150Hz is built-in to compressor
@@ -304,6 +374,7 @@ void MiniAcid::init() {
     
     LOG_PRINTLN("  - MiniAcid::init: DRAM MODE ACTIVE (Reduced buffers)");
   }
+  if (sampleStore) sampleStore->setTargetSampleRate(static_cast<uint32_t>(sampleRateValue));
 
   LOG_PRINTLN("  - MiniAcid::init: Memory strategy applied");
 
@@ -347,6 +418,11 @@ void MiniAcid::init() {
   AudioDiagnostics::instance().enable(false);
   LOG_PRINTLN("  - MiniAcid::init: applySceneStateFromManager()...");
   applySceneStateFromManager();
+#if defined(ESP32) || defined(ESP_PLATFORM)
+  // Page files live on the SD card; desktop builds only flip the page index.
+  LOG_PRINTLN("  - MiniAcid::init: starting page prefetcher...");
+  pagePrefetcher_.begin();
+#endif
   LOG_PRINTLN("  - MiniAcid::init: Done");
 }
 
@@ -392,7 +468,7 @@ void MiniAcid::reset() {
   songStepCounter_ = 0;
   currentTimingOffset_ = 0;
   updateTickIncrement();
-  masterOutputLpState_ = 0.0f;
+  masterBus_.reset();
   
   delay303.reset();
   delay303.setBeats(0.5f); // eighth note
@@ -415,6 +491,8 @@ void MiniAcid::reset() {
   drumCompressor.reset();
   drumTransientShaper.reset();
   drumReverb.reset();
+  drumBusGate_.reset();
+  for (int v = 0; v < NUM_303_VOICES; ++v) synthFxGate_[v].reset();
   
   updateDrumCompression(0.0f);
   updateDrumTransientAttack(0.0f);
@@ -454,13 +532,16 @@ void MiniAcid::reset() {
 }
 
 void MiniAcid::start() {
+  if (postCommand_(AudioCommandType::Start)) return;
   LOG_PRINTLN("[DSP] START command received");
   playing = true;
   currentStepIndex = -1;
   // Force immediate first step trigger.
   tickPhaseAccum_ = 0x100000000ULL; // Trigger advance on first sample
   currentTick_ = 383; // Set to end of bar so first modulo triggers step 0
+  pendingTriggerCount_ = 0;
   currentTimingOffset_ = 0;
+  lookaheadSongPosition_ = -1;
   if (songMode_) {
     if (!liveMixMode_) {
       songPlaybackSlot_ = sceneManager_.activeSongSlot();
@@ -472,13 +553,15 @@ void MiniAcid::start() {
 }
 
 void MiniAcid::stop() {
+  if (postCommand_(AudioCommandType::Stop)) return;
   LOG_PRINTLN("[DSP] STOP command received");
   playing = false;
   currentStepIndex = -1;
   tickPhaseAccum_ = 0;
   currentTick_ = 0;
-  gateCountdownA_ = 0;
-  gateCountdownB_ = 0;
+  pendingTriggerCount_ = 0;
+  gateA_ = {};
+  gateB_ = {};
   retrigA_ = {};
   retrigB_ = {};
   for (int i = 0; i < NUM_DRUM_VOICES; ++i) retrigDrums_[i] = {};
@@ -491,6 +574,7 @@ void MiniAcid::stop() {
 }
 
 void MiniAcid::setBpm(float bpm) {
+  if (postCommand_(AudioCommandType::SetBpm, 0, 0, bpm)) return;
   bpmValue = bpm;
   if (bpmValue < 10.0f)
     bpmValue = 10.0f;
@@ -508,9 +592,10 @@ void MiniAcid::setMasterOutputHighCutHz(float hz) {
   if (hz > nyquist) hz = nyquist;
   masterOutputHighCutHz_ = hz;
   const float omega = 2.0f * 3.14159265f * masterOutputHighCutHz_ / sampleRateValue;
-  masterOutputLpAlpha_ = 1.0f - expf(-omega);
-  if (masterOutputLpAlpha_ < 0.0f) masterOutputLpAlpha_ = 0.0f;
-  if (masterOutputLpAlpha_ > 1.0f) masterOutputLpAlpha_ = 1.0f;
+  float alpha = 1.0f - expf(-omega);
+  if (alpha < 0.0f) alpha = 0.0f;
+  if (alpha > 1.0f) alpha = 1.0f;
+  masterBus_.setLowPassAlpha(alpha);
 }
 
 float MiniAcid::bpm() const { return bpmValue; }
@@ -695,6 +780,7 @@ const bool* MiniAcid::patternClapAccentSteps() const {
 bool MiniAcid::songModeEnabled() const { return songMode_; }
 
 void MiniAcid::setSongMode(bool enabled) {
+  if (postCommand_(AudioCommandType::SetSongMode, enabled)) return;
   if (enabled == songMode_) return;
   if (enabled) {
     patternModeDrumPatternIndex_ = sceneManager_.getCurrentDrumPatternIndex();
@@ -718,13 +804,23 @@ void MiniAcid::setSongMode(bool enabled) {
   sceneManager_.setSongMode(songMode_);
 }
 
-void MiniAcid::toggleSongMode() { setSongMode(!songMode_); }
+void MiniAcid::toggleSongMode() {
+  if (postCommand_(AudioCommandType::ToggleSongMode)) return;
+  setSongMode(!songMode_);
+}
 
 bool MiniAcid::loopModeEnabled() const { return sceneManager_.loopMode(); }
 
-void MiniAcid::setLoopMode(bool enabled) { sceneManager_.setLoopMode(enabled); }
+void MiniAcid::setLoopMode(bool enabled) {
+  if (postCommand_(AudioCommandType::SetLoopMode, enabled)) return;
+  sceneManager_.setLoopMode(enabled);
+}
 
 void MiniAcid::setLoopRange(int startRow, int endRow) {
+  if (postCommand_(AudioCommandType::SetLoopRange, static_cast<int16_t>(startRow),
+                   static_cast<int16_t>(endRow))) {
+    return;
+  }
   sceneManager_.setLoopRange(startRow, endRow);
 }
 
@@ -733,7 +829,10 @@ int MiniAcid::loopStartRow() const { return sceneManager_.loopStartRow(); }
 int MiniAcid::loopEndRow() const { return sceneManager_.loopEndRow(); }
 
 int MiniAcid::songLength() const { return sceneManager_.songLength(); }
-void MiniAcid::setSongLength(int length) { sceneManager_.setSongLength(length); }
+void MiniAcid::setSongLength(int length) {
+  if (postCommand_(AudioCommandType::SetSongLength, static_cast<int16_t>(length))) return;
+  sceneManager_.setSongLength(length);
+}
 
 int MiniAcid::currentSongPosition() const { return sceneManager_.getSongPosition(); }
 
@@ -741,12 +840,25 @@ int MiniAcid::songPlayheadPosition() const { return songPlayheadPosition_; }
 
 void MiniAcid::setSongPosition(int position) {
   int pos = clampSongPosition(position);
+  if (postCommand_(AudioCommandType::SetSongPosition, static_cast<int16_t>(position))) {
+    // A jump to a row on this page: have its patterns ready when it lands.
+    int page = songRowPage_(pos);
+    if (songMode_ && (page < 0 || page == currentPageIndex())) {
+      cueSelection_() = songRowSelection_(pos);
+      publishPatterns();
+    }
+    return;
+  }
   sceneManager_.setSongPosition(pos);
   if (!playing) songPlayheadPosition_ = pos;
   if (songMode_) applySongPositionSelection();
 }
 
 void MiniAcid::setSongPattern(int position, SongTrack track, int16_t patternIndex) {
+  if (postCommand_(AudioCommandType::SetSongPattern, static_cast<int16_t>(position),
+                   static_cast<int16_t>(track), patternIndex)) {
+    return;
+  }
   sceneManager_.setSongPattern(position, track, patternIndex);
   if (songMode_ && position == currentSongPosition() &&
       activeSongSlot() == songPlaybackSlot_) {
@@ -755,6 +867,10 @@ void MiniAcid::setSongPattern(int position, SongTrack track, int16_t patternInde
 }
 
 void MiniAcid::clearSongPattern(int position, SongTrack track) {
+  if (postCommand_(AudioCommandType::ClearSongPattern, static_cast<int16_t>(position),
+                   static_cast<int16_t>(track))) {
+    return;
+  }
   sceneManager_.clearSongPattern(position, track);
   int pos = clampSongPosition(sceneManager_.getSongPosition());
   sceneManager_.setSongPosition(pos);
@@ -775,6 +891,7 @@ int16_t MiniAcid::songPatternAtSlot(int slot, int position, SongTrack track) con
 const Song& MiniAcid::song() const { return sceneManager_.song(); }
 int MiniAcid::activeSongSlot() const { return sceneManager_.activeSongSlot(); }
 void MiniAcid::setActiveSongSlot(int slot) {
+  if (postCommand_(AudioCommandType::SetActiveSongSlot, static_cast<int16_t>(slot))) return;
   sceneManager_.setActiveSongSlot(slot);
   if (!liveMixMode_) {
     songPlaybackSlot_ = sceneManager_.activeSongSlot();
@@ -785,6 +902,7 @@ void MiniAcid::setActiveSongSlot(int slot) {
 }
 int MiniAcid::songPlaybackSlot() const { return songPlaybackSlot_; }
 void MiniAcid::setSongPlaybackSlot(int slot) {
+  if (postCommand_(AudioCommandType::SetSongPlaybackSlot, static_cast<int16_t>(slot))) return;
   if (slot < 0) slot = 0;
   if (slot > 1) slot = 1;
   if (songPlaybackSlot_ == slot) return;
@@ -793,6 +911,7 @@ void MiniAcid::setSongPlaybackSlot(int slot) {
 }
 bool MiniAcid::liveMixModeEnabled() const { return liveMixMode_; }
 void MiniAcid::setLiveMixMode(bool enabled) {
+  if (postCommand_(AudioCommandType::SetLiveMixMode, enabled)) return;
   if (liveMixMode_ == enabled) return;
   liveMixMode_ = enabled;
   if (!liveMixMode_) {
@@ -800,14 +919,59 @@ void MiniAcid::setLiveMixMode(bool enabled) {
     if (songMode_) applySongPositionSelection();
   }
 }
-void MiniAcid::toggleLiveMixMode() { setLiveMixMode(!liveMixMode_); }
-void MiniAcid::mergeSongs() { sceneManager_.mergeSongs(); }
-void MiniAcid::alternateSongs() { sceneManager_.alternateSongs(); }
-void MiniAcid::insertSongRow(int position) { sceneManager_.insertSongRow(position); }
-void MiniAcid::deleteSongRow(int position) { sceneManager_.deleteSongRow(position); }
-void MiniAcid::setSongReverse(bool reverse) { sceneManager_.setSongReverse(reverse); }
+void MiniAcid::toggleLiveMixMode() {
+  if (postCommand_(AudioCommandType::ToggleLiveMixMode)) return;
+  setLiveMixMode(!liveMixMode_);
+}
+void MiniAcid::mergeSongs() {
+  int slot = activeSongSlot();
+  auto merged = std::make_unique<Song>();
+  sceneManager_.buildMergedSong(*merged);
+  postSong_(slot, std::move(merged));
+}
+void MiniAcid::alternateSongs() {
+  int slot = activeSongSlot();
+  auto alternated = std::make_unique<Song>();
+  sceneManager_.buildAlternatedSong(*alternated);
+  postSong_(slot, std::move(alternated));
+}
+void MiniAcid::replaceSong(const Song& song) {
+  postSong_(activeSongSlot(), std::make_unique<Song>(song));
+}
+void MiniAcid::postSong_(int slot, std::unique_ptr<Song> song) {
+  if (deferToAudioThread_()) {
+    AudioCommand cmd;
+    cmd.type = AudioCommandType::ReplaceSong;
+    cmd.a = static_cast<int16_t>(slot);
+    cmd.ptr = song.release();
+    if (!pushCommand_(cmd)) delete static_cast<Song*>(cmd.ptr);
+    return;
+  }
+  if (dualCore_ && drumWorker_.busy()) drumWorker_.wait();
+  swapInSong_(slot, song.release());
+}
+void MiniAcid::swapInSong_(int slot, Song* song) {
+  sceneManager_.swapSong(slot, *song);
+  if (songMode_ && slot == songPlaybackSlot_) applySongPositionSelection();
+  // `song` now holds the old one; same hand-back as genre stages.
+  if (onAudioThread_() && retiredSongs_.push(song)) return;
+  delete song;
+}
+void MiniAcid::insertSongRow(int position) {
+  if (postCommand_(AudioCommandType::InsertSongRow, static_cast<int16_t>(position))) return;
+  sceneManager_.insertSongRow(position);
+}
+void MiniAcid::deleteSongRow(int position) {
+  if (postCommand_(AudioCommandType::DeleteSongRow, static_cast<int16_t>(position))) return;
+  sceneManager_.deleteSongRow(position);
+}
+void MiniAcid::setSongReverse(bool reverse) {
+  if (postCommand_(AudioCommandType::SetSongReverse, reverse)) return;
+  sceneManager_.setSongReverse(reverse);
+}
 bool MiniAcid::isSongReverse() const { return sceneManager_.isSongReverse(); }
 void MiniAcid::queueSongReverseToggle() {
+  if (postCommand_(AudioCommandType::QueueSongReverseToggle)) return;
   if (playing && songMode_) {
     songReverseTogglePending_ = true;
     return;
@@ -870,6 +1034,7 @@ uint8_t MiniAcid::synthParameterCount(int voiceIndex) const {
 }
 
 void MiniAcid::adjustSynthParameter(int voiceIndex, int knobIndex, int steps) {
+  if (postCommand_(AudioCommandType::AdjustSynthParameter, static_cast<int16_t>(voiceIndex), static_cast<int16_t>(knobIndex), static_cast<float>(steps))) return;
   int idx = clamp303Voice(voiceIndex);
   if (synthVoices_[idx]) {
     // We get a non-const copy or pointer if possible? 
@@ -890,35 +1055,36 @@ void MiniAcid::adjustSynthParameter(int voiceIndex, int knobIndex, int steps) {
 
 void MiniAcid::setSynthEngine(int voiceIndex, const std::string& engineName) {
   int idx = clamp303Voice(voiceIndex);
-  if (!synthVoices_[idx]) {
-    synthVoices_[idx] = std::make_unique<SwappableSynthVoice>(sampleRateValue, SynthEngineType::TB303);
-    synthVoices_[idx]->setMode(sceneManager_.getMode());
-    const float loFiAmt = sceneManager_.currentScene().feel.lofiAmount / 100.0f;
-    synthVoices_[idx]->setLoFiAmount(loFiAmt);
-  }
-
   std::string name = engineName;
   for (auto& c : name) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
   LOG_DEBUG("[Synth] %d -> %s\n", idx, name.c_str());
 
   SynthEngineType target = SynthEngineType::TB303;
-  const char* targetName = "TB303";
   if (name.find("SID") != std::string::npos) {
     target = SynthEngineType::SID;
-    targetName = "SID";
   } else if (name.find("OPL2") != std::string::npos ||
              name.find("YM3812") != std::string::npos ||
              name.find("FM") != std::string::npos) {
     target = SynthEngineType::OPL2;
-    targetName = "OPL2";
   } else if (name.find("AY") != std::string::npos ||
              name.find("YM2149") != std::string::npos ||
              name.find("PSG") != std::string::npos) {
     target = SynthEngineType::AY;
-    targetName = "AY";
-  } else if (name.find("TB303") != std::string::npos || name.find("303") != std::string::npos) {
-    target = SynthEngineType::TB303;
-    targetName = "TB303";
+  }
+
+  if (postCommand_(AudioCommandType::SetSynthEngine, static_cast<int16_t>(idx), static_cast<int16_t>(target))) return;
+  applySynthEngine_(idx, target);
+}
+
+void MiniAcid::applySynthEngine_(int idx, SynthEngineType target) {
+  static const char* const kSynthEngineNames[] = {"TB303", "SID", "AY", "OPL2"};
+  const char* targetName = kSynthEngineNames[static_cast<int>(target)];
+
+  if (!synthVoices_[idx]) {
+    synthVoices_[idx] = std::make_unique<SwappableSynthVoice>(sampleRateValue, SynthEngineType::TB303);
+    synthVoices_[idx]->setMode(sceneManager_.getMode());
+    const float loFiAmt = sceneManager_.currentScene().feel.lofiAmount / 100.0f;
+    synthVoices_[idx]->setLoFiAmount(loFiAmt);
   }
 
   if (synthEngineNames_[idx] == targetName) {
@@ -958,67 +1124,88 @@ std::string MiniAcid::currentSynthEngineName(int voiceIndex) const {
 }
 
 
+// Indexed like getAvailableDrumEngines().
+static const char* const kDrumEngineNames[] = {"808", "909", "606", "CR78", "KPR77", "SP12"};
+static constexpr int kDrumEngineCount = sizeof(kDrumEngineNames) / sizeof(kDrumEngineNames[0]);
+
 void MiniAcid::setDrumEngine(const std::string& engineName) {
   std::string name = toLowerCopy(engineName);
-  std::string targetEngine;
+  int kind = -1;
   if (name.find("909") != std::string::npos) {
-    targetEngine = "909";
+    kind = 1;
   } else if (name.find("606") != std::string::npos) {
-    targetEngine = "606";
+    kind = 2;
   } else if (name.find("808") != std::string::npos) {
-    targetEngine = "808";
+    kind = 0;
   } else if (name.find("cr78") != std::string::npos) {
-    targetEngine = "CR78";
+    kind = 3;
   } else if (name.find("kpr77") != std::string::npos) {
-    targetEngine = "KPR77";
+    kind = 4;
   } else if (name.find("sp12") != std::string::npos) {
-    targetEngine = "SP12";
+    kind = 5;
   }
   LOG_DEBUG("    - MiniAcid::setDrumEngine: setting to %s\n", name.c_str());
-  if (targetEngine.empty()) {
+  if (kind < 0) {
     LOG_PRINTLN("    - MiniAcid::setDrumEngine: Unknown engine!");
     return;
   }
-  if (drums && drumEngineName_ == targetEngine) {
-    return;
-  }
 
-  if (targetEngine == "909") {
-    drums = std::make_unique<TR909DrumSynthVoice>(sampleRateValue);
-    drumEngineName_ = "909";
-  } else if (targetEngine == "606") {
-    drums = std::make_unique<TR606DrumSynthVoice>(sampleRateValue);
-    drumEngineName_ = "606";
-  } else if (targetEngine == "808") {
-    drums = std::make_unique<TR808DrumSynthVoice>(sampleRateValue);
-    drumEngineName_ = "808";
-  } else if (targetEngine == "CR78") {
-    drums = std::make_unique<CR78DrumSynthVoice>(sampleRateValue);
-    drumEngineName_ = "CR78";
-  } else if (targetEngine == "KPR77") {
-    drums = std::make_unique<KPR77DrumSynthVoice>(sampleRateValue);
-    drumEngineName_ = "KPR77";
-  } else if (targetEngine == "SP12") {
-    drums = std::make_unique<SP12DrumSynthVoice>(sampleRateValue);
-    drumEngineName_ = "SP12";
-  }
-  if (drums) {
-    LOG_PRINTLN("    - MiniAcid::setDrumEngine: resetting drums...");
-    drums->reset();
+  if (postCommand_(AudioCommandType::SetDrumEngine, 0, static_cast<int16_t>(kind))) return;
+  selectDrumKit_(kind);
+}
+
+void MiniAcid::selectDrumKit_(int kind) {
+  // Every kit is pre-built in drumKits_, so this is safe on the audio thread.
+  if (kind < 0 || kind >= kDrumEngineCount) return;
+  if (deferDrumEvent_(DrumEventType::SelectKit, kind, 0.0f)) return;
+  if (kind == drumKitIndex_) return;
+  drums = drumKits_.kit(kind);
+  drumKitIndex_ = kind;
+  drums->reset();
+  // Pooled kits keep old lo-fi settings; bring the new one in line.
+  setDrumLoFi_(drumLoFiEnabled_, drumLoFiAmount_);
+}
+
+void MiniAcid::setDrumLoFi_(bool enabled, float amount) {
+  drumLoFiEnabled_ = enabled;
+  drumLoFiAmount_ = amount;
+  if (!drums) return;
+  drums->setLoFiMode(enabled && appliedQualityTier_ < QualityTier::Lite);
+  drums->setLoFiAmount(amount);
+}
+
+void MiniAcid::applyQualityTier_(QualityTier tier) {
+  const bool eco = tier >= QualityTier::Eco;
+  const bool lite = tier >= QualityTier::Lite;
+  const bool minimal = tier >= QualityTier::Minimal;
+  // Coming back from a bypass: drop the stale tail instead of replaying it.
+  if (!minimal && appliedQualityTier_ >= QualityTier::Minimal) drumReverb.reset();
+
+  appliedQualityTier_ = tier;
+  drumReverb.setHalfRate(eco);
+  if (tapeFX) tapeFX->setEconomy(eco);
+  for (int v = 0; v < NUM_303_VOICES; ++v) {
+    if (synthVoices_[v]) synthVoices_[v]->setLiteMode(lite);
   }
+  setDrumLoFi_(drumLoFiEnabled_, drumLoFiAmount_);
+  perfStats.qualityTier = static_cast<uint8_t>(tier);
+  LOG_DEBUG("[Audio] quality tier -> %s (predicted load %d%%)\n", qualityTierName(tier),
+            static_cast<int>(qualityGovernor_.predictedLoad() * 100.0f));
 }
 
 std::string MiniAcid::currentDrumEngineName() const {
-  return drumEngineName_;
+  return kDrumEngineNames[drumKitIndex_];
 }
 
 // Thread-safe waveform buffer access for UI
 const MiniAcid::WaveformBuffer& MiniAcid::getWaveformBuffer() const {
   int idx = displayBufferIndex_.load(std::memory_order_acquire);
+  waveformWanted_.store(true, std::memory_order_release);
   return waveformBuffers_[idx];
 }
 
 void MiniAcid::toggleMute303(int voiceIndex) {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(clamp303Voice(voiceIndex)))) return;
   int idx = clamp303Voice(voiceIndex);
   bool muted;
   if (idx == 0) {
@@ -1031,39 +1218,48 @@ void MiniAcid::toggleMute303(int voiceIndex) {
   LedManager::instance().onMuteChanged(muted, sceneManager_.currentScene().led);
 }
 void MiniAcid::toggleMuteKick() {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(VoiceId::DrumKick))) return;
   muteKick = !muteKick;
   LedManager::instance().onMuteChanged(muteKick, sceneManager_.currentScene().led);
 }
 void MiniAcid::toggleMuteSnare() {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(VoiceId::DrumSnare))) return;
   muteSnare = !muteSnare;
   LedManager::instance().onMuteChanged(muteSnare, sceneManager_.currentScene().led);
 }
 void MiniAcid::toggleMuteHat() {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(VoiceId::DrumHatC))) return;
   muteHat = !muteHat;
   LedManager::instance().onMuteChanged(muteHat, sceneManager_.currentScene().led);
 }
 void MiniAcid::toggleMuteOpenHat() {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(VoiceId::DrumHatO))) return;
   muteOpenHat = !muteOpenHat;
   LedManager::instance().onMuteChanged(muteOpenHat, sceneManager_.currentScene().led);
 }
 void MiniAcid::toggleMuteMidTom() {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(VoiceId::DrumTomM))) return;
   muteMidTom = !muteMidTom;
   LedManager::instance().onMuteChanged(muteMidTom, sceneManager_.currentScene().led);
 }
 void MiniAcid::toggleMuteHighTom() {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(VoiceId::DrumTomH))) return;
   muteHighTom = !muteHighTom;
   LedManager::instance().onMuteChanged(muteHighTom, sceneManager_.currentScene().led);
 }
 void MiniAcid::toggleMuteRim() {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(VoiceId::DrumRim))) return;
   muteRim = !muteRim;
   LedManager::instance().onMuteChanged(muteRim, sceneManager_.currentScene().led);
 }
 void MiniAcid::toggleMuteClap() {
+  if (postCommand_(AudioCommandType::ToggleMute, static_cast<int16_t>(VoiceId::DrumClap))) return;
   muteClap = !muteClap;
   LedManager::instance().onMuteChanged(muteClap, sceneManager_.currentScene().led);
 }
 
 void MiniAcid::setMute303(int voiceIndex, bool muted) {
+  if (postCommand_(AudioCommandType::SetMute303, static_cast<int16_t>(voiceIndex), muted)) return;
   int idx = clamp303Voice(voiceIndex);
   if (idx == 0) mute303 = muted;
   else mute303_2 = muted;
@@ -1087,6 +1283,7 @@ bool MiniAcid::isTrackActive(int index) const {
 }
 
 void MiniAcid::setTrackVolume(VoiceId id, float volume) {
+    if (postCommand_(AudioCommandType::SetTrackVolume, static_cast<int16_t>(id), 0, volume)) return;
     sceneManager_.setTrackVolume((int)id, volume);
 }
 
@@ -1095,6 +1292,7 @@ float MiniAcid::getTrackVolume(VoiceId id) const {
 }
 
 void MiniAcid::toggleDelay303(int voiceIndex) {
+  if (postCommand_(AudioCommandType::ToggleDelay303, static_cast<int16_t>(voiceIndex))) return;
   int idx = clamp303Voice(voiceIndex);
   if (idx == 0) {
     delay303Enabled = !delay303Enabled;
@@ -1105,6 +1303,7 @@ void MiniAcid::toggleDelay303(int voiceIndex) {
   }
 }
 void MiniAcid::toggleDistortion303(int voiceIndex) {
+  if (postCommand_(AudioCommandType::ToggleDistortion303, static_cast<int16_t>(voiceIndex))) return;
   int idx = clamp303Voice(voiceIndex);
   if (idx == 0) {
     distortion303Enabled = !distortion303Enabled;
@@ -1116,6 +1315,7 @@ void MiniAcid::toggleDistortion303(int voiceIndex) {
 }
 
 void MiniAcid::set303DelayEnabled(int voiceIndex, bool enabled) {
+  if (postCommand_(AudioCommandType::Set303Delay, static_cast<int16_t>(voiceIndex), enabled)) return;
   int idx = clamp303Voice(voiceIndex);
   if (idx == 0) {
     delay303Enabled = enabled;
@@ -1127,6 +1327,7 @@ void MiniAcid::set303DelayEnabled(int voiceIndex, bool enabled) {
 }
 
 void MiniAcid::set303DistortionEnabled(int voiceIndex, bool enabled) {
+  if (postCommand_(AudioCommandType::Set303Distortion, static_cast<int16_t>(voiceIndex), enabled)) return;
   int idx = clamp303Voice(voiceIndex);
   if (idx == 0) {
     distortion303Enabled = enabled;
@@ -1138,10 +1339,21 @@ void MiniAcid::set303DistortionEnabled(int voiceIndex, bool enabled) {
 }
 
 void MiniAcid::setDrumPatternIndex(int16_t patternIndex) {
+  if (postCommand_(AudioCommandType::SetDrumPatternIndex, patternIndex)) {
+    cueSelection_().drumPattern = clampSelectionPattern(patternIndex);
+    publishPatterns();
+    return;
+  }
   sceneManager_.setCurrentDrumPatternIndex(patternIndex);
 }
 
 void MiniAcid::shiftDrumPatternIndex(int delta) {
+  if (postCommand_(AudioCommandType::ShiftDrumPatternIndex, static_cast<int16_t>(delta))) {
+    PatternSelection& cue = cueSelection_();
+    cue.drumPattern = wrapSelectionPattern(cue.drumPattern + delta);
+    publishPatterns();
+    return;
+  }
   int current = sceneManager_.getCurrentDrumPatternIndex();
   int next = current + delta;
   if (next < 0) next = Bank<DrumPatternSet>::kPatterns - 1;
@@ -1150,16 +1362,24 @@ void MiniAcid::shiftDrumPatternIndex(int delta) {
 }
 
 void MiniAcid::setDrumBankIndex(int bankIndex) {
+  if (postCommand_(AudioCommandType::SetDrumBankIndex, static_cast<int16_t>(bankIndex))) {
+    cueSelection_().drumBank = clampSelectionBank(bankIndex);
+    publishPatterns();
+    return;
+  }
   sceneManager_.setCurrentBankIndex(0, bankIndex);
 }
 
 void MiniAcid::adjust303Parameter(TB303ParamId id, int steps, int voiceIndex) {
+  if (postCommand_(AudioCommandType::Adjust303Parameter, static_cast<int16_t>(voiceIndex), static_cast<int16_t>(id), static_cast<float>(steps))) return;
   if (TB303Voice* v303 = tb303Voice(voiceIndex)) v303->adjustParameter(id, steps);
 }
 void MiniAcid::set303Parameter(TB303ParamId id, float value, int voiceIndex) {
+  if (postCommand_(AudioCommandType::Set303Parameter, static_cast<int16_t>(voiceIndex), static_cast<int16_t>(id), value)) return;
   if (TB303Voice* v303 = tb303Voice(voiceIndex)) v303->setParameter(id, value);
 }
 void MiniAcid::set303ParameterNormalized(TB303ParamId id, float norm, int voiceIndex) {
+  if (postCommand_(AudioCommandType::Set303ParameterNormalized, static_cast<int16_t>(voiceIndex), static_cast<int16_t>(id), norm)) return;
   int idx = clamp303Voice(voiceIndex);
   if (synthVoices_[idx]) {
       synthVoices_[idx]->setParameterNormalized(static_cast<uint8_t>(id), norm);
@@ -1167,10 +1387,21 @@ void MiniAcid::set303ParameterNormalized(TB303ParamId id, float norm, int voiceI
 }
 void MiniAcid::set303PatternIndex(int voiceIndex, int16_t patternIndex) {
   int idx = clamp303Voice(voiceIndex);
+  if (postCommand_(AudioCommandType::Set303PatternIndex, static_cast<int16_t>(voiceIndex), patternIndex)) {
+    cueSelection_().synthPattern[idx] = clampSelectionPattern(patternIndex);
+    publishPatterns();
+    return;
+  }
   sceneManager_.setCurrentSynthPatternIndex(idx, patternIndex);
 }
 void MiniAcid::shift303PatternIndex(int voiceIndex, int delta) {
   int idx = clamp303Voice(voiceIndex);
+  if (postCommand_(AudioCommandType::Shift303PatternIndex, static_cast<int16_t>(voiceIndex), static_cast<int16_t>(delta))) {
+    PatternSelection& cue = cueSelection_();
+    cue.synthPattern[idx] = wrapSelectionPattern(cue.synthPattern[idx] + delta);
+    publishPatterns();
+    return;
+  }
   int current = sceneManager_.getCurrentSynthPatternIndex(idx);
   int next = current + delta;
   if (next < 0) next = Bank<SynthPattern>::kPatterns - 1;
@@ -1180,6 +1411,11 @@ void MiniAcid::shift303PatternIndex(int voiceIndex, int delta) {
 
 void MiniAcid::set303BankIndex(int voiceIndex, int bankIndex) {
   int idx = clamp303Voice(voiceIndex);
+  if (postCommand_(AudioCommandType::Set303BankIndex, static_cast<int16_t>(voiceIndex), static_cast<int16_t>(bankIndex))) {
+    cueSelection_().synthBank[idx] = clampSelectionBank(bankIndex);
+    publishPatterns();
+    return;
+  }
   sceneManager_.setCurrentBankIndex(idx + 1, bankIndex);
 }
 
@@ -1338,7 +1574,6 @@ void MiniAcid::setupDrumStepFx_(int voiceIdx, uint8_t fx, uint8_t fxParam, uint8
     rs.countRemaining = fxParam;
     rs.interval = (int)(samplesPerStep_ / (fxParam + 1));
     if (rs.interval < 1) rs.interval = 1;
-    rs.counter = rs.interval;
     rs.active = true;
   } else if (fx == DRUM_FX_FLAM) {
     // Flam: one extra hit after fxParam ticks (24 ticks per 16th step).
@@ -1347,7 +1582,6 @@ void MiniAcid::setupDrumStepFx_(int voiceIdx, uint8_t fx, uint8_t fxParam, uint8
     rs.countRemaining = 1;
     rs.interval = (int)((samplesPerStep_ * gapTicks) / 24.0f);
     if (rs.interval < 1) rs.interval = 1;
-    rs.counter = rs.interval;
     rs.flamGhostVelocity = (uint8_t)((int)velocity * 72 / 100);
     rs.active = true;
   } else if (fx == DRUM_FX_ROLL) {
@@ -1362,7 +1596,6 @@ void MiniAcid::setupDrumStepFx_(int voiceIdx, uint8_t fx, uint8_t fxParam, uint8
     rs.countRemaining = rs.rollTotal;
     rs.interval = (int)(samplesPerStep_ / hitCount);
     if (rs.interval < 1) rs.interval = 1;
-    rs.counter = rs.interval;
     rs.active = true;
   } else {
     rs.active = false;
@@ -1436,6 +1669,234 @@ const DrumPattern& MiniAcid::activeDrumPattern(int drumVoiceIndex) const {
   return set.voices[idx];
 }
 
+MiniAcid::PatternSelection MiniAcid::currentPatternSelection_() const {
+  PatternSelection sel;
+  for (int i = 0; i < NUM_303_VOICES; ++i) {
+    sel.synthBank[i] = sceneManager_.getCurrentBankIndex(i + 1);
+    sel.synthPattern[i] = sceneManager_.getCurrentSynthPatternIndex(i);
+  }
+  sel.drumBank = sceneManager_.getCurrentBankIndex(0);
+  sel.drumPattern = sceneManager_.getCurrentDrumPatternIndex();
+  return sel;
+}
+
+// Selection applySongPositionSelection() makes for a song row; tracks the
+// row leaves empty keep their pattern-mode choice.
+MiniAcid::PatternSelection MiniAcid::songRowSelection_(int position) const {
+  PatternSelection sel;
+  for (int i = 0; i < NUM_303_VOICES; ++i) {
+    SongTrack track = i == 0 ? SongTrack::SynthA : SongTrack::SynthB;
+    int pat = sceneManager_.songPatternAtSlot(songPlaybackSlot_, position, track);
+    if (pat < 0) {
+      sel.synthBank[i] = patternModeSynthBankIndex_[i];
+      sel.synthPattern[i] = patternModeSynthPatternIndex_[i];
+    } else {
+      int bank = songPatternBank(pat);
+      if (bank < 0) bank = 0;
+      if (bank >= kBankCount) bank = kBankCount - 1;
+      sel.synthBank[i] = bank;
+      sel.synthPattern[i] = songPatternIndexInBank(pat);
+    }
+  }
+  int patD = sceneManager_.songPatternAtSlot(songPlaybackSlot_, position, SongTrack::Drums);
+  if (patD < 0) {
+    sel.drumBank = patternModeDrumBankIndex_;
+    sel.drumPattern = patternModeDrumPatternIndex_;
+  } else {
+    int bank = songPatternBank(patD);
+    if (bank < 0) bank = 0;
+    if (bank >= kBankCount) bank = kBankCount - 1;
+    sel.drumBank = bank;
+    sel.drumPattern = songPatternIndexInBank(patD);
+  }
+  return sel;
+}
+
+void MiniAcid::capturePatternCopy_(PatternCopy& copy, const PatternSelection& sel, int page) {
+  const Scene& scene = sceneManager_.currentScene();
+  copy.page = page;
+  for (int i = 0; i < NUM_303_VOICES; ++i) {
+    const Bank<SynthPattern>* banks = i == 0 ? scene.synthABanks : scene.synthBBanks;
+    const SynthPattern& src = banks[clampSelectionBank(sel.synthBank[i])].patterns[clampSelectionPattern(sel.synthPattern[i])];
+    copy.synthSource[i] = &src;
+    copy.synth[i] = src;
+  }
+  const DrumPatternSet& drums = scene.drumBanks[clampSelectionBank(sel.drumBank)].patterns[clampSelectionPattern(sel.drumPattern)];
+  copy.drumSource = &drums;
+  copy.drums = drums;
+}
+
+void MiniAcid::capturePatternSnapshot_(PatternSnapshot& snap) {
+  int page = currentPageIndex();
+  PatternSelection current = currentPatternSelection_();
+  snap.active = 0;
+  capturePatternCopy_(snap.copies[0], current, page);
+  // The selection playback moves to next: a queued pattern change first,
+  // else the next song row while it is on this page.
+  PatternCopy& upcoming = snap.copies[1];
+  upcoming.page = -1;
+  // Done once the audio thread has applied it, or taken every command (a
+  // dropped one would otherwise keep the cue forever).
+  if (selectionCued_ && (std::memcmp(&cuedSelection_, &current, sizeof(current)) == 0 ||
+                         commandQueue_.empty())) {
+    selectionCued_ = false;
+  }
+  if (selectionCued_) {
+    capturePatternCopy_(upcoming, cuedSelection_, page);
+  } else if (songMode_ && playing) {
+    int next = nextSongPosition_(songPlayheadPosition_);
+    int nextPage = songRowPage_(next);
+    if (nextPage < 0 || nextPage == page) capturePatternCopy_(upcoming, songRowSelection_(next), page);
+  }
+}
+
+bool MiniAcid::copyMatchesSelection_(const PatternCopy& copy) const {
+  if (copy.page != currentPageIndex()) return false;
+  if (copy.drumSource != &sceneManager_.getCurrentDrumPattern()) return false;
+  for (int i = 0; i < NUM_303_VOICES; ++i) {
+    if (copy.synthSource[i] != &sceneManager_.getCurrentSynthPattern(i)) return false;
+  }
+  return true;
+}
+
+// UI thread, after posting a command that moves the selection: returns the
+// selection the queued commands lead to, for the setter to update before it
+// publishes, so the audio thread has the patterns when the command lands.
+MiniAcid::PatternSelection& MiniAcid::cueSelection_() {
+  if (!selectionCued_) {
+    cuedSelection_ = currentPatternSelection_();
+    selectionCued_ = true;
+  }
+  return cuedSelection_;
+}
+
+void MiniAcid::publishPatterns() {
+  // The audio thread never copies from the scene; the UI does it next frame.
+  if (onAudioThread_()) {
+    patternPublishWanted_.store(true, std::memory_order_release);
+    return;
+  }
+  // No audio thread yet: nobody else reads the front copy.
+  if (!deferToAudioThread_()) {
+    selectionCued_ = false;
+    capturePatternSnapshot_(patternSnapshots_[snapshotFront_]);
+    return;
+  }
+  // Cleared first: a request made while capturing asks again next frame.
+  patternPublishWanted_.store(false, std::memory_order_release);
+  uint8_t back = snapshotBack_;
+  capturePatternSnapshot_(patternSnapshots_[back]);
+  snapshotBack_ = snapshotMiddle_.exchange(back | kSnapshotFresh, std::memory_order_acq_rel) & kSnapshotSlotMask;
+}
+
+// Audio thread: the scene cannot be trusted yet, so play on from the current
+// copy. Either the UI may be swapping a page into the banks (until
+// servicePageSwitch_() makes it current), or genre patterns the snapshot
+// already plays are not in the scene yet (until drainAudioHandBacks()).
+bool MiniAcid::holdPatternSnapshot_() const {
+  if (!onAudioThread_()) return false;
+  return isPageLoading() || genreCommitsPending_.load(std::memory_order_acquire) > 0;
+}
+
+void MiniAcid::syncPatternSnapshot_() {
+  if (holdPatternSnapshot_()) return;
+  if (snapshotMiddle_.load(std::memory_order_acquire) & kSnapshotFresh) {
+    snapshotFront_ = snapshotMiddle_.exchange(snapshotFront_, std::memory_order_acq_rel) & kSnapshotSlotMask;
+  }
+  PatternSnapshot& front = patternSnapshots_[snapshotFront_];
+  if (copyMatchesSelection_(front.copies[front.active])) return;
+  // Pattern/bank/page selection moved (commands, song mode, paging).
+  uint8_t other = front.active ^ 1;
+  if (copyMatchesSelection_(front.copies[other])) {
+    // Published ahead of time: switch now, and have the UI prepare the
+    // selection after this one.
+    front.active = other;
+    if (onAudioThread_()) patternPublishWanted_.store(true, std::memory_order_release);
+    return;
+  }
+  if (!onAudioThread_()) {
+    // No separate audio thread: the scene is ours to read.
+    capturePatternSnapshot_(front);
+    return;
+  }
+  // The scene belongs to the UI thread: play on from the current copy until
+  // it publishes one for the new selection.
+  patternPublishWanted_.store(true, std::memory_order_release);
+}
+
+const SynthPattern& MiniAcid::playingSynthPattern_(int synthIndex) const {
+  int idx = clamp303Voice(synthIndex);
+  SongTrack track = idx == 0 ? SongTrack::SynthA : SongTrack::SynthB;
+  if (songPatternIndexForTrack(track) < 0) return kEmptySynthPattern;
+  const PatternSnapshot& front = patternSnapshots_[snapshotFront_];
+  return front.copies[front.active].synth[idx];
+}
+
+const DrumPatternSet& MiniAcid::playingDrumPatternSet_() const {
+  const PatternSnapshot& front = patternSnapshots_[snapshotFront_];
+  return front.copies[front.active].drums;
+}
+
+// Page holding the patterns of a song row, or -1 for a row without
+// synth/drum patterns. The first assigned track decides, as for auto-paging.
+int MiniAcid::songRowPage_(int position) const {
+  int firstGlobal = -1;
+  for (SongTrack track : {SongTrack::SynthA, SongTrack::SynthB, SongTrack::Drums}) {
+    firstGlobal = sceneManager_.songPatternAtSlot(songPlaybackSlot_, position, track);
+    if (firstGlobal >= 0) break;
+  }
+  return firstGlobal >= 0 ? songPatternPage(firstGlobal) : -1;
+}
+
+// Completes a pending page switch once its banks are in the scene and, while
+// the song plays, asks for the page the next row will need. The banks belong
+// to the UI thread, which swaps them in (swapInPrefetchedPage()); the audio
+// thread only makes the page current, and the snapshot follows on the next
+// step.
+void MiniAcid::servicePageSwitch_() {
+  if (isPageLoading()) {
+    int target = targetPageIndex();
+    if (target < 0) return;
+    pagePrefetcher_.prefetch(target);
+    // No separate audio thread: nothing else can be reading the banks.
+    if (!onAudioThread_()) {
+      swapInPrefetchedPage();
+      return;
+    }
+    int swapped = swappedPage_.load(std::memory_order_acquire);
+    if (swapped >= 0) finishPageSwitch_(swapped);
+    return;
+  }
+  if (!songMode_ || songPlayheadPosition_ == lookaheadSongPosition_) return;
+  lookaheadSongPosition_ = songPlayheadPosition_;
+  int page = songRowPage_(nextSongPosition_(songPlayheadPosition_));
+  if (page >= 0 && page != currentPageIndex()) pagePrefetcher_.prefetch(page);
+}
+
+bool MiniAcid::swapInPrefetchedPage() {
+  if (!isPageLoading() || swappedPage_.load(std::memory_order_acquire) >= 0) return false;
+  int target = targetPageIndex();
+  if (target < 0) return false;
+  pagePrefetcher_.prefetch(target);
+  if (!pagePrefetcher_.trySwapIn(target, currentPageIndex(), sceneManager_.currentScene())) return false;
+  if (deferToAudioThread_()) {
+    swappedPage_.store(static_cast<int8_t>(target), std::memory_order_release);
+  } else {
+    finishPageSwitch_(target);
+  }
+  return true;
+}
+
+void MiniAcid::finishPageSwitch_(int page) {
+  setCurrentPage(static_cast<int8_t>(page));
+  swappedPage_.store(-1, std::memory_order_release);
+  // A request for yet another page made meanwhile stays pending.
+  if (targetPageIndex() == page) {
+    setTargetPage(-1);
+    setPageLoading(false);
+  }
+}
+
 int MiniAcid::clampSongPosition(int position) const {
   int len = songMode_ ? sceneManager_.songLengthAtSlot(songPlaybackSlot_) : sceneManager_.songLength();
   if (len < 1) len = 1;
@@ -1450,22 +1911,14 @@ void MiniAcid::applySongPositionSelection() {
   int pos = clampSongPosition(sceneManager_.getSongPosition());
   sceneManager_.setSongPosition(pos);
   songPlayheadPosition_ = pos;
-  int patA = sceneManager_.songPatternAtSlot(songPlaybackSlot_, pos, SongTrack::SynthA);
-  int patB = sceneManager_.songPatternAtSlot(songPlaybackSlot_, pos, SongTrack::SynthB);
-  int patD = sceneManager_.songPatternAtSlot(songPlaybackSlot_, pos, SongTrack::Drums);
   int patV = sceneManager_.songPatternAtSlot(songPlaybackSlot_, pos, SongTrack::Voice);
 
   // Check for auto-paging
-  int firstGlobal = -1;
-  if (patA >= 0) firstGlobal = patA;
-  else if (patB >= 0) firstGlobal = patB;
-  else if (patD >= 0) firstGlobal = patD;
-
-  if (firstGlobal >= 0) {
-      int tPage = songPatternPage(firstGlobal);
-      if (tPage != currentPageIndex()) {
-          requestPageSwitch(tPage);
-      }
+  int tPage = songRowPage_(pos);
+  if (tPage >= 0 && tPage != currentPageIndex()) {
+      requestPageSwitch(tPage);
+      // On the audio thread a prefetched page lands right at the row boundary.
+      if (!deferToAudioThread_()) servicePageSwitch_();
   }
 
   if (playing && patV >= 0) {
@@ -1476,41 +1929,13 @@ void MiniAcid::applySongPositionSelection() {
     }
   }
 
-  if (patA < 0) {
-    sceneManager_.setCurrentBankIndex(1, patternModeSynthBankIndex_[0]);
-    sceneManager_.setCurrentSynthPatternIndex(0, patternModeSynthPatternIndex_[0]);
-  } else {
-    int bank = songPatternBank(patA);
-    int pat = songPatternIndexInBank(patA);
-    if (bank < 0) bank = 0;
-    if (bank >= kBankCount) bank = kBankCount - 1;
-    sceneManager_.setCurrentBankIndex(1, bank);
-    sceneManager_.setCurrentSynthPatternIndex(0, pat);
-  }
-
-  if (patB < 0) {
-    sceneManager_.setCurrentBankIndex(2, patternModeSynthBankIndex_[1]);
-    sceneManager_.setCurrentSynthPatternIndex(1, patternModeSynthPatternIndex_[1]);
-  } else {
-    int bank = songPatternBank(patB);
-    int pat = songPatternIndexInBank(patB);
-    if (bank < 0) bank = 0;
-    if (bank >= kBankCount) bank = kBankCount - 1;
-    sceneManager_.setCurrentBankIndex(2, bank);
-    sceneManager_.setCurrentSynthPatternIndex(1, pat);
-  }
-
-  if (patD < 0) {
-    sceneManager_.setCurrentBankIndex(0, patternModeDrumBankIndex_);
-    sceneManager_.setCurrentDrumPatternIndex(patternModeDrumPatternIndex_);
-  } else {
-    int bank = songPatternBank(patD);
-    int pat = songPatternIndexInBank(patD);
-    if (bank < 0) bank = 0;
-    if (bank >= kBankCount) bank = kBankCount - 1;
-    sceneManager_.setCurrentBankIndex(0, bank);
-    sceneManager_.setCurrentDrumPatternIndex(pat);
+  PatternSelection sel = songRowSelection_(pos);
+  for (int i = 0; i < NUM_303_VOICES; ++i) {
+    sceneManager_.setCurrentBankIndex(i + 1, sel.synthBank[i]);
+    sceneManager_.setCurrentSynthPatternIndex(i, sel.synthPattern[i]);
   }
+  sceneManager_.setCurrentBankIndex(0, sel.drumBank);
+  sceneManager_.setCurrentDrumPatternIndex(sel.drumPattern);
 }
 
 // REWRITTEN LOGIC
@@ -1522,7 +1947,9 @@ void MiniAcid::acknowledgeRehearsal() {
   }
 }
 
-void MiniAcid::advanceSongPlayhead() {
+// Row the playhead moves to after currentPos, honouring loop range and
+// reverse. Rehearsal pauses are left to the caller.
+int MiniAcid::nextSongPosition_(int currentPos) const {
   int len = sceneManager_.songLengthAtSlot(songPlaybackSlot_);
   if (len < 1) len = 1;
 
@@ -1542,8 +1969,6 @@ void MiniAcid::advanceSongPlayhead() {
       loopEnd = tmp;
   }
 
-  // Current position (from SceneManager to be safe, though local should verify)
-  int currentPos = sceneManager_.getSongPosition();
   int nextPos = currentPos;
 
   if (loop) {
@@ -1572,6 +1997,16 @@ void MiniAcid::advanceSongPlayhead() {
           if (nextPos >= len) nextPos = 0;
       }
   }
+  return nextPos;
+}
+
+void MiniAcid::advanceSongPlayhead() {
+  int len = sceneManager_.songLengthAtSlot(songPlaybackSlot_);
+  if (len < 1) len = 1;
+
+  // Current position (from SceneManager to be safe, though local should verify)
+  int currentPos = sceneManager_.getSongPosition();
+  int nextPos = nextSongPosition_(currentPos);
 
   // REHEARSAL MODE (Pause Rows)
   // Check if next row contains the pause sentinel (-2) on any track
@@ -1626,11 +2061,11 @@ void MiniAcid::refreshDrumCache(int drumVoiceIndex) const {
 void MiniAcid::updateTickIncrement() {
   // Q32.32 math: inc = (ticksPerSec * 2^32) / sampleRate
   double ticksPerSec = (double)bpmValue * (double)kPPQN / 60.0;
-  tickPhaseInc_ = (uint64_t)((ticksPerSec * 4294967296.0) / (double)SAMPLE_RATE);
+  tickPhaseInc_ = (uint64_t)((ticksPerSec * 4294967296.0) / (double)sampleRateValue);
 
   // Legacy fallback for gate lengths and envelope durations expecting sample counts
   float effectiveSteps = 16.0f; 
-  samplesPerStep_ = (float)SAMPLE_RATE * 240.0f / (bpmValue * effectiveSteps);
+  samplesPerStep_ = sampleRateValue * 240.0f / (bpmValue * effectiveSteps);
 }
 
 float MiniAcid::noteToFreq(int note) {
@@ -1753,8 +2188,6 @@ float MiniAcid::evaluateAutomationLaneAtStep_(const AutomationLane& lane, int st
 
 void MiniAcid::applyDrumAutomationLanesForStep_(const DrumPatternSet& patternSet, int step) {
   Scene& scene = sceneManager_.currentScene();
-  static const char* kEngineByLaneValue[] = {"808", "909", "606", "CR78", "KPR77", "SP12"};
-  constexpr int kEngineCount = static_cast<int>(sizeof(kEngineByLaneValue) / sizeof(kEngineByLaneValue[0]));
 
   for (int i = 0; i < DrumPatternSet::kMaxLanes; ++i) {
     const AutomationLane& lane = patternSet.lanes[i];
@@ -1775,10 +2208,11 @@ void MiniAcid::applyDrumAutomationLanesForStep_(const DrumPatternSet& patternSet
         updateDrumTransientAttack(value);
         break;
       case DRUM_AUTOMATION_ENGINE_SWITCH: {
-        int engineIdx = static_cast<int>(value * static_cast<float>(kEngineCount));
+        // Lane value maps onto kDrumEngineNames order; no string parsing here.
+        int engineIdx = static_cast<int>(value * static_cast<float>(kDrumEngineCount));
         if (engineIdx < 0) engineIdx = 0;
-        if (engineIdx >= kEngineCount) engineIdx = kEngineCount - 1;
-        setDrumEngine(kEngineByLaneValue[engineIdx]);
+        if (engineIdx >= kDrumEngineCount) engineIdx = kDrumEngineCount - 1;
+        selectDrumKit_(engineIdx);
         break;
       }
       default:
@@ -1787,27 +2221,26 @@ void MiniAcid::applyDrumAutomationLanesForStep_(const DrumPatternSet& patternSet
   }
 }
 
-void MiniAcid::advanceTick() {
-    // Current monolithic implementation - Stage 1
-    // We trigger everything at the start of the 16th note (tick % 24 == 0)
-    processSequencerEvents(currentTick_);
-}
-
 void MiniAcid::processSequencerEvents(uint32_t absoluteTick) {
   uint32_t barTick = absoluteTick % 384;
   currentStepIndex = barTick / 24;
+  // Row first, so the downbeat already plays the new row's patterns.
+  if (barTick == 0) advanceSongStep_();
+  syncPatternSnapshot_();
 
   if (barTick == 0) {
-    advanceSongStep_();
-    // Also regenerate if needed at bar start
-    if (genreManager_.commitPendingRecipe()) {
-      regeneratePatternsWithGenre();
-    }
+    // Queued recipe change: patterns were generated when it was queued.
+    if (pendingGenreStage_) applyGenreStage_();
     LedManager::instance().onBeat(currentStepIndex, sceneManager_.currentScene().led);
   } else if (barTick % 24 == 0) {
     LedManager::instance().onBeat(currentStepIndex, sceneManager_.currentScene().led);
   }
 
+  // Drum automation lanes follow the step grid, not individual hits.
+  if (songPatternIndexForTrack(SongTrack::Drums) >= 0) {
+    applyDrumAutomationLanesForStep_(playingDrumPatternSet_(), currentStepIndex);
+  }
+
   // Timing constants
   int swingPct = sceneManager_.currentScene().feel.swingPct;
   if (swingPct < 50) swingPct = 50;
@@ -1815,9 +2248,13 @@ void MiniAcid::processSequencerEvents(uint32_t absoluteTick) {
   int swingDelay = (int)std::round((swingPct - 50.0f) * 24.0f / 50.0f);
   uint16_t swingMask = sceneManager_.currentScene().feel.swingMask;
 
-  // For efficiency, we only check steps that could logically trigger at this tick.
+  // Plan every note/hit that lands in this step's 24-tick window at its exact
+  // tick (swing + microtiming); the block scheduler turns ticks into samples.
   // Microtiming is typically ±12 ticks, so Step S can trigger in [(S-1)*24+12, (S+1)*24+12]
   // We'll check nominal, previous, and next step slots.
+  auto windowDelta = [barTick](uint32_t triggerBarTick) {
+    return (triggerBarTick + 384 - barTick) % 384;
+  };
   int nominalStep = barTick / 24;
   for (int sIdx = nominalStep - 1; sIdx <= nominalStep + 1; ++sIdx) {
     int s = (sIdx + 16) % 16;
@@ -1825,35 +2262,777 @@ void MiniAcid::processSequencerEvents(uint32_t absoluteTick) {
     
     // Synth A
     int swingA = (s % 2 != 0 && (swingMask & (1 << (int)VoiceId::SynthA))) ? swingDelay : 0;
-    int microA = activeSynthPattern(0).steps[s].timing;
-    if ((nominalT + swingA + microA + 384) % 384 == barTick) {
-       triggerSynthStep_(0, s);
+    int microA = playingSynthPattern_(0).steps[s].timing;
+    uint32_t deltaA = windowDelta((nominalT + swingA + microA + 384) % 384);
+    if (deltaA < 24) {
+       scheduleTrigger_(SeqEventType::SynthNote, absoluteTick + deltaA, 0, s);
     }
 
     // Synth B
     int swingB = (s % 2 != 0 && (swingMask & (1 << (int)VoiceId::SynthB))) ? swingDelay : 0;
-    int microB = activeSynthPattern(1).steps[s].timing;
-    if ((nominalT + swingB + microB + 384) % 384 == barTick) {
-       triggerSynthStep_(1, s);
+    int microB = playingSynthPattern_(1).steps[s].timing;
+    uint32_t deltaB = windowDelta((nominalT + swingB + microB + 384) % 384);
+    if (deltaB < 24) {
+       scheduleTrigger_(SeqEventType::SynthNote, absoluteTick + deltaB, 1, s);
     }
 
     // Drums
-    const DrumPatternSet& dSet = sceneManager_.getCurrentDrumPattern();
+    const DrumPatternSet& dSet = playingDrumPatternSet_();
     for (int v = 0; v < 8; ++v) {
         VoiceId vId = (VoiceId)((int)VoiceId::DrumKick + v);
         int swingD = (s % 2 != 0 && (swingMask & (1 << (int)vId))) ? swingDelay : 0;
         int microD = dSet.voices[v].steps[s].timing;
-        if ((nominalT + swingD + microD + 384) % 384 == barTick) {
-           triggerDrumVoice_(v, s);
+        uint32_t deltaD = windowDelta((nominalT + swingD + microD + 384) % 384);
+        if (deltaD < 24) {
+           scheduleTrigger_(SeqEventType::DrumHit, absoluteTick + deltaD, v, s);
+        }
+    }
+  }
+}
+
+
+
+void MiniAcid::beginSequencerBlock_(size_t numSamples) {
+  seqQueue_.clear();
+  blockAccum0_ = tickPhaseAccum_;
+  blockTick0_ = currentTick_;
+  blockLen_ = numSamples;
+
+  // 16th boundaries crossed by this block
+  if (tickPhaseInc_ > 0) {
+    uint32_t tick = blockTick0_ + (24u - (blockTick0_ % 24u));
+    uint16_t offset = 0;
+    while (tickOffsetInBlock_(tick, offset)) {
+      SeqEvent ev;
+      ev.type = SeqEventType::Step;
+      ev.tick = tick;
+      ev.offset = offset;
+      seqQueue_.push(ev);
+      tick += 24;
+    }
+  }
+
+  // Notes/hits planned by an earlier step that land in this block
+  int kept = 0;
+  for (int i = 0; i < pendingTriggerCount_; ++i) {
+    SeqEvent ev = pendingTriggers_[i];
+    if (tickOffsetInBlock_(ev.tick, ev.offset)) {
+      seqQueue_.push(ev);
+    } else {
+      pendingTriggers_[kept++] = ev;
+    }
+  }
+  pendingTriggerCount_ = kept;
+
+  // Gates and retrigs armed in earlier blocks
+  const uint64_t blockEnd = seqSampleClock_ + numSamples;
+  if (gateA_.armed && gateA_.releaseAt < blockEnd) scheduleAt_(SeqEventType::GateOff, 0, gateA_.releaseAt);
+  if (gateB_.armed && gateB_.releaseAt < blockEnd) scheduleAt_(SeqEventType::GateOff, 1, gateB_.releaseAt);
+  if (retrigA_.active && retrigA_.nextAt < blockEnd) scheduleAt_(SeqEventType::SynthRetrig, 0, retrigA_.nextAt);
+  if (retrigB_.active && retrigB_.nextAt < blockEnd) scheduleAt_(SeqEventType::SynthRetrig, 1, retrigB_.nextAt);
+  for (int v = 0; v < NUM_DRUM_VOICES; ++v) {
+    if (retrigDrums_[v].active && retrigDrums_[v].nextAt < blockEnd) {
+      scheduleAt_(SeqEventType::DrumRetrig, v, retrigDrums_[v].nextAt);
+    }
+  }
+}
+
+size_t MiniAcid::dispatchSequencerEvents_(size_t pos, size_t numSamples) {
+  seqNow_ = seqSampleClock_ + pos;
+  while (!seqQueue_.empty() && seqQueue_.front().offset <= pos && playing) {
+    const SeqEvent ev = seqQueue_.front();
+    seqQueue_.pop();
+    switch (ev.type) {
+      case SeqEventType::Step:
+        processSequencerEvents(ev.tick);
+        break;
+      case SeqEventType::SynthNote:
+        triggerSynthStep_(ev.voice, ev.step);
+        break;
+      case SeqEventType::DrumHit:
+        triggerDrumVoice_(ev.voice, ev.step);
+        break;
+      case SeqEventType::GateOff: {
+        GateState& gate = (ev.voice == 0) ? gateA_ : gateB_;
+        if (gate.armed && gate.releaseAt == seqNow_) {
+          gate.armed = false;
+          releaseSynth_(ev.voice);
         }
+        break;
+      }
+      case SeqEventType::SynthRetrig:
+        fireSynthRetrig_(ev.voice);
+        break;
+      case SeqEventType::DrumRetrig:
+        fireDrumRetrig_(ev.voice);
+        break;
+    }
+  }
+  if (seqQueue_.empty()) return numSamples;
+  return std::min<size_t>(seqQueue_.front().offset, numSamples);
+}
+
+void MiniAcid::endSequencerBlock_(size_t numSamples) {
+  uint64_t accum = blockAccum0_ + tickPhaseInc_ * numSamples;
+  currentTick_ = blockTick0_ + (uint32_t)(accum >> 32);
+  tickPhaseAccum_ = accum & 0xFFFFFFFFULL;
+  seqSampleClock_ += numSamples;
+}
+
+bool MiniAcid::tickOffsetInBlock_(uint32_t tick, uint16_t& offset) const {
+  // The per-sample clock adds tickPhaseInc_ before checking, so tick k (k >= 1
+  // past the block start) lands on the first sample i with
+  // accum0 + (i + 1) * inc >= k << 32.
+  if (tickPhaseInc_ == 0) return false;
+  uint32_t k = tick - blockTick0_;
+  if (k == 0 || k > 0x7FFFFFFFu) {
+    offset = 0; // already due
+    return blockLen_ > 0;
+  }
+  const uint64_t target = (uint64_t)k << 32;
+  uint64_t samples = 0;
+  if (target > blockAccum0_) {
+    samples = (target - blockAccum0_ + tickPhaseInc_ - 1) / tickPhaseInc_;
+  }
+  size_t index = samples > 0 ? (size_t)(samples - 1) : 0;
+  if (index >= blockLen_) return false;
+  offset = (uint16_t)index;
+  return true;
+}
+
+void MiniAcid::scheduleTrigger_(SeqEventType type, uint32_t tick, int voice, int step) {
+  SeqEvent ev;
+  ev.type = type;
+  ev.tick = tick;
+  ev.voice = (uint8_t)voice;
+  ev.step = (uint8_t)step;
+  if (tickOffsetInBlock_(tick, ev.offset)) {
+    // Never schedule behind the event being dispatched.
+    const uint16_t now = (uint16_t)(seqNow_ - seqSampleClock_);
+    if (ev.offset < now) ev.offset = now;
+    seqQueue_.push(ev);
+  } else if (pendingTriggerCount_ < kMaxPendingTriggers) {
+    pendingTriggers_[pendingTriggerCount_++] = ev;
+  }
+}
+
+void MiniAcid::scheduleAt_(SeqEventType type, int voice, uint64_t sampleTime) {
+  seqQueue_.remove(type, (uint8_t)voice);
+  if (sampleTime < seqSampleClock_) sampleTime = seqSampleClock_;
+  if (sampleTime >= seqSampleClock_ + blockLen_) return; // picked up by a later block
+  SeqEvent ev;
+  ev.type = type;
+  ev.voice = (uint8_t)voice;
+  ev.offset = (uint16_t)(sampleTime - seqSampleClock_);
+  seqQueue_.push(ev);
+}
+
+void MiniAcid::armGate_(int synthIdx, long durationSamples) {
+  GateState& gate = (synthIdx == 0) ? gateA_ : gateB_;
+  // The old countdown decremented on the arming sample itself.
+  if (durationSamples <= 0) {
+    gate.armed = false;
+    seqQueue_.remove(SeqEventType::GateOff, (uint8_t)synthIdx);
+    return;
+  }
+  gate.armed = true;
+  gate.releaseAt = seqNow_ + (uint64_t)(durationSamples - 1);
+  scheduleAt_(SeqEventType::GateOff, synthIdx, gate.releaseAt);
+}
+
+void MiniAcid::armRetrig_(SeqEventType type, int voice) {
+  RetrigState& rs = (type == SeqEventType::DrumRetrig) ? retrigDrums_[voice]
+                  : (voice == 0 ? retrigA_ : retrigB_);
+  if (!rs.active || rs.countRemaining <= 0) {
+    rs.active = false;
+    seqQueue_.remove(type, (uint8_t)voice);
+    return;
+  }
+  if (rs.interval < 1) rs.interval = 1;
+  rs.nextAt = seqNow_ + (uint64_t)(rs.interval - 1);
+  scheduleAt_(type, voice, rs.nextAt);
+}
+
+void MiniAcid::fireSynthRetrig_(int synthIdx) {
+  RetrigState& rs = (synthIdx == 0) ? retrigA_ : retrigB_;
+  if (!rs.active || rs.countRemaining <= 0 || rs.nextAt != seqNow_ || currentStepIndex < 0) return;
+
+  const SynthStep& step = playingSynthPattern_(synthIdx).steps[currentStepIndex];
+  startSynthNote_(synthIdx, noteToFreq(step.note), step.accent, step.slide, step.velocity);
+  LedManager::instance().onVoiceTriggered(synthIdx == 0 ? VoiceId::SynthA : VoiceId::SynthB,
+                                          sceneManager_.currentScene().led);
+  rs.countRemaining--;
+  if (rs.countRemaining <= 0) {
+    rs.active = false;
+    return;
+  }
+  rs.nextAt = seqNow_ + (uint64_t)rs.interval;
+  scheduleAt_(SeqEventType::SynthRetrig, synthIdx, rs.nextAt);
+}
+
+void MiniAcid::fireDrumRetrig_(int v) {
+  RetrigState& rs = retrigDrums_[v];
+  if (!rs.active || rs.countRemaining <= 0 || rs.nextAt != seqNow_ || currentStepIndex < 0) return;
+
+  const DrumPatternSet& patternSet = songPatternIndexForTrack(SongTrack::Drums) >= 0
+                                          ? playingDrumPatternSet_()
+                                          : kEmptyDrumPatternSet;
+  const DrumStep& step = patternSet.voices[v].steps[currentStepIndex];
+  bool accent = step.accent;
+  uint8_t trigVelocity = step.velocity;
+
+  // FLAM: a single lighter secondary hit.
+  if (rs.flamGhostVelocity > 0 && rs.rollTotal == 0) {
+    trigVelocity = rs.flamGhostVelocity;
+  }
+
+  // ROLL: crescendo across scheduled retrigs.
+  if (rs.rollTotal > 0) {
+    const int total = rs.rollTotal;
+    const int done = total - rs.countRemaining; // 0..total-1
+    const float t = (total <= 1) ? 1.0f : (float)done / (float)(total - 1);
+    const int startV = std::max(1, (int)step.velocity * 60 / 100);
+    const int endV = std::min(127, (int)step.velocity + 20);
+    int vel = startV + (int)((endV - startV) * t + 0.5f);
+    if (vel < 1) vel = 1;
+    if (vel > 127) vel = 127;
+    trigVelocity = (uint8_t)vel;
+  }
+
+  switch(v) {
+      case kDrumKickVoice: if (!muteKick) { hitDrum_(kDrumKickVoice, accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(0, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
+      case kDrumSnareVoice: if (!muteSnare) { hitDrum_(kDrumSnareVoice, accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(1, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
+      case kDrumHatVoice: if (!muteHat) { hitDrum_(kDrumHatVoice, accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(2, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
+      case kDrumOpenHatVoice: if (!muteOpenHat) { hitDrum_(kDrumOpenHatVoice, accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(3, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
+      case kDrumMidTomVoice: if (!muteMidTom) { hitDrum_(kDrumMidTomVoice, accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(4, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
+      case kDrumHighTomVoice: if (!muteHighTom) { hitDrum_(kDrumHighTomVoice, accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(5, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
+      case kDrumRimVoice: if (!muteRim) { hitDrum_(kDrumRimVoice, accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(6, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
+      case kDrumClapVoice: if (!muteClap) { hitDrum_(kDrumClapVoice, accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(7, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
+  }
+  rs.countRemaining--;
+  if (rs.countRemaining <= 0) {
+    rs.active = false;
+    return;
+  }
+  rs.nextAt = seqNow_ + (uint64_t)rs.interval;
+  scheduleAt_(SeqEventType::DrumRetrig, v, rs.nextAt);
+}
+
+void MiniAcid::renderSynthSegment_(float* out, size_t n, const float* trackVolumes) {
+  float* voiceBuf = synthVoiceBuffer_.get();
+  std::fill(out, out + n, 0.0f);
+
+  struct SynthTrack {
+    bool muted;
+    IMonoSynthVoice* voice;
+    TubeDistortion& distortion;
+    TempoDelay& delay;
+    ActivityGate& gate;
+    VoiceId id;
+  };
+  SynthTrack tracks[2] = {
+    {mute303, synthVoices_[0].get(), distortion303, delay303, synthFxGate_[0], VoiceId::SynthA},
+    {mute303_2, synthVoices_[1].get(), distortion3032, delay3032, synthFxGate_[1], VoiceId::SynthB},
+  };
+  for (SynthTrack& t : tracks) {
+    // A finished voice renders exact silence, so it is skipped outright; the
+    // track stays awake only while its delay still has repeats to play.
+    const bool live = !t.muted && t.voice && !t.voice->isIdle();
+    if (!t.gate.update(live, n, t.delay.tailSamples())) continue;
+    if (live) {
+      t.voice->processBlock(voiceBuf, n);
+      for (size_t i = 0; i < n; ++i) voiceBuf[i] *= 0.5f;
+      t.distortion.processBlock(voiceBuf, n);
+      const float vol = trackVolumes[(int)t.id];
+      for (size_t i = 0; i < n; ++i) voiceBuf[i] *= vol;
+      t.delay.processBlock(voiceBuf, n);
+      for (size_t i = 0; i < n; ++i) out[i] += voiceBuf[i];
+    } else {
+      // Silence through the (memoryless) distortion is silence; only the
+      // delay tail remains. Muted tracks decay it without being heard.
+      std::fill(voiceBuf, voiceBuf + n, 0.0f);
+      t.delay.processBlock(voiceBuf, n);
+      if (!t.muted) {
+        for (size_t i = 0; i < n; ++i) out[i] += voiceBuf[i];
+      }
+    }
+  }
+}
+
+void MiniAcid::startSynthNote_(int synthIdx, float freq, bool accent, bool slide, uint8_t velocity) {
+  if (deferSynthEvent_(SynthEventType::Note, synthIdx, freq, accent, slide, velocity)) return;
+  if (synthVoices_[synthIdx]) synthVoices_[synthIdx]->startNote(freq, accent, slide, velocity);
+}
+
+void MiniAcid::releaseSynth_(int synthIdx) {
+  if (deferSynthEvent_(SynthEventType::Release, synthIdx)) return;
+  if (synthVoices_[synthIdx]) synthVoices_[synthIdx]->release();
+}
+
+bool MiniAcid::deferSynthEvent_(SynthEventType type, int synthIdx, float freq, bool accent,
+                                bool slide, uint8_t velocity) {
+  if (!recordingEvents_) return false;
+  SynthPlan& plan = synthPlan_;
+  // Out of room: drop it, as the drum plan does.
+  if (plan.eventCount >= SynthPlan::kMaxEvents) return true;
+  SynthEvent& ev = plan.events[plan.eventCount++];
+  ev.offset = static_cast<uint16_t>(seqNow_ - seqSampleClock_);
+  ev.type = type;
+  ev.voice = static_cast<uint8_t>(synthIdx);
+  ev.velocity = velocity;
+  ev.accent = accent;
+  ev.slide = slide;
+  ev.freq = freq;
+  return true;
+}
+
+void MiniAcid::applySynthEvent_(const SynthEvent& ev) {
+  switch (ev.type) {
+    case SynthEventType::Note: startSynthNote_(ev.voice, ev.freq, ev.accent, ev.slide, ev.velocity); break;
+    case SynthEventType::Release: releaseSynth_(ev.voice); break;
+  }
+}
+
+void MiniAcid::renderSynthPlan_(float* out, size_t frames, size_t playFrames, const float* trackVolumes) {
+  const SynthPlan& plan = synthPlan_;
+  size_t pos = 0;
+  int next = 0;
+  while (pos < playFrames) {
+    while (next < plan.eventCount && plan.events[next].offset <= pos) {
+      applySynthEvent_(plan.events[next++]);
+    }
+    size_t end = playFrames;
+    if (next < plan.eventCount && plan.events[next].offset < end) end = plan.events[next].offset;
+    renderSynthSegment_(out + pos, end - pos, trackVolumes);
+    pos = end;
+  }
+  while (next < plan.eventCount) applySynthEvent_(plan.events[next++]);
+  std::fill(out + pos, out + frames, 0.0f);
+}
+
+void MiniAcid::renderDrumSegment_(float* out, size_t n, const float* trackVolumes) {
+  uint16_t muteMask = 0;
+  if (muteKick)    muteMask |= 1u << KICK;
+  if (muteSnare)   muteMask |= 1u << SNARE;
+  if (muteHat)     muteMask |= 1u << CLOSED_HAT;
+  if (muteOpenHat) muteMask |= 1u << OPEN_HAT;
+  if (muteMidTom)  muteMask |= 1u << MID_TOM;
+  if (muteHighTom) muteMask |= 1u << HIGH_TOM;
+  if (muteRim)     muteMask |= 1u << RIM;
+  if (muteClap)    muteMask |= 1u << CLAP;
+  const bool live = drums->renderBlock(out, trackVolumes + (int)VoiceId::DrumKick, muteMask, n);
+
+  // With the kit silent, the bus only has the DC blocker and reverb tails left
+  // to play; past them it sleeps and the (already cleared) bus stays zero.
+  const bool reverbOn = appliedQualityTier_ < QualityTier::Minimal;
+  const uint32_t tail = kDrumBusDcTailSamples + (reverbOn ? drumReverb.tailSamples() : 0u);
+  if (!drumBusGate_.update(live, n, tail)) return;
+
+  // DC blocker: y[n] = x[n] - x[n-1] + 0.995 * y[n-1]
+  float prev = dcBlockPrev_;
+  float y = dcBlockOut_;
+  for (size_t i = 0; i < n; ++i) {
+    float x = out[i] * 0.60f;
+    y = x - prev + 0.995f * y;
+    prev = x;
+    out[i] = y;
+  }
+  dcBlockPrev_ = prev;
+  dcBlockOut_ = y;
+
+  // Drum Bus Processing
+  drumTransientShaper.processBlock(out, n);
+  drumCompressor.processBlock(out, n);
+  if (reverbOn) drumReverb.processBlock(out, n);
+
+  for (size_t i = 0; i < n; ++i) out[i] = softLimit(out[i]);
+
+  // Going to sleep: drop the sub-threshold residue so the next hit starts clean.
+  if (drumBusGate_.justSlept()) {
+    dcBlockPrev_ = 0.0f;
+    dcBlockOut_ = 0.0f;
+    drumTransientShaper.reset();
+    drumCompressor.reset();
+    drumReverb.reset();
+  }
+}
+
+void MiniAcid::hitDrum_(int voiceIdx, bool accent, uint8_t velocity) {
+  if (deferDrumEvent_(DrumEventType::Hit, voiceIdx, 0.0f, velocity, accent)) return;
+  switch (voiceIdx) {
+    case kDrumKickVoice: drums->triggerKick(accent, velocity); break;
+    case kDrumSnareVoice: drums->triggerSnare(accent, velocity); break;
+    case kDrumHatVoice: drums->triggerHat(accent, velocity); break;
+    case kDrumOpenHatVoice: drums->triggerOpenHat(accent, velocity); break;
+    case kDrumMidTomVoice: drums->triggerMidTom(accent, velocity); break;
+    case kDrumHighTomVoice: drums->triggerHighTom(accent, velocity); break;
+    case kDrumRimVoice: drums->triggerRim(accent, velocity); break;
+    case kDrumClapVoice: drums->triggerClap(accent, velocity); break;
+    default: break;
+  }
+}
+
+bool MiniAcid::deferDrumEvent_(DrumEventType type, int voice, float value, uint8_t velocity,
+                               bool accent) {
+  if (!recordingEvents_) return false;
+  DrumJob& job = drumJob_;
+  // Out of room: drop it rather than touch the kit the worker may be rendering.
+  if (job.eventCount >= DrumJob::kMaxEvents) return true;
+  DrumEvent& ev = job.events[job.eventCount++];
+  ev.offset = static_cast<uint16_t>(seqNow_ - seqSampleClock_);
+  ev.type = type;
+  ev.voice = static_cast<uint8_t>(voice);
+  ev.velocity = velocity;
+  ev.accent = accent;
+  ev.value = value;
+  return true;
+}
+
+void MiniAcid::applyDrumEvent_(const DrumEvent& ev) {
+  // Worker side: call the DSP directly, the public setters would post commands.
+  switch (ev.type) {
+    case DrumEventType::Hit: hitDrum_(ev.voice, ev.accent, ev.velocity); break;
+    case DrumEventType::ReverbMix: drumReverb.setMix(ev.value); break;
+    case DrumEventType::Compression:
+      drumCompressor.setAmount(ev.value);
+      drumCompressor.setEnabled(ev.value > 0.01f);
+      break;
+    case DrumEventType::TransientAttack: drumTransientShaper.setAttackAmount(ev.value); break;
+    case DrumEventType::SelectKit: selectDrumKit_(ev.voice); break;
+  }
+}
+
+void MiniAcid::runDrumJob_(void* ctx) {
+  static_cast<MiniAcid*>(ctx)->renderDrumJob_();
+}
+
+void MiniAcid::renderDrumJob_() {
+  DrumJob& job = drumJob_;
+  const uint32_t t0 = micros();
+  size_t pos = 0;
+  int next = 0;
+  while (pos < job.playFrames) {
+    while (next < job.eventCount && job.events[next].offset <= pos) {
+      applyDrumEvent_(job.events[next++]);
+    }
+    size_t end = job.playFrames;
+    if (next < job.eventCount && job.events[next].offset < end) end = job.events[next].offset;
+    renderDrumSegment_(job.out + pos, end - pos, job.trackVolumes);
+    pos = end;
+  }
+  // Events at the stop point still reach the kit, as in single-core order.
+  while (next < job.eventCount) applyDrumEvent_(job.events[next++]);
+  std::fill(job.out + pos, job.out + job.frames, 0.0f);
+  job.renderUs = micros() - t0;
+}
+
+void MiniAcid::setDualCore_(bool enabled) {
+  drumWorker_.wait();
+  if (enabled) {
+    if (!synthBusBack_) synthBusBack_.reset(new (std::nothrow) float[AUDIO_BUFFER_SAMPLES]);
+    if (!drumBusBack_) drumBusBack_.reset(new (std::nothrow) float[AUDIO_BUFFER_SAMPLES]);
+    if (!synthBusBack_ || !drumBusBack_ || !drumWorker_.begin()) {
+      LOG_PRINTLN("MiniAcid: dual-core render unavailable, staying single-core");
+      enabled = false;
     }
   }
+  dualCore_ = enabled;
+  pipeSlot_ = 0;
+  pipeHeldFrames_ = 0;
+  qualityGovernor_.setParallelDrums(enabled);
+}
+
+bool MiniAcid::deferToAudioThread_() const {
+  uintptr_t audio = audioThread_.load(std::memory_order_acquire);
+  return audio != 0 && audio != currentThreadToken();
+}
+
+bool MiniAcid::onAudioThread_() const {
+  uintptr_t audio = audioThread_.load(std::memory_order_acquire);
+  return audio != 0 && audio == currentThreadToken();
+}
+
+bool MiniAcid::pushCommand_(const AudioCommand& cmd) {
+  // Producer side doubles as the free point for objects the audio thread retired.
+  drainAudioHandBacks();
+
+  // A full queue means the audio thread is behind. Transport and song edits
+  // wait for as long as it keeps draining and only give up once it has taken
+  // nothing for half a second (audio stopped); the rest gives up after ~20 ms.
+  const bool mustDeliver = cmd.type <= AudioCommandType::QueueSongReverseToggle;
+  const int patienceMs = mustDeliver ? 500 : 20;
+  uint32_t popped = commandQueue_.popCount();
+  for (int idleMs = 0; idleMs < patienceMs; ++idleMs) {
+    if (commandQueue_.push(cmd)) return true;
+    delay(1);
+    uint32_t now = commandQueue_.popCount();
+    if (mustDeliver && now != popped) {
+      popped = now;
+      idleMs = 0;
+    }
+  }
+  ++droppedCommands_;
+  LOG_WARNING("[Audio] command queue full, dropped command %d (total %u)\n",
+            static_cast<int>(cmd.type), (unsigned)droppedCommands_);
+  return false;
+}
+
+bool MiniAcid::postCommand_(AudioCommandType type, int16_t a, int16_t b, float value) {
+  if (!deferToAudioThread_()) {
+    // Applied right here. Between blocks (a host driving generateAudioBuffer
+    // itself) the drum job for the held block may still be running, and
+    // stop() or a kit change must not reach the kit under it.
+    if (dualCore_ && drumWorker_.busy()) drumWorker_.wait();
+    return false;
+  }
+  AudioCommand cmd;
+  cmd.type = type;
+  cmd.a = a;
+  cmd.b = b;
+  cmd.value = value;
+  pushCommand_(cmd);
+  return true;
+}
+
+void MiniAcid::drainCommands_() {
+  AudioCommand cmd;
+  while (commandQueue_.pop(cmd)) applyCommand_(cmd);
+}
+
+void MiniAcid::applyCommand_(const AudioCommand& cmd) {
+  // Runs where the engine state lives, so the setters below apply directly.
+  switch (cmd.type) {
+    case AudioCommandType::Start: start(); break;
+    case AudioCommandType::Stop: stop(); break;
+    case AudioCommandType::SetBpm: setBpm(cmd.value); break;
+    case AudioCommandType::SetSongMode: setSongMode(cmd.a != 0); break;
+    case AudioCommandType::ToggleSongMode: toggleSongMode(); break;
+    case AudioCommandType::SetLoopMode: setLoopMode(cmd.a != 0); break;
+    case AudioCommandType::SetSongPosition: setSongPosition(cmd.a); break;
+    case AudioCommandType::SetLiveMixMode: setLiveMixMode(cmd.a != 0); break;
+    case AudioCommandType::ToggleLiveMixMode: toggleLiveMixMode(); break;
+    case AudioCommandType::SetLoopRange: setLoopRange(cmd.a, cmd.b); break;
+    case AudioCommandType::SetSongLength: setSongLength(cmd.a); break;
+    case AudioCommandType::SetSongPattern:
+      setSongPattern(cmd.a, static_cast<SongTrack>(cmd.b), static_cast<int16_t>(cmd.value));
+      break;
+    case AudioCommandType::ClearSongPattern: clearSongPattern(cmd.a, static_cast<SongTrack>(cmd.b)); break;
+    case AudioCommandType::SetActiveSongSlot: setActiveSongSlot(cmd.a); break;
+    case AudioCommandType::SetSongPlaybackSlot: setSongPlaybackSlot(cmd.a); break;
+    case AudioCommandType::ReplaceSong: swapInSong_(cmd.a, static_cast<Song*>(cmd.ptr)); break;
+    case AudioCommandType::InsertSongRow: insertSongRow(cmd.a); break;
+    case AudioCommandType::DeleteSongRow: deleteSongRow(cmd.a); break;
+    case AudioCommandType::SetSongReverse: setSongReverse(cmd.a != 0); break;
+    case AudioCommandType::QueueSongReverseToggle: queueSongReverseToggle(); break;
+    case AudioCommandType::SetSynthEngine:
+      applySynthEngine_(clamp303Voice(cmd.a), static_cast<SynthEngineType>(cmd.b));
+      break;
+    case AudioCommandType::SetDrumEngine: selectDrumKit_(cmd.b); break;
+    case AudioCommandType::ToggleMute:
+      switch (static_cast<VoiceId>(cmd.a)) {
+        case VoiceId::SynthA:
+        case VoiceId::SynthB: toggleMute303(cmd.a); break;
+        case VoiceId::DrumKick: toggleMuteKick(); break;
+        case VoiceId::DrumSnare: toggleMuteSnare(); break;
+        case VoiceId::DrumHatC: toggleMuteHat(); break;
+        case VoiceId::DrumHatO: toggleMuteOpenHat(); break;
+        case VoiceId::DrumTomM: toggleMuteMidTom(); break;
+        case VoiceId::DrumTomH: toggleMuteHighTom(); break;
+        case VoiceId::DrumRim: toggleMuteRim(); break;
+        case VoiceId::DrumClap: toggleMuteClap(); break;
+        default: break;
+      }
+      break;
+    case AudioCommandType::SetMute303: setMute303(cmd.a, cmd.b != 0); break;
+    case AudioCommandType::SetTrackVolume: setTrackVolume(static_cast<VoiceId>(cmd.a), cmd.value); break;
+    case AudioCommandType::ToggleDelay303: toggleDelay303(cmd.a); break;
+    case AudioCommandType::ToggleDistortion303: toggleDistortion303(cmd.a); break;
+    case AudioCommandType::Set303Delay: set303DelayEnabled(cmd.a, cmd.b != 0); break;
+    case AudioCommandType::Set303Distortion: set303DistortionEnabled(cmd.a, cmd.b != 0); break;
+    case AudioCommandType::SetDrumPatternIndex: setDrumPatternIndex(cmd.a); break;
+    case AudioCommandType::ShiftDrumPatternIndex: shiftDrumPatternIndex(cmd.a); break;
+    case AudioCommandType::SetDrumBankIndex: setDrumBankIndex(cmd.a); break;
+    case AudioCommandType::Set303PatternIndex: set303PatternIndex(cmd.a, cmd.b); break;
+    case AudioCommandType::Shift303PatternIndex: shift303PatternIndex(cmd.a, cmd.b); break;
+    case AudioCommandType::Set303BankIndex: set303BankIndex(cmd.a, cmd.b); break;
+    case AudioCommandType::Adjust303Parameter:
+      adjust303Parameter(static_cast<TB303ParamId>(cmd.b), static_cast<int>(cmd.value), cmd.a);
+      break;
+    case AudioCommandType::Set303Parameter:
+      set303Parameter(static_cast<TB303ParamId>(cmd.b), cmd.value, cmd.a);
+      break;
+    case AudioCommandType::Set303ParameterNormalized:
+      set303ParameterNormalized(static_cast<TB303ParamId>(cmd.b), cmd.value, cmd.a);
+      break;
+    case AudioCommandType::AdjustSynthParameter:
+      adjustSynthParameter(cmd.a, cmd.b, static_cast<int>(cmd.value));
+      break;
+    case AudioCommandType::DrumCompression: updateDrumCompression(cmd.value); break;
+    case AudioCommandType::DrumTransientAttack: updateDrumTransientAttack(cmd.value); break;
+    case AudioCommandType::DrumTransientSustain: updateDrumTransientSustain(cmd.value); break;
+    case AudioCommandType::DrumReverbMix: updateDrumReverbMix(cmd.value); break;
+    case AudioCommandType::DrumReverbDecay: updateDrumReverbDecay(cmd.value); break;
+    case AudioCommandType::SetGrooveboxMode: setGrooveboxMode(static_cast<GrooveboxMode>(cmd.a)); break;
+    case AudioCommandType::ToggleGrooveboxMode: toggleGrooveboxMode(); break;
+    case AudioCommandType::SetGrooveFlavor: setGrooveFlavor(cmd.a); break;
+    case AudioCommandType::ShiftGrooveFlavor: shiftGrooveFlavor(cmd.a); break;
+    case AudioCommandType::SetParameter: setParameter(static_cast<MiniAcidParamId>(cmd.a), cmd.value); break;
+    case AudioCommandType::AdjustParameter: adjustParameter(static_cast<MiniAcidParamId>(cmd.a), cmd.b); break;
+    case AudioCommandType::SetTestTone: setTestTone(cmd.a != 0); break;
+    case AudioCommandType::SetVoiceTrackMute: setVoiceTrackMute(cmd.a != 0); break;
+    case AudioCommandType::ToggleVoiceTrackMute: toggleVoiceTrackMute(); break;
+    case AudioCommandType::SetTapeMode: setTapeMode(static_cast<TapeMode>(cmd.a), cmd.b != 0); break;
+    case AudioCommandType::ClearTapeLoop: clearTapeLoop(); break;
+    case AudioCommandType::EjectTape: ejectTape(); break;
+    case AudioCommandType::ToggleTapeStutter: toggleTapeStutter(); break;
+    case AudioCommandType::StageGenrePatterns:
+      stageGenrePatterns_(std::unique_ptr<GenreStage>(static_cast<GenreStage*>(cmd.ptr)));
+      break;
+  }
 }
 
+void MiniAcid::setTapeMode(TapeMode mode, bool dubAutoExit) {
+  if (postCommand_(AudioCommandType::SetTapeMode, static_cast<int16_t>(mode), dubAutoExit)) return;
+  sceneManager_.currentScene().tape.mode = mode;
+  if (tapeLooper) {
+    tapeLooper->setDubAutoExit(dubAutoExit);
+    tapeLooper->setMode(mode);
+  }
+  lastTapeMode_ = mode;
+}
+
+void MiniAcid::clearTapeLoop() {
+  if (postCommand_(AudioCommandType::ClearTapeLoop)) return;
+  if (tapeLooper) tapeLooper->clear();
+}
+
+void MiniAcid::ejectTape() {
+  if (postCommand_(AudioCommandType::EjectTape)) return;
+  if (tapeLooper) tapeLooper->eject();
+  TapeState& tape = sceneManager_.currentScene().tape;
+  tape.mode = TapeMode::Stop;
+  tape.fxEnabled = false;
+  lastTapeMode_ = TapeMode::Stop;
+}
+
+void MiniAcid::toggleTapeStutter() {
+  if (postCommand_(AudioCommandType::ToggleTapeStutter)) return;
+  if (tapeLooper) tapeLooper->setStutter(!tapeLooper->stutterActive());
+}
+
+void MiniAcid::attachAudioThread() {
+  audioThread_.store(currentThreadToken(), std::memory_order_release);
+}
+
+void MiniAcid::detachAudioThread() {
+  drumWorker_.wait();
+  audioThread_.store(0, std::memory_order_release);
+  drainCommands_();
+  drainAudioHandBacks();
+}
+
+void MiniAcid::requestAudioConfig(const AudioConfig& config) {
+  audioConfigRequest_.store(config.sanitized().pack(), std::memory_order_release);
+}
+
+bool MiniAcid::takeAudioConfigRequest(AudioConfig& out) {
+  uint32_t packed = audioConfigRequest_.exchange(0, std::memory_order_acq_rel);
+  if (packed == 0) return false;
+  out = AudioConfig::unpack(packed);
+  return true;
+}
+
+AudioConfig MiniAcid::audioConfig() const {
+  return AudioConfig::unpack(activeAudioConfig_.load(std::memory_order_acquire));
+}
+
+bool MiniAcid::setSampleRate_(float sampleRate) {
+  sampleRateValue = sampleRate;
+  drumKits_.setSampleRate(sampleRate);
+  for (int v = 0; v < NUM_303_VOICES; ++v) {
+    if (synthVoices_[v]) synthVoices_[v]->setSampleRate(sampleRate);
+  }
+  delay303.setSampleRate(sampleRate);
+  delay3032.setSampleRate(sampleRate);
+  delay303.setBpm(bpmValue);
+  delay3032.setBpm(bpmValue);
+  drumReverb.setSampleRate(sampleRate);
+  drumReverb.reset();
+  drumTransientShaper.setSampleRate(sampleRate);
+  tapeFX->setSampleRate(sampleRate);
+  bool buffersOk = tapeLooper->setSampleRate(sampleRate);
+  if (!buffersOk) {
+    LOG_WARNING("MiniAcid: no memory for the looper at %u Hz, looper off\n", (unsigned)sampleRate);
+  }
+  // Sync the scene's looper mode back on the next block (a re-sized looper is empty).
+  tapeControlCached_ = false;
+  samplerTrack->setSampleRate(sampleRate);
+  if (sampleStore) sampleStore->setTargetSampleRate(static_cast<uint32_t>(sampleRate));
+  masterBass.setSampleRate(sampleRate);
+  setMasterOutputHighCutHz(kMasterHighCutHz);
+  updateTickIncrement();
+  return buffersOk;
+}
+
+bool MiniAcid::applyAudioConfig(const AudioConfig& config) {
+  AudioConfig next = config.sanitized();
+  const AudioConfig prev = audioConfig_;
+  drumWorker_.wait();
+  qualityTierPending_ = false;
+  bool buffersOk = true;
+  if (next.sampleRate != prev.sampleRate) buffersOk = setSampleRate_(static_cast<float>(next.sampleRate));
+  if (next.dualCore != dualCore_) setDualCore_(next.dualCore);
+  next.dualCore = dualCore_;
+
+  // The cost model is per block at the old size/rate; start it over.
+  qualityGovernor_.reset();
+  applyQualityTier_(QualityTier::Full);
+  perfStats.cpuAudioPeakPct = 0.0f;
+
+  // A fresh search when auto-tune is switched on or the rate moves; a step
+  // requested by the tuner itself keeps its history.
+  if (next.autoTune && (!prev.autoTune || next.sampleRate != prev.sampleRate ||
+                        next.blockFrames != blockTuner_.blockFrames())) {
+    blockTuner_.reset(next.blockFrames);
+  }
 
+  audioConfig_ = next;
+  activeAudioConfig_.store(next.pack(), std::memory_order_release);
+  LOG_DEBUG("MiniAcid: audio config %u Hz, %u frames%s%s\n", (unsigned)next.sampleRate,
+            (unsigned)next.blockFrames, next.autoTune ? " (auto)" : "",
+            next.dualCore ? ", dual core" : "");
+  return buffersOk;
+}
 
 void MiniAcid::generateAudioBuffer(int16_t *buffer, size_t numSamples) {
   if (!buffer || numSamples == 0) return;
+  // Scratch buffers hold one maximum-size block; render larger requests in pieces.
+  while (numSamples > (size_t)AUDIO_BUFFER_SAMPLES) {
+    generateAudioBuffer(buffer, AUDIO_BUFFER_SAMPLES);
+    buffer += AUDIO_BUFFER_SAMPLES;
+    numSamples -= AUDIO_BUFFER_SAMPLES;
+  }
+
+  // Claim the audio thread on first use, then apply everything the UI posted.
+  uintptr_t self = currentThreadToken();
+  if (audioThread_.load(std::memory_order_relaxed) != self) {
+    audioThread_.store(self, std::memory_order_release);
+  }
+  // Dual core: last block's drum job must be done before anything below
+  // touches the kit or the drum bus.
+  uint32_t tDrumWait = 0;
+  if (dualCore_) {
+    const uint32_t tWait0 = micros();
+    drumWorker_.wait();
+    tDrumWait = micros() - tWait0;
+    lastDrumJobUs_ = drumJob_.renderUs;
+    if (qualityTierPending_) {
+      qualityTierPending_ = false;
+      applyQualityTier_(qualityGovernor_.tier());
+    }
+  }
+  drainCommands_();
+  servicePageSwitch_();
 
   // Test Tone Mode (Hardware diagnostic)
   if (testToneEnabled_) {
@@ -1936,182 +3115,83 @@ void MiniAcid::generateAudioBuffer(int16_t *buffer, size_t numSamples) {
   // Cache immutable-per-buffer flags
   const float* trackVolumes = sceneManager_.currentScene().trackVolumes;
   const bool looperActive = (tapeState.mode != TapeMode::Stop);
-  const bool tapeFxEnabled = tapeState.fxEnabled;
+  const bool tapeFxEnabled = tapeState.fxEnabled && appliedQualityTier_ < QualityTier::Minimal;
   AudioDiagnostics& diag = AudioDiagnostics::instance();
   const bool diagEnabled = diag.isEnabled();
   // Fine-grained profiling is expensive, so we do it periodically.
-  const bool detailedProfile = diagEnabled && ((perfDetailCounter_++ & 0x7Fu) == 0);
+  const bool detailedProfile = detailedProfiling_ ||
+                               (diagEnabled && ((perfDetailCounter_++ & 0x7Fu) == 0));
 
-  // FX safety guard: if previous callback was near/over budget, reduce FX wet path
-  // first (Tape/Looper) to avoid audible underruns, then recover gradually.
-  const float cpuLoad = perfStats.cpuAudioPctIdeal;
-  const uint32_t underrunsNow = perfStats.audioUnderruns;
-  const bool underrunAdvanced = (underrunsNow != lastUnderrunCount_);
-  lastUnderrunCount_ = underrunsNow;
-  const bool hardOverload = underrunAdvanced || (cpuLoad > 99.0f);
-  const bool nearOverload = (cpuLoad > 92.0f);
-  if (hardOverload) {
-    fxSafetyMix_ -= 0.20f;
-    fxSafetyHold_ = 80; // hold ~80 buffers before full recovery
-  } else if (nearOverload) {
-    fxSafetyMix_ -= 0.06f;
-    fxSafetyHold_ = 40;
-  } else {
-    if (fxSafetyHold_ > 0) {
-      fxSafetyHold_--;
-    } else {
-      fxSafetyMix_ += 0.01f;
-    }
-  }
-  if (fxSafetyMix_ < 0.35f) fxSafetyMix_ = 0.35f;
-  if (fxSafetyMix_ > 1.0f) fxSafetyMix_ = 1.0f;
-
-  // Profiling accumulators (detailed sections only when diagnostics is enabled)
+  // Profiling accumulators. Synth and drum renders are always timed (a few
+  // micros() calls per block) since the quality governor's cost model needs them;
+  // the per-sample sections below only run when detailed profiling is on.
   uint32_t tVoicesTotal = 0;
   uint32_t tDrumsTotal = 0;
   uint32_t tFxTotal = 0;
   uint32_t tVocalTotal = 0;
   uint32_t tLoopStart = micros();
 
-  for (size_t i = 0; i < numSamples; ++i) {
-    if (playing) {
-      tickPhaseAccum_ += tickPhaseInc_;
-      if (tickPhaseAccum_ >= 0x100000000ULL) {
-        uint32_t ticksToAdvance = (uint32_t)(tickPhaseAccum_ >> 32);
-        tickPhaseAccum_ &= 0xFFFFFFFFULL;
-        
-        while (ticksToAdvance--) {
-          currentTick_++;
-          // For Stage 2: We trigger patterns every 24 ticks (1/16th note @ 96 PPQN)
-          if (currentTick_ % 24 == 0) {
-              advanceTick();
-          }
-        }
-      }
-      if (gateCountdownA_ > 0 && --gateCountdownA_ <= 0) if (synthVoices_[0]) synthVoices_[0]->release();
-      if (gateCountdownB_ > 0 && --gateCountdownB_ <= 0) if (synthVoices_[1]) synthVoices_[1]->release();
+  // Sequencer pass: plan the block's notes, releases and hits at their
+  // sample offsets, then render the synth bus and the drum bus from the plans.
+  // Dual core: this plans the next block into the back slots and the worker
+  // renders its drums while the synths render here; the mix below plays the
+  // block planned last time.
+  const bool pipelined = dualCore_;
+  const int planSlot = pipelined ? (pipeSlot_ ^ 1) : 0;
+  float* synthBus = planSlot ? synthBusBack_.get() : synthBusBuffer_.get();
+  float* drumBus = planSlot ? drumBusBack_.get() : drumBusBuffer_.get();
+  synthPlan_.eventCount = 0;
+  drumJob_.eventCount = 0;
+  recordingEvents_ = true;
+  size_t playFrames = 0; // frames before the transport stopped
+  if (playing) {
+    beginSequencerBlock_(numSamples);
+    while (playFrames < numSamples) {
+      size_t segEnd = dispatchSequencerEvents_(playFrames, numSamples);
+      if (!playing) break;
+      playFrames = segEnd;
     }
+    if (playing) endSequencerBlock_(numSamples);
+  }
+  recordingEvents_ = false;
+
+  DrumJob& job = drumJob_;
+  job.out = drumBus;
+  job.frames = numSamples;
+  job.playFrames = playFrames;
+  std::copy(trackVolumes, trackVolumes + (int)VoiceId::Count, job.trackVolumes);
+  const bool drumsPosted = pipelined && drumWorker_.post(&MiniAcid::runDrumJob_, this);
+
+  const uint32_t tV0 = micros();
+  renderSynthPlan_(synthBus, numSamples, playFrames, trackVolumes);
+  tVoicesTotal = micros() - tV0;
+  if (!drumsPosted) {
+    renderDrumJob_();
+    tDrumsTotal = job.renderUs;
+  }
 
-    float sample = 0.0f;
-    float sample303 = 0.0f;
-    float drumsMix = 0.0f;
-    float samplerSample = 0.0f;
-
-    // Retrig Logic (omitted for brevity in this view? No, I must keep it!)
-    // [Keeping retrig logic as it was in the file]
-    if (playing && currentStepIndex >= 0 && retrigA_.active) {
-        if (--retrigA_.counter <= 0 && retrigA_.countRemaining > 0) {
-            const SynthStep& step = activeSynthPattern(0).steps[currentStepIndex];
-            if (synthVoices_[0]) {
-                synthVoices_[0]->startNote(noteToFreq(step.note), step.accent, step.slide, step.velocity);
-            }
-            LedManager::instance().onVoiceTriggered(VoiceId::SynthA, sceneManager_.currentScene().led);
-            retrigA_.counter = retrigA_.interval;
-            retrigA_.countRemaining--;
-            if (retrigA_.countRemaining <= 0) retrigA_.active = false;
-        }
-    }
-    if (playing && currentStepIndex >= 0 && retrigB_.active) {
-        if (--retrigB_.counter <= 0 && retrigB_.countRemaining > 0) {
-            const SynthStep& step = activeSynthPattern(1).steps[currentStepIndex];
-            if (synthVoices_[1]) {
-                synthVoices_[1]->startNote(noteToFreq(step.note), step.accent, step.slide, step.velocity);
-            }
-            LedManager::instance().onVoiceTriggered(VoiceId::SynthB, sceneManager_.currentScene().led);
-            retrigB_.counter = retrigB_.interval;
-            retrigB_.countRemaining--;
-            if (retrigB_.countRemaining <= 0) retrigB_.active = false;
-        }
-    }
-    for (int v = 0; v < NUM_DRUM_VOICES; ++v) {
-        if (!playing || currentStepIndex < 0) continue;
-        if (retrigDrums_[v].active) {
-             if (--retrigDrums_[v].counter <= 0 && retrigDrums_[v].countRemaining > 0) {
-                 const DrumPattern& pattern = activeDrumPattern(v);
-                 const DrumStep& step = pattern.steps[currentStepIndex];
-                 bool accent = step.accent;
-                 uint8_t trigVelocity = step.velocity;
-
-                 // FLAM: a single lighter secondary hit.
-                 if (retrigDrums_[v].flamGhostVelocity > 0 && retrigDrums_[v].rollTotal == 0) {
-                     trigVelocity = retrigDrums_[v].flamGhostVelocity;
-                 }
-
-                 // ROLL: crescendo across scheduled retrigs.
-                 if (retrigDrums_[v].rollTotal > 0) {
-                     const int total = retrigDrums_[v].rollTotal;
-                     const int done = total - retrigDrums_[v].countRemaining; // 0..total-1
-                     const float t = (total <= 1) ? 1.0f : (float)done / (float)(total - 1);
-                     const int startV = std::max(1, (int)step.velocity * 60 / 100);
-                     const int endV = std::min(127, (int)step.velocity + 20);
-                     int vel = startV + (int)((endV - startV) * t + 0.5f);
-                     if (vel < 1) vel = 1;
-                     if (vel > 127) vel = 127;
-                     trigVelocity = (uint8_t)vel;
-                 }
-
-                 switch(v) {
-                     case kDrumKickVoice: if (!muteKick) { drums->triggerKick(accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(0, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
-                     case kDrumSnareVoice: if (!muteSnare) { drums->triggerSnare(accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(1, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
-                     case kDrumHatVoice: if (!muteHat) { drums->triggerHat(accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(2, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
-                     case kDrumOpenHatVoice: if (!muteOpenHat) { drums->triggerOpenHat(accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(3, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
-                     case kDrumMidTomVoice: if (!muteMidTom) { drums->triggerMidTom(accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(4, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
-                     case kDrumHighTomVoice: if (!muteHighTom) { drums->triggerHighTom(accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(5, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
-                     case kDrumRimVoice: if (!muteRim) { drums->triggerRim(accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(6, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
-                     case kDrumClapVoice: if (!muteClap) { drums->triggerClap(accent, trigVelocity); if(sampleStore) samplerTrack->triggerPad(7, accent?1.0f:0.6f, *sampleStore, step.fx == (uint8_t)StepFx::Reverse); } break;
-                 }
-                 retrigDrums_[v].counter = retrigDrums_[v].interval;
-                 retrigDrums_[v].countRemaining--;
-                 if (retrigDrums_[v].countRemaining <= 0) retrigDrums_[v].active = false;
-             }
-        }
+  if (pipelined) {
+    // After enabling or a block-size change nothing of this length is held
+    // yet; play silence for that one block.
+    const int playSlot = pipeSlot_;
+    synthBus = playSlot ? synthBusBack_.get() : synthBusBuffer_.get();
+    drumBus = playSlot ? drumBusBack_.get() : drumBusBuffer_.get();
+    if (pipeHeldFrames_ != numSamples) {
+      std::fill(synthBus, synthBus + numSamples, 0.0f);
+      std::fill(drumBus, drumBus + numSamples, 0.0f);
     }
+    pipeSlot_ = planSlot;
+    pipeHeldFrames_ = numSamples;
+    tDrumsTotal = lastDrumJobUs_;
+  }
 
-    uint32_t tV0 = 0;
-    if (detailedProfile) tV0 = micros();
-    if (playing) {
-      if (!mute303 && synthVoices_[0]) {
-        float v = synthVoices_[0]->process() * 0.5f;
-        v = distortion303.process(v);
-        v *= trackVolumes[(int)VoiceId::SynthA];
-        sample303 += delay303.process(v);
-      } else delay303.process(0.0f);
-      if (!mute303_2 && synthVoices_[1]) {
-        float v = synthVoices_[1]->process() * 0.5f;
-        v = distortion3032.process(v);
-        v *= trackVolumes[(int)VoiceId::SynthB];
-        sample303 += delay3032.process(v);
-      } else delay3032.process(0.0f);
-    }
-    if (detailedProfile) tVoicesTotal += (micros() - tV0);
-
-    uint32_t tD0 = 0;
-    if (detailedProfile) tD0 = micros();
-    if (playing) {
-      if (!muteKick)    drumsMix += drums->processKick() * trackVolumes[(int)VoiceId::DrumKick];
-      if (!muteSnare)   drumsMix += drums->processSnare() * trackVolumes[(int)VoiceId::DrumSnare];
-      if (!muteHat)     drumsMix += drums->processHat() * trackVolumes[(int)VoiceId::DrumHatC];
-      if (!muteOpenHat) drumsMix += drums->processOpenHat() * trackVolumes[(int)VoiceId::DrumHatO];
-      if (!muteMidTom)  drumsMix += drums->processMidTom() * trackVolumes[(int)VoiceId::DrumTomM];
-      if (!muteHighTom) drumsMix += drums->processHighTom() * trackVolumes[(int)VoiceId::DrumTomH];
-      if (!muteRim)     drumsMix += drums->processRim() * trackVolumes[(int)VoiceId::DrumRim];
-      if (!muteClap)    drumsMix += drums->processClap() * trackVolumes[(int)VoiceId::DrumClap];
-      drumsMix *= 0.60f;
-      
-      // DC blocker: y[n] = x[n] - x[n-1] + 0.995 * y[n-1]
-      dcBlockOut_ = drumsMix - dcBlockPrev_ + 0.995f * dcBlockOut_;
-      dcBlockPrev_ = drumsMix;
-      drumsMix = dcBlockOut_;
-
-      // Drum Bus Processing
-      drumsMix = drumTransientShaper.process(drumsMix);
-      drumsMix = drumCompressor.process(drumsMix);
-      drumsMix = drumReverb.process(drumsMix);
-      
-      drumsMix = softLimit(drumsMix);
-      sample += sample303 + drumsMix;
-    }
-    if (detailedProfile) tDrumsTotal += (micros() - tD0);
+  const uint32_t tMixStart = micros();
+  float* mix = synthBus;
+  for (size_t i = 0; i < numSamples; ++i) {
+    float sample303 = synthBus[i];
+    float drumsMix = drumBus[i];
+    float sample = sample303 + drumsMix;
+    float samplerSample = 0.0f;
 
     uint32_t tS0 = 0;
     if (detailedProfile) tS0 = micros();
@@ -2140,40 +3220,31 @@ void MiniAcid::generateAudioBuffer(int16_t *buffer, size_t numSamples) {
         float lv = std::min(tapeState.looperVolume, 1.0f);
         sample = sample * (1.0f - lv) + loopSample;
       } else {
-        sample += loopSample * fxSafetyMix_;
+        sample += loopSample;
       }
     }
     if (tapeFxEnabled) {
-      float wet = tapeFX->process(sample);
-      sample = sample + (wet - sample) * fxSafetyMix_;
-    }
-
-    sample *= 0.65f;
-    masterOutputLpState_ += masterOutputLpAlpha_ * (sample - masterOutputLpState_);
-    sample = masterOutputLpState_;
-    float dcIn = sample;
-    float dcOut = dcIn - dcBlockX1_ + 0.995f * dcBlockY1_;
-    dcBlockX1_ = dcIn; dcBlockY1_ = dcOut;
-    float preLimiter = dcOut;
-    float limited = softLimit(dcOut);
-    float vol = params[static_cast<int>(MiniAcidParamId::MainVolume)].value();
-    if (vol < 0.0f) vol = 0.0f;
-    if (vol > 1.8f) vol = 1.8f;
-    float finalSample = softLimit(limited * vol);
-    ditherState_ = ditherState_ * 1664525u + 1013904223u;
-    float r1 = (float)(ditherState_ & 65535) * (1.0f / 65536.0f);
-    ditherState_ = ditherState_ * 1664525u + 1013904223u;
-    float r2 = (float)(ditherState_ & 65535) * (1.0f / 65536.0f);
-    finalSample += (r1 - r2) * (1.0f / 32768.0f); 
-    if (finalSample > 1.0f) finalSample = 1.0f;
-    if (finalSample < -1.0f) finalSample = -1.0f;
-    if (diagEnabled) diag.accumulate(preLimiter, limited);
-    buffer[i] = (int16_t)(finalSample * 32767.0f);
+      sample = tapeFX->process(sample);
+    }
+    // The synth bus has been read for this sample; reuse it as the mix buffer.
+    mix[i] = sample;
     if (detailedProfile) tFxTotal += (micros() - tF0);
   }
+
+  uint32_t tM0 = 0;
+  if (detailedProfile) tM0 = micros();
+  masterBus_.filterBlock(mix, numSamples);
+  if (diagEnabled) {
+    for (size_t i = 0; i < numSamples; ++i) diag.accumulate(mix[i], MasterBus::softLimit(mix[i]));
+  }
+  masterBus_.limitBlock(mix, buffer, numSamples,
+                        params[static_cast<int>(MiniAcidParamId::MainVolume)].value());
+  if (detailedProfile) tFxTotal += (micros() - tM0);
   // seq handled by wrapper for accuracy
 
-  perfStats.dspTimeUs = (micros() - tLoopStart) + tSamplerTime;
+  const uint32_t tLoopEnd = micros();
+  // Time spent waiting on the drum core counts: it is when drums are the bottleneck.
+  perfStats.dspTimeUs = (tLoopEnd - tLoopStart) + tSamplerTime + tDrumWait;
   if (detailedProfile) {
     perfStats.dspVoicesUs = tVoicesTotal;
     perfStats.dspDrumsUs = tDrumsTotal;
@@ -2181,6 +3252,35 @@ void MiniAcid::generateAudioBuffer(int16_t *buffer, size_t numSamples) {
     perfStats.dspFxUs = tFxTotal;
   }
 
+  // Quality governor: fold this block's cost into the model and switch tiers
+  // for the next block. Sampler time counts as FX; it is the master-stage work.
+  const uint32_t underrunsNow = perfStats.audioUnderruns;
+  const bool underrunAdvanced = (underrunsNow != lastUnderrunCount_);
+  lastUnderrunCount_ = underrunsNow;
+  const float budgetUs = static_cast<float>(numSamples) * 1000000.0f / sampleRateValue;
+  if (qualityGovernor_.update(tVoicesTotal, tDrumsTotal, (tLoopEnd - tMixStart) + tSamplerTime,
+                              budgetUs, underrunAdvanced)) {
+    // The worker owns the drum side until the next block's handoff.
+    if (pipelined) qualityTierPending_ = true;
+    else applyQualityTier_(qualityGovernor_.tier());
+  }
+
+  // Block-size auto-tune: ask the platform for a new size once the tuner moves.
+  if (audioConfig_.autoTune) {
+    if (blockTunerRestart_.exchange(false, std::memory_order_acq_rel)) {
+      blockTuner_.reset(audioConfig_.blockFrames);
+    }
+    const uint32_t before = blockTuner_.blockFrames();
+    const uint32_t frames = blockTuner_.update(audioConfig_.blockFrames, perfStats.dspTimeUs,
+                                               budgetUs, underrunAdvanced,
+                                               appliedQualityTier_ != QualityTier::Full);
+    if (frames != before) {
+      AudioConfig next = audioConfig_;
+      next.blockFrames = frames;
+      requestAudioConfig(next);
+    }
+  }
+
   // Tape looper can change mode internally (e.g. REC->PLAY, safety DUB->PLAY).
   // Mirror it back into scene state so UI/state remain consistent.
   if (tapeState.mode != tapeLooper->mode()) {
@@ -2188,11 +3288,14 @@ void MiniAcid::generateAudioBuffer(int16_t *buffer, size_t numSamples) {
     lastTapeMode_ = tapeLooper->mode();
   }
 
-  size_t copyCount = std::min(numSamples, (size_t)AUDIO_BUFFER_SAMPLES);
-  memcpy(waveformBuffers_[writeBufferIndex_].data, buffer, copyCount * sizeof(int16_t));
-  waveformBuffers_[writeBufferIndex_].count = copyCount;
-  displayBufferIndex_.store(writeBufferIndex_, std::memory_order_release);
-  writeBufferIndex_ = 1 - writeBufferIndex_;
+  // Skip the copy while no scope is being drawn.
+  if (waveformWanted_.exchange(false, std::memory_order_acq_rel)) {
+    size_t copyCount = std::min(numSamples, (size_t)AUDIO_BUFFER_SAMPLES);
+    memcpy(waveformBuffers_[writeBufferIndex_].data, buffer, copyCount * sizeof(int16_t));
+    waveformBuffers_[writeBufferIndex_].count = copyCount;
+    displayBufferIndex_.store(writeBufferIndex_, std::memory_order_release);
+    writeBufferIndex_ = 1 - writeBufferIndex_;
+  }
   if (diagEnabled) diag.flushIfReady(millis());
 }
 
@@ -2216,9 +3319,11 @@ void MiniAcid::randomize303Pattern(int voiceIndex) {
     }
   }
   modeManager_.generatePattern(editSynthPattern(idx), bpmValue, recipe, behavior, idx);
+  publishPatterns();
 }
 
 void MiniAcid::setParameter(MiniAcidParamId id, float value) {
+  if (postCommand_(AudioCommandType::SetParameter, static_cast<int16_t>(id), 0, value)) return;
   params[static_cast<int>(id)].setValue(value);
   
   // Update real-time DSP parameters for voice
@@ -2229,6 +3334,7 @@ void MiniAcid::setParameter(MiniAcidParamId id, float value) {
 }
 
 void MiniAcid::adjustParameter(MiniAcidParamId id, int steps) {
+  if (postCommand_(AudioCommandType::AdjustParameter, static_cast<int16_t>(id), static_cast<int16_t>(steps))) return;
   params[static_cast<int>(id)].addSteps(steps);
   setParameter(id, params[static_cast<int>(id)].value());
 }
@@ -2238,6 +3344,7 @@ void MiniAcid::randomizeDrumPattern() {
   const auto recipe = genreManager_.getGrooveRecipe();
   const auto behavior = genreManager_.getBehavior();
   modeManager_.generateDrumPattern(sceneManager_.editCurrentDrumPattern(), recipe, behavior);
+  publishPatterns();
 }
 
 void MiniAcid::randomizeDrumVoice(int voiceIndex) {
@@ -2245,6 +3352,7 @@ void MiniAcid::randomizeDrumVoice(int voiceIndex) {
   const auto recipe = genreManager_.getGrooveRecipe();
   const auto behavior = genreManager_.getBehavior();
   modeManager_.generateDrumVoice(sceneManager_.editCurrentDrumPattern().voices[idx], idx, recipe, behavior);
+  publishPatterns();
 }
 
 // Helper to clear a step for REST
@@ -2279,21 +3387,28 @@ void MiniAcid::randomizeDrumPatternChaos() {
       
       modeManager_.generateDrumVoice(patternSet.voices[v], v, recipe, chaosBehavior);
   }
+  publishPatterns();
 }
 
 void MiniAcid::regeneratePatternsWithGenre() {
   // NOTE: applyTexture is NOT called here - it's applied separately by UI on texture change
   // This prevents double-application which would cause delta-bias drift
   syncGrooveModeToGenre();
-  
-  const auto recipe = genreManager_.getGrooveRecipe();
-  const auto behavior = genreManager_.getBehavior();
+  generateGenrePatterns_(genreManager_, editSynthPattern(0), editSynthPattern(1),
+                         sceneManager_.editCurrentDrumPattern());
+  publishPatterns();
+}
+
+void MiniAcid::generateGenrePatterns_(const GenreManager& genre, SynthPattern& bass, SynthPattern& lead,
+                                      DrumPatternSet& drums) const {
+  const auto recipe = genre.getGrooveRecipe();
+  const auto behavior = genre.getBehavior();
 
   // Regenerate 303 patterns using generative mode + structural behavior
   // Voice 0 = bass (low, repetitive), Voice 1 = lead/arp (high, melodic)
   auto bassBehavior = behavior;
   auto leadBehavior = behavior;
-  if (genreManager_.generativeMode() == GenerativeMode::Reggae) {
+  if (genre.generativeMode() == GenerativeMode::Reggae) {
     // Bass breathes on downbeats, skank/lead stays offbeat.
     bassBehavior.stepMask = 0x1111;
     bassBehavior.motifLength = 2;
@@ -2305,11 +3420,102 @@ void MiniAcid::regeneratePatternsWithGenre() {
     leadBehavior.avoidClusters = false;
     leadBehavior.forceOctaveJump = false;
   }
-  modeManager_.generatePattern(editSynthPattern(0), bpmValue, recipe, bassBehavior, 0); // Bass
-  modeManager_.generatePattern(editSynthPattern(1), bpmValue, recipe, leadBehavior, 1); // Lead
+  modeManager_.generatePattern(bass, bpmValue, recipe, bassBehavior, 0); // Bass
+  modeManager_.generatePattern(lead, bpmValue, recipe, leadBehavior, 1); // Lead
 
   // Regenerate drum pattern
-  modeManager_.generateDrumPattern(sceneManager_.editCurrentDrumPattern(), recipe, behavior);
+  modeManager_.generateDrumPattern(drums, recipe, behavior, &genre);
+}
+
+void MiniAcid::queueGenreRecipe(GenreRecipeId recipe, GenreRecipeId morphTarget, uint8_t morphAmount) {
+  auto stage = std::make_unique<GenreStage>();
+  stage->recipe = recipe;
+  stage->morphTarget = morphTarget;
+  stage->morphAmount = morphAmount;
+  // Generate against a fresh manager: the live one keeps the old recipe (and
+  // its compiled cache, which the sequencer touches) until the bar flips.
+  GenreManager next;
+  next.setGenerativeMode(genreManager_.generativeMode());
+  next.setTextureMode(genreManager_.textureMode());
+  next.setRecipe(recipe);
+  next.setMorphTarget(morphTarget);
+  next.setMorphAmount(morphAmount);
+  generateGenrePatterns_(next, stage->synth[0], stage->synth[1], stage->drums);
+
+  if (deferToAudioThread_()) {
+    AudioCommand cmd;
+    cmd.type = AudioCommandType::StageGenrePatterns;
+    cmd.ptr = stage.release();
+    if (!pushCommand_(cmd)) delete static_cast<GenreStage*>(cmd.ptr);
+    return;
+  }
+  stageGenrePatterns_(std::move(stage));
+}
+
+void MiniAcid::stageGenrePatterns_(std::unique_ptr<GenreStage> stage) {
+  if (!stage) return;
+  // A newer queue before the bar supersedes the older one.
+  retireGenreStage_(pendingGenreStage_.release());
+  pendingGenreStage_ = std::move(stage);
+}
+
+void MiniAcid::applyGenreStage_() {
+  GenreStage* stage = pendingGenreStage_.release();
+  if (onAudioThread_()) {
+    // The scene belongs to the UI thread: play the new patterns from the
+    // snapshot now and hand them back for the scene. The snapshot is held
+    // until they are there (see holdPatternSnapshot_()).
+    PatternSnapshot& snap = patternSnapshots_[snapshotFront_];
+    PatternCopy& front = snap.copies[snap.active];
+    for (int i = 0; i < NUM_303_VOICES; ++i) front.synth[i] = stage->synth[i];
+    front.drums = stage->drums;
+    stage->applied = true;
+    genreCommitsPending_.fetch_add(1, std::memory_order_acq_rel);
+    if (!retiredGenreStages_.push(stage)) {
+      // Hand-back ring full (UI thread stalled): keep playing the new
+      // patterns from the snapshot and hand them back at the next bar.
+      genreCommitsPending_.fetch_sub(1, std::memory_order_acq_rel);
+      stage->applied = false;
+      pendingGenreStage_.reset(stage);
+      return;
+    }
+  }
+  genreManager_.setRecipe(stage->recipe);
+  genreManager_.setMorphTarget(stage->morphTarget);
+  genreManager_.setMorphAmount(stage->morphAmount);
+  if (stage->applied) return;
+  // No separate audio thread: the scene is ours to write.
+  commitGenreStage_(*stage);
+  delete stage;
+}
+
+void MiniAcid::commitGenreStage_(const GenreStage& stage) {
+  editSynthPattern(0) = stage.synth[0];
+  editSynthPattern(1) = stage.synth[1];
+  sceneManager_.editCurrentDrumPattern() = stage.drums;
+  publishPatterns();
+}
+
+void MiniAcid::retireGenreStage_(GenreStage* stage) {
+  if (!stage) return;
+  // Same hand-back as drum kits: the UI thread frees it in drainAudioHandBacks().
+  if (onAudioThread_() && retiredGenreStages_.push(stage)) return;
+  delete stage;
+}
+
+void MiniAcid::drainAudioHandBacks() {
+  GenreStage* stage = nullptr;
+  while (retiredGenreStages_.pop(stage)) {
+    if (stage->applied) {
+      // Published before the count drops, so the audio thread resumes from
+      // a snapshot that has them.
+      commitGenreStage_(*stage);
+      genreCommitsPending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    delete stage;
+  }
+  Song* song = nullptr;
+  while (retiredSongs_.pop(song)) delete song;
 }
 
 void MiniAcid::syncGrooveModeToGenre() {
@@ -2329,6 +3535,7 @@ void MiniAcid::toggleAudioDiag() {
 }
 
 void MiniAcid::setGrooveboxMode(GrooveboxMode mode) {
+  if (postCommand_(AudioCommandType::SetGrooveboxMode, static_cast<int16_t>(mode))) return;
   sceneManager_.setMode(mode);
   modeManager_.setModeLocal(mode);
   syncModeToVoices();
@@ -2354,10 +3561,7 @@ void MiniAcid::syncModeToVoices() {
     }
   }
   
-  if (drums) {
-    drums->setLoFiMode(cfg.dsp.lofiDrums);
-    drums->setLoFiAmount(0.4f);
-  }
+  setDrumLoFi_(cfg.dsp.lofiDrums, 0.4f);
 }
 
 GrooveboxMode MiniAcid::grooveboxMode() const {
@@ -2365,10 +3569,12 @@ GrooveboxMode MiniAcid::grooveboxMode() const {
 }
 
 void MiniAcid::toggleGrooveboxMode() {
+  if (postCommand_(AudioCommandType::ToggleGrooveboxMode)) return;
   modeManager_.toggle();
 }
 
 void MiniAcid::setGrooveFlavor(int flavor) {
+  if (postCommand_(AudioCommandType::SetGrooveFlavor, static_cast<int16_t>(flavor))) return;
   sceneManager_.setGrooveFlavor(flavor);
   const int flv = sceneManager_.getGrooveFlavor();
   modeManager_.setFlavorLocal(flv);
@@ -2386,6 +3592,7 @@ int MiniAcid::grooveFlavor() const {
 }
 
 void MiniAcid::shiftGrooveFlavor(int delta) {
+  if (postCommand_(AudioCommandType::ShiftGrooveFlavor, static_cast<int16_t>(delta))) return;
   int flavor = sceneManager_.getGrooveFlavor() + delta;
   while (flavor < 0) flavor += 5;
   while (flavor >= 5) flavor -= 5;
@@ -2456,7 +3663,8 @@ bool MiniAcid::createNewSceneWithName(const std::string& name) {
 
 void MiniAcid::loadSceneFromStorage() {
   if (sceneStorage_) {
-    if (sceneStorage_->readScene(sceneManager_)) return;
+    // Last auto-save (snapshot + journal) if there is one, else the saved scene.
+    if (sceneStorage_->readSceneAuto(sceneManager_)) return;
     // String-based fallback REMOVED - it causes OOM on DRAM-only devices
     // If streaming parse fails, load default scene
     LOG_PRINTLN("  - loadSceneFromStorage: Streaming parse failed, loading default scene");
@@ -2470,8 +3678,19 @@ void MiniAcid::saveSceneToStorage() {
   sceneStorage_->writeScene(sceneManager_);
 }
 
+void MiniAcid::autosaveScene() {
+  if (!sceneStorage_) return;
+  syncSceneStateToManager();
+  sceneStorage_->writeSceneAuto(sceneManager_);
+}
+
 void MiniAcid::applySceneStateFromManager() {
   LOG_PRINTLN("  - MiniAcid::applySceneStateFromManager: Start");
+  // A different scene has a different load; let the block-size tuner search again.
+  blockTunerRestart_.store(true, std::memory_order_release);
+  // The scene's banks were replaced wholesale; prefetched pages are stale.
+  pagePrefetcher_.invalidate();
+  swappedPage_.store(-1, std::memory_order_release);
   
   // Reset bias tracking since scene overwrites all params
   genreManager_.resetTextureBiasTracking();
@@ -2640,7 +3859,8 @@ void MiniAcid::applySceneStateFromManager() {
 
   LOG_PRINTLN("  - MiniAcid::applySceneStateFromManager: applyFeelTexture...");
   applyTextureFromScene_();
-  
+
+  publishPatterns();
   LOG_PRINTLN("  - MiniAcid::applySceneStateFromManager: Done");
 }
 
@@ -2652,10 +3872,7 @@ void MiniAcid::applyTextureFromScene_() {
   const float lofiAmt = f.lofiEnabled ? (static_cast<float>(f.lofiAmount) / 100.0f) : 0.0f;
   if (synthVoices_[0]) synthVoices_[0]->setLoFiAmount(lofiAmt);
   if (synthVoices_[1]) synthVoices_[1]->setLoFiAmount(lofiAmt);
-  if (drums) {
-    drums->setLoFiMode(f.lofiEnabled);
-    drums->setLoFiAmount(lofiAmt);
-  }
+  setDrumLoFi_(f.lofiEnabled, lofiAmt);
 
   // --- Drive ---
   const float driveAmtNorm = f.driveEnabled ? (static_cast<float>(f.driveAmount) / 100.0f) : 0.0f;
@@ -2695,7 +3912,7 @@ void MiniAcid::applyFeelTimingFromScene_() {
 
 void MiniAcid::syncSceneStateToManager() {
   sceneManager_.setBpm(bpmValue);
-  sceneManager_.setDrumEngineName(drumEngineName_);
+  sceneManager_.setDrumEngineName(kDrumEngineNames[drumKitIndex_]);
   sceneManager_.setSynthEngineName(0, currentSynthEngineName(0));
   sceneManager_.setSynthEngineName(1, currentSynthEngineName(1));
   
@@ -2883,6 +4100,7 @@ void PatternGenerator::generateRandomDrumPattern(DrumPatternSet& patternSet) {
 }
 
 void MiniAcid::setTestTone(bool enabled) {
+  if (postCommand_(AudioCommandType::SetTestTone, enabled)) return;
   testToneEnabled_ = enabled;
   if (!enabled) {
     testTonePhase_ = 0.0f;
@@ -2947,10 +4165,12 @@ bool MiniAcid::speakCached(const char* text) {
 
 
 void MiniAcid::toggleVoiceTrackMute() {
+    if (postCommand_(AudioCommandType::ToggleVoiceTrackMute)) return;
     voiceTrackMuted_ = !voiceTrackMuted_;
 }
 
 void MiniAcid::setVoiceTrackMute(bool muted) {
+    if (postCommand_(AudioCommandType::SetVoiceTrackMute, muted)) return;
     voiceTrackMuted_ = muted;
 }
 
@@ -2961,131 +4181,6 @@ void MiniAcid::toggleAudioDiag() {
 }
   */
 
-bool MiniAcid::renderProjectToWav(const std::string& filename, std::function<void(float)> progressCallback) {
-  if (filename.empty()) return false;
-  
-  // 1. Stop Audio
-  bool wasPlaying = isPlaying();
-  stop();
-
-  // 2. Open File
-  if (SD.exists(filename.c_str())) {
-      SD.remove(filename.c_str());
-  }
-  File file = SD.open(filename.c_str(), FILE_WRITE);
-  if (!file) {
-      if (wasPlaying) start();
-      return false;
-  }
-
-  // 3. Setup Render Parameters
-  // Determine duration
-  int totalSteps = 0;
-  if (songModeEnabled()) {
-      totalSteps = songLength() * SEQ_STEPS;
-      // Reset to start of song
-      setSongPosition(0);
-      songPlayheadPosition_ = 0;
-  } else {
-      // Pattern Mode: Render 4 bars (4 patterns) = 64 steps
-      totalSteps = 64; 
-      // Reset to step 0
-      set303PatternIndex(0, current303PatternIndex(0));
-      set303PatternIndex(1, current303PatternIndex(1));
-      setDrumPatternIndex(currentDrumPatternIndex());
-  }
-  
-  if (totalSteps <= 0) totalSteps = 64; // Fallback
-
-  // Reset Engine State for rendering
-  currentStepIndex = 0;
-  tickPhaseAccum_ = 0;
-  currentTick_ = 0;
-  
-  // 4. Write WAV Header placeholder
-  WavHeader header;
-  header.sample_rate = (uint32_t)sampleRateValue;
-  header.channels = 1; // Mono output from generateAudioBuffer? CHECK
-  // generateAudioBuffer fills int16 buffer. Assuming Mono.
-  // Actually MiniAcid output is generally Mono unless platform specific.
-  // We write Mono.
-  header.byterate = header.sample_rate * 1 * 2; // Mono, 16-bit
-  header.block_align = 2; // 1 * 16/8
-  header.overall_size = 0; // Update later
-  header.data_size = 0;    // Update later
-  
-  file.write((const uint8_t*)&header, sizeof(WavHeader));
-  
-  // 5. Render Loop
-  const int kRenderBlockSize = 512;
-  int16_t buffer[kRenderBlockSize];
-  
-  // Approximate total samples
-  float sps = (sampleRateValue * 60.0f) / (bpmValue * 4.0f); 
-  // samples per beat = (SR * 60) / BPM.
-  // samples per step (1/16th) = samples per beat / 4.
-  // So samplesPerStep = (SR * 60) / (BPM * 4).
-  float samplesPerStepAvg = (sampleRateValue * 60.0f) / (bpmValue * 4.0f);
-  int expectedTotalSamples = (int)(totalSteps * samplesPerStepAvg);
-  
-  int stepsRendered = 0;
-  int currentSampleCount = 0;
-  
-  // We need to simulate playback.
-  playing = true; // Force playing flag for generateAudioBuffer
-  
-  // Hack: Reset internal counters
-  tickPhaseAccum_ = 0;
-  currentTick_ = 0;
-  
-  uint32_t bytesWritten = 0;
-  int lastStepIndex = 0;
-  int stepsAdvanced = 0;
-  
-  // We loop until we advanced enough steps
-  // We monitor 'currentStepIndex' wrapping or handled by stepsAdvanced?
-  // generateAudioBuffer updates currentStepIndex.
-  // We need to track how many times we advanced.
-  // But generateAudioBuffer doesn't expose "steps advanced".
-  // We can track step index changes?
-  // Or simpler: just render the expected number of samples.
-  
-  while (currentSampleCount < expectedTotalSamples) {
-      // Render a block
-      generateAudioBuffer(buffer, kRenderBlockSize);
-      
-      // Mono write
-      // Note: FILE system on ESP32 is sometimes slow.
-      file.write((const uint8_t*)buffer, kRenderBlockSize * sizeof(int16_t));
-      bytesWritten += kRenderBlockSize * sizeof(int16_t);
-      currentSampleCount += kRenderBlockSize;
-      
-      if (progressCallback && (currentSampleCount % (44100/2) == 0)) {
-          progressCallback((float)currentSampleCount / (float)expectedTotalSamples);
-          #if defined(ARDUINO)
-          vTaskDelay(1); // Yield to keep callback responsive / WDT happy
-          #else
-          delay(1);
-          #endif
-      }
-  }
-  
-  stop(); // Stop internal playing flag
-  if (wasPlaying) playing = true; // Restore playing state logical? No, wait for start()
-  
-  // 6. Update Header
-  header.data_size = bytesWritten;
-  header.overall_size = bytesWritten + sizeof(WavHeader) - 8;
-  file.seek(0);
-  file.write((const uint8_t*)&header, sizeof(WavHeader));
-  file.close();
-
-  // 7. Cleanup
-  if (wasPlaying) start();
-  
-  return true;
-}
-
 void MiniAcid::rotatePattern(int voiceIndex, int steps) {
     if (steps == 0) return;
     
@@ -3106,27 +4201,36 @@ void MiniAcid::rotatePattern(int voiceIndex, int steps) {
     // Also rotate slides/accents in the cache? 
     // Wait, the cache is rebuilt from pattern.steps in refreshSynthCaches.
     // So modifying pattern.steps is sufficient.
+    publishPatterns();
 }
 
 void MiniAcid::updateDrumCompression(float value) {
+  if (postCommand_(AudioCommandType::DrumCompression, 0, 0, value)) return;
+  if (deferDrumEvent_(DrumEventType::Compression, 0, value)) return;
   drumCompressor.setAmount(value);
   bool on = (value > 0.01f);
   drumCompressor.setEnabled(on);
 }
 
 void MiniAcid::updateDrumTransientAttack(float value) {
+  if (postCommand_(AudioCommandType::DrumTransientAttack, 0, 0, value)) return;
+  if (deferDrumEvent_(DrumEventType::TransientAttack, 0, value)) return;
   drumTransientShaper.setAttackAmount(value);
 }
 
 void MiniAcid::updateDrumTransientSustain(float value) {
+  if (postCommand_(AudioCommandType::DrumTransientSustain, 0, 0, value)) return;
   drumTransientShaper.setSustainAmount(value);
 }
 
 void MiniAcid::updateDrumReverbMix(float value) {
+  if (postCommand_(AudioCommandType::DrumReverbMix, 0, 0, value)) return;
+  if (deferDrumEvent_(DrumEventType::ReverbMix, 0, value)) return;
   drumReverb.setMix(value);
 }
 
 void MiniAcid::updateDrumReverbDecay(float value) {
+  if (postCommand_(AudioCommandType::DrumReverbDecay, 0, 0, value)) return;
   drumReverb.setDecay(value);
 }
 
@@ -3136,7 +4240,7 @@ void MiniAcid::triggerSynthStep_(int synthIdx, int stepIdx) {
   if (synthIdx == 0 && mute303) return;
   if (synthIdx == 1 && mute303_2) return;
 
-  const SynthPattern& pattern = activeSynthPattern(synthIdx);
+  const SynthPattern& pattern = playingSynthPattern_(synthIdx);
   const SynthStep& step = pattern.steps[stepIdx];
 
   const auto recipe = genreManager_.getGrooveRecipe();
@@ -3148,31 +4252,24 @@ void MiniAcid::triggerSynthStep_(int synthIdx, int stepIdx) {
   if (synthIdx == 1 && effectiveGateMult > 0.98f) effectiveGateMult = 0.98f;
 
   if (step.note == -2) { // TIE
-    if (synthIdx == 0 && gateCountdownA_ > 0) gateCountdownA_ += (long)(samplesPerStep_ * effectiveGateMult);
-    else if (synthIdx == 1 && gateCountdownB_ > 0) gateCountdownB_ += (long)(samplesPerStep_ * effectiveGateMult);
+    GateState& gate = (synthIdx == 0) ? gateA_ : gateB_;
+    if (gate.armed) {
+      gate.releaseAt += (uint64_t)(samplesPerStep_ * effectiveGateMult);
+      scheduleAt_(SeqEventType::GateOff, synthIdx, gate.releaseAt);
+    }
   } else if (step.note >= 0 && (!step.ghost || (rand() % 100 < 80))) {
     if (step.probability >= 100 || (rand() % 100 < step.probability)) {
-        if (synthVoices_[synthIdx]) synthVoices_[synthIdx]->startNote(noteToFreq(step.note), step.accent, step.slide, (uint8_t)step.velocity);
+        startSynthNote_(synthIdx, noteToFreq(step.note), step.accent, step.slide, (uint8_t)step.velocity);
         long dur = (long)(samplesPerStep_ * effectiveGateMult);
-        if (synthIdx == 0) {
-            gateCountdownA_ = dur;
-            retrigA_.active = false;
-            if (step.fx == (uint8_t)StepFx::Retrig && step.fxParam > 0) {
-                retrigA_.countRemaining = step.fxParam;
-                retrigA_.interval = (int)(samplesPerStep_ / (step.fxParam + 1));
-                retrigA_.counter = retrigA_.interval;
-                retrigA_.active = true;
-            }
-        } else {
-            gateCountdownB_ = dur;
-            retrigB_.active = false;
-            if (step.fx == (uint8_t)StepFx::Retrig && step.fxParam > 0) {
-                retrigB_.countRemaining = step.fxParam;
-                retrigB_.interval = (int)(samplesPerStep_ / (step.fxParam + 1));
-                retrigB_.counter = retrigB_.interval;
-                retrigB_.active = true;
-            }
+        armGate_(synthIdx, dur);
+        RetrigState& rs = (synthIdx == 0) ? retrigA_ : retrigB_;
+        rs.active = false;
+        if (step.fx == (uint8_t)StepFx::Retrig && step.fxParam > 0) {
+            rs.countRemaining = step.fxParam;
+            rs.interval = (int)(samplesPerStep_ / (step.fxParam + 1));
+            rs.active = true;
         }
+        armRetrig_(SeqEventType::SynthRetrig, synthIdx);
         LedManager::instance().onVoiceTriggered(synthIdx == 0 ? VoiceId::SynthA : VoiceId::SynthB, sceneManager_.currentScene().led);
     }
   }
@@ -3182,10 +4279,7 @@ void MiniAcid::triggerDrumVoice_(int voiceIdx, int stepIdx) {
   int songPatternDrums = songPatternIndexForTrack(SongTrack::Drums);
   if (songPatternDrums < 0) return;
 
-  const DrumPatternSet& currentDrumPatternSet = sceneManager_.getCurrentDrumPattern();
-  if (stepIdx == currentStepIndex) {
-      applyDrumAutomationLanesForStep_(currentDrumPatternSet, stepIdx);
-  }
+  const DrumPatternSet& currentDrumPatternSet = playingDrumPatternSet_();
 
   const DrumPattern& pattern = currentDrumPatternSet.voices[voiceIdx];
   const DrumStep& step = pattern.steps[stepIdx];
@@ -3210,42 +4304,42 @@ void MiniAcid::triggerDrumVoice_(int voiceIdx, int stepIdx) {
   
   switch(voiceIdx) {
     case kDrumKickVoice: 
-        drums->triggerKick(accent, (uint8_t)step.velocity);
+        hitDrum_(kDrumKickVoice, accent, (uint8_t)step.velocity);
         if (sampleStore) samplerTrack->triggerPad(0, accent ? 1.0f : 0.6f, *sampleStore, rev);
         LedManager::instance().onVoiceTriggered(VoiceId::DrumKick, sceneManager_.currentScene().led);
         break;
     case kDrumSnareVoice:
-        drums->triggerSnare(accent, (uint8_t)step.velocity);
+        hitDrum_(kDrumSnareVoice, accent, (uint8_t)step.velocity);
         if (sampleStore) samplerTrack->triggerPad(1, accent ? 1.0f : 0.6f, *sampleStore, rev);
         LedManager::instance().onVoiceTriggered(VoiceId::DrumSnare, sceneManager_.currentScene().led);
         break;
     case kDrumHatVoice:
-        drums->triggerHat(accent, (uint8_t)step.velocity);
+        hitDrum_(kDrumHatVoice, accent, (uint8_t)step.velocity);
         if (sampleStore) samplerTrack->triggerPad(2, accent ? 1.0f : 0.6f, *sampleStore, rev);
         LedManager::instance().onVoiceTriggered(VoiceId::DrumHatC, sceneManager_.currentScene().led);
         break;
     case kDrumOpenHatVoice:
-        drums->triggerOpenHat(accent, (uint8_t)step.velocity);
+        hitDrum_(kDrumOpenHatVoice, accent, (uint8_t)step.velocity);
         if (sampleStore) samplerTrack->triggerPad(3, accent ? 1.0f : 0.6f, *sampleStore, rev);
         LedManager::instance().onVoiceTriggered(VoiceId::DrumHatO, sceneManager_.currentScene().led);
         break;
     case kDrumMidTomVoice:
-        drums->triggerMidTom(accent, (uint8_t)step.velocity);
+        hitDrum_(kDrumMidTomVoice, accent, (uint8_t)step.velocity);
         if (sampleStore) samplerTrack->triggerPad(4, accent ? 1.0f : 0.6f, *sampleStore, rev);
         LedManager::instance().onVoiceTriggered(VoiceId::DrumTomM, sceneManager_.currentScene().led);
         break;
     case kDrumHighTomVoice:
-        drums->triggerHighTom(accent, (uint8_t)step.velocity);
+        hitDrum_(kDrumHighTomVoice, accent, (uint8_t)step.velocity);
         if (sampleStore) samplerTrack->triggerPad(5, accent ? 1.0f : 0.6f, *sampleStore, rev);
         LedManager::instance().onVoiceTriggered(VoiceId::DrumTomH, sceneManager_.currentScene().led);
         break;
     case kDrumRimVoice:
-        drums->triggerRim(accent, (uint8_t)step.velocity);
+        hitDrum_(kDrumRimVoice, accent, (uint8_t)step.velocity);
         if (sampleStore) samplerTrack->triggerPad(6, accent ? 1.0f : 0.6f, *sampleStore, rev);
         LedManager::instance().onVoiceTriggered(VoiceId::DrumRim, sceneManager_.currentScene().led);
         break;
     case kDrumClapVoice:
-        drums->triggerClap(accent, (uint8_t)step.velocity);
+        hitDrum_(kDrumClapVoice, accent, (uint8_t)step.velocity);
         if (sampleStore) samplerTrack->triggerPad(7, accent ? 1.0f : 0.6f, *sampleStore, rev);
         LedManager::instance().onVoiceTriggered(VoiceId::DrumClap, sceneManager_.currentScene().led);
         break;
@@ -3256,6 +4350,7 @@ void MiniAcid::triggerDrumVoice_(int voiceIdx, int stepIdx) {
   } else {
       retrigDrums_[voiceIdx].active = false;
   }
+  armRetrig_(SeqEventType::DrumRetrig, voiceIdx);
 }
 
 void MiniAcid::advanceSongStep_() {
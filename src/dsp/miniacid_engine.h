@@ -8,6 +8,7 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <atomic>
 
 #include "mode_manager.h"
 #include "src/dsp/genre_manager.h"
@@ -18,7 +19,13 @@
 #include "swappable_synth_voice.h"
 #include "mini_drumvoices.h"
 #include "tube_distortion.h"
+#include "activity_gate.h"
 #include "perf_stats.h"
+#include "quality_governor.h"
+#include "block_size_tuner.h"
+#include "master_bus.h"
+#include "seq_event_queue.h"
+#include "audio_command_queue.h"
 #include "tape_fx.h"
 #include "tape_looper.h"
 #include "../audio/audio_config.h"
@@ -30,14 +37,15 @@
 #include "../audio/vocal_mixer.h"
 #include "voice_compressor.h"
 #include "../audio/voice_cache.h"
+#include "../audio/page_prefetcher.h"
+#include "../audio/audio_worker.h"
 #include "drum_reverb.h"
 #include "one_knob_compressor.h"
 #include "transient_shaper.h"
 
 // ===================== Audio config =====================
 
-static const int SAMPLE_RATE = kSampleRate;        // Hz
-static const int AUDIO_BUFFER_SAMPLES = kBlockFrames; // per buffer, mono
+static const int AUDIO_BUFFER_SAMPLES = kMaxBlockFrames; // scratch per buffer, mono (largest block)
 static const int SEQ_STEPS = 16;             // 16-step sequencer
 static const int kPPQN = 96;                 // Pulses Per Quarter Note
 static const int NUM_303_VOICES = 2;
@@ -61,6 +69,10 @@ public:
   bool isEnabled() const;
 
   float process(float input);
+  // In-place block variant; same output as calling process() per sample.
+  void processBlock(float* buf, size_t n);
+  // Samples until the repeats of a single impulse fall below -100 dB.
+  uint32_t tailSamples() const;
 
 private:
   // for 2 voices at 22050 Hz, this is the max that the cardputer can handle.
@@ -173,6 +185,12 @@ public:
   void setTargetPage(int8_t page) { targetPage_.store(page, std::memory_order_release); }
   void setCurrentPage(int8_t page) { currentPage_.store(page, std::memory_order_release); }
   void requestPageSwitch(int pageIndex);
+  // True when page switches are served from prefetched pages.
+  bool pagePrefetchActive() const { return pagePrefetcher_.running(); }
+  // UI thread: swaps the prefetched target page into the scene's banks once
+  // it is loaded. The audio thread makes it the current page on its next
+  // block; until then it keeps playing its pattern snapshot.
+  bool swapInPrefetchedPage();
   int songLength() const;
   void setSongLength(int length);
   int currentSongPosition() const;
@@ -192,6 +210,11 @@ public:
   void toggleLiveMixMode();
   void mergeSongs();
   void alternateSongs();
+  // Replaces the active slot's song in one step (cut, paste, merge, ...).
+  // The copy is made on the caller's thread, for the slot active there; the
+  // audio thread swaps it in and hands the old song back to be freed in
+  // drainAudioHandBacks().
+  void replaceSong(const Song& song);
   void insertSongRow(int position);
   void deleteSongRow(int position);
   
@@ -223,7 +246,8 @@ public:
   bool loadSceneByName(const std::string& name);
   bool saveSceneAs(const std::string& name);
   bool createNewSceneWithName(const std::string& name);
-  bool renderProjectToWav(const std::string& filename, std::function<void(float)> progressCallback);
+  // Journals what changed since the last auto-save; cheap when little did.
+  void autosaveScene();
 
   void toggleMute303(int voiceIndex = 0);
   void setMute303(int voiceIndex, bool muted);
@@ -309,6 +333,10 @@ public:
   const TempoDelay& tempoDelay(int voiceIndex) const { return (voiceIndex == 1) ? delay3032 : delay303; }
   
   void regeneratePatternsWithGenre();  // Regenerate patterns using current genre
+  // Switch recipe at the next bar while playing. The matching patterns are
+  // generated on the caller's thread; at the bar the audio thread plays them
+  // from its snapshot and hands them back for the scene (drainAudioHandBacks()).
+  void queueGenreRecipe(GenreRecipeId recipe, GenreRecipeId morphTarget, uint8_t morphAmount);
   void syncGrooveModeToGenre();        // Align 5-mode groove macro with current generative genre
 
   Parameter& miniParameter(MiniAcidParamId id);
@@ -317,6 +345,11 @@ public:
   
   // Audio diagnostics toggle (hotkey: Ctrl+D or similar)
   void toggleAudioDiag();
+  // Fill the per-section perfStats timings on every buffer instead of every
+  // 128th (headless renderer / benchmarks; adds timer overhead).
+  void setDetailedProfiling(bool enabled) { detailedProfiling_ = enabled; }
+  // Tier picked by the CPU quality governor (also mirrored in perfStats).
+  QualityTier qualityTier() const { return appliedQualityTier_; }
   
   // Test Tone Mode (Diagnose hardware vs DSP)
   void setTestTone(bool enabled);
@@ -345,15 +378,162 @@ public:
   const VoiceCache& voiceCache() const { return voiceCache_; }
   bool speakCached(const char* text); // Play from cache or fallback to synth
 
+  // Hand the current patterns to the sequencer, which swaps them in on its
+  // next 16th step. Edits made through MiniAcidDisplay events are published
+  // for you, as are pattern/bank/song-position changes (with the selection
+  // they lead to, so the sequencer has it when the command lands); call this
+  // after editing pattern data from anywhere else. One publishing thread only
+  // (the UI thread).
+  void publishPatterns();
+  // Set by the audio thread when the pattern selection moved (song row,
+  // bank, page) and it needs a fresh copy; the UI publishes on seeing it.
+  bool patternPublishWanted() const { return patternPublishWanted_.load(std::memory_order_acquire); }
+  // UI thread, once per frame: writes genre patterns the audio thread
+  // switched to into the scene and frees what it retired.
+  void drainAudioHandBacks();
+  // Commands the audio thread never took (queue full while it was stalled);
+  // the UI reports an increase.
+  uint32_t droppedCommandCount() const { return droppedCommands_; }
+
+  // Tape looper transport; routed through the command queue like the other setters.
+  void setTapeMode(TapeMode mode, bool dubAutoExit = false);
+  void clearTapeLoop();
+  void ejectTape();
+  void toggleTapeStutter();
+
+  // Runtime audio configuration. The UI (or the block-size auto-tuner) posts a
+  // request; the platform picks it up between blocks with takeAudioConfigRequest(),
+  // re-opens its output device and calls applyAudioConfig(), which re-initializes
+  // every DSP object for the new rate. applyAudioConfig() allocates, so call it
+  // from the UI thread with the audio thread stopped or parked (and detached),
+  // never from the audio thread. Returns false when a buffer could not be had
+  // at the new rate (the looper is off until a later rate change gets one).
+  void requestAudioConfig(const AudioConfig& config);
+  bool takeAudioConfigRequest(AudioConfig& out);
+  bool applyAudioConfig(const AudioConfig& config);
+  AudioConfig audioConfig() const;
+
   void generateAudioBuffer(int16_t *buffer, size_t numSamples);
+  // Forget the audio thread (e.g. after the device is closed) so setters
+  // apply directly again. Applies anything still queued.
+  void detachAudioThread();
+  // Claim the audio thread for the caller before its first block, so setters
+  // queue again from then on (generateAudioBuffer() otherwise claims it).
+  void attachAudioThread();
 
 private:
+  // UI -> audio command queue. Setters called off the audio thread post a
+  // command instead of touching engine state; generateAudioBuffer drains it.
+  bool postCommand_(AudioCommandType type, int16_t a = 0, int16_t b = 0, float value = 0.0f);
+  bool pushCommand_(const AudioCommand& cmd);
+  bool deferToAudioThread_() const;
+  bool onAudioThread_() const;
+  void drainCommands_();
+  void applyCommand_(const AudioCommand& cmd);
+  void applySynthEngine_(int idx, SynthEngineType target);
+  void selectDrumKit_(int kind);
+  void setDrumLoFi_(bool enabled, float amount);
+  void applyQualityTier_(QualityTier tier);
+
+  // Recipe change plus the patterns generated for it, built off the audio thread.
+  struct GenreStage {
+    GenreRecipeId recipe = 0;
+    GenreRecipeId morphTarget = 0;
+    uint8_t morphAmount = 0;
+    SynthPattern synth[NUM_303_VOICES];
+    DrumPatternSet drums;
+    bool applied = false; // playing from the snapshot; the scene still needs them
+  };
+  void generateGenrePatterns_(const GenreManager& genre, SynthPattern& bass, SynthPattern& lead,
+                              DrumPatternSet& drums) const;
+  void stageGenrePatterns_(std::unique_ptr<GenreStage> stage);
+  void applyGenreStage_();
+  void commitGenreStage_(const GenreStage& stage);
+  void retireGenreStage_(GenreStage* stage);
+
+  void postSong_(int slot, std::unique_ptr<Song> song);
+  void swapInSong_(int slot, Song* song);
+
   void updateTickIncrement();
-  void advanceTick();
   void processSequencerEvents(uint32_t absoluteTick);
   void triggerSynthStep_(int synthIdx, int stepIdx);
   void triggerDrumVoice_(int voiceIdx, int stepIdx);
   void advanceSongStep_();
+  // Block scheduler: plan the block's events up front, dispatch them at their
+  // sample offsets, and render the voices in the gaps between them.
+  void beginSequencerBlock_(size_t numSamples);
+  size_t dispatchSequencerEvents_(size_t pos, size_t numSamples);
+  void endSequencerBlock_(size_t numSamples);
+  bool tickOffsetInBlock_(uint32_t tick, uint16_t& offset) const;
+  void scheduleTrigger_(SeqEventType type, uint32_t tick, int voice, int step);
+  void scheduleAt_(SeqEventType type, int voice, uint64_t sampleTime);
+  void armGate_(int synthIdx, long durationSamples);
+  void armRetrig_(SeqEventType type, int voice);
+  void fireSynthRetrig_(int synthIdx);
+  void fireDrumRetrig_(int voiceIdx);
+  void renderSynthSegment_(float* out, size_t n, const float* trackVolumes);
+  void renderDrumSegment_(float* out, size_t n, const float* trackVolumes);
+
+  // Each block starts with a sequencer pass that only records what the
+  // voices and the kit have to do, with sample offsets; the synth bus and the
+  // drum bus then render from those plans.
+  //
+  // Dual-core pipeline (see AudioConfig::dualCore): the audio thread plans
+  // block N+1, hands its drum plan and drum bus to drumWorker_, renders the
+  // synth bus for N+1 into the back slot while the worker renders the drums,
+  // then mixes block N from the front slot. wait() at the top of the next
+  // block is the handoff.
+  enum class SynthEventType : uint8_t { Note, Release };
+  struct SynthEvent {
+    uint16_t offset;
+    SynthEventType type;
+    uint8_t voice;
+    uint8_t velocity;
+    bool accent;
+    bool slide;
+    float freq;
+  };
+  struct SynthPlan {
+    static constexpr int kMaxEvents = 64;
+    SynthEvent events[kMaxEvents];
+    int eventCount = 0;
+  };
+  enum class DrumEventType : uint8_t { Hit, ReverbMix, Compression, TransientAttack, SelectKit };
+  struct DrumEvent {
+    uint16_t offset;
+    DrumEventType type;
+    uint8_t voice;    // drum voice, or kit index for SelectKit
+    uint8_t velocity;
+    bool accent;
+    float value;
+  };
+  struct DrumJob {
+    static constexpr int kMaxEvents = 128;
+    float* out = nullptr;
+    size_t frames = 0;
+    size_t playFrames = 0; // frames rendered before the transport stopped
+    float trackVolumes[(int)VoiceId::Count] = {};
+    DrumEvent events[kMaxEvents];
+    int eventCount = 0;
+    uint32_t renderUs = 0;
+  };
+
+  // Note starts and releases go straight to the voice, or into synthPlan_
+  // during the sequencer pass (deferSynthEvent_ returns true then).
+  void startSynthNote_(int synthIdx, float freq, bool accent, bool slide, uint8_t velocity);
+  void releaseSynth_(int synthIdx);
+  bool deferSynthEvent_(SynthEventType type, int synthIdx, float freq = 0.0f, bool accent = false,
+                        bool slide = false, uint8_t velocity = 0);
+  void applySynthEvent_(const SynthEvent& ev);
+  void renderSynthPlan_(float* out, size_t frames, size_t playFrames, const float* trackVolumes);
+  // Same for the kit: drum hits and drum-bus settings land in drumJob_.
+  void hitDrum_(int voiceIdx, bool accent, uint8_t velocity);
+  bool deferDrumEvent_(DrumEventType type, int voice, float value, uint8_t velocity = 0,
+                       bool accent = false);
+  void applyDrumEvent_(const DrumEvent& ev);
+  void setDualCore_(bool enabled);
+  static void runDrumJob_(void* ctx);
+  void renderDrumJob_();
 
   int timingTicksForStep_(int stepIndex) const;
   int grooveOverrideTicksForStep_(const DrumPatternSet& patternSet, int stepIndex) const;
@@ -376,16 +556,58 @@ private:
   const DrumPattern& activeDrumPattern(int drumVoiceIndex) const;
   int songPatternIndexForTrack(SongTrack track) const;
   void applySongPositionSelection();
+
+  // Bank and pattern each track plays on the current page.
+  struct PatternSelection {
+    int synthBank[NUM_303_VOICES];
+    int synthPattern[NUM_303_VOICES];
+    int drumBank;
+    int drumPattern;
+  };
+  // Copy of the patterns of one selection.
+  struct PatternCopy {
+    SynthPattern synth[NUM_303_VOICES];
+    DrumPatternSet drums;
+    // Scene slots the copies came from; a mismatch means the selection moved.
+    const SynthPattern* synthSource[NUM_303_VOICES] = {};
+    const DrumPatternSet* drumSource = nullptr;
+    int page = -1; // -1: unused
+  };
+  // What the sequencer plays, triple-buffered with the UI: the publisher
+  // fills the back slot and swaps it into the middle, the audio thread swaps
+  // the middle into the front on a step boundary. Besides the selection at
+  // publish time it carries the one playback moves to next (the next song
+  // row, or a pattern change still in the command queue), so the audio thread
+  // switches over on the step itself instead of waiting for a UI frame.
+  struct PatternSnapshot {
+    PatternCopy copies[2];
+    uint8_t active = 0;
+  };
+  PatternSelection currentPatternSelection_() const;
+  PatternSelection songRowSelection_(int position) const;
+  void capturePatternCopy_(PatternCopy& copy, const PatternSelection& sel, int page);
+  void capturePatternSnapshot_(PatternSnapshot& snap);
+  bool copyMatchesSelection_(const PatternCopy& copy) const;
+  PatternSelection& cueSelection_();
+  void syncPatternSnapshot_();
+  bool holdPatternSnapshot_() const;
+  const SynthPattern& playingSynthPattern_(int synthIndex) const;
+  const DrumPatternSet& playingDrumPatternSet_() const;
   void syncModeToVoices();
   void advanceSongPlayhead();
+  int nextSongPosition_(int currentPos) const;
+  int songRowPage_(int position) const;
+  void servicePageSwitch_();
+  void finishPageSwitch_(int page);
   int clampSongPosition(int position) const;
 
   std::unique_ptr<SwappableSynthVoice> synthVoices_[NUM_303_VOICES];
   std::string synthEngineNames_[NUM_303_VOICES];
   
-  std::unique_ptr<DrumSynthVoice> drums;
+  DrumKitPool drumKits_;
+  DrumSynthVoice* drums; // active kit, owned by drumKits_
   float sampleRateValue;
-  std::string drumEngineName_;
+  int drumKitIndex_ = 0;
 
   SceneManager sceneManager_;
   SceneStorage* sceneStorage_;
@@ -427,9 +649,24 @@ private:
   uint32_t currentTick_ = 0;
   float samplesPerStep_ = 10000.0f;
   
-  // Gate length countdown (samples until release, 0 = released)
-  long gateCountdownA_ = 0;
-  long gateCountdownB_ = 0;
+  // Gate release time on the sequencer sample clock (armed while a note holds)
+  struct GateState {
+    bool armed = false;
+    uint64_t releaseAt = 0;
+  };
+  GateState gateA_;
+  GateState gateB_;
+
+  // Block scheduler state (audio thread only)
+  SeqEventQueue seqQueue_;
+  static constexpr int kMaxPendingTriggers = 64;
+  SeqEvent pendingTriggers_[kMaxPendingTriggers]; // planned note/hit ticks beyond this block
+  int pendingTriggerCount_ = 0;
+  uint64_t seqSampleClock_ = 0; // absolute sample index of the current block start
+  uint64_t seqNow_ = 0;         // absolute sample of the event being dispatched
+  uint64_t blockAccum0_ = 0;
+  uint32_t blockTick0_ = 0;
+  size_t blockLen_ = 0;
   bool songMode_;
   int drumCycleIndex_;
   int songPlayheadPosition_;
@@ -440,7 +677,10 @@ private:
   std::atomic<int8_t> currentPage_{0};
   std::atomic<int8_t> targetPage_{-1};
   std::atomic<bool> pageLoading_{false};
+  std::atomic<int8_t> swappedPage_{-1}; // in the banks, not yet current; -1 = none
   bool approachB_Enabled_ = true;
+  PagePrefetcher pagePrefetcher_;
+  int lookaheadSongPosition_ = -1; // audio thread: row the last look-ahead ran for
   volatile uint32_t cyclePulseCounter_ = 0;
 
   int patternModeDrumPatternIndex_;
@@ -450,7 +690,7 @@ private:
 
   struct RetrigState {
     int interval = 0;       // Buffer samples between triggers
-    int counter = 0;        // Countdown to next trigger
+    uint64_t nextAt = 0;    // Sequencer sample clock of the next trigger
     int countRemaining = 0; // Number of retrigs left
     bool active = false;    // Is retrig active
     uint8_t flamGhostVelocity = 0; // >0 for flam: velocity of ghost hit
@@ -477,6 +717,7 @@ private:
     float f_coeff = 80.0f / (float)kSampleRate; 
     float boost = 1.25f; 
     float lpf = 0.0f;
+    void setSampleRate(float sr) { f_coeff = 80.0f / sr; }
     float process(float in) {
       lpf += f_coeff * (in - lpf);
       return in + lpf * (boost - 1.0f);
@@ -486,7 +727,7 @@ private:
   // High-frequency dampening to soften harsh highs
   struct HighShelfCut {
     float lpf = 0.0f;
-    float coeff = 0.08f; // ~3kHz rolloff at 44100Hz 
+    float coeff = 0.08f; // one-pole weight, not rate-scaled (~3kHz at 44100Hz, ~1.5kHz at 22050Hz)
     float process(float in) {
       lpf += coeff * (in - lpf);
       return lpf; // Lowpass output
@@ -497,6 +738,8 @@ private:
   TempoDelay delay3032;
   TubeDistortion distortion303;
   TubeDistortion distortion3032;
+  // Per-track sleep for distortion + delay once the voice and delay tail are silent.
+  ActivityGate synthFxGate_[NUM_303_VOICES];
   
   // Drum FX
   OneKnobCompressor drumCompressor;
@@ -506,12 +749,16 @@ private:
   // DC blocker for drum bus (removes sub-5Hz DC offset)
   float dcBlockPrev_ = 0.0f;
   float dcBlockOut_ = 0.0f;
+  // Sleep for the whole drum bus (DC blocker, shaper, compressor, reverb).
+  ActivityGate drumBusGate_;
   
   // Thread-safe waveform buffer for UI visualization
   // Uses double-buffering with atomic swap to avoid race conditions
   WaveformBuffer waveformBuffers_[2];
   std::atomic<int> displayBufferIndex_{0};
   int writeBufferIndex_ = 1;
+  // Set by each UI read; the audio thread only copies a block when it is set.
+  mutable std::atomic<bool> waveformWanted_{true};
 
   // Vocal synthesizer (formant-based robotic speech)
   FormantSynth vocalSynth_;
@@ -540,11 +787,16 @@ public:
   const SceneManager& sceneManager() const { return sceneManager_; }
 
 private:
+  // Per-buffer bus scratch (AUDIO_BUFFER_SAMPLES each), allocated once in the ctor.
+  std::unique_ptr<float[]> synthBusBuffer_;
+  std::unique_ptr<float[]> synthVoiceBuffer_;
+  std::unique_ptr<float[]> drumBusBuffer_;
+
   GrooveboxModeManager modeManager_{*this};
   GenreManager genreManager_;
   
   // DSP State for Audio Quality
-  uint32_t ditherState_ = 12345;
+  uint32_t ditherState_ = 12345; // test tone; the master bus keeps its own
   bool tapeControlCached_ = false;
   TapeMacro lastTapeMacro_{};
   uint8_t lastTapeSpace_ = 0xFF;
@@ -553,18 +805,42 @@ private:
   TapeMode lastTapeMode_ = TapeMode::Stop;
   uint8_t lastTapeSpeed_ = 0xFF;
   float lastTapeLooperVolume_ = -1.0f;
-  float fxSafetyMix_ = 1.0f;
-  uint16_t fxSafetyHold_ = 0;
+  QualityGovernor qualityGovernor_;
+  QualityTier appliedQualityTier_ = QualityTier::Full;
+  bool drumLoFiEnabled_ = false; // requested drum lo-fi; the Lite tier overrides it
+  float drumLoFiAmount_ = 0.0f;
   uint32_t lastUnderrunCount_ = 0;
+  AudioConfig audioConfig_;                   // audio thread copy of the active config
+  std::atomic<uint32_t> activeAudioConfig_{0}; // packed, for readers on other threads
+  std::atomic<uint32_t> audioConfigRequest_{0}; // packed request, 0 when none pending
+  BlockSizeTuner blockTuner_;
+  std::atomic<bool> blockTunerRestart_{false}; // scene changed: search again
+  bool setSampleRate_(float sampleRate);
   uint32_t perfDetailCounter_ = 0;
+  bool detailedProfiling_ = false;
+
+  SpscRing<AudioCommand, 128> commandQueue_;
+  SpscRing<GenreStage*, 4> retiredGenreStages_;
+  SpscRing<Song*, 4> retiredSongs_;
+  std::unique_ptr<GenreStage> pendingGenreStage_; // audio thread; applied at bar start
+  std::atomic<uint32_t> genreCommitsPending_{0};   // applied stages not yet in the scene
+  std::atomic<uintptr_t> audioThread_{0};
+  uint32_t droppedCommands_ = 0;
+
+  static constexpr uint8_t kSnapshotFresh = 0x80;
+  static constexpr uint8_t kSnapshotSlotMask = 0x03;
+  PatternSnapshot patternSnapshots_[3];
+  uint8_t snapshotFront_ = 0;              // audio thread only
+  uint8_t snapshotBack_ = 1;               // publisher only
+  std::atomic<uint8_t> snapshotMiddle_{2}; // slot index | kSnapshotFresh when unread
+  std::atomic<bool> patternPublishWanted_{false}; // audio thread: front no longer matches the selection
+  PatternSelection cuedSelection_{};       // publisher only: selection queued commands lead to
+  bool selectionCued_ = false;
 
   // Rehearsal Mode
   bool waitingForRehearsal_ = false;
   bool rehearsalAcknowledged_ = false;
 
-  float dcBlockX1_ = 0.0f;
-  float dcBlockY1_ = 0.0f;
-
   // Global safety low-pass on master output.
   // Recommended fixed cutoffs:
   // - 12000 Hz: very safe for compact/bright speakers
@@ -572,8 +848,7 @@ private:
   // - 18000 Hz: more air, less protection
   static constexpr float kMasterHighCutHz = 16000.0f;
   float masterOutputHighCutHz_ = 16000.0f;
-  float masterOutputLpState_ = 0.0f;
-  float masterOutputLpAlpha_ = 1.0f;
+  MasterBus masterBus_;
   void setMasterOutputHighCutHz(float hz);
   
   // Test Tone State
@@ -581,6 +856,20 @@ private:
   float testTonePhase_ = 0.0f;
   
 
+  // Block plans and dual-core pipeline state (see SynthPlan and DrumJob above).
+  std::unique_ptr<float[]> synthBusBack_; // second slots, allocated on first enable
+  std::unique_ptr<float[]> drumBusBack_;
+  SynthPlan synthPlan_;
+  DrumJob drumJob_;
+  bool dualCore_ = false;
+  bool recordingEvents_ = false; // sequencer pass: voice and kit calls are recorded
+  bool qualityTierPending_ = false; // governor moved while the worker held the kit
+  int pipeSlot_ = 0;                // slot holding the rendered block to play next
+  size_t pipeHeldFrames_ = 0;       // its length; 0 while priming
+  uint32_t lastDrumJobUs_ = 0;
+  // Declared last so it is joined before the state its jobs touch goes away.
+  AudioWorker drumWorker_;
+
   static float softLimit(float x) {
       float absX = (x > 0) ? x : -x;
       return x / (1.0f + absX); 
@@ -474,15 +474,17 @@ void GrooveboxModeManager::generateDrumPattern(DrumPatternSet& patternSet, const
 // Full drum pattern with structural behavior
 void GrooveboxModeManager::generateDrumPattern(DrumPatternSet& patternSet, 
                                                const GenerativeParams& params,
-                                               const GenreBehavior& behavior) const {
+                                               const GenreBehavior& behavior,
+                                               const GenreManager* genre) const {
     // Structural behavior is currently encoded by selected GenerativeMode via
     // DrumGenreTemplate table; keep the parameter for API compatibility.
     (void)behavior;
+    const GenreManager& source = genre ? *genre : engine_.genreManager();
     DrumPatternGenerator::generateDrumPattern(
         patternSet,
         params,
-        engine_.genreManager().generativeMode(),
-        engine_.genreManager().drumTemplateOverride());
+        source.generativeMode(),
+        source.drumTemplateOverride());
 }
 
 void GrooveboxModeManager::generateDrumVoice(DrumPattern& pattern, int voiceIndex,
@@ -634,7 +636,8 @@ void GrooveboxModeManager::generatePattern(SynthPattern& pattern, float bpm,
 
 void GrooveboxModeManager::generateDrumPattern(DrumPatternSet& patternSet, 
                                                const GrooveRecipe& recipe, 
-                                               const GenreBehavior& behavior) const {
+                                               const GenreBehavior& behavior,
+                                               const GenreManager* genre) const {
     GenerativeParams params;
     params.minNotes = (int)std::round(recipe.densityMin * 16.0f);
     params.maxNotes = (int)std::round(recipe.densityMax * 16.0f);
@@ -646,7 +649,7 @@ void GrooveboxModeManager::generateDrumPattern(DrumPatternSet& patternSet,
     params.preferDownbeats = recipe.preferDownbeats;
     params.drumVoiceCount = 8;
     
-    generateDrumPattern(patternSet, params, behavior);
+    generateDrumPattern(patternSet, params, behavior, genre);
 }
 
 void GrooveboxModeManager::generateDrumVoice(DrumPattern& pattern, int voiceIndex, 
@@ -76,12 +76,15 @@ public:
     // Pattern generation (Genre + Behavior + Voice Role)
     // voiceIndex: 0 = bass (low, repetitive), 1 = lead/arp (high, melodic)
     void generatePattern(SynthPattern& pattern, float bpm, const GenerativeParams& params, const GenreBehavior& behavior, int voiceIndex = 0) const;
-    void generateDrumPattern(DrumPatternSet& patternSet, const GenerativeParams& params, const GenreBehavior& behavior) const;
+    // genre: source of the genre drum template; nullptr = the engine's live GenreManager
+    void generateDrumPattern(DrumPatternSet& patternSet, const GenerativeParams& params, const GenreBehavior& behavior,
+                             const GenreManager* genre = nullptr) const;
     void generateDrumVoice(DrumPattern& pattern, int voiceIndex, const GenerativeParams& params, const GenreBehavior& behavior) const;
     
     // Pattern generation (Data-Driven Recipe)
     void generatePattern(SynthPattern& pattern, float bpm, const GrooveRecipe& recipe, const GenreBehavior& behavior, int voiceIndex = 0) const;
-    void generateDrumPattern(DrumPatternSet& patternSet, const GrooveRecipe& recipe, const GenreBehavior& behavior) const;
+    void generateDrumPattern(DrumPatternSet& patternSet, const GrooveRecipe& recipe, const GenreBehavior& behavior,
+                             const GenreManager* genre = nullptr) const;
     void generateDrumVoice(DrumPattern& pattern, int voiceIndex, const GrooveRecipe& recipe, const GenreBehavior& behavior) const;
     
 private:
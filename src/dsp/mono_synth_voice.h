@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string>
 #include "mini_dsp_params.h"
@@ -26,6 +27,14 @@ public:
     // Process next sample
     virtual float process() = 0;
 
+    // Render n samples into out (overwrites). Engines implement this natively so
+    // the mixer pays one virtual call per block instead of one per sample.
+    virtual void processBlock(float* out, size_t n) = 0;
+
+    // True while processBlock() would only write silence (gate off, envelope
+    // finished). The mixer skips idle voices; startNote() wakes them.
+    virtual bool isIdle() const { return false; }
+
     // Parameter abstraction
     virtual uint8_t parameterCount() const = 0;
     virtual void setParameterNormalized(uint8_t index, float norm) = 0;
@@ -38,6 +47,10 @@ public:
     // Engine-specific global mode/lofi state
     virtual void setMode(GrooveboxMode mode) = 0;
     virtual void setLoFiAmount(float amount) = 0;
+
+    // CPU governor hook: trade voicing detail for cost while the engine is under
+    // load. Engines without a cheaper path ignore it.
+    virtual void setLiteMode(bool lite) { (void)lite; }
 };
 
 #endif // MONO_SYNTH_VOICE_H
@@ -64,3 +64,37 @@ float OneKnobCompressor::process(float input) {
   float wet = driven * gain * makeup;
   return input * (1.0f - mix_) + wet * mix_;
 }
+
+void OneKnobCompressor::processBlock(float* buf, size_t n) {
+  if (!enabled_) {
+    return;
+  }
+
+  const float drive = 1.0f + amount_ * 2.0f;
+  const float threshold = 0.45f - 0.40f * amount_;
+  const float ratio = 1.0f + amount_ * 19.0f;
+  const float makeup = 1.0f + amount_ * 1.0f;
+  const float dry = 1.0f - mix_;
+  const float mix = mix_;
+  float envelope = envelope_;
+  for (size_t i = 0; i < n; ++i) {
+    float input = buf[i];
+    float driven = input * drive;
+    float level = fabsf(driven);
+    if (level > envelope) {
+      envelope += (level - envelope) * 0.25f;
+    } else {
+      envelope += (level - envelope) * 0.02f;
+    }
+
+    float gain = 1.0f;
+    if (envelope > threshold) {
+      float compressed = threshold + (envelope - threshold) / ratio;
+      gain = compressed / (envelope + 0.000001f);
+    }
+
+    float wet = driven * gain * makeup;
+    buf[i] = input * dry + wet * mix;
+  }
+  envelope_ = envelope;
+}
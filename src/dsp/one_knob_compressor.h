@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+
 class OneKnobCompressor {
 public:
   OneKnobCompressor();
@@ -9,6 +11,7 @@ public:
   bool isEnabled() const;
   void reset();
   float process(float input);
+  void processBlock(float* buf, size_t n);
 
 private:
   float amount_;
@@ -58,50 +58,72 @@ void Opl2SynthVoice::release() {
 }
 
 float Opl2SynthVoice::process() {
-  if (!gate_ && env_ <= 0.0001f) return 0.0f;
+  float out = 0.0f;
+  processBlock(&out, 1);
+  return out;
+}
+
+void Opl2SynthVoice::processBlock(float* out, size_t n) {
+  if (!out || n == 0) return;
+  if (!gate_ && env_ <= 0.0001f) {
+    std::fill(out, out + n, 0.0f);
+    return;
+  }
 
+  // Operator rates and the envelope coefficient are block invariants.
   const float ratio = params_[0].value();
   const float index = params_[1].value();
   const float decayMs = params_[2].value();
   const float feedback = params_[3].value();
 
-  const float modHz = ratioToHz(baseFreqHz_, ratio);
-  modPhase_ += modHz / sampleRate_;
-  if (modPhase_ >= 1.0f) modPhase_ -= 1.0f;
+  const float modInc = ratioToHz(baseFreqHz_, ratio) / sampleRate_;
+  const float carInc = baseFreqHz_ / sampleRate_;
+  // Gentle sustain drift while gated to keep movement instead of hard hold.
+  const float coef = gate_ ? expDecayCoef(sampleRate_, decayMs * 2.5f)
+                           : expDecayCoef(sampleRate_, decayMs);
+  const float slewRate = 1000.0f / sampleRate_;
+  const float gain = velocityGain_ * 0.75f; // Increased from 0.35f
 
-  // OPL-like 2-op: modulator with feedback feeding carrier phase.
-  const float modIn = 2.0f * 3.1415926535f * modPhase_ + feedbackSample_ * feedback * 6.0f;
-  const float mod = std::sin(modIn);
-  feedbackSample_ = mod;
+  float modeGain = 1.0f;
+  if (mode_ == GrooveboxMode::Electro) modeGain *= 1.08f;
+  if (mode_ == GrooveboxMode::Dub) modeGain *= 0.9f;
+  const bool crunch = loFiAmount_ > 0.001f;
+  const float levels = 256.0f - loFiAmount_ * 192.0f;
 
-  carrierPhase_ += baseFreqHz_ / sampleRate_;
-  if (carrierPhase_ >= 1.0f) carrierPhase_ -= 1.0f;
+  for (size_t i = 0; i < n; ++i) {
+    if (!gate_ && env_ <= 0.0001f) {
+      out[i] = 0.0f;
+      continue;
+    }
 
-  const float carIn = 2.0f * 3.1415926535f * carrierPhase_ + mod * index;
-  float out = std::sin(carIn);
+    modPhase_ += modInc;
+    if (modPhase_ >= 1.0f) modPhase_ -= 1.0f;
 
-  float coef = expDecayCoef(sampleRate_, decayMs);
-  if (gate_) {
-    // Gentle sustain drift to keep movement instead of hard hold.
-    coef = expDecayCoef(sampleRate_, decayMs * 2.5f);
-  }
-  env_ *= coef;
-  if (!gate_ && env_ < 0.0001f) env_ = 0.0f;
+    // OPL-like 2-op: modulator with feedback feeding carrier phase.
+    const float modIn = 2.0f * 3.1415926535f * modPhase_ + feedbackSample_ * feedback * 6.0f;
+    const float mod = std::sin(modIn);
+    feedbackSample_ = mod;
 
-  // 1-2 ms attack slew to prevent clicks at start of note
-  envSlew_ += (env_ - envSlew_) * (1000.0f / sampleRate_);
-  
-  out *= envSlew_ * velocityGain_ * 0.75f; // Increased from 0.35f
+    carrierPhase_ += carInc;
+    if (carrierPhase_ >= 1.0f) carrierPhase_ -= 1.0f;
 
-  if (loFiAmount_ > 0.001f) {
-    const float levels = 256.0f - loFiAmount_ * 192.0f;
-    out = std::floor(out * levels + 0.5f) / levels;
-  }
+    const float carIn = 2.0f * 3.1415926535f * carrierPhase_ + mod * index;
+    float sample = std::sin(carIn);
 
-  if (mode_ == GrooveboxMode::Electro) out *= 1.08f;
-  if (mode_ == GrooveboxMode::Dub) out *= 0.9f;
+    env_ *= coef;
+    if (!gate_ && env_ < 0.0001f) env_ = 0.0f;
 
-  return out;
+    // 1-2 ms attack slew to prevent clicks at start of note
+    envSlew_ += (env_ - envSlew_) * slewRate;
+
+    sample *= envSlew_ * gain;
+
+    if (crunch) {
+      sample = std::floor(sample * levels + 0.5f) / levels;
+    }
+
+    out[i] = sample * modeGain;
+  }
 }
 
 void Opl2SynthVoice::setParameterNormalized(uint8_t index, float norm) {
@@ -32,6 +32,7 @@ struct PerfStats {
   volatile uint32_t dspDrumsUs = 0;
   volatile uint32_t dspFxUs = 0;
   volatile uint32_t dspSamplerUs = 0;
+  volatile uint8_t qualityTier = 0;          // QualityTier picked by the CPU governor
   
   volatile uint32_t heapFree = 0;
   volatile uint32_t heapMinFree = 0;
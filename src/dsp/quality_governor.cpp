@@ -0,0 +1,94 @@
+#include "quality_governor.h"
+
+namespace {
+constexpr int kTierCount = static_cast<int>(QualityTier::Count);
+
+// Rough cost of each component per tier, relative to Full. Only the ratios
+// matter: they map a measurement taken at one tier onto the others.
+//                                        Full  Eco   Lite  Minimal
+constexpr float kVoiceCost[kTierCount] = {1.00f, 1.00f, 0.70f, 0.70f};
+constexpr float kDrumCost[kTierCount]  = {1.00f, 0.80f, 0.70f, 0.55f};
+constexpr float kFxCost[kTierCount]    = {1.00f, 0.75f, 0.75f, 0.35f};
+
+constexpr float kCostSmoothing = 0.08f;   // EMA weight of the newest block
+constexpr float kEscalateLoad = 0.85f;    // step to a cheaper tier above this
+constexpr float kTargetLoad = 0.75f;      // ...choosing the first one predicted below this
+constexpr float kRecoverLoad = 0.60f;     // the richer tier must fit under this
+constexpr uint16_t kRecoverBlocks = 200;  // ...for this many blocks in a row (~4.6 s)
+constexpr uint16_t kMinDwellBlocks = 16;  // let the EMA settle after a change
+
+const float* costTable(int component) {
+  switch (component) {
+    case 0: return kVoiceCost;
+    case 1: return kDrumCost;
+    default: return kFxCost;
+  }
+}
+
+const char* const kTierNames[kTierCount] = {"FULL", "ECO", "LITE", "MIN"};
+} // namespace
+
+const char* qualityTierName(QualityTier tier) {
+  int idx = static_cast<int>(tier);
+  if (idx < 0 || idx >= kTierCount) return "?";
+  return kTierNames[idx];
+}
+
+void QualityGovernor::reset() {
+  for (int c = 0; c < kComponentCount; ++c) fullCostUs_[c] = 0.0f;
+  budgetUs_ = 0.0f;
+  tier_ = QualityTier::Full;
+  dwell_ = 0;
+  calmBlocks_ = 0;
+}
+
+float QualityGovernor::predictLoad(QualityTier tier) const {
+  if (budgetUs_ <= 0.0f) return 0.0f;
+  const int t = static_cast<int>(tier);
+  float cost[kComponentCount];
+  for (int c = 0; c < kComponentCount; ++c) cost[c] = fullCostUs_[c] * costTable(c)[t];
+  float us = cost[kVoices] + cost[kDrums] + cost[kFx];
+  if (parallelDrums_) {
+    const float local = cost[kVoices] + cost[kFx];
+    us = local > cost[kDrums] ? local : cost[kDrums];
+  }
+  return us / budgetUs_;
+}
+
+void QualityGovernor::setTier(QualityTier tier) {
+  tier_ = tier;
+  dwell_ = 0;
+  calmBlocks_ = 0;
+}
+
+bool QualityGovernor::update(uint32_t voicesUs, uint32_t drumsUs, uint32_t fxUs, float budgetUs, bool underrun) {
+  if (budgetUs <= 0.0f) return false;
+  budgetUs_ = budgetUs;
+
+  // Fold this block into the model at Full-tier scale.
+  const int t = static_cast<int>(tier_);
+  const uint32_t measured[kComponentCount] = {voicesUs, drumsUs, fxUs};
+  for (int c = 0; c < kComponentCount; ++c) {
+    const float full = static_cast<float>(measured[c]) / costTable(c)[t];
+    fullCostUs_[c] += kCostSmoothing * (full - fullCostUs_[c]);
+  }
+  if (dwell_ < 0xFFFF) ++dwell_;
+
+  const QualityTier previous = tier_;
+  const int last = kTierCount - 1;
+  if (underrun || (dwell_ >= kMinDwellBlocks && predictLoad(tier_) > kEscalateLoad)) {
+    // Cheapest tier that the model says fits; an underrun always costs at least one tier.
+    int next = underrun ? t + 1 : t;
+    while (next < last && predictLoad(static_cast<QualityTier>(next)) > kTargetLoad) ++next;
+    if (next > last) next = last;
+    if (next != t) setTier(static_cast<QualityTier>(next));
+  } else if (t > 0 && dwell_ >= kMinDwellBlocks) {
+    // Recover one tier at a time, only after a sustained quiet stretch.
+    if (predictLoad(static_cast<QualityTier>(t - 1)) < kRecoverLoad) {
+      if (++calmBlocks_ >= kRecoverBlocks) setTier(static_cast<QualityTier>(t - 1));
+    } else {
+      calmBlocks_ = 0;
+    }
+  }
+  return tier_ != previous;
+}
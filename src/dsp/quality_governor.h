@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+
+// Quality tiers, cheapest last. Each tier keeps every cut of the ones above it.
+enum class QualityTier : uint8_t {
+  Full = 0, // everything on
+  Eco,      // drum reverb at half rate, TapeFX wow/space off
+  Lite,     // + lite synth voicing (fewer supersaw oscs, Chamberlin for diode), drum lo-fi off
+  Minimal,  // + drum reverb and TapeFX bypassed
+  Count
+};
+
+const char* qualityTierName(QualityTier tier);
+
+// Picks a QualityTier from a moving per-component cost model. Fed once per
+// audio block with the measured voice/drum/FX time; every input is normalised
+// back to Full-tier cost, so the model can predict the load of any tier and
+// step straight to the one that fits. Audio thread only, no allocation.
+class QualityGovernor {
+public:
+  void reset();
+  // Drums render on another core from the end of the sequencer pass, while
+  // the synths and the master stage run here: a block costs
+  // max(voices + FX, drums) instead of the sum.
+  void setParallelDrums(bool parallel) { parallelDrums_ = parallel; }
+
+  // Returns true when the tier changed.
+  bool update(uint32_t voicesUs, uint32_t drumsUs, uint32_t fxUs, float budgetUs, bool underrun);
+
+  QualityTier tier() const { return tier_; }
+  // Predicted load of the current tier as a fraction of the block budget.
+  float predictedLoad() const { return predictLoad(tier_); }
+
+private:
+  enum Component { kVoices = 0, kDrums, kFx, kComponentCount };
+
+  float predictLoad(QualityTier tier) const;
+  void setTier(QualityTier tier);
+
+  float fullCostUs_[kComponentCount] = {0.0f, 0.0f, 0.0f};
+  float budgetUs_ = 0.0f;
+  QualityTier tier_ = QualityTier::Full;
+  bool parallelDrums_ = false;
+  uint16_t dwell_ = 0;      // blocks since the last tier change
+  uint16_t calmBlocks_ = 0; // consecutive blocks the lighter tier would have fit
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Sequencer events for one audio block. Events at the same sample offset run in
+// enum order, which mirrors the old per-sample loop: tick work first, then
+// gate releases, then synth and drum retrigs.
+enum class SeqEventType : uint8_t {
+  Step = 0,    // 16th boundary: song/LED bookkeeping, automation, trigger planning
+  SynthNote,   // voice = synth index, step = pattern step
+  DrumHit,     // voice = drum voice, step = pattern step
+  GateOff,     // voice = synth index
+  SynthRetrig, // voice = synth index
+  DrumRetrig,  // voice = drum voice
+};
+
+struct SeqEvent {
+  uint32_t tick = 0;    // absolute sequencer tick (Step / SynthNote / DrumHit)
+  uint16_t offset = 0;  // sample offset inside the current block
+  SeqEventType type = SeqEventType::Step;
+  uint8_t voice = 0;
+  uint8_t step = 0;
+};
+
+// Fixed-capacity queue kept sorted by (offset, type). Equal keys keep their
+// insertion order. Lives on the audio thread only; no allocation.
+class SeqEventQueue {
+public:
+  static constexpr size_t kCapacity = 96;
+
+  void clear() {
+    head_ = 0;
+    tail_ = 0;
+  }
+
+  bool empty() const { return head_ == tail_; }
+  size_t size() const { return tail_ - head_; }
+  const SeqEvent& front() const { return events_[head_]; }
+  void pop() {
+    if (head_ < tail_) ++head_;
+  }
+
+  bool push(const SeqEvent& ev) {
+    if (tail_ == kCapacity) {
+      if (head_ == 0) return false;
+      size_t n = tail_ - head_;
+      for (size_t i = 0; i < n; ++i) events_[i] = events_[head_ + i];
+      head_ = 0;
+      tail_ = n;
+    }
+    size_t pos = tail_;
+    while (pos > head_ && before(ev, events_[pos - 1])) {
+      events_[pos] = events_[pos - 1];
+      --pos;
+    }
+    events_[pos] = ev;
+    ++tail_;
+    return true;
+  }
+
+  // Drop queued events of one type/voice (used when a gate or retrig is re-armed).
+  void remove(SeqEventType type, uint8_t voice) {
+    size_t w = head_;
+    for (size_t r = head_; r < tail_; ++r) {
+      if (events_[r].type == type && events_[r].voice == voice) continue;
+      events_[w++] = events_[r];
+    }
+    tail_ = w;
+  }
+
+private:
+  static bool before(const SeqEvent& a, const SeqEvent& b) {
+    if (a.offset != b.offset) return a.offset < b.offset;
+    return static_cast<uint8_t>(a.type) < static_cast<uint8_t>(b.type);
+  }
+
+  SeqEvent events_[kCapacity];
+  size_t head_ = 0;
+  size_t tail_ = 0;
+};
@@ -17,7 +17,6 @@ void SidSynth::reset() {
     currentMidiNote_ = -1;
 
     lpState_ = 0.0f;
-    peak_ = 0.0f;
 
     // параметры оставляем как “патч” (не сбрасываем), как обычно в синтах
 }
@@ -51,27 +50,42 @@ void SidSynth::process(float* buffer, size_t numSamples) {
     const float alpha = std::clamp(cutoffNorm * (0.20f + (1.0f - resNorm) * 0.80f), 0.001f, 0.50f);
     const float duty = std::clamp(static_cast<float>(pulseWidth_) / 4095.0f, 0.02f, 0.98f);
 
+    const float phaseInc = freqHz_ / sampleRate_;
+    const float gain = amp_ * volume_ * 0.25f;
+
+    // Everything but the oscillator and filter state is fixed for the block,
+    // so the filter type is resolved once here instead of per sample.
+    switch (filterType_) {
+        case 0:  render<0>(buffer, numSamples, phaseInc, duty, alpha, gain); break;
+        case 1:  render<1>(buffer, numSamples, phaseInc, duty, alpha, gain); break;
+        case 2:  render<2>(buffer, numSamples, phaseInc, duty, alpha, gain); break;
+        default: render<3>(buffer, numSamples, phaseInc, duty, alpha, gain); break;
+    }
+}
+
+template <uint8_t kFilterType>
+void SidSynth::render(float* buffer, size_t numSamples, float phaseInc, float duty, float alpha, float gain) {
+    float phase = phase_;
+    float lp = lpState_;
     for (size_t i = 0; i < numSamples; ++i) {
-        phase_ += freqHz_ / sampleRate_;
-        if (phase_ >= 1.0f) phase_ -= 1.0f;
+        phase += phaseInc;
+        if (phase >= 1.0f) phase -= 1.0f;
 
-        const float osc = (phase_ < duty) ? 1.0f : -1.0f;
+        const float osc = (phase < duty) ? 1.0f : -1.0f;
 
-        lpState_ += alpha * (osc - lpState_);
-        const float hp = osc - lpState_;
+        lp += alpha * (osc - lp);
+        const float hp = osc - lp;
 
-        float shaped = osc;
-        switch (filterType_) {
-            case 0: shaped = lpState_; break;                 // LP
-            case 1: shaped = (osc + hp) * 0.5f; break;        // BP-ish
-            case 2: shaped = hp; break;                       // HP
-            case 3: default: shaped = osc; break;             // OFF
-        }
+        float shaped;
+        if constexpr (kFilterType == 0) shaped = lp;                       // LP
+        else if constexpr (kFilterType == 1) shaped = (osc + hp) * 0.5f;  // BP-ish
+        else if constexpr (kFilterType == 2) shaped = hp;                  // HP
+        else shaped = osc;                                                 // OFF
 
-        const float out = shaped * amp_ * volume_ * 0.25f;
-        peak_ = std::max(peak_, std::fabs(out));
-        buffer[i] += out;
+        buffer[i] += shaped * gain;
     }
+    phase_ = phase;
+    lpState_ = lp;
 }
 
 void SidSynth::setPulseWidth(uint16_t pw) {
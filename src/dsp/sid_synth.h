@@ -24,6 +24,10 @@ public:
     void setFilterType(uint8_t type); // 0=LP,1=BP,2=HP,3=OFF
 
 private:
+    // Inner loop for one filter type; state is kept in locals for the block.
+    template <uint8_t kFilterType>
+    void render(float* buffer, size_t numSamples, float phaseInc, float duty, float alpha, float gain);
+
     float sampleRate_{44100.0f};
 
     bool  active_{false};
@@ -34,7 +38,6 @@ private:
     float amp_{0.0f};
 
     float volume_{1.0f};
-    float peak_{0.0f};
 
     float lpState_{0.0f};
 
@@ -1,11 +1,10 @@
 #include "sid_synth_voice.h"
 
+#include <algorithm>
 #include <cmath>
 
 SidSynthVoice::SidSynthVoice(float sampleRate)
     : sid_(std::make_unique<SidSynth>()), sampleRate_(sampleRate) {
-    sampleBuffer_.resize(1, 0.0f);
-
     params_[0] = Parameter("Cutoff", "Hz", 0.0f, 12000.0f, 4000.0f, 1.0f);
     params_[1] = Parameter("Reso",   "",   0.0f,   255.0f,   0.0f, 1.0f);
     params_[2] = Parameter("P-Width","",   0.0f,  4095.0f,2048.0f, 1.0f);
@@ -48,11 +47,18 @@ void SidSynthVoice::release() {
 }
 
 float SidSynthVoice::process() {
-    if (!sid_ || !sid_->isActive()) return 0.0f;
+    float out = 0.0f;
+    processBlock(&out, 1);
+    return out;
+}
+
+void SidSynthVoice::processBlock(float* out, size_t n) {
+    if (!out || n == 0) return;
+    std::fill(out, out + n, 0.0f);
+    if (!sid_ || !sid_->isActive()) return;
 
-    sampleBuffer_[0] = 0.0f;
-    sid_->process(sampleBuffer_.data(), 1);
-    return sampleBuffer_[0];
+    // SidSynth accumulates into the buffer, so one call covers the whole block.
+    sid_->process(out, n);
 }
 
 uint8_t SidSynthVoice::parameterCount() const {
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <memory>
-#include <vector>
+#include <cstddef>
 #include <cstdint>
 
 #include "mono_synth_voice.h"
@@ -20,6 +20,8 @@ public:
     void release() override;
 
     float process() override;
+    void processBlock(float* out, size_t n) override;
+    bool isIdle() const override { return !sid_ || !sid_->isActive(); }
 
     uint8_t parameterCount() const override;
     void setParameterNormalized(uint8_t index, float norm) override;
@@ -36,5 +38,4 @@ private:
     float sampleRate_{44100.0f};
 
     Parameter params_[4];
-    std::vector<float> sampleBuffer_;
 };
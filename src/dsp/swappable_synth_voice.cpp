@@ -1,4 +1,5 @@
 #include "swappable_synth_voice.h"
+#include <algorithm>
 #include <cmath>
 #include <ctype.h>
 
@@ -24,34 +25,57 @@ SynthEngineType SwappableSynthVoice::parseEngineName(const std::string& name) {
 }
 
 SwappableSynthVoice::SwappableSynthVoice(float sampleRate, SynthEngineType initialType)
-    : sampleRate_(sampleRate), type_(initialType), pendingType_(initialType) {
-    if (sampleRate_ <= 0.0f) sampleRate_ = 44100.0f;
-    current_ = createVoice(type_, sampleRate_);
-    if (current_) {
-        current_->setMode(mode_);
-        current_->setLoFiAmount(loFi_);
-    }
+    : sampleRate_(sampleRate > 0.0f ? sampleRate : 44100.0f),
+      type_(initialType),
+      pendingType_(initialType),
+      tb303_(sampleRate_),
+      sid_(sampleRate_),
+      ay_(sampleRate_),
+      opl2_(sampleRate_) {
+    current_ = prepareEngine(type_);
 }
 
-std::unique_ptr<IMonoSynthVoice> SwappableSynthVoice::createVoice(SynthEngineType type, float sampleRate) {
+IMonoSynthVoice* SwappableSynthVoice::engine(SynthEngineType type) {
     switch (type) {
-        case SynthEngineType::SID:   return std::make_unique<SidSynthVoice>(sampleRate);
-        case SynthEngineType::AY:    return std::make_unique<AySynthVoice>(sampleRate);
-        case SynthEngineType::OPL2:  return std::make_unique<Opl2SynthVoice>(sampleRate);
+        case SynthEngineType::SID:   return &sid_;
+        case SynthEngineType::AY:    return &ay_;
+        case SynthEngineType::OPL2:  return &opl2_;
         case SynthEngineType::TB303:
-        default:                     return std::make_unique<TB303Voice>(sampleRate);
+        default:                     return &tb303_;
     }
 }
 
+IMonoSynthVoice* SwappableSynthVoice::prepareEngine(SynthEngineType type) {
+    // Bring a pooled engine back to the state a freshly built one would have.
+    IMonoSynthVoice* voice = engine(type);
+    voice->reset();
+    for (uint8_t i = 0; i < voice->parameterCount(); ++i) {
+        Parameter param = voice->getParameter(i);
+        param.reset();
+        voice->setParameterNormalized(i, param.normalized());
+    }
+    voice->setMode(mode_);
+    voice->setLoFiAmount(loFi_);
+    return voice;
+}
+
 void SwappableSynthVoice::setEngineType(SynthEngineType type) {
-    if (type == type_ && !switching_) return;
+    if (switching_ && next_) {
+        if (type == pendingType_) return;
+        if (type == type_) {
+            // Back to the engine that is fading out: reverse the fade rather
+            // than crossfading an engine into itself.
+            std::swap(current_, next_);
+            std::swap(type_, pendingType_);
+            xfadePos_ = xfadeTotal_ - xfadePos_;
+            return;
+        }
+    } else if (type == type_) {
+        return;
+    }
 
     pendingType_ = type;
-    next_ = createVoice(pendingType_, sampleRate_);
-    if (!next_) return;
-
-    next_->setMode(mode_);
-    next_->setLoFiAmount(loFi_);
+    next_ = prepareEngine(pendingType_);
 
     if (noteHeld_) {
         next_->startNote(lastFreqHz_, lastAccent_, lastSlide_, lastVelocity_);
@@ -88,13 +112,8 @@ void SwappableSynthVoice::setState(const SynthVoiceState& st) {
     
     type_ = st.engineType;
     pendingType_ = st.engineType;
-    current_ = createVoice(type_, sampleRate_);
-    next_.reset();
-
-    if (!current_) return;
-
-    current_->setMode(mode_);
-    current_->setLoFiAmount(loFi_);
+    current_ = prepareEngine(type_);
+    next_ = nullptr;
 
     const uint8_t n = std::min<uint8_t>(st.paramCount, current_->parameterCount());
     for (uint8_t i = 0; i < n; ++i) {
@@ -112,15 +131,17 @@ void SwappableSynthVoice::reset() {
     switching_ = false;
     xfadeTotal_ = 0;
     xfadePos_ = 0;
-    next_.reset();
+    next_ = nullptr;
 
     if (current_) current_->reset();
 }
 
 void SwappableSynthVoice::setSampleRate(float sampleRate) {
     sampleRate_ = sampleRate;
-    if (current_) current_->setSampleRate(sampleRate_);
-    if (next_) next_->setSampleRate(sampleRate_);
+    tb303_.setSampleRate(sampleRate_);
+    sid_.setSampleRate(sampleRate_);
+    ay_.setSampleRate(sampleRate_);
+    opl2_.setSampleRate(sampleRate_);
 }
 
 void SwappableSynthVoice::startNote(float freqHz, bool accent, bool slideFlag, uint8_t velocity) {
@@ -141,49 +162,73 @@ void SwappableSynthVoice::release() {
 }
 
 float SwappableSynthVoice::process() {
-    const float a = current_ ? current_->process() : 0.0f;
-    if (!switching_ || !next_) return a;
-
-    const float b = next_->process();
-
-    const float t = (xfadeTotal_ > 0) ? (static_cast<float>(xfadePos_) / static_cast<float>(xfadeTotal_)) : 1.0f;
-    const float mix = clamp01(t);
-    constexpr float kHalfPi = 1.57079632679f;
-    const float gainA = std::cos(mix * kHalfPi);
-    const float gainB = std::cos((1.0f - mix) * kHalfPi);
-    const float out = a * gainA + b * gainB;
-
-    if (xfadePos_ < xfadeTotal_) ++xfadePos_;
-    if (xfadePos_ >= xfadeTotal_) {
-        current_ = std::move(next_);
-        next_.reset();
-        type_ = pendingType_;
-        switching_ = false;
-        xfadeTotal_ = 0;
-        xfadePos_ = 0;
+    float out = 0.0f;
+    processBlock(&out, 1);
+    return out;
+}
+
+void SwappableSynthVoice::processBlock(float* out, size_t n) {
+    if (!out || n == 0) return;
+
+    size_t done = 0;
+    while (done < n && switching_ && next_) {
+        size_t chunk = std::min(n - done, kXfadeChunkFrames);
+        const uint32_t remaining = (xfadeTotal_ > xfadePos_) ? (xfadeTotal_ - xfadePos_) : 1u;
+        if (chunk > remaining) chunk = remaining;
+
+        float* a = out + done;
+        float b[kXfadeChunkFrames];
+        if (current_) current_->processBlock(a, chunk);
+        else std::fill(a, a + chunk, 0.0f);
+        next_->processBlock(b, chunk);
+
+        constexpr float kHalfPi = 1.57079632679f;
+        for (size_t i = 0; i < chunk; ++i) {
+            const float t = (xfadeTotal_ > 0) ? (static_cast<float>(xfadePos_) / static_cast<float>(xfadeTotal_)) : 1.0f;
+            const float mix = clamp01(t);
+            const float gainA = std::cos(mix * kHalfPi);
+            const float gainB = std::cos((1.0f - mix) * kHalfPi);
+            a[i] = a[i] * gainA + b[i] * gainB;
+            if (xfadePos_ < xfadeTotal_) ++xfadePos_;
+        }
+        done += chunk;
+
+        if (xfadePos_ >= xfadeTotal_) finishSwitch();
     }
 
-    return out;
+    if (done == n) return;
+    if (current_) current_->processBlock(out + done, n - done);
+    else std::fill(out + done, out + n, 0.0f);
+}
+
+void SwappableSynthVoice::finishSwitch() {
+    // The outgoing engine stays in the pool, idle until it is picked again.
+    current_ = next_;
+    next_ = nullptr;
+    type_ = pendingType_;
+    switching_ = false;
+    xfadeTotal_ = 0;
+    xfadePos_ = 0;
 }
 
 uint8_t SwappableSynthVoice::parameterCount() const {
-    const IMonoSynthVoice* voice = (switching_ && next_) ? next_.get() : current_.get();
+    const IMonoSynthVoice* voice = (switching_ && next_) ? next_ : current_;
     return voice ? voice->parameterCount() : 0;
 }
 
 void SwappableSynthVoice::setParameterNormalized(uint8_t index, float norm) {
-    IMonoSynthVoice* voice = (switching_ && next_) ? next_.get() : current_.get();
+    IMonoSynthVoice* voice = (switching_ && next_) ? next_ : current_;
     if (voice) voice->setParameterNormalized(index, clamp01(norm));
 }
 
 float SwappableSynthVoice::getParameterNormalized(uint8_t index) const {
-    const IMonoSynthVoice* voice = (switching_ && next_) ? next_.get() : current_.get();
+    const IMonoSynthVoice* voice = (switching_ && next_) ? next_ : current_;
     return voice ? voice->getParameterNormalized(index) : 0.0f;
 }
 
 const Parameter& SwappableSynthVoice::getParameter(uint8_t index) const {
     static Parameter dummy("dummy", "", 0.0f, 1.0f, 0.0f, 1.0f);
-    const IMonoSynthVoice* voice = (switching_ && next_) ? next_.get() : current_.get();
+    const IMonoSynthVoice* voice = (switching_ && next_) ? next_ : current_;
     return voice ? voice->getParameter(index) : dummy;
 }
 
@@ -199,7 +244,15 @@ void SwappableSynthVoice::setLoFiAmount(float amount) {
     if (next_) next_->setLoFiAmount(loFi_);
 }
 
+void SwappableSynthVoice::setLiteMode(bool lite) {
+    // Pooled engines all follow, so a swap mid-overload stays cheap.
+    tb303_.setLiteMode(lite);
+    sid_.setLiteMode(lite);
+    ay_.setLiteMode(lite);
+    opl2_.setLiteMode(lite);
+}
+
 const char* SwappableSynthVoice::getEngineName() const {
-    const IMonoSynthVoice* voice = (switching_ && next_) ? next_.get() : current_.get();
+    const IMonoSynthVoice* voice = (switching_ && next_) ? next_ : current_;
     return voice ? voice->getEngineName() : "none";
 }
@@ -35,8 +35,8 @@ public:
     
     // Compatibility helpers
     void setEngineName(const std::string& name);
-    IMonoSynthVoice* activeVoice() { return current_ ? current_.get() : nullptr; }
-    const IMonoSynthVoice* activeVoice() const { return current_ ? current_.get() : nullptr; }
+    IMonoSynthVoice* activeVoice() { return current_; }
+    const IMonoSynthVoice* activeVoice() const { return current_; }
 
     SynthVoiceState getState() const;
     void setState(const SynthVoiceState& st);
@@ -48,6 +48,9 @@ public:
     void startNote(float freqHz, bool accent, bool slideFlag, uint8_t velocity = 100) override;
     void release() override;
     float process() override;
+    void processBlock(float* out, size_t n) override;
+    // Busy through a crossfade so the outgoing engine can finish fading.
+    bool isIdle() const override { return !switching_ && (!current_ || current_->isIdle()); }
 
     uint8_t parameterCount() const override;
     void setParameterNormalized(uint8_t index, float norm) override;
@@ -56,19 +59,32 @@ public:
 
     void setMode(GrooveboxMode mode) override;
     void setLoFiAmount(float amount) override;
+    void setLiteMode(bool lite) override;
     const char* getEngineName() const override;
 
 private:
-    static std::unique_ptr<IMonoSynthVoice> createVoice(SynthEngineType type, float sampleRate);
     static SynthEngineType parseEngineName(const std::string& name);
+    IMonoSynthVoice* engine(SynthEngineType type);
+    IMonoSynthVoice* prepareEngine(SynthEngineType type);
+    void finishSwitch();
+
+    // Crossfade renders the incoming engine through a stack scratch of this size.
+    static constexpr size_t kXfadeChunkFrames = 64;
 
     float sampleRate_{44100.0f};
 
     SynthEngineType type_{SynthEngineType::TB303};
     SynthEngineType pendingType_{SynthEngineType::TB303};
 
-    std::unique_ptr<IMonoSynthVoice> current_{};
-    std::unique_ptr<IMonoSynthVoice> next_{};
+    // One instance per engine type, built with the voice. Switching picks one
+    // and resets it, so engine swaps never allocate or free on the audio thread.
+    TB303Voice tb303_;
+    SidSynthVoice sid_;
+    AySynthVoice ay_;
+    Opl2SynthVoice opl2_;
+
+    IMonoSynthVoice* current_{nullptr};
+    IMonoSynthVoice* next_{nullptr};
 
     // click-free switching
     bool switching_{false};
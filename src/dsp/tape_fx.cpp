@@ -32,6 +32,12 @@ TapeFX::TapeFX() {
     pinkB0_ = pinkB1_ = pinkB2_ = pinkB3_ = pinkB4_ = pinkB5_ = pinkB6_ = 0;
 }
 
+void TapeFX::setSampleRate(float sampleRate) {
+    if (sampleRate <= 0.0f) sampleRate = static_cast<float>(kSampleRate);
+    sampleRate_ = sampleRate;
+    paramsDirty_ = true;
+}
+
 void TapeFX::applyMacro(const TapeMacro& macro) {
     // Only mark dirty if macro actually changed
     if (std::memcmp(&macro, &currentMacro_, sizeof(TapeMacro)) != 0) {
@@ -50,7 +56,7 @@ void TapeFX::updateInternalParams() {
     
     // Wow freq: 0.3 - 1.5 Hz
     float wowHz = 0.3f + (m.wow / 100.0f) * 1.2f;
-    float thetaWow = kPi2 * wowHz / static_cast<float>(kSampleRate);
+    float thetaWow = kPi2 * wowHz / sampleRate_;
     wowStepSin_ = sinf(thetaWow);
     wowStepCos_ = cosf(thetaWow);
     
@@ -62,7 +68,7 @@ void TapeFX::updateInternalParams() {
         if(flutterRatio_ > 0.3f) flutterRatio_ = 0.3f; 
         
         float flutterHz = 4.0f + ((m.wow - 50) / 50.0f) * 4.0f;
-        float thetaFlutter = kPi2 * flutterHz / static_cast<float>(kSampleRate);
+        float thetaFlutter = kPi2 * flutterHz / sampleRate_;
         flutterStepSin_ = sinf(thetaFlutter);
         flutterStepCos_ = cosf(thetaFlutter);
     } else {
@@ -75,7 +81,7 @@ void TapeFX::updateInternalParams() {
     
     // Warmth LPF: Starts at 8kHz, drops to 2kHz
     float warmthCutoffHz = 8000.0f - (ageAmount_ * 6000.0f);
-    warmthCutoffNorm_ = warmthCutoffHz / kSampleRate;
+    warmthCutoffNorm_ = warmthCutoffHz / sampleRate_;
     
     // SAT: Drive 1.0 .. 2.5, Mix 0.3 .. 0.7
     drive_ = 1.0f + (m.sat / 100.0f) * 1.5f;
@@ -142,7 +148,8 @@ float TapeFX::process(float input) {
 
     if (paramsDirty_) updateInternalParams();
     
-    if (wowActive_) {
+    const bool wow = wowActive_ && !economy_;
+    if (wow) {
         if (++lfoCounter_ >= kLFOUpdateRate) {
             lfoCounter_ = 0;
             updateLFO();
@@ -152,12 +159,12 @@ float TapeFX::process(float input) {
     float output = input;
 
     // 1. WOW/FLUTTER
-    if (wowActive_) {
+    if (wow) {
         float mod = wowSin_ * wowDepth_;
         if (flutterRatio_ > 0) {
             mod += flutterSin_ * wowDepth_ * 0.3f * flutterRatio_;
         }
-        float delaySmp = 100.0f + mod * kSampleRate;
+        float delaySmp = 100.0f + mod * sampleRate_;
         output = readDelayInterpolated(delaySmp);
     }
     
@@ -192,7 +199,7 @@ float TapeFX::process(float input) {
     }
 
     // 6. Minimal Extensions
-    if (spaceAmount_ > 0.05f) {
+    if (spaceAmount_ > 0.05f && !economy_) {
         float dTime = 4000.0f;
         float sRead = (float)spaceWritePos_ - dTime;
         if (sRead < 0) sRead += kSpaceDelaySize;
@@ -200,10 +207,13 @@ float TapeFX::process(float input) {
         spaceBuffer_[spaceWritePos_] = output + spaceDelayed * 0.7f;
         spaceWritePos_ = (spaceWritePos_ + 1) & (kSpaceDelaySize - 1);
         output = output * (1.0f - spaceAmount_ * 0.5f) + spaceDelayed * spaceAmount_;
+    } else if (spaceAmount_ > 0.05f) {
+        spaceBuffer_[spaceWritePos_] = output;
+        spaceWritePos_ = (spaceWritePos_ + 1) & (kSpaceDelaySize - 1);
     }
 
     if (movementAmount_ > 0.01f) {
-        movementPhase_ += movementFreq_ / static_cast<float>(kSampleRate);
+        movementPhase_ += movementFreq_ / sampleRate_;
         if (movementPhase_ >= 1.0f) movementPhase_ -= 1.0f;
         float mod = Wavetable::lookupSine((uint32_t)(movementPhase_ * kPhaseToUint32)) * 0.5f + 0.5f;
         float fc = 0.1f + mod * movementAmount_ * 0.8f;
@@ -53,6 +53,13 @@ public:
     void setEnabled(bool enabled) { enabled_ = enabled; }
     bool isEnabled() const { return enabled_; }
 
+    // Re-derives LFO steps and filter cutoffs for a new output rate.
+    void setSampleRate(float sampleRate);
+
+    // Economy mode skips the two delay-line stages (wow/flutter and space);
+    // the delay buffers keep filling so they resume without a gap.
+    void setEconomy(bool economy) { economy_ = economy; }
+
 private:
     // Delay line for wow/flutter
     static constexpr uint32_t kDelaySize = 1024;
@@ -64,6 +71,8 @@ private:
     TapeMacro currentMacro_;
     bool paramsDirty_ = true;
     bool enabled_ = true;
+    bool economy_ = false;
+    float sampleRate_ = static_cast<float>(kSampleRate);
 
     // LFO state (rotation matrix for cheap sin/cos)
     float wowSin_ = 0, wowCos_ = 1.0f;
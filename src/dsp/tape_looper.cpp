@@ -33,10 +33,12 @@ bool TapeLooper::init(float maxSeconds) {
 
     if (!(maxSeconds > 0.0f)) {
         maxSamples_ = 0;
+        maxSeconds_ = 0.0f;
         return false;
     }
 
-    const float sampleCount = maxSeconds * static_cast<float>(kSampleRate);
+    maxSeconds_ = maxSeconds;
+    const float sampleCount = maxSeconds * sampleRate_;
     maxSamples_ = static_cast<uint32_t>(sampleCount);
     if (maxSamples_ == 0) {
         maxSamples_ = 1;
@@ -58,6 +60,14 @@ bool TapeLooper::init(float maxSeconds) {
     return false;
 }
 
+bool TapeLooper::setSampleRate(float sampleRate) {
+    if (sampleRate <= 0.0f || sampleRate == sampleRate_) return buffer_ != nullptr;
+    sampleRate_ = sampleRate;
+    // Also retries a buffer a previous rate could not get.
+    if (!(maxSeconds_ > 0.0f)) return false;
+    return init(maxSeconds_);
+}
+
 void TapeLooper::clear() {
     if (buffer_ && maxSamples_ > 0) {
         std::memset(buffer_, 0, maxSamples_ * sizeof(int16_t));
@@ -143,7 +153,7 @@ float TapeLooper::playheadProgress() const {
 }
 
 float TapeLooper::loopLengthSeconds() const {
-    return static_cast<float>(length_) / static_cast<float>(kSampleRate);
+    return static_cast<float>(length_) / sampleRate_;
 }
 
 float TapeLooper::readInterpolated(float pos) const {
@@ -20,7 +20,7 @@ public:
     // Fits in internal RAM (no PSRAM needed)
     // Musically: 1 bar @ 120 BPM, perfect for techno/minimal
     static constexpr uint32_t kMaxSeconds = 2;
-    static constexpr uint32_t kMaxSamples = kMaxSeconds * kSampleRate;
+    static constexpr uint32_t kMaxSamples = kMaxSeconds * kMaxSampleRate;
     static constexpr uint32_t kStutterFrames = 512; // ~23ms @ 22kHz
     static constexpr uint32_t kCrossfadeFrames = 256;
 
@@ -33,6 +33,11 @@ public:
     // Returns true if any buffer was allocated
     bool init(float maxSeconds);
 
+    // Change the output rate. The buffer is re-allocated to keep the same
+    // length in seconds (the loop content is cleared); false when that
+    // allocation fails. Not for the audio thread.
+    bool setSampleRate(float sampleRate);
+
     // Mode control (call with AudioGuard from UI thread!)
     void setMode(TapeMode mode);
     TapeMode mode() const { return mode_; }
@@ -64,7 +69,7 @@ public:
     float loopLengthSeconds() const;
     bool hasLoop() const { return length_ > 0; }
     bool isFirstRecordPass() const { return mode_ == TapeMode::Rec && firstRecord_; }
-    float recordElapsedSeconds() const { return static_cast<float>(playheadSamples()) / static_cast<float>(kSampleRate); }
+    float recordElapsedSeconds() const { return static_cast<float>(playheadSamples()) / sampleRate_; }
     uint32_t loopLengthSamples() const { return length_; }
     uint32_t playheadSamples() const { return static_cast<uint32_t>(playhead_); }
     float getPeak() { float p = peak_; peak_ = 0; return p; } // logically read-and-clear
@@ -77,6 +82,8 @@ public:
 private:
     int16_t* buffer_ = nullptr;
     uint32_t maxSamples_ = 0;
+    float maxSeconds_ = 0.0f;
+    float sampleRate_ = static_cast<float>(kSampleRate);
     uint32_t length_ = 0;         // Current loop length in samples
     float playhead_ = 0;          // Float for interpolated playback
     
@@ -62,6 +62,33 @@ float TransientShaper::process(float input) {
   return input * totalGain;
 }
 
+void TransientShaper::processBlock(float* buf, size_t n) {
+  float attackLeverage = (attackAmount_ >= 0.0f) ? (attackAmount_ * 4.0f) : (attackAmount_ * 0.9f);
+  float sustainLeverage = (sustainAmount_ >= 0.0f) ? (sustainAmount_ * 2.0f) : (sustainAmount_ * 0.9f);
+
+  // Neutral settings leave the signal untouched; only keep the followers warm.
+  if (attackLeverage == 0.0f && sustainLeverage == 0.0f) {
+    for (size_t i = 0; i < n; ++i) {
+      fastEnv_.process(buf[i]);
+      slowEnv_.process(buf[i]);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    float input = buf[i];
+    float delta = fastEnv_.process(input) - slowEnv_.process(input);
+    if (delta < 0.0f) delta = 0.0f;
+    float transientMask = delta * 12.0f;
+    if (transientMask > 1.0f) transientMask = 1.0f;
+
+    float totalGain = 1.0f;
+    totalGain += attackLeverage * transientMask;
+    totalGain += sustainLeverage * (1.0f - transientMask);
+    buf[i] = input * totalGain;
+  }
+}
+
 void TransientShaper::EnvelopeFollower::reset() {
   env = 0.0f;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <stddef.h>
 
 class TransientShaper {
 public:
@@ -12,6 +13,7 @@ public:
   void setSustainAmount(float amount);
 
   float process(float input);
+  void processBlock(float* buf, size_t n);
 
 private:
   struct EnvelopeFollower {
@@ -42,3 +42,20 @@ float TubeDistortion::process(float input) {
   // Gentle safety clip to avoid sudden overs while preserving body.
   return out / (1.0f + 0.35f * fabsf(out));
 }
+
+void TubeDistortion::processBlock(float* buf, size_t n) {
+  if (!enabled_) {
+    return;
+  }
+  const float drive = drive_;
+  const float comp = cachedComp_;
+  const float wet = mix_;
+  const float dry = 1.0f - mix_;
+  for (size_t i = 0; i < n; ++i) {
+    float input = buf[i];
+    float driven = input * drive;
+    float shaped = driven / (1.0f + fabsf(driven)) * comp;
+    float out = input * dry + shaped * wet;
+    buf[i] = out / (1.0f + 0.35f * fabsf(out));
+  }
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+
 class TubeDistortion {
 public:
   TubeDistortion();
@@ -8,6 +10,7 @@ public:
   void setEnabled(bool on);
   bool isEnabled() const;
   float process(float input);
+  void processBlock(float* buf, size_t n);
 
 private:
   float drive_;
@@ -3,6 +3,7 @@
 // Logging layer for both Arduino (ESP32) and Desktop/SDL builds.
 // Usage:
 //   LOG_DEBUG("value=%d\n", x);
+//   LOG_WARNING("lost %d\n", n);  // something the user should know about
 //   LOG_PRINTLN("hello");
 
 #if defined(ARDUINO)
@@ -17,8 +18,15 @@
     Serial.printf(fmt, args...);
   }
 
+  template <typename... Args>
+  inline void log_warning(const char* fmt, Args... args) {
+    Serial.print("[WARN] ");
+    Serial.printf(fmt, args...);
+  }
+
   #define LOG_PRINTLN(msg) ::log_println(msg)
   #define LOG_DEBUG(...)   ::log_debug(__VA_ARGS__)
+  #define LOG_WARNING(...) ::log_warning(__VA_ARGS__)
 
   inline void logMem() {
     Serial.printf("heapFree=%u heapMin=%u\n", ESP.getFreeHeap(), ESP.getMinFreeHeap());
@@ -37,8 +45,15 @@
     std::printf(fmt, args...);
   }
 
+  template <typename... Args>
+  inline void log_warning(const char* fmt, Args... args) {
+    std::fprintf(stderr, "[WARN] ");
+    std::fprintf(stderr, fmt, args...);
+  }
+
   #define LOG_PRINTLN(msg) ::log_println(msg)
   #define LOG_DEBUG(...)   ::log_debug(__VA_ARGS__)
+  #define LOG_WARNING(...) ::log_warning(__VA_ARGS__)
   
   inline void logMem() {
       // Desktop stub
@@ -0,0 +1,20 @@
+#pragma once
+
+// Opaque token for the calling thread/task. Only used for equality checks
+// (e.g. "is this the audio thread?"), never dereferenced.
+
+#include <stdint.h>
+
+#if defined(ARDUINO)
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+
+  inline uintptr_t currentThreadToken() {
+    return reinterpret_cast<uintptr_t>(xTaskGetCurrentTaskHandle());
+  }
+#else
+  inline uintptr_t currentThreadToken() {
+    static thread_local char tag;
+    return reinterpret_cast<uintptr_t>(&tag);
+  }
+#endif
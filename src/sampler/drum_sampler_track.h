@@ -27,6 +27,8 @@ public:
 
   // Audio Thread: Process audio loop
   void process(float* output, uint32_t numFrames, ISampleStore& store);
+
+  void setSampleRate(float sampleRate) { pool_.setSampleRate(sampleRate); }
   
   SamplerPad& pad(int index) { return pads_[index]; }
   const SamplerPad& pad(int index) const { return pads_[index]; }
@@ -1,5 +1,7 @@
 #include "ram_sample_store.h"
 #include "sample_index.h"
+#include "sample_loader.h"
+#include "../audio/audio_config.h"
 #include <atomic>
 #include <mutex>
 #include <array>
@@ -8,11 +10,26 @@
 #include <cstdio>
 #include <limits>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
-// External WAV loader
-bool loadWavFile(const char* path, WavInfo& info, int16_t** outPcm);
+#if defined(ESP32) || defined(ESP_PLATFORM) || defined(ARDUINO)
+#include <esp_heap_caps.h>
+#define ARENA_MALLOC_PSRAM(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define ARENA_MALLOC_DRAM(size) heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define ARENA_MALLOC_PSRAM(size) malloc(size)
+#define ARENA_MALLOC_DRAM(size) malloc(size)
+#endif
 
-RamSampleStore::RamSampleStore() : currentPoolUsage_(0), maxPoolBytes_(256 * 1024), timeCounter_(0) {
+static constexpr std::size_t kArenaAlign = 4;
+
+static std::size_t alignUp(std::size_t bytes) {
+  return (bytes + kArenaAlign - 1) & ~(kArenaAlign - 1);
+}
+
+RamSampleStore::RamSampleStore() : currentPoolUsage_(0), maxPoolBytes_(256 * 1024), timeCounter_(0),
+                                   targetRate_(kSampleRate) {
   for (auto& slot : slots_) {
     slot.id.store(0);
     slot.ready.store(false);
@@ -22,6 +39,10 @@ RamSampleStore::RamSampleStore() : currentPoolUsage_(0), maxPoolBytes_(256 * 102
   }
 }
 
+RamSampleStore::~RamSampleStore() {
+  free(arena_);
+}
+
 uint32_t RamSampleStore::nextTime() {
   return timeCounter_.fetch_add(1, std::memory_order_relaxed);
 }
@@ -33,7 +54,13 @@ SampleHandle RamSampleStore::acquireHandle(SampleId id) {
     auto& slot = slots_[i];
     if (slot.id.load(std::memory_order_relaxed) == id.value &&
         slot.ready.load(std::memory_order_acquire)) {
-      slot.refCount.fetch_add(1, std::memory_order_relaxed);
+      slot.refCount.fetch_add(1, std::memory_order_seq_cst);
+      // Pairs with lockForMove(): the slot may be about to move or go away.
+      if (!slot.ready.load(std::memory_order_seq_cst) ||
+          slot.id.load(std::memory_order_relaxed) != id.value) {
+        slot.refCount.fetch_sub(1, std::memory_order_relaxed);
+        continue;
+      }
       slot.lastAccess.store(nextTime(), std::memory_order_relaxed);
       return {i, id};
     }
@@ -101,86 +128,229 @@ void RamSampleStore::registerFile(SampleId id, const std::string& path) {
   filePaths_[id.value] = path;
 }
 
-bool RamSampleStore::preload(SampleId id) {
-  // 1. Check if already loaded
+bool RamSampleStore::touchLoaded(SampleId id) {
   for (auto& slot : slots_) {
     if (slot.id.load(std::memory_order_acquire) == id.value) {
       slot.lastAccess.store(nextTime(), std::memory_order_relaxed);
       return true;
     }
   }
+  return false;
+}
 
-  // 2. Find path
-  std::string path;
-  {
-    std::lock_guard<std::mutex> lk(pathsMutex_);
-    auto it = filePaths_.find(id.value);
-    if (it == filePaths_.end()) {
-        printf("Preload: ID %u not found in registry\n", id.value);
-        return false;
-    }
-    path = it->second;
+bool RamSampleStore::lookupPath(SampleId id, std::string& path) {
+  std::lock_guard<std::mutex> lk(pathsMutex_);
+  auto it = filePaths_.find(id.value);
+  if (it == filePaths_.end()) {
+      printf("Preload: ID %u not found in registry\n", id.value);
+      return false;
   }
+  path = it->second;
+  return true;
+}
 
-  printf("Preload: Loading %s ...\n", path.c_str());
+bool RamSampleStore::ensureArena() {
+  if (arena_ && (arenaBytes_ == maxPoolBytes_ || currentPoolUsage_ > 0)) return true;
+  free(arena_);
+  arenaBytes_ = 0;
+  arena_ = (uint8_t*)ARENA_MALLOC_PSRAM(maxPoolBytes_);
+  if (!arena_) arena_ = (uint8_t*)ARENA_MALLOC_DRAM(maxPoolBytes_);
+  if (!arena_) {
+    printf("Pool: Arena alloc failed for %u bytes\n", (unsigned)maxPoolBytes_);
+    return false;
+  }
+  arenaBytes_ = maxPoolBytes_;
+  return true;
+}
 
-  // 3. Load from disk
-  WavInfo info;
-  int16_t* pcm = nullptr;
-  if (!loadWavFile(path.c_str(), info, &pcm)) {
-    printf("Preload: loadWavFile failed for %s\n", path.c_str());
+void RamSampleStore::setPoolSize(std::size_t bytes) {
+  maxPoolBytes_ = bytes;
+  if (currentPoolUsage_ > 0) {
+    printf("Pool: Resize to %u deferred, %u bytes in use\n", (unsigned)bytes, (unsigned)currentPoolUsage_);
+    return;
+  }
+  ensureArena();
+}
+
+void RamSampleStore::setTargetSampleRate(uint32_t rate) {
+  targetRate_.store(rate, std::memory_order_relaxed);
+}
+
+// Arena ranges held by slots (published or reserved), sorted by offset.
+int RamSampleStore::usedRanges(Range* out) const {
+  int n = 0;
+  for (const auto& slot : slots_) {
+    if (slot.sizeBytes > 0) out[n++] = {slot.arenaOffset, slot.sizeBytes};
+  }
+  std::sort(out, out + n, [](const Range& a, const Range& b) { return a.offset < b.offset; });
+  return n;
+}
+
+bool RamSampleStore::findGap(std::size_t size, std::size_t* offset) const {
+  Range used[kMaxSampleSlots];
+  int n = usedRanges(used);
+  std::size_t cursor = 0;
+  for (int i = 0; i < n; ++i) {
+    if (used[i].offset - cursor >= size) break;
+    cursor = used[i].offset + used[i].size;
+  }
+  if (arenaBytes_ - cursor < size) return false;
+  *offset = cursor;
+  return true;
+}
+
+std::size_t RamSampleStore::largestFreeBlock() const {
+  if (!arena_) return 0;
+  Range used[kMaxSampleSlots];
+  int n = usedRanges(used);
+  std::size_t cursor = 0;
+  std::size_t largest = 0;
+  for (int i = 0; i < n; ++i) {
+    largest = std::max(largest, used[i].offset - cursor);
+    cursor = used[i].offset + used[i].size;
+  }
+  return std::max(largest, arenaBytes_ - cursor);
+}
+
+// Takes an unreferenced slot away from the audio thread. Clears ready, then
+// checks refCount; acquireHandle() does the reverse, so either the voice
+// sees the slot as not ready or we see its reference and put ready back.
+bool RamSampleStore::lockForMove(SampleSlot& slot) {
+  slot.ready.store(false, std::memory_order_seq_cst);
+  if (slot.refCount.load(std::memory_order_seq_cst) != 0) {
+    slot.ready.store(true, std::memory_order_release);
     return false;
   }
-  
-  std::size_t size = info.numFrames * sizeof(int16_t);
-  printf("Preload: Loaded %u frames (%u bytes). Pool usage: %u/%u\n", 
-         info.numFrames, (unsigned)size, (unsigned)currentPoolUsage_, (unsigned)maxPoolBytes_);
-  
-  // 4. Find free slot or evict
-  int slotIdx = -1;
-  while (currentPoolUsage_ + size > maxPoolBytes_) {
+  return true;
+}
+
+// Slides unreferenced samples towards the start of the arena so the free
+// space collects at the end. Samples in use stay where they are.
+void RamSampleStore::compact() {
+  std::size_t cursor = 0;
+  std::size_t moved = 0;
+  for (;;) {
+    // Lowest slot at or above the cursor; slots are few, a scan is fine.
+    SampleSlot* next = nullptr;
+    for (auto& slot : slots_) {
+      if (slot.sizeBytes > 0 && slot.arenaOffset >= cursor &&
+          (!next || slot.arenaOffset < next->arenaOffset)) {
+        next = &slot;
+      }
+    }
+    if (!next) break;
+    // Reserved slots (id 0) are being loaded into and cannot move.
+    if (next->arenaOffset > cursor && next->id.load(std::memory_order_relaxed) != 0 &&
+        lockForMove(*next)) {
+      uint8_t* dst = arena_ + cursor;
+      memmove(dst, arena_ + next->arenaOffset, next->sizeBytes);
+      next->arenaOffset = cursor;
+      next->data.store(reinterpret_cast<const int16_t*>(dst), std::memory_order_relaxed);
+      next->ready.store(true, std::memory_order_release);
+      moved += next->sizeBytes;
+    }
+    cursor = next->arenaOffset + next->sizeBytes;
+  }
+  ++compactions_;
+  printf("Pool: Compacted, moved %u bytes, largest free %u/%u\n",
+         (unsigned)moved, (unsigned)largestFreeBlock(), (unsigned)freePoolBytes());
+}
+
+int RamSampleStore::reserveSlot(std::size_t size, int16_t** pcm) {
+  size = alignUp(size);
+  if (!ensureArena()) return -1;
+  if (size > arenaBytes_) {
+    printf("Preload: %u bytes is larger than the whole pool (%u)\n", (unsigned)size, (unsigned)arenaBytes_);
+    return -1;
+  }
+
+  std::size_t offset = 0;
+  for (;;) {
+    if (currentPoolUsage_ + size <= arenaBytes_) {
+      if (findGap(size, &offset)) break;
+      compact();
+      if (findGap(size, &offset)) break;
+    }
     printf("Preload: Evicting LRU to make space...\n");
+    std::size_t before = currentPoolUsage_;
     evictLRU();
-    // Safety break if eviction didn't help (e.g. all locked?)
-    if (freePoolBytes() < size && currentPoolUsage_ == 0) break; // Should not happen if evict works
-  }
-  
-  if (currentPoolUsage_ + size > maxPoolBytes_) {
-      printf("Preload: Pool full! Needed %u, have %u free. Max: %u\n", 
-             (unsigned)size, (unsigned)freePoolBytes(), (unsigned)maxPoolBytes_);
-      free(pcm);
-      return false;
+    // Nothing left to evict (all in use)
+    if (currentPoolUsage_ == before) {
+      printf("Preload: Pool full! Needed %u, have %u free (largest %u). Max: %u\n", 
+             (unsigned)size, (unsigned)freePoolBytes(), (unsigned)largestFreeBlock(), (unsigned)arenaBytes_);
+      return -1;
+    }
   }
 
-  // Find empty slot
   for (int i = 0; i < kMaxSampleSlots; ++i) {
-    if (slots_[i].id.load(std::memory_order_relaxed) == 0) {
-      slotIdx = i;
-      break;
+    auto& slot = slots_[i];
+    if (slot.id.load(std::memory_order_relaxed) == 0 && slot.sizeBytes == 0) {
+      slot.arenaOffset = offset;
+      slot.sizeBytes = size;
+      currentPoolUsage_ += size;
+      *pcm = reinterpret_cast<int16_t*>(arena_ + offset);
+      return i;
     }
   }
+  printf("Preload: No free slots!\n");
+  return -1;
+}
 
-  if (slotIdx < 0) {
-    printf("Preload: No free slots!\n");
-    if (pcm) free(pcm);
-    return false;
-  }
+void RamSampleStore::cancelSlot(int slotIdx) {
+  currentPoolUsage_ -= slots_[slotIdx].sizeBytes;
+  slots_[slotIdx].sizeBytes = 0;
+}
 
-  // 5. Fill slot
-  slots_[slotIdx].frames = info.numFrames;
-  slots_[slotIdx].sampleRate = info.sampleRate;
-  slots_[slotIdx].sizeBytes = size;
-  slots_[slotIdx].data.store(pcm, std::memory_order_relaxed);
-  slots_[slotIdx].lastAccess.store(nextTime(), std::memory_order_relaxed);
-  slots_[slotIdx].refCount.store(0, std::memory_order_relaxed);
+void RamSampleStore::publishSlot(int slotIdx, SampleId id, uint32_t frames, uint32_t sampleRate) {
+  auto& slot = slots_[slotIdx];
+  slot.frames = frames;
+  slot.sampleRate = sampleRate;
+  slot.data.store(reinterpret_cast<const int16_t*>(arena_ + slot.arenaOffset), std::memory_order_relaxed);
+  slot.lastAccess.store(nextTime(), std::memory_order_relaxed);
+  slot.refCount.store(0, std::memory_order_relaxed);
   
   // Publish ID
-  slots_[slotIdx].id.store(id.value, std::memory_order_relaxed);
+  slot.id.store(id.value, std::memory_order_relaxed);
   
   // Publish ready LAST with release semantics
-  slots_[slotIdx].ready.store(true, std::memory_order_release);
+  slot.ready.store(true, std::memory_order_release);
+}
+
+bool RamSampleStore::preload(SampleId id) {
+  // 1. Check if already loaded
+  if (touchLoaded(id)) return true;
+
+  // 2. Find path
+  std::string path;
+  if (!lookupPath(id, path)) return false;
+
+  printf("Preload: Loading %s ...\n", path.c_str());
+
+  // 3. Reserve arena space, then read straight into it
+  SampleSource src;
+  if (!openSampleSource(path.c_str(), targetRate_.load(std::memory_order_relaxed), src)) {
+    printf("Preload: openSampleSource failed for %s\n", path.c_str());
+    return false;
+  }
   
-  currentPoolUsage_ += size;
+  std::size_t size = src.frames * sizeof(int16_t);
+  int16_t* pcm = nullptr;
+  int slotIdx = reserveSlot(size, &pcm);
+  if (slotIdx < 0) return false;
+
+  bool loaded = src.needsConversion
+                    ? convertSample(path.c_str(), src.sampleRate, pcm, src.frames)
+                    : readSampleFrames(src, 0, src.frames, pcm) == src.frames;
+  if (!loaded) {
+    printf("Preload: Incomplete read of %s\n", path.c_str());
+    cancelSlot(slotIdx);
+    return false;
+  }
+  printf("Preload: Loaded %u frames (%u bytes). Pool usage: %u/%u\n", 
+         src.frames, (unsigned)size, (unsigned)currentPoolUsage_, (unsigned)arenaBytes_);
+
+  // 4. Publish
+  publishSlot(slotIdx, id, src.frames, src.sampleRate);
   return true;
 }
 
@@ -201,17 +371,18 @@ void RamSampleStore::evictLRU() {
 
   if (candidateIdx >= 0) {
     // Clear ready first to stop new acquisitions
-    slots_[candidateIdx].ready.store(false, std::memory_order_release);
-    slots_[candidateIdx].id.store(0, std::memory_order_relaxed);
-    int16_t* ptr = (int16_t*)slots_[candidateIdx].data.exchange(nullptr, std::memory_order_acquire);
-    if (ptr) free(ptr); 
-    
-    currentPoolUsage_ -= slots_[candidateIdx].sizeBytes;
-    slots_[candidateIdx].sizeBytes = 0;
+    auto& slot = slots_[candidateIdx];
+    if (!lockForMove(slot)) return;
+    slot.id.store(0, std::memory_order_relaxed);
+    slot.data.store(nullptr, std::memory_order_relaxed);
+    currentPoolUsage_ -= slot.sizeBytes;
+    slot.sizeBytes = 0;
+    onSlotFreed(candidateIdx);
   }
 }
 
 std::size_t RamSampleStore::freePoolBytes() const {
-  if (currentPoolUsage_ > maxPoolBytes_) return 0;
-  return maxPoolBytes_ - currentPoolUsage_;
+  std::size_t capacity = arena_ ? arenaBytes_ : maxPoolBytes_;
+  if (currentPoolUsage_ > capacity) return 0;
+  return capacity - currentPoolUsage_;
 }
@@ -17,14 +17,28 @@ struct SampleSlot {
   std::atomic<const int16_t*> data{nullptr};
   uint32_t frames = 0;
   uint32_t sampleRate = 0;
-  std::size_t sizeBytes = 0;
+  std::size_t arenaOffset = 0;
+  std::size_t sizeBytes = 0;          // arena bytes held, 0 = none
   std::atomic<uint32_t> refCount{0};
   std::atomic<uint32_t> lastAccess{0};
 };
 
+// Sample data lives in one arena of setPoolSize() bytes, allocated once, so
+// loading a kit never goes to the heap and the pool holds what its size says
+// instead of what heap fragmentation leaves. Samples get first-fit ranges;
+// when the free bytes are there but not in one piece, unreferenced samples
+// are slid down to close the gaps (compaction) before anything is evicted.
+//
+// Moving or evicting a slot clears `ready` and then checks refCount, while
+// acquireHandle() bumps refCount and then checks `ready`, so a slot is never
+// moved under a voice: one side always sees the other and backs off.
+//
+// Samples are loaded as 16-bit mono at the engine rate (see sample_loader.h),
+// so a slot costs two bytes per frame whatever the WAV was.
 class RamSampleStore : public ISampleStore {
 public:
   RamSampleStore();
+  ~RamSampleStore() override;
   
   // --- Audio Thread Interface (Lock-Free) ---
   // Handle-based API (preferred)
@@ -41,7 +55,12 @@ public:
   bool preload(SampleId id) override;
   void evictLRU() override;
   std::size_t freePoolBytes() const override;
-  void setPoolSize(std::size_t bytes) { maxPoolBytes_ = bytes; }
+  std::size_t largestFreeBlock() const override;
+  // (Re)allocates the arena. A pool with samples loaded keeps its arena
+  // until it has been emptied.
+  void setPoolSize(std::size_t bytes) override;
+  void setTargetSampleRate(uint32_t rate) override;
+  uint32_t compactionCount() const { return compactions_; }
 
   // Helpers
   void registerFile(SampleId id, const std::string& path);
@@ -49,6 +68,20 @@ public:
 protected:
   uint32_t nextTime();
 
+  // preload() steps, for stores that load samples their own way.
+  bool touchLoaded(SampleId id);
+  bool lookupPath(SampleId id, std::string& path);
+  // Finds arena space for `bytes` (compacting, then evicting, as needed) and
+  // a free slot to hold it; pcm receives the range to load into. Returns the
+  // slot, or -1 (pool full). The slot stays unpublished until publishSlot(),
+  // or gives the range back with cancelSlot().
+  int reserveSlot(std::size_t bytes, int16_t** pcm);
+  void cancelSlot(int slotIdx);
+  void publishSlot(int slotIdx, SampleId id, uint32_t frames, uint32_t sampleRate);
+  // Called after evictLRU() has freed a slot, for per-slot state kept
+  // alongside slots_.
+  virtual void onSlotFreed(int slotIdx) { (void)slotIdx; }
+
   // Slots: accessible by both threads
   std::array<SampleSlot, kMaxSampleSlots> slots_;
   
@@ -58,4 +91,18 @@ protected:
   std::size_t currentPoolUsage_;
   std::size_t maxPoolBytes_;
   std::atomic<uint32_t> timeCounter_;
+  std::atomic<uint32_t> targetRate_;
+
+private:
+  struct Range { std::size_t offset; std::size_t size; };
+
+  bool ensureArena();
+  int usedRanges(Range* out) const;
+  bool findGap(std::size_t bytes, std::size_t* offset) const;
+  void compact();
+  bool lockForMove(SampleSlot& slot);
+
+  uint8_t* arena_ = nullptr;
+  std::size_t arenaBytes_ = 0;
+  uint32_t compactions_ = 0;
 };
@@ -1,19 +1,18 @@
 #include "../audio/audio_config.h"
-#include "sample_store.h" // for WavInfo
+#include "sample_loader.h"
+#include "sample_index.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
-#include <vector>
 #include <cstdlib>
 
 #if defined(ESP32) || defined(ESP_PLATFORM) || defined(ARDUINO)
-#include <esp_heap_caps.h>
 #include <SD.h>
-#define SAMPLE_MALLOC_PSRAM(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
-#define SAMPLE_MALLOC_DRAM(size) heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
 #define USE_SD_OPEN 1
 #else
-#define SAMPLE_MALLOC_PSRAM(size) malloc(size)
-#define SAMPLE_MALLOC_DRAM(size) malloc(size)
+#include <cerrno>
+#include <sys/stat.h>
 #define USE_SD_OPEN 0
 #endif
 
@@ -21,186 +20,475 @@ struct WavRiffHeader {
   char riff[4]; uint32_t totalSize; char wave[4];
 };
 
-struct WavFmtChunk {
-  char fmt[4]; uint32_t chunkSize;
-  uint16_t audioFormat; uint16_t numChannels;
-  uint32_t sampleRate; uint32_t byteRate;
-  uint16_t blockAlign; uint16_t bitsPerSample;
-};
-
 struct WavChunkHeader { char id[4]; uint32_t size; };
 
-bool loadWavFile(const char* path, WavInfo& outInfo, int16_t** outPcm) {
-  printf("loadWavFile: %s\n", path);
+// Samples are read in two steps: the source, so the store can reserve pool
+// space, then frames straight into that space (whole samples at preload,
+// page by page for streamed ones).
+
+namespace {
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatFloat = 3;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+constexpr uint16_t kMaxChannels = 8;
+
+constexpr uint32_t kCacheMagic = 0x43535047;  // "GPSC"
+constexpr uint16_t kCacheVersion = 1;
+
+// Header of a cache entry; 16-bit mono frames follow.
+struct SampleCacheHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t sampleRate;  // rate the frames were converted to
+  uint32_t frames;
+  uint32_t sourceSize;  // WAV size and modification time at conversion
+  uint32_t sourceTime;
+  uint32_t pathHash;
+};
+static_assert(sizeof(SampleCacheHeader) == 28, "SampleCacheHeader must stay packed");
 
 #if USE_SD_OPEN
-  File f = SD.open(path, FILE_READ);
-  if (!f) {
-      printf("loadWavFile: SD.open failed for %s\n", path);
-      return false;
-  }
+struct SampleFile {
+  File f;
+  bool open(const char* path) { f = SD.open(path, FILE_READ); return (bool)f; }
+  bool create(const char* path) { f = SD.open(path, FILE_WRITE); return (bool)f; }
+  size_t read(void* dst, size_t len) { return f.read((uint8_t*)dst, len); }
+  bool write(const void* src, size_t len) { return f.write((const uint8_t*)src, len) == len; }
+  bool seek(uint32_t pos) { return f.seek(pos); }
+  uint32_t position() { return f.position(); }
+  uint32_t size() { return f.size(); }
+  uint32_t mtime() { return (uint32_t)f.getLastWrite(); }
+  void close() { f.close(); }
+};
 
-  WavRiffHeader riff;
-  if (f.read((uint8_t*)&riff, sizeof(riff)) != sizeof(riff)) { f.close(); return false; }
+bool makeDir(const char* path) { return SD.exists(path) || SD.mkdir(path); }
+bool replaceFile(const char* from, const char* to) {
+  if (SD.exists(to)) SD.remove(to);
+  return SD.rename(from, to);
+}
+void removeFile(const char* path) { SD.remove(path); }
+#else
+struct SampleFile {
+  FILE* f = nullptr;
+  bool open(const char* path) { f = fopen(path, "rb"); return f != nullptr; }
+  bool create(const char* path) { f = fopen(path, "wb"); return f != nullptr; }
+  size_t read(void* dst, size_t len) { return fread(dst, 1, len, f); }
+  bool write(const void* src, size_t len) { return fwrite(src, 1, len, f) == len; }
+  bool seek(uint32_t pos) { return fseek(f, pos, SEEK_SET) == 0; }
+  uint32_t position() { return (uint32_t)ftell(f); }
+  uint32_t size() { struct stat st; return fstat(fileno(f), &st) == 0 ? (uint32_t)st.st_size : 0; }
+  uint32_t mtime() { struct stat st; return fstat(fileno(f), &st) == 0 ? (uint32_t)st.st_mtime : 0; }
+  void close() { if (f) fclose(f); f = nullptr; }
+};
+
+bool makeDir(const char* path) { return mkdir(path, 0755) == 0 || errno == EEXIST; }
+bool replaceFile(const char* from, const char* to) { return rename(from, to) == 0; }
+void removeFile(const char* path) { remove(path); }
+#endif
 
-  if (strncmp(riff.riff, "RIFF", 4) != 0 || strncmp(riff.wave, "WAVE", 4) != 0) {
-    printf("loadWavFile: Invalid RIFF/WAVE header\n");
-    f.close(); return false;
+struct WavFormat {
+  uint16_t format = 0;  // kFormatPcm or kFormatFloat
+  uint16_t channels = 0;
+  uint32_t sampleRate = 0;
+  uint16_t bitsPerSample = 0;
+  uint16_t blockAlign = 0;
+  uint32_t dataOffset = 0;
+  uint32_t frames = 0;
+};
+
+bool parseWav(SampleFile& f, WavFormat& out) {
+  WavRiffHeader riff;
+  if (f.read(&riff, sizeof(riff)) != sizeof(riff) ||
+      strncmp(riff.riff, "RIFF", 4) != 0 || strncmp(riff.wave, "WAVE", 4) != 0) {
+    printf("parseWav: Invalid RIFF/WAVE header\n");
+    return false;
   }
 
   bool fmtFound = false, dataFound = false;
   uint32_t dataSize = 0;
-  WavFmtChunk fmt;
-  memset(&fmt, 0, sizeof(fmt));
-
-  while (!dataFound && f.available()) {
+  while (!dataFound) {
     WavChunkHeader header;
-    if (f.read((uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+    if (f.read(&header, sizeof(header)) != sizeof(header)) break;
+    // Chunks are padded to an even size.
+    uint32_t padded = header.size + (header.size & 1);
 
     if (strncmp(header.id, "fmt ", 4) == 0) {
-      size_t toRead = (header.size < sizeof(fmt) - 8) ? header.size : (sizeof(fmt) - 8);
-      if (f.read((uint8_t*)&fmt.audioFormat, toRead) != toRead) break;
-      if (header.size > toRead) f.seek(f.position() + (header.size - toRead));
+      uint8_t body[26] = {0};
+      uint32_t n = std::min<uint32_t>(header.size, sizeof(body));
+      if (n < 16 || f.read(body, n) != n) break;
+      memcpy(&out.format, body, 2);
+      memcpy(&out.channels, body + 2, 2);
+      memcpy(&out.sampleRate, body + 4, 4);
+      memcpy(&out.blockAlign, body + 12, 2);
+      memcpy(&out.bitsPerSample, body + 14, 2);
+      // WAVE_FORMAT_EXTENSIBLE: the real format opens the sub-format GUID.
+      if (out.format == kFormatExtensible && n >= 26) memcpy(&out.format, body + 24, 2);
+      if (padded > n) f.seek(f.position() + (padded - n));
       fmtFound = true;
-      printf("loadWavFile: Found fmt. AudioFormat=%d Channels=%d Rate=%d Bits=%d\n", 
-             fmt.audioFormat, fmt.numChannels, fmt.sampleRate, fmt.bitsPerSample);
     } else if (strncmp(header.id, "data", 4) == 0) {
       dataSize = header.size;
+      out.dataOffset = f.position();
       dataFound = true;
-      printf("loadWavFile: Found data size=%u\n", dataSize);
     } else {
-      f.seek(f.position() + header.size);
+      f.seek(f.position() + padded);
     }
   }
 
-  if (!fmtFound || !dataFound || fmt.audioFormat != 1 || fmt.bitsPerSample != 16) {
-    printf("loadWavFile: Format not supported (req PCM 16-bit)\n");
-    f.close(); return false;
+  bool pcm = out.format == kFormatPcm &&
+             (out.bitsPerSample == 8 || out.bitsPerSample == 16 || out.bitsPerSample == 24 ||
+              out.bitsPerSample == 32);
+  bool flt = out.format == kFormatFloat && out.bitsPerSample == 32;
+  if (!fmtFound || !dataFound || !(pcm || flt) || out.channels < 1 || out.channels > kMaxChannels ||
+      out.sampleRate == 0 || out.blockAlign != out.channels * (out.bitsPerSample / 8)) {
+    printf("parseWav: Format not supported (format %u, %u-bit, %u ch)\n",
+           out.format, out.bitsPerSample, out.channels);
+    return false;
   }
+  out.frames = dataSize / out.blockAlign;
+  return true;
+}
 
-  outInfo.sampleRate = fmt.sampleRate;
-  outInfo.channels = fmt.numChannels; 
-  outInfo.bitsPerSample = fmt.bitsPerSample;
-  outInfo.numFrames = dataSize / ((fmt.bitsPerSample / 8) * fmt.numChannels);
-
-  size_t bytes = dataSize;
-  *outPcm = (int16_t*)SAMPLE_MALLOC_PSRAM(bytes);
-  if (!*outPcm) {
-    printf("loadWavFile: PSRAM alloc failed, trying DRAM\n");
-    *outPcm = (int16_t*)SAMPLE_MALLOC_DRAM(bytes);
-  }
-  if (!*outPcm) { 
-      printf("loadWavFile: Alloc failed for %zu bytes\n", bytes);
-      f.close(); return false; 
+float decodeSample(const uint8_t* p, const WavFormat& fmt) {
+  switch (fmt.bitsPerSample) {
+    case 8:
+      return ((int)p[0] - 128) / 128.0f;
+    case 16: {
+      int16_t v;
+      memcpy(&v, p, 2);
+      return v / 32768.0f;
+    }
+    case 24: {
+      int32_t v = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+      return v / 8388608.0f;
+    }
+    default:
+      if (fmt.format == kFormatFloat) {
+        float v;
+        memcpy(&v, p, 4);
+        return v;
+      } else {
+        int32_t v;
+        memcpy(&v, p, 4);
+        return v / 2147483648.0f;
+      }
   }
+}
 
-  if (f.read((uint8_t*)*outPcm, dataSize) != dataSize) {
-    printf("loadWavFile: Incomplete read\n");
-    free(*outPcm); *outPcm = nullptr;
-    f.close(); return false;
+// Decodes up to `count` frames from the file position into mono floats.
+uint32_t decodeFrames(SampleFile& f, const WavFormat& fmt, float* dst, uint32_t count) {
+  uint8_t raw[1024];
+  const uint32_t perRead = sizeof(raw) / fmt.blockAlign;
+  const uint32_t bytesPerSample = fmt.bitsPerSample / 8;
+  const float scale = 1.0f / fmt.channels;
+  uint32_t done = 0;
+  while (done < count) {
+    uint32_t want = std::min(count - done, perRead);
+    uint32_t got = (uint32_t)(f.read(raw, want * fmt.blockAlign) / fmt.blockAlign);
+    for (uint32_t i = 0; i < got; ++i) {
+      const uint8_t* frame = raw + i * fmt.blockAlign;
+      float sum = 0.0f;
+      for (uint16_t c = 0; c < fmt.channels; ++c) sum += decodeSample(frame + c * bytesPerSample, fmt);
+      dst[done + i] = sum * scale;
+    }
+    done += got;
+    if (got < want) break;
   }
-  f.close();
+  return done;
+}
 
-#else
-  // Desktop/SDL: use fopen
-  FILE* f = fopen(path, "rb");
-  if (!f) {
-      printf("loadWavFile: fopen failed for %s\n", path);
-      return false;
+int16_t toPcm16(float v) {
+  float s = v * 32768.0f;
+  if (s >= 32767.0f) return 32767;
+  if (s <= -32768.0f) return -32768;
+  return (int16_t)lrintf(s);
+}
+
+// Polyphase Blackman-windowed sinc over kHalfZeroCrossings zero crossings a
+// side. Row p holds the taps() coefficients for an output p/phases() of the
+// way between two source frames; rows are interpolated for the fraction in
+// between. When downsampling the kernel is stretched so its cutoff sits below
+// the target Nyquist frequency, which takes more taps but fewer phases (the
+// stretched kernel is smoother), so rows share one fixed Q15 table. Past
+// about 11:1 it no longer fits in kMaxTaps and keeps fewer zero crossings.
+//
+// The table is file-static: conversion only runs from preload(), which the
+// stores call from one thread.
+class PolyphaseKernel {
+public:
+  static constexpr int kHalfZeroCrossings = 8;
+  static constexpr int kMaxTaps = 192;
+  static constexpr int kMaxPhases = 64;
+  static constexpr int kTableSize = (kMaxPhases + 1) * 32;
+  static constexpr float kCutoff = 0.94f;
+
+  void build(uint32_t sourceRate, uint32_t targetRate) {
+    const float pi = 3.14159265f;
+    const float fc = std::min(1.0f, (float)targetRate / (float)sourceRate) * kCutoff;
+    taps_ = std::min(kMaxTaps, 2 * (int)std::ceil(kHalfZeroCrossings / fc));
+    phases_ = std::min(kMaxPhases, kTableSize / taps_ - 1);
+    const float half = taps_ / 2;
+    for (int p = 0; p <= phases_; ++p) {
+      int16_t* row = coef_ + p * taps_;
+      for (int j = 0; j < taps_; ++j) {
+        // Distance from tap j to the output position, in source frames.
+        float d = (float)p / phases_ + half - 1.0f - j;
+        float x = pi * fc * d;
+        float sinc = d == 0.0f ? 1.0f : std::sin(x) / x;
+        float u = d / half;
+        float w = std::fabs(u) >= 1.0f ? 0.0f : 0.42f + 0.5f * std::cos(pi * u) + 0.08f * std::cos(2.0f * pi * u);
+        row[j] = (int16_t)lrintf(sinc * w * fc * 32767.0f);
+      }
+    }
   }
 
-  WavRiffHeader riff;
-  if (fread(&riff, 1, sizeof(riff), f) != sizeof(riff)) { fclose(f); return false; }
+  int taps() const { return taps_; }
 
-  if (strncmp(riff.riff, "RIFF", 4) != 0 || strncmp(riff.wave, "WAVE", 4) != 0) {
-    printf("loadWavFile: Invalid RIFF/WAVE header\n");
-    fclose(f); return false;
+  // `x` holds the kernel's source frames, first tap first; `frac` is the
+  // output's position past frame x[taps() / 2 - 1], in 2^-32 frame steps.
+  float apply(const float* x, uint32_t frac) const {
+    const uint64_t at = (uint64_t)frac * (uint32_t)phases_;
+    const int p = (int)(at >> 32);
+    const float t = (uint32_t)at * (1.0f / 4294967296.0f);
+    const int16_t* a = coef_ + p * taps_;
+    const int16_t* b = a + taps_;
+    float accA = 0.0f;
+    float accB = 0.0f;
+    for (int j = 0; j < taps_; ++j) {
+      accA += x[j] * a[j];
+      accB += x[j] * b[j];
+    }
+    return (accA + t * (accB - accA)) * (1.0f / 32767.0f);
   }
 
-  bool fmtFound = false, dataFound = false;
-  uint32_t dataSize = 0;
-  WavFmtChunk fmt;
-  memset(&fmt, 0, sizeof(fmt));
+private:
+  int taps_ = 0;
+  int phases_ = 0;
+  int16_t coef_[kTableSize] = {};
+};
 
-  while (!dataFound && !feof(f)) {
-    WavChunkHeader header;
-    if (fread(&header, 1, sizeof(header), f) != sizeof(header)) break;
+PolyphaseKernel gKernel;
 
-    if (strncmp(header.id, "fmt ", 4) == 0) {
-      size_t toRead = (header.size < sizeof(fmt) - 8) ? header.size : (sizeof(fmt) - 8);
-      if (fread(&fmt.audioFormat, 1, toRead, f) != toRead) break;
-      if (header.size > toRead) fseek(f, header.size - toRead, SEEK_CUR);
-      fmtFound = true;
-      printf("loadWavFile: Found fmt. AudioFormat=%d Channels=%d Rate=%d Bits=%d\n", 
-             fmt.audioFormat, fmt.numChannels, fmt.sampleRate, fmt.bitsPerSample);
-    } else if (strncmp(header.id, "data", 4) == 0) {
-      dataSize = header.size;
-      dataFound = true;
-      printf("loadWavFile: Found data size=%u\n", dataSize);
-    } else {
-      fseek(f, header.size, SEEK_CUR);
+uint32_t convertedFrames(const WavFormat& fmt, uint32_t targetRate) {
+  uint64_t frames = (uint64_t)fmt.frames * targetRate / fmt.sampleRate;
+  return (uint32_t)std::max<uint64_t>(frames, 1);
+}
+
+// Streams the WAV's data through mono mixing and resampling into `sink`
+// (called as sink(const int16_t*, uint32_t) -> bool), producing exactly
+// outFrames frames (silence past a short file's end). All scratch is fixed
+// size; nothing here touches the heap.
+template <typename Sink>
+bool convertWav(SampleFile& f, const WavFormat& fmt, uint32_t targetRate, uint32_t outFrames, Sink&& sink) {
+  if (!f.seek(fmt.dataOffset)) return false;
+  constexpr uint32_t kChunk = 256;
+  int16_t out[kChunk];
+  uint32_t outFill = 0;
+  auto emit = [&](float v) {
+    out[outFill++] = toPcm16(v);
+    if (outFill < kChunk) return true;
+    outFill = 0;
+    return sink(out, kChunk);
+  };
+
+  // Source frames, decoded ahead of the kernel: window[i] is frame base + i.
+  constexpr uint32_t kWindow = 2 * PolyphaseKernel::kMaxTaps;
+  float window[kWindow];
+  if (fmt.sampleRate == targetRate) {
+    uint32_t produced = 0;
+    while (produced < outFrames) {
+      uint32_t want = std::min(kWindow, outFrames - produced);
+      uint32_t got = decodeFrames(f, fmt, window, want);
+      std::fill(window + got, window + want, 0.0f);
+      for (uint32_t i = 0; i < want; ++i) {
+        if (!emit(window[i])) return false;
+      }
+      produced += want;
     }
+    return outFill == 0 || sink(out, outFill);
   }
 
-  if (!fmtFound || !dataFound || fmt.audioFormat != 1 || fmt.bitsPerSample != 16) {
-    printf("loadWavFile: Format not supported (req PCM 16-bit)\n");
-    fclose(f); return false;
+  gKernel.build(fmt.sampleRate, targetRate);
+  const int taps = gKernel.taps();
+  const int64_t lead = taps / 2 - 1;  // taps before the frame at or left of t
+  // The output position t = pos + rem / targetRate steps by an exact rational.
+  const uint32_t stepWhole = fmt.sampleRate / targetRate;
+  const uint32_t stepRem = fmt.sampleRate % targetRate;
+  int64_t pos = 0;
+  uint32_t rem = 0;
+  int64_t base = -lead;  // the first output's kernel starts before frame 0
+  uint32_t filled = 0;
+  uint32_t decoded = 0;
+  // Produces source frames [next, next + count) into dst, in order: zeros
+  // before frame 0 and past the end (or a truncated file), decoded between.
+  auto produce = [&](int64_t next, float* dst, uint32_t count) {
+    uint32_t done = 0;
+    while (done < count) {
+      int64_t at = next + done;
+      uint32_t got;
+      if (at < 0) {
+        got = (uint32_t)std::min<int64_t>(count - done, -at);
+        std::fill(dst + done, dst + done + got, 0.0f);
+      } else if (decoded < fmt.frames) {
+        got = decodeFrames(f, fmt, dst + done, std::min(count - done, fmt.frames - decoded));
+        decoded += got;
+        if (got == 0) decoded = fmt.frames;  // truncated file: the rest is silence
+      } else {
+        got = count - done;
+        std::fill(dst + done, dst + count, 0.0f);
+      }
+      done += got;
+    }
+  };
+  for (uint32_t n = 0; n < outFrames; ++n) {
+    const int64_t first = pos - lead;
+    if (first + taps > base + (int64_t)filled) {
+      // Slide what the kernel still needs to the front (or skip frames it
+      // stepped over), then top the window up.
+      int64_t next = base + filled;
+      uint32_t keep = 0;
+      if (first < next) {
+        keep = (uint32_t)(next - first);
+        std::memmove(window, window + (filled - keep), keep * sizeof(float));
+      }
+      while (next < first) {
+        uint32_t skip = (uint32_t)std::min<int64_t>(first - next, kWindow);
+        produce(next, window, skip);
+        next += skip;
+      }
+      base = first;
+      produce(base + keep, window + keep, kWindow - keep);
+      filled = kWindow;
+    }
+    const uint32_t frac = (uint32_t)(((uint64_t)rem << 32) / targetRate);
+    if (!emit(gKernel.apply(window + (first - base), frac))) return false;
+    pos += stepWhole;
+    rem += stepRem;
+    if (rem >= targetRate) {
+      rem -= targetRate;
+      ++pos;
+    }
   }
+  return outFill == 0 || sink(out, outFill);
+}
 
-  outInfo.sampleRate = fmt.sampleRate;
-  outInfo.channels = fmt.numChannels; 
-  outInfo.bitsPerSample = fmt.bitsPerSample;
-  outInfo.numFrames = dataSize / ((fmt.bitsPerSample / 8) * fmt.numChannels);
+std::string cacheDirFor(const std::string& path) {
+  size_t slash = path.find_last_of('/');
+  if (slash == std::string::npos) return ".cache";
+  return path.substr(0, slash) + "/.cache";
+}
 
-  size_t bytes = dataSize;
-  *outPcm = (int16_t*)SAMPLE_MALLOC_PSRAM(bytes);
-  if (!*outPcm) {
-    printf("loadWavFile: PSRAM alloc failed, trying DRAM\n");
-    *outPcm = (int16_t*)SAMPLE_MALLOC_DRAM(bytes);
+bool cacheMatches(const std::string& cachePath, const SampleCacheHeader& expected) {
+  SampleFile f;
+  if (!f.open(cachePath.c_str())) return false;
+  SampleCacheHeader header;
+  bool ok = f.read(&header, sizeof(header)) == sizeof(header) &&
+            memcmp(&header, &expected, sizeof(header)) == 0 &&
+            f.size() >= sizeof(header) + (uint64_t)header.frames * sizeof(int16_t);
+  f.close();
+  return ok;
+}
+
+// Written to a temporary name and renamed, so a cut-off conversion never
+// leaves a valid-looking entry behind.
+bool writeCache(SampleFile& wav, const WavFormat& fmt, const std::string& cachePath,
+                const SampleCacheHeader& header) {
+  std::string tmpPath = cachePath + ".tmp";
+  SampleFile out;
+  if (!out.create(tmpPath.c_str())) return false;
+  bool ok = out.write(&header, sizeof(header)) &&
+            convertWav(wav, fmt, header.sampleRate, header.frames,
+                       [&out](const int16_t* pcm, uint32_t n) { return out.write(pcm, n * sizeof(int16_t)); });
+  out.close();
+  if (!ok || !replaceFile(tmpPath.c_str(), cachePath.c_str())) {
+    removeFile(tmpPath.c_str());
+    return false;
   }
-  if (!*outPcm) { 
-      printf("loadWavFile: Alloc failed for %zu bytes\n", bytes);
-      fclose(f); return false; 
+  return true;
+}
+} // namespace
+
+bool openSampleSource(const char* path, uint32_t targetRate, SampleSource& out) {
+  SampleFile f;
+  if (!f.open(path)) {
+    printf("openSampleSource: open failed for %s\n", path);
+    return false;
+  }
+  WavFormat fmt;
+  if (!parseWav(f, fmt)) {
+    f.close();
+    return false;
   }
 
-  if (fread(*outPcm, 2, dataSize / 2, f) != dataSize / 2) {
-    printf("loadWavFile: Incomplete read\n");
-    free(*outPcm); *outPcm = nullptr;
-    fclose(f); return false;
+  // Already in the engine's format: read it as is.
+  if (fmt.format == kFormatPcm && fmt.bitsPerSample == 16 && fmt.channels <= 2 &&
+      fmt.sampleRate == targetRate) {
+    f.close();
+    out = {path, fmt.dataOffset, fmt.channels, fmt.frames, fmt.sampleRate, false};
+    return true;
   }
-  fclose(f);
-#endif
-  
-  // Stereo to Mono mixdown if needed
-  if (fmt.numChannels == 2) {
-      // Very simple in-place mix: L = (L+R)/2
-      // Input: L0, R0, L1, R1...
-      // Output: M0, M1...
-      int16_t* data = *outPcm;
-      for (uint32_t i = 0; i < outInfo.numFrames; ++i) {
-          int32_t l = data[i*2];
-          int32_t r = data[i*2+1];
-          data[i] = (l + r) / 2;
-      }
-      outInfo.channels = 1;
-      // Realloc? No, just keep the detailed buffer or use less space.
-      // For V1, we just waste half space or realloc down. 
-      // Realloc down is better for small RAM.
-      // But careful with `new[]`. We can't realloc easily.
-      // Allocate new smaller buffer with PSRAM priority
-      int16_t* mono = (int16_t*)SAMPLE_MALLOC_PSRAM(outInfo.numFrames * 2);
-      if (!mono) mono = (int16_t*)SAMPLE_MALLOC_DRAM(outInfo.numFrames * 2);
-      
-      if (mono) {
-          for(uint32_t i=0; i<outInfo.numFrames; ++i) mono[i] = data[i];
-          free(data);
-          *outPcm = mono;
-      } else {
-          // If mono allocation fails, we keep the original (larger) buffer and just use it as mono
-          // (wasteful but prevents crash)
-          outInfo.channels = 1;
-      }
+
+  SampleCacheHeader header{kCacheMagic, kCacheVersion, 0, targetRate, convertedFrames(fmt, targetRate),
+                           f.size(), f.mtime(), SampleIndex::calculateHash(path)};
+  std::string dir = cacheDirFor(path);
+  char name[32];
+  snprintf(name, sizeof(name), "/%08x_%u.pcm", (unsigned)header.pathHash, (unsigned)targetRate);
+  std::string cachePath = dir + name;
+
+  if (!cacheMatches(cachePath, header)) {
+    printf("openSampleSource: Converting %s (%u Hz, %u-bit, %u ch) to %u Hz mono\n", path,
+           (unsigned)fmt.sampleRate, fmt.bitsPerSample, fmt.channels, (unsigned)targetRate);
+    if (!makeDir(dir.c_str()) || !writeCache(f, fmt, cachePath, header)) {
+      f.close();
+      printf("openSampleSource: Cache write failed, converting in memory\n");
+      out = {path, 0, 1, header.frames, targetRate, true};
+      return true;
+    }
   }
-  
+  f.close();
+  out = {cachePath, (uint32_t)sizeof(header), 1, header.frames, targetRate, false};
   return true;
 }
+
+uint32_t readSampleFrames(const SampleSource& src, uint32_t first, uint32_t count, int16_t* dst) {
+  if (src.needsConversion) return 0;
+  SampleFile f;
+  if (!f.open(src.path.c_str())) return 0;
+  if (!f.seek(src.dataOffset + first * src.channels * sizeof(int16_t))) { f.close(); return 0; }
+
+  uint32_t done = 0;
+  if (src.channels == 1) {
+    done = (uint32_t)(f.read(dst, count * sizeof(int16_t)) / sizeof(int16_t));
+  } else {
+    // Small chunks keep the stereo scratch on the stack.
+    int16_t chunk[256 * 2];
+    while (done < count) {
+      uint32_t want = count - done;
+      if (want > 256) want = 256;
+      uint32_t got = (uint32_t)(f.read(chunk, want * 2 * sizeof(int16_t)) / (2 * sizeof(int16_t)));
+      for (uint32_t i = 0; i < got; ++i) {
+        dst[done + i] = (int16_t)(((int32_t)chunk[i*2] + chunk[i*2+1]) / 2);
+      }
+      done += got;
+      if (got < want) break;
+    }
+  }
+  f.close();
+  return done;
+}
+
+bool convertSample(const char* path, uint32_t targetRate, int16_t* dst, uint32_t frames) {
+  SampleFile f;
+  if (!f.open(path)) return false;
+  WavFormat fmt;
+  uint32_t filled = 0;
+  bool ok = parseWav(f, fmt) &&
+            convertWav(f, fmt, targetRate, frames, [&](const int16_t* pcm, uint32_t n) {
+              n = std::min(n, frames - filled);
+              memcpy(dst + filled, pcm, n * sizeof(int16_t));
+              filled += n;
+              return true;
+            });
+  f.close();
+  return ok && filled == frames;
+}
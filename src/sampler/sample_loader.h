@@ -0,0 +1,30 @@
+#pragma once
+#include "sample_store.h"
+#include <string>
+
+// Where a sample's frames are read from once it has been normalized to
+// 16-bit mono at the engine rate: the WAV itself when it already is 16-bit
+// PCM at that rate, otherwise its converted copy in the SD cache
+// (<sample dir>/.cache/). Conversion happens once per file; the cache entry
+// records the source size and modification time and is redone when they
+// change.
+struct SampleSource {
+  std::string path;
+  uint32_t dataOffset = 0;
+  uint16_t channels = 1;        // 1 or 2; stereo is mixed down on read
+  uint32_t frames = 0;
+  uint32_t sampleRate = 0;
+  // The cache could not be written: only convertSample() can produce the
+  // frames, in one go.
+  bool needsConversion = false;
+};
+
+// Accepts 8/16/24/32-bit PCM and 32-bit float WAV, any channel count.
+bool openSampleSource(const char* path, uint32_t targetRate, SampleSource& out);
+
+// Reads `count` frames starting at frame `first` of a source into dst as
+// mono. Returns the frames read.
+uint32_t readSampleFrames(const SampleSource& src, uint32_t first, uint32_t count, int16_t* dst);
+
+// Converts a WAV to exactly `frames` mono frames at targetRate, into memory.
+bool convertSample(const char* path, uint32_t targetRate, int16_t* dst, uint32_t frames);
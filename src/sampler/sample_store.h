@@ -26,8 +26,17 @@ struct SampleView {
   const int16_t* pcm;   // pointer to data in pool
   uint32_t frames;      // valid length
   uint32_t sampleRate;  // original rate
+  // Streamed samples are viewed through a window: pcm holds frames
+  // [first, first + frames) of a sample totalFrames long. Whole-sample
+  // views leave both at 0.
+  uint32_t first = 0;
+  uint32_t totalFrames = 0;
   
   bool empty() const { return pcm == nullptr || frames == 0; }
+  // No data yet for a sample that exists: the stream has not caught up.
+  bool underflow() const { return empty() && totalFrames > 0; }
+  uint32_t length() const { return totalFrames ? totalFrames : frames; }
+  bool contains(uint32_t frame) const { return frame >= first && frame - first < frames; }
 };
 
 // Handle returned by acquireHandle - binds voice to a specific slot
@@ -62,6 +71,17 @@ public:
   // Audio Thread: Get direct view of data by handle.
   // O(1), no search, guaranteed not to block.
   virtual SampleView viewHandle(SampleHandle h) const = 0;
+
+  // Audio Thread: View for a voice whose playhead is at `frame`. Stores that
+  // stream from disk return the window holding it and read ahead in the
+  // playback direction; when that window is not loaded yet the view is an
+  // underflow rather than a wait. Stores holding whole samples ignore the
+  // position.
+  virtual SampleView viewHandleAt(SampleHandle h, uint32_t frame, bool reverse) {
+    (void)frame;
+    (void)reverse;
+    return viewHandle(h);
+  }
   
   // === Legacy ID-based API (deprecated, kept for compatibility) ===
   
@@ -79,5 +99,11 @@ public:
   
   // Debug/Stats
   virtual std::size_t freePoolBytes() const = 0;
+  // Biggest sample that fits without evicting; below freePoolBytes() when
+  // the free space is fragmented.
+  virtual std::size_t largestFreeBlock() const { return freePoolBytes(); }
   virtual void setPoolSize(std::size_t bytes) = 0;
+  // Engine rate that samples are converted to when loaded. Samples already
+  // loaded keep their rate; the voice resamples them.
+  virtual void setTargetSampleRate(uint32_t rate) { (void)rate; }
 };
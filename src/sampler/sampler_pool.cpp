@@ -27,6 +27,10 @@ void SamplerPool::process(float* output, uint32_t numFrames, ISampleStore& store
   }
 }
 
+void SamplerPool::setSampleRate(float sampleRate) {
+  for (auto& voice : voices_) voice.setSampleRate(sampleRate);
+}
+
 void SamplerPool::stopAll() {
   for (auto& voice : voices_) {
       if (voice.isActive()) {
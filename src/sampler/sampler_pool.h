@@ -15,6 +15,9 @@ public:
   // Audio Thread: Render and mix all active voices.
   void process(float* output, uint32_t numFrames, ISampleStore& store);
 
+  // Output rate for every voice in the pool
+  void setSampleRate(float sampleRate);
+
   // Stop all voices immediately
   void stopAll();
   
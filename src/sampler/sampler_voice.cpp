@@ -14,6 +14,14 @@ void SamplerVoice::reset() {
   fadeCounter_ = 0;
 }
 
+void SamplerVoice::setSampleRate(float sampleRate) {
+  if (sampleRate <= 0.0f) return;
+  outputRate_ = sampleRate;
+  fadeFrames_ = fadeFramesFor(static_cast<uint32_t>(sampleRate));
+  if (fadeFrames_ == 0) fadeFrames_ = 1;
+  if (fadeCounter_ > fadeFrames_) fadeCounter_ = fadeFrames_;
+}
+
 void SamplerVoice::trigger(const Params& params, ISampleStore& store) {
   // Release previous handle if active
   if (active_ && handle_.valid()) {
@@ -42,37 +50,45 @@ void SamplerVoice::trigger(const Params& params, ISampleStore& store) {
   
   active_ = true;
   fadingOut_ = false;
-  fadeCounter_ = kFadeFrames;
+  fadeCounter_ = fadeFrames_;
 }
 
 void SamplerVoice::stop() {
   if (active_ && !fadingOut_) {
     fadingOut_ = true;
-    fadeCounter_ = kFadeFrames;
+    fadeCounter_ = fadeFrames_;
   }
 }
 
 void SamplerVoice::process(float* output, uint32_t numFrames, ISampleStore& store) {
   if (!active_) return;
 
-  // O(1) view via handle - no search
-  SampleView view = store.viewHandle(handle_);
-  if (view.empty()) {
+  // O(1) view via handle - no search. Streamed samples come back as a
+  // window around the playhead, re-viewed when playback leaves it.
+  uint32_t playhead = position_ > 0.0 ? (uint32_t)position_ : 0;
+  SampleView view = store.viewHandleAt(handle_, playhead, reverse_);
+  if (view.empty() && !view.underflow()) {
     if (handle_.valid()) store.releaseHandle(handle_);
     handle_ = SampleHandle::invalid();
     active_ = false;
     return;
   }
 
-  const int16_t* pcm = view.pcm;
-  uint32_t totalFrames = view.frames;
+  uint32_t totalFrames = view.length();
   
   uint32_t actualEnd = (endFrame_ == 0 || endFrame_ > totalFrames) ? totalFrames : endFrame_;
   uint32_t actualStart = (startFrame_ >= actualEnd) ? 0 : startFrame_;
 
-  float srScale = (float)view.sampleRate / (float)kSampleRate;
+  float srScale = (float)view.sampleRate / outputRate_;
   double step = playbackRate_ * srScale;
   if (reverse_) step = -step;
+  // Samples load at the engine rate, so at the original pitch the playhead
+  // stays on whole frames and the next frame is never needed.
+  const bool wholeFrames = (step == 1.0 || step == -1.0) && position_ == (double)(int64_t)position_;
+
+  // Set once a re-view found no data: the rest of the block is silent rather
+  // than asking the store again every frame.
+  bool starved = false;
 
   for (uint32_t i = 0; i < numFrames; ++i) {
     double pos = position_;
@@ -85,19 +101,34 @@ void SamplerVoice::process(float* output, uint32_t numFrames, ISampleStore& stor
       active_ = false; 
       break;
     }
+
+    bool hasNext = !wholeFrames && i1 < (int)totalFrames;
+    if (!starved && (!view.contains(i0) || (hasNext && !view.contains(i1)))) {
+      view = store.viewHandleAt(handle_, (uint32_t)i0, reverse_);
+      starved = !view.contains(i0);
+    }
     
-    float s0 = (float)pcm[i0] / 32768.0f;
-    float s1 = s0;
-    if (i1 < (int)totalFrames) {
-      s1 = (float)pcm[i1] / 32768.0f;
+    // Underflow: silence, but the playhead keeps time.
+    float s0 = 0.0f;
+    float s1 = 0.0f;
+    if (!starved) {
+      const int16_t* pcm = view.pcm;
+      s0 = (float)pcm[i0 - view.first] / 32768.0f;
+      s1 = s0;
+      if (hasNext && view.contains(i1)) {
+        s1 = (float)pcm[i1 - view.first] / 32768.0f;
+      }
     }
     
-    float frac = (float)(pos - i0);
-    float sample = s0 + frac * (s1 - s0);
+    float sample = s0;
+    if (!wholeFrames) {
+      float frac = (float)(pos - i0);
+      sample = s0 + frac * (s1 - s0);
+    }
 
     float gain = 1.0f;
     if (fadingOut_) {
-      gain = (float)fadeCounter_ / (float)kFadeFrames;
+      gain = (float)fadeCounter_ / (float)fadeFrames_;
       if (fadeCounter_ > 0) fadeCounter_--;
       else {
         if (handle_.valid()) store.releaseHandle(handle_);
@@ -106,7 +137,7 @@ void SamplerVoice::process(float* output, uint32_t numFrames, ISampleStore& stor
         break;
       }
     } else if (fadeCounter_ > 0) {
-      gain = 1.0f - ((float)fadeCounter_ / (float)kFadeFrames);
+      gain = 1.0f - ((float)fadeCounter_ / (float)fadeFrames_);
       fadeCounter_--;
     }
 
@@ -25,10 +25,14 @@ public:
   void stop();
 
   // Audio Thread: Render audio into a mono buffer
-  // Note: will call store.release(id) when playback finishes.
+  // Note: will call store.release(id) when playback finishes. Streamed
+  // samples that have not caught up render as silence, in time.
   void process(float* output, uint32_t numFrames, ISampleStore& store);
 
   bool isActive() const { return active_; }
+
+  // Output rate the voice renders at; sets the resampling ratio and fade length.
+  void setSampleRate(float sampleRate);
   
   // Tag used for choke groups or identifying the source (e.g. pad index)
   int tag() const { return tag_; }
@@ -49,7 +53,10 @@ private:
   
   bool active_ = false;
   
+  float outputRate_ = static_cast<float>(kSampleRate);
+
   // Fade to prevent clicks
+  uint32_t fadeFrames_ = kFadeFrames;
   uint32_t fadeCounter_ = 0;
   bool fadingOut_ = false;
   
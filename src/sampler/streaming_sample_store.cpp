@@ -0,0 +1,281 @@
+#include "streaming_sample_store.h"
+#include "sample_loader.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define STREAM_MALLOC_PSRAM(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#else
+#include <chrono>
+#define STREAM_MALLOC_PSRAM(size) malloc(size)
+#endif
+
+static constexpr uint32_t kReaderIdleMs = 5;
+
+StreamingSampleStore::~StreamingSampleStore() {
+#if !defined(ARDUINO)
+  running_.store(false, std::memory_order_release);
+  if (worker_.joinable()) worker_.join();
+  for (auto& stream : streams_) {
+    for (auto& page : stream.pages) free(page.pcm);
+  }
+#endif
+}
+
+bool StreamingSampleStore::beginStreaming() {
+  if (running_.load(std::memory_order_acquire)) return true;
+
+  const std::size_t pageBytes = (kPageFrames + kPageOverlap) * sizeof(int16_t);
+  for (auto& stream : streams_) {
+    for (auto& page : stream.pages) {
+      if (!page.pcm) page.pcm = (int16_t*)STREAM_MALLOC_PSRAM(pageBytes);
+      if (!page.pcm) {
+        // Internal RAM is too small for this; large samples stay unplayable.
+        printf("Streaming: disabled, no PSRAM for %u-byte pages\n", (unsigned)pageBytes);
+        for (auto& s : streams_) {
+          for (auto& p : s.pages) { free(p.pcm); p.pcm = nullptr; }
+        }
+        return false;
+      }
+    }
+  }
+
+  running_.store(true, std::memory_order_release);
+#if defined(ARDUINO)
+  // UI core, but above the page prefetcher: a late page is audible.
+  BaseType_t ok = xTaskCreatePinnedToCore(workerTask_, "SampleStream", 6144, this, 2, nullptr, 0);
+  if (ok != pdPASS) {
+    running_.store(false, std::memory_order_release);
+    printf("Streaming: disabled, reader task create failed\n");
+    return false;
+  }
+#else
+  worker_ = std::thread(&StreamingSampleStore::workerLoop_, this);
+#endif
+  printf("Streaming: %d streams, %u KB of pages\n", kMaxStreams,
+         (unsigned)(kMaxStreams * 2 * pageBytes / 1024));
+  return true;
+}
+
+// === Audio thread ===
+
+SampleHandle StreamingSampleStore::acquireHandle(SampleId id) {
+  SampleHandle h = RamSampleStore::acquireHandle(id);
+  if (!h.valid() || !streaming()) return h;
+  if (sources_[h.slot].id.load(std::memory_order_acquire) != id.value) return h;
+
+  for (int i = 0; i < kMaxStreams; ++i) {
+    Stream& stream = streams_[i];
+    uint8_t expected = Free;
+    if (!stream.state.compare_exchange_strong(expected, Claimed, std::memory_order_acq_rel)) continue;
+    // The stream takes over the slot reference acquired above.
+    stream.slot = h.slot;
+    stream.id = id.value;
+    stream.playhead.store(0, std::memory_order_relaxed);
+    stream.reverse.store(false, std::memory_order_relaxed);
+    stream.state.store(Active, std::memory_order_release);
+    return {static_cast<uint16_t>(kMaxSampleSlots + i), id};
+  }
+  // All streams busy: play what is resident, then underflow.
+  return h;
+}
+
+void StreamingSampleStore::releaseHandle(SampleHandle h) {
+  if (!h.valid()) return;
+  if (h.slot < kMaxSampleSlots) {
+    RamSampleStore::releaseHandle(h);
+    return;
+  }
+  if (h.slot >= kMaxSampleSlots + kMaxStreams) return;
+  // The reader drops the slot reference once it is done with the file.
+  uint8_t expected = Active;
+  streams_[h.slot - kMaxSampleSlots].state.compare_exchange_strong(expected, Releasing,
+                                                                   std::memory_order_acq_rel);
+}
+
+SampleView StreamingSampleStore::residentView(uint16_t slotIdx, SampleId id) const {
+  const auto& slot = slots_[slotIdx];
+  if (slot.id.load(std::memory_order_relaxed) != id.value || !slot.ready.load(std::memory_order_acquire)) {
+    return {nullptr, 0, 0};
+  }
+  const int16_t* p = slot.data.load(std::memory_order_relaxed);
+  if (!p) return {nullptr, 0, 0};
+  const StreamSource& src = sources_[slotIdx];
+  uint32_t total = src.id.load(std::memory_order_acquire) == id.value ? src.file.frames : 0;
+  return {p, slot.frames, slot.sampleRate, 0, total};
+}
+
+SampleView StreamingSampleStore::viewHandle(SampleHandle h) const {
+  if (!h.valid()) return {nullptr, 0, 0};
+  if (h.slot < kMaxSampleSlots) return residentView(h.slot, h.id);
+  if (h.slot >= kMaxSampleSlots + kMaxStreams) return {nullptr, 0, 0};
+  return residentView(streams_[h.slot - kMaxSampleSlots].slot, h.id);
+}
+
+SampleView StreamingSampleStore::viewHandleAt(SampleHandle h, uint32_t frame, bool reverse) {
+  if (!h.valid() || h.slot < kMaxSampleSlots) return viewHandle(h);
+  if (h.slot >= kMaxSampleSlots + kMaxStreams) return {nullptr, 0, 0};
+  Stream& stream = streams_[h.slot - kMaxSampleSlots];
+
+  // Publish the playhead before looking up a page; the reader checks it
+  // again before reusing one (see fillStream_).
+  stream.reverse.store(reverse, std::memory_order_relaxed);
+  stream.playhead.store(frame, std::memory_order_seq_cst);
+
+  SampleView view = residentView(stream.slot, h.id);
+  if (view.empty() || frame + 1 < view.frames) return view;
+
+  uint32_t pageNo = frame / kPageFrames;
+  for (const auto& page : stream.pages) {
+    if (page.index.load(std::memory_order_seq_cst) == static_cast<int32_t>(pageNo)) {
+      return {page.pcm, page.frames, view.sampleRate, pageNo * kPageFrames, view.totalFrames};
+    }
+  }
+  underflows_.fetch_add(1, std::memory_order_relaxed);
+  return {nullptr, 0, view.sampleRate, 0, view.totalFrames};
+}
+
+// === Main thread ===
+
+bool StreamingSampleStore::preload(SampleId id) {
+  if (!streaming()) return RamSampleStore::preload(id);
+  if (touchLoaded(id)) return true;
+
+  std::string path;
+  if (!lookupPath(id, path)) return false;
+
+  // Converted samples stream from their cache entry; one that could only be
+  // converted in memory has to fit the pool.
+  SampleSource file;
+  if (!openSampleSource(path.c_str(), targetRate_.load(std::memory_order_relaxed), file) ||
+      file.needsConversion || (std::size_t)file.frames * sizeof(int16_t) <= kStreamAboveBytes) {
+    return RamSampleStore::preload(id);
+  }
+
+  uint32_t resident = (uint32_t)((uint64_t)file.sampleRate * kResidentMs / 1000);
+  resident = std::min(std::max<uint32_t>(resident, 2), file.frames);
+  int16_t* pcm = nullptr;
+  int slotIdx = reserveSlot(resident * sizeof(int16_t), &pcm);
+  if (slotIdx < 0) return false;
+  if (readSampleFrames(file, 0, resident, pcm) != resident) {
+    printf("Preload: readSampleFrames failed for %s\n", file.path.c_str());
+    cancelSlot(slotIdx);
+    return false;
+  }
+
+  // No stream can reference a free slot, so the reader is not using this.
+  StreamSource& src = sources_[slotIdx];
+  src.file = file;
+  src.id.store(id.value, std::memory_order_release);
+  publishSlot(slotIdx, id, resident, file.sampleRate);
+
+  printf("Preload: Streaming %s: %u frames, %u resident\n", path.c_str(), file.frames, resident);
+  return true;
+}
+
+// Evicted slots have no stream on them. Forget the file so the same id
+// reloaded whole into this slot is not taken for a streamed sample.
+void StreamingSampleStore::onSlotFreed(int slotIdx) {
+  StreamSource& src = sources_[slotIdx];
+  src.id.store(0, std::memory_order_release);
+  src.file = SampleSource{};
+}
+
+// === Reader ===
+
+// Loads at most one page for the stream. Returns true if it did any work.
+bool StreamingSampleStore::fillStream_(Stream& stream) {
+  if (stream.failed) return false;
+  const StreamSource& src = sources_[stream.slot];
+  uint32_t resident = slots_[stream.slot].frames;
+  int32_t lastPage = static_cast<int32_t>((src.file.frames - 1) / kPageFrames);
+
+  int32_t current = static_cast<int32_t>(stream.playhead.load(std::memory_order_seq_cst) / kPageFrames);
+  int32_t next = stream.reverse.load(std::memory_order_relaxed) ? current - 1 : current + 1;
+  const int32_t wanted[2] = {current, next};
+
+  for (int32_t pageNo : wanted) {
+    // Pages the resident head already answers for are never viewed.
+    if (pageNo < 0 || pageNo > lastPage || (uint32_t)(pageNo + 1) * kPageFrames < resident) continue;
+    if (stream.pages[0].index.load(std::memory_order_acquire) == pageNo ||
+        stream.pages[1].index.load(std::memory_order_acquire) == pageNo) {
+      continue;
+    }
+
+    StreamPage* victim = nullptr;
+    int32_t held = -1;
+    for (auto& page : stream.pages) {
+      held = page.index.load(std::memory_order_acquire);
+      if (held != wanted[0] && held != wanted[1]) {
+        victim = &page;
+        break;
+      }
+    }
+    if (!victim) continue;
+
+    // A voice that jumped (loop, retrigger position) may have just looked the
+    // victim up; it published its playhead first, so seeing it here is enough
+    // to leave that page alone until the next pass.
+    victim->index.store(-1, std::memory_order_seq_cst);
+    if (held >= 0 &&
+        static_cast<int32_t>(stream.playhead.load(std::memory_order_seq_cst) / kPageFrames) == held) {
+      victim->index.store(held, std::memory_order_release);
+      return true;
+    }
+
+    uint32_t first = static_cast<uint32_t>(pageNo) * kPageFrames;
+    uint32_t count = std::min(kPageFrames + kPageOverlap, src.file.frames - first);
+    uint32_t got = readSampleFrames(src.file, first, count, victim->pcm);
+    if (got == 0) {
+      printf("Streaming: read failed for %s at frame %u\n", src.file.path.c_str(), first);
+      stream.failed = true;
+      return true;
+    }
+    victim->frames = got;
+    victim->index.store(pageNo, std::memory_order_release);
+    return true;
+  }
+  return false;
+}
+
+// One pass over all streams. Returns false when there was nothing to do.
+bool StreamingSampleStore::step_() {
+  bool worked = false;
+  for (auto& stream : streams_) {
+    uint8_t state = stream.state.load(std::memory_order_acquire);
+    if (state == Releasing) {
+      for (auto& page : stream.pages) page.index.store(-1, std::memory_order_relaxed);
+      stream.failed = false;
+      RamSampleStore::releaseHandle({stream.slot, {stream.id}});
+      stream.state.store(Free, std::memory_order_release);
+      worked = true;
+    } else if (state == Active) {
+      worked |= fillStream_(stream);
+    }
+  }
+  return worked;
+}
+
+void StreamingSampleStore::workerLoop_() {
+  while (running_.load(std::memory_order_acquire)) {
+    if (!step_()) {
+#if defined(ARDUINO)
+      vTaskDelay(pdMS_TO_TICKS(kReaderIdleMs));
+#else
+      std::this_thread::sleep_for(std::chrono::milliseconds(kReaderIdleMs));
+#endif
+    }
+  }
+}
+
+#if defined(ARDUINO)
+void StreamingSampleStore::workerTask_(void* arg) {
+  static_cast<StreamingSampleStore*>(arg)->workerLoop_();
+  vTaskDelete(nullptr);
+}
+#endif
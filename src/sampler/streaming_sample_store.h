@@ -0,0 +1,105 @@
+#pragma once
+#include "ram_sample_store.h"
+#include "sample_loader.h"
+#include <array>
+#include <atomic>
+#include <string>
+
+#if !defined(ARDUINO)
+#include <thread>
+#endif
+
+// RamSampleStore that also plays samples too large for the pool (breaks,
+// stems). Such a sample keeps only its first kResidentMs in the pool, so a
+// trigger sounds at once; the rest is streamed from SD. Each voice playing a
+// streamed sample gets its own stream of two pages, which a background reader
+// keeps filled with the page under the playhead and the next one in the
+// playback direction.
+//
+// A page holds kPageFrames plus kPageOverlap frames of the next page, so a
+// voice crossing into the next page within one block still sees contiguous
+// data. viewHandleAt() never waits for the reader: if the page under the
+// playhead is not loaded yet it returns an underflow view and the voice plays
+// silence while keeping time. That is also how playback that starts
+// outside the resident head (reverse, a late start point) opens: the first
+// few blocks are silent until the reader has that page.
+//
+// Threading: acquireHandle/releaseHandle/viewHandleAt run on the audio
+// thread and only touch atomics. The reader owns page contents and hands
+// released streams (and their slot reference) back, so a sample is never
+// evicted while the reader still reads its file.
+class StreamingSampleStore : public RamSampleStore {
+public:
+  static constexpr int kMaxStreams = 10;  // SamplerPool voices, plus streams still being released
+  static constexpr uint32_t kResidentMs = 500;
+  static constexpr uint32_t kPageFrames = 8192;
+  static constexpr uint32_t kPageOverlap = 1024;
+  // Samples whose mono PCM is larger than this are streamed.
+  static constexpr std::size_t kStreamAboveBytes = 128 * 1024;
+
+  StreamingSampleStore() = default;
+  ~StreamingSampleStore() override;
+
+  // Allocates the stream pages (PSRAM only) and starts the reader. Until
+  // then, or if there is no PSRAM for them, every sample loads whole as in
+  // RamSampleStore. Safe to call twice.
+  bool beginStreaming();
+  bool streaming() const { return running_.load(std::memory_order_acquire); }
+
+  // Views that found their page missing, for diagnostics.
+  uint32_t underflowCount() const { return underflows_.load(std::memory_order_relaxed); }
+
+  SampleHandle acquireHandle(SampleId id) override;
+  void releaseHandle(SampleHandle h) override;
+  SampleView viewHandle(SampleHandle h) const override;
+  SampleView viewHandleAt(SampleHandle h, uint32_t frame, bool reverse) override;
+
+  bool preload(SampleId id) override;
+
+protected:
+  void onSlotFreed(int slotIdx) override;
+
+private:
+  enum StreamState : uint8_t { Free = 0, Claimed, Active, Releasing };
+
+  // Per-slot file info for streamed samples; `id` matches the slot's id
+  // only while the slot holds a streamed sample.
+  struct StreamSource {
+    std::atomic<uint32_t> id{0};
+    SampleSource file;
+  };
+
+  struct StreamPage {
+    std::atomic<int32_t> index{-1};  // page number held, -1 = none
+    uint32_t frames = 0;
+    int16_t* pcm = nullptr;
+  };
+
+  struct Stream {
+    std::atomic<uint8_t> state{Free};
+    uint16_t slot = 0;
+    uint32_t id = 0;
+    std::atomic<uint32_t> playhead{0};
+    std::atomic<bool> reverse{false};
+    bool failed = false;  // reader only
+    StreamPage pages[2];
+  };
+
+  SampleView residentView(uint16_t slot, SampleId id) const;
+
+  bool step_();
+  bool fillStream_(Stream& stream);
+  void workerLoop_();
+#if defined(ARDUINO)
+  static void workerTask_(void* arg);
+#endif
+
+  std::array<StreamSource, kMaxSampleSlots> sources_;
+  std::array<Stream, kMaxStreams> streams_;
+  std::atomic<uint32_t> underflows_{0};
+
+  std::atomic<bool> running_{false};
+#if !defined(ARDUINO)
+  std::thread worker_;
+#endif
+};
@@ -100,7 +100,12 @@ std::unique_ptr<IPage> MiniAcidDisplay::createPage_(int index) {
         case 7:  page = std::make_unique<SequencerHubPage>(gfx_, mini_acid_, audio_guard_); break;
         case 8:  page = std::make_unique<FeelTexturePage>(gfx_, mini_acid_, audio_guard_); break;
         case 9:  page = std::make_unique<SettingsPage>(gfx_, mini_acid_, audio_guard_); break;
-        case 10: page = std::make_unique<ProjectPage>(gfx_, mini_acid_, audio_guard_); break;
+        case 10: {
+            auto project = std::make_unique<ProjectPage>(gfx_, mini_acid_, audio_guard_);
+            project->setAudioRecorder(audio_recorder_);
+            page = std::move(project);
+            break;
+        }
         case 11: page = std::make_unique<ModePage>(gfx_, mini_acid_, audio_guard_); break;
     }
 #if defined(ESP32) || defined(ESP_PLATFORM)
@@ -153,11 +158,25 @@ void MiniAcidDisplay::setAudioGuard(AudioGuard guard) {
 
 void MiniAcidDisplay::setAudioRecorder(IAudioRecorder* recorder) {
     audio_recorder_ = recorder;
+    if (pages_.size() > 10 && pages_[10]) {
+        static_cast<ProjectPage*>(pages_[10].get())->setAudioRecorder(recorder);
+    }
 }
 
 void MiniAcidDisplay::update() {
     syncVisualStyle_();
+    mini_acid_.drainAudioHandBacks();
     handlePaging_();
+    // Also when the sequencer moved to other patterns and wants them copied.
+    if (patterns_dirty_ || mini_acid_.patternPublishWanted()) {
+        patterns_dirty_ = false;
+        mini_acid_.publishPatterns();
+    }
+    uint32_t dropped = mini_acid_.droppedCommandCount();
+    if (dropped != last_dropped_commands_) {
+        last_dropped_commands_ = dropped;
+        showToast("Audio busy: edit lost", 1500);
+    }
     gfx_.startWrite();
     if (splash_active_) {
         drawSplashScreen();
@@ -281,6 +300,10 @@ void MiniAcidDisplay::dismissSplash() {
 }
 
 bool MiniAcidDisplay::handleEvent(UIEvent event) {
+    // Any page may edit pattern data in place; hand a fresh copy to the
+    // sequencer on the next frame.
+    patterns_dirty_ = true;
+
     // Global Help Overlay takes priority when visible
     if (global_help_overlay_.isVisible()) {
         if (global_help_overlay_.handleEvent(event)) return true;
@@ -331,11 +354,14 @@ bool MiniAcidDisplay::handleEvent(UIEvent event) {
 
         // Global transport toggle: always available, independent from page handlers.
         if (event.key == ' ') {
+            // start()/stop() may be queued for the audio thread, so decide the
+            // toast from the state before posting.
+            const bool willPlay = !mini_acid_.isPlaying();
             withAudioGuard([&]() {
-                if (mini_acid_.isPlaying()) mini_acid_.stop();
-                else mini_acid_.start();
+                if (willPlay) mini_acid_.start();
+                else mini_acid_.stop();
             });
-            showToast(mini_acid_.isPlaying() ? "Play" : "Stop", 500);
+            showToast(willPlay ? "Play" : "Stop", 500);
             return true;
         }
 
@@ -598,6 +624,7 @@ void MiniAcidDisplay::drawDebugOverlay() {
     uint32_t s1, s2;
     uint32_t underruns;
     float cpuIdeal, cpuActual;
+    uint8_t tier;
     
     // Retry loop until we get a consistent snapshot
     do {
@@ -605,6 +632,7 @@ void MiniAcidDisplay::drawDebugOverlay() {
         underruns = stats.audioUnderruns;
         cpuIdeal = stats.cpuAudioPctIdeal;
         cpuActual = stats.cpuAudioPctActual;
+        tier = stats.qualityTier;
         s2 = stats.seq;
     } while (s1 != s2 || (s1 & 1));  // Retry if torn read or mid-write
     
@@ -630,6 +658,10 @@ void MiniAcidDisplay::drawDebugOverlay() {
     // Underruns
     snprintf(buf, sizeof(buf), "UNDR:%u", underruns);
     gfx_.drawText(2, yy, buf); yy += 10;
+
+    // Active CPU quality tier
+    snprintf(buf, sizeof(buf), "Q:%s", qualityTierName(static_cast<QualityTier>(tier)));
+    gfx_.drawText(2, yy, buf); yy += 10;
 }
 bool MiniAcidDisplay::translateToApplicationEvent(UIEvent& event) { return false; }
 
@@ -664,10 +696,21 @@ void MiniAcidDisplay::handlePaging_() {
         int target = mini_acid_.targetPageIndex();
         if (target >= 0) {
             // Serial.printf("[Page] Loading target %d\n", target);
-            char buf[32];
-            snprintf(buf, sizeof(buf), "Switching to Page %d...", target + 1);
-            showToast(buf, 800);
-            
+            if (target != paging_toast_target_) {
+                paging_toast_target_ = target;
+                char buf[32];
+                snprintf(buf, sizeof(buf), "Switching to Page %d...", target + 1);
+                showToast(buf, 800);
+            }
+
+#if defined(ESP32) || defined(ESP_PLATFORM)
+            // Swap the page in once the prefetcher has read it; only fall
+            // back to blocking SD I/O without one.
+            if (mini_acid_.pagePrefetchActive()) {
+                mini_acid_.swapInPrefetchedPage();
+                return;
+            }
+#endif
             withAudioGuard([&]() {
 #if defined(ESP32) || defined(ESP_PLATFORM)
                 // AUTO-SAVE: Save current page before swapping data
@@ -688,5 +731,7 @@ void MiniAcidDisplay::handlePaging_() {
         } else {
             mini_acid_.setPageLoading(false);
         }
+    } else {
+        paging_toast_target_ = -1;
     }
 }
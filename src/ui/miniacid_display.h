@@ -84,4 +84,8 @@ private:
   unsigned long cycle_pulse_until_ms_ = 0;
   VisualStyle applied_visual_style_ = VisualStyle::MINIMAL;
   bool visual_style_initialized_ = false;
+  // Set by handleEvent; update() then publishes the patterns to the sequencer.
+  bool patterns_dirty_ = false;
+  int paging_toast_target_ = -1;
+  uint32_t last_dropped_commands_ = 0;
 };
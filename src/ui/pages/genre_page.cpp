@@ -905,10 +905,10 @@ void GenrePage::cycleRecipeSelection(int direction) {
 
     withAudioGuard([&]() {
         if (mini_acid_.isPlaying()) {
-            mini_acid_.genreManager().queueRecipe(static_cast<GenreRecipeId>(recipeIndex_));
-            mini_acid_.genreManager().queueMorphTarget(
-                morphAmount_ > 0 ? static_cast<GenreRecipeId>(recipeIndex_) : kBaseRecipeId);
-            mini_acid_.genreManager().queueMorphAmount(static_cast<uint8_t>(morphAmount_));
+            mini_acid_.queueGenreRecipe(
+                static_cast<GenreRecipeId>(recipeIndex_),
+                morphAmount_ > 0 ? static_cast<GenreRecipeId>(recipeIndex_) : kBaseRecipeId,
+                static_cast<uint8_t>(morphAmount_));
         } else {
             mini_acid_.genreManager().setRecipe(static_cast<GenreRecipeId>(recipeIndex_));
             mini_acid_.genreManager().setMorphTarget(
@@ -939,8 +939,7 @@ void GenrePage::adjustMorphAmount(int delta) {
     const uint8_t nextAmount = static_cast<uint8_t>(morphAmount_);
     withAudioGuard([&]() {
         if (mini_acid_.isPlaying()) {
-            mini_acid_.genreManager().queueMorphTarget(nextTarget);
-            mini_acid_.genreManager().queueMorphAmount(nextAmount);
+            mini_acid_.queueGenreRecipe(static_cast<GenreRecipeId>(recipeIndex_), nextTarget, nextAmount);
         } else {
             mini_acid_.genreManager().setMorphTarget(nextTarget);
             mini_acid_.genreManager().setMorphAmount(nextAmount);
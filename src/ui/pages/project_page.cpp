@@ -1,6 +1,7 @@
 #include "project_page.h"
 #include "../ui_common.h"
 #include "../../audio/midi_importer.h"
+#include "../../audio/audio_recorder.h"
 #include <algorithm>
 #include <vector>
 #ifdef ARDUINO
@@ -125,6 +126,7 @@ const char* sectionName(int section) {
     case 0: return "SCENES";
     case 1: return "GROOVE";
     case 2: return "LED";
+    case 3: return "AUDIO";
     default: return "SCENES";
   }
 }
@@ -143,6 +145,10 @@ void sectionRange(int section, int& first, int& last) {
       first = (int)ProjectPage::MainFocus::LedMode;
       last = (int)ProjectPage::MainFocus::LedFlash;
       return;
+    case 3: // audio
+      first = (int)ProjectPage::MainFocus::AudioRate;
+      last = (int)ProjectPage::MainFocus::AudioRecord;
+      return;
     default:
       first = 0;
       last = 2;
@@ -150,6 +156,40 @@ void sectionRange(int section, int& first, int& last) {
   }
 }
 
+// Steps the runtime audio config; the platform applies it between blocks.
+// Picking a block size by hand turns auto-tune off. A WAV file has one rate,
+// so a running recording is closed here, on the UI thread, before the audio
+// task sees the new rate.
+bool adjustAudioConfig(MiniAcid& engine, IAudioRecorder* recorder,
+                       ProjectPage::MainFocus focus, int delta) {
+  AudioConfig cfg = engine.audioConfig();
+  if (focus == ProjectPage::MainFocus::AudioRate) {
+    int idx = 0;
+    for (int i = 0; i < kSupportedSampleRateCount; ++i) {
+      if (kSupportedSampleRates[i] == cfg.sampleRate) idx = i;
+    }
+    idx = (idx + delta + kSupportedSampleRateCount) % kSupportedSampleRateCount;
+    cfg.sampleRate = kSupportedSampleRates[idx];
+  } else if (focus == ProjectPage::MainFocus::AudioBlock) {
+    uint32_t frames = delta > 0 ? cfg.blockFrames * 2 : cfg.blockFrames / 2;
+    if (frames < kMinBlockFrames) frames = kMaxBlockFrames;
+    if (frames > kMaxBlockFrames) frames = kMinBlockFrames;
+    cfg.blockFrames = frames;
+    cfg.autoTune = false;
+  } else if (focus == ProjectPage::MainFocus::AudioAutoTune) {
+    cfg.autoTune = !cfg.autoTune;
+  } else if (focus == ProjectPage::MainFocus::AudioDualCore) {
+    cfg.dualCore = !cfg.dualCore;
+  } else {
+    return false;
+  }
+  if (recorder && recorder->isRecording() && cfg.sampleRate != engine.audioConfig().sampleRate) {
+    recorder->stop();
+  }
+  engine.requestAudioConfig(cfg);
+  return true;
+}
+
 constexpr size_t kMaxMidiDirsInUi = 24;
 constexpr size_t kMaxMidiFilesInUi = 48;
 #if defined(ESP32) || defined(ESP_PLATFORM)
@@ -674,10 +714,13 @@ bool ProjectPage::deleteSelectionInDialog() {
     if (scenes_.empty()) return true;
     if (selection_index_ < 0 || selection_index_ >= (int)scenes_.size()) return true;
     std::string name = scenes_[selection_index_];
-    std::string path = "/scenes/" + name + ".json";
-    std::string autoPath = "/scenes/" + name + ".auto.json";
-    bool removed = SD.remove(path.c_str());
-    SD.remove(autoPath.c_str());
+    std::string base = "/scenes/" + name;
+    bool removed = SD.remove((base + ".json").c_str());
+    removed = SD.remove((base + ".gps").c_str()) || removed;
+    SD.remove((base + ".auto.json").c_str());
+    SD.remove((base + ".auto.gps").c_str());
+    SD.remove((base + ".auto.gps.tmp").c_str());
+    SD.remove((base + ".journal").c_str());
     if (removed) {
       UI::showToast("Scene deleted");
       refreshScenes();
@@ -778,6 +821,25 @@ void ProjectPage::ensureMainFocusVisible(int visibleRows) {
   if (main_scroll_ > maxScroll) main_scroll_ = maxScroll;
 }
 
+// start()/stop() run here on the UI thread; the audio task only ever calls
+// writeSamples(). The file takes the current rate, mono like the output.
+void ProjectPage::toggleRecording() {
+  if (!audio_recorder_) {
+    UI::showToast("Recording unavailable");
+    return;
+  }
+  char toast[64];
+  if (audio_recorder_->isRecording()) {
+    audio_recorder_->stop();
+    std::snprintf(toast, sizeof(toast), "Saved %s", audio_recorder_->filename().c_str());
+  } else if (audio_recorder_->start((int)mini_acid_.audioConfig().sampleRate, 1)) {
+    std::snprintf(toast, sizeof(toast), "REC %s", audio_recorder_->filename().c_str());
+  } else {
+    std::snprintf(toast, sizeof(toast), "Record failed");
+  }
+  UI::showToast(toast);
+}
+
 bool ProjectPage::loadSceneAtSelection() {
   if (scenes_.empty()) return true;
   if (selection_index_ < 0 || selection_index_ >= static_cast<int>(scenes_.size())) return true;
@@ -1363,7 +1425,7 @@ bool ProjectPage::handleEvent(UIEvent& ui_event) {
     char key = ui_event.key;
     if (key == '\t') {
         int sectionIdx = static_cast<int>(section_);
-        sectionIdx = (sectionIdx + 1) % 3;
+        sectionIdx = (sectionIdx + 1) % 4;
         section_ = static_cast<ProjectSection>(sectionIdx);
         int focusIdx = static_cast<int>(main_focus_);
         if (!focusInSection(sectionIdx, focusIdx)) {
@@ -1416,6 +1478,8 @@ bool ProjectPage::handleEvent(UIEvent& ui_event) {
                 genre.applySoundMacros = !genre.applySoundMacros;
                 return true;
             }
+            if (main_focus_ == MainFocus::AudioRecord) { toggleRecording(); return true; }
+            if (adjustAudioConfig(mini_acid_, audio_recorder_, main_focus_, right ? 1 : -1)) return true;
             if (main_focus_ == MainFocus::LedMode) {
                 int m = static_cast<int>(led.mode);
                 m += right ? 1 : -1;
@@ -1508,6 +1572,9 @@ bool ProjectPage::handleEvent(UIEvent& ui_event) {
             return true;
         }
         
+        if (main_focus_ == MainFocus::AudioRecord) { toggleRecording(); return true; }
+        if (adjustAudioConfig(mini_acid_, audio_recorder_, main_focus_, 1)) return true;
+
         auto& led = mini_acid_.sceneManager().currentScene().led;
         if (main_focus_ == MainFocus::LedMode) { led.mode = static_cast<LedMode>((static_cast<int>(led.mode) + 1) % 4); return true; }
         if (main_focus_ == MainFocus::LedSource) {
@@ -1740,6 +1807,7 @@ void ProjectPage::draw(IGfx& gfx) {
   }
 
   // Main Page Drawing
+  const AudioConfig audio = mini_acid_.audioConfig();
   const int rowBase = 2;
   const int visibleRows = 8;
   for (int row = 0; row < visibleRows; ++row) {
@@ -1801,6 +1869,24 @@ void ProjectPage::draw(IGfx& gfx) {
       case MainFocus::LedFlash:
         std::snprintf(line, sizeof(line), "LED Flash  %ums", (unsigned)led.flashMs);
         break;
+      case MainFocus::AudioRate:
+        std::snprintf(line, sizeof(line), "Rate       %uHz", (unsigned)audio.sampleRate);
+        break;
+      case MainFocus::AudioBlock:
+        std::snprintf(line, sizeof(line), "Block      %u%s", (unsigned)audio.blockFrames,
+                      audio.autoTune ? " auto" : "");
+        break;
+      case MainFocus::AudioAutoTune:
+        std::snprintf(line, sizeof(line), "Auto Block [%s]", audio.autoTune ? "ON" : "OFF");
+        break;
+      case MainFocus::AudioDualCore:
+        std::snprintf(line, sizeof(line), "Dual Core  [%s]", audio.dualCore ? "ON" : "OFF");
+        break;
+      case MainFocus::AudioRecord: {
+        bool rec = audio_recorder_ && audio_recorder_->isRecording();
+        std::snprintf(line, sizeof(line), "Record WAV [%s]", rec ? "REC" : "OFF");
+        break;
+      }
     }
     Widgets::drawListRow(gfx, x, LayoutManager::lineY(rowBase + row), listW, line, selected);
   }
@@ -1816,7 +1902,13 @@ void ProjectPage::draw(IGfx& gfx) {
   static char perf0[42];
   static char perf1[42];
   static char perf2[42];
-  std::snprintf(perf0, sizeof(perf0), "CPU:%d/%d%%", cpuAvg, cpuPeak);
+  const QualityTier tier = mini_acid_.qualityTier();
+  if (tier == QualityTier::Full) {
+    std::snprintf(perf0, sizeof(perf0), "CPU:%d/%d%%", cpuAvg, cpuPeak);
+  } else {
+    // Governor is trading quality for CPU; show which tier is active.
+    std::snprintf(perf0, sizeof(perf0), "CPU:%d/%d%% %s", cpuAvg, cpuPeak, qualityTierName(tier));
+  }
   std::snprintf(perf1, sizeof(perf1), "RAM:%uk/%uk",
                 (unsigned)(freeInt / 1024), (unsigned)(largestInt / 1024));
   std::snprintf(perf2, sizeof(perf2), "Th:%s  M:%s",
@@ -1830,6 +1922,7 @@ int ProjectPage::firstFocusInSection(int sectionIdx) {
   if (sectionIdx == 0) return (int)ProjectPage::MainFocus::Load;
   if (sectionIdx == 1) return (int)ProjectPage::MainFocus::VisualStyle;
   if (sectionIdx == 2) return (int)ProjectPage::MainFocus::LedMode;
+  if (sectionIdx == 3) return (int)ProjectPage::MainFocus::AudioRate;
   return 0;
 }
 
@@ -1837,6 +1930,7 @@ int ProjectPage::lastFocusInSection(int sectionIdx) {
   if (sectionIdx == 0) return (int)ProjectPage::MainFocus::ClearProject;
   if (sectionIdx == 1) return (int)ProjectPage::MainFocus::Volume;
   if (sectionIdx == 2) return (int)ProjectPage::MainFocus::LedFlash;
+  if (sectionIdx == 3) return (int)ProjectPage::MainFocus::AudioRecord;
   return 0;
 }
 
@@ -1845,6 +1939,7 @@ bool ProjectPage::focusInSection(int sectionIdx, int focusIdx) {
   if (sectionIdx == 0) return f >= ProjectPage::MainFocus::Load && f <= ProjectPage::MainFocus::ClearProject;
   if (sectionIdx == 1) return f >= ProjectPage::MainFocus::VisualStyle && f <= ProjectPage::MainFocus::Volume;
   if (sectionIdx == 2) return f >= ProjectPage::MainFocus::LedMode && f <= ProjectPage::MainFocus::LedFlash;
+  if (sectionIdx == 3) return f >= ProjectPage::MainFocus::AudioRate && f <= ProjectPage::MainFocus::AudioRecord;
   return false;
 }
 
@@ -6,9 +6,12 @@
 #include "help_dialog.h"
 #include "../../audio/midi_importer.h"
 
+class IAudioRecorder;
+
 class ProjectPage : public IPage, public IMultiHelpFramesProvider {
  public:
   ProjectPage(IGfx& gfx, MiniAcid& mini_acid, AudioGuard audio_guard);
+  void setAudioRecorder(IAudioRecorder* recorder) { audio_recorder_ = recorder; }
   void draw(IGfx& gfx) override;
   void onEnter(int context = 0) override;
   bool handleEvent(UIEvent& ui_event) override;
@@ -17,8 +20,8 @@ class ProjectPage : public IPage, public IMultiHelpFramesProvider {
   std::unique_ptr<MultiPageHelpDialog> getHelpDialog() override;
   int getHelpFrameCount() const override;
   void drawHelpFrame(IGfx& gfx, int frameIndex, Rect bounds) const override;
-  enum class ProjectSection { Scenes = 0, Groove, Led };
-  enum class MainFocus { Load = 0, SaveAs, New, ImportMidi, ClearProject, VisualStyle, GrooveMode, GrooveFlavor, ApplyMacros, Volume, LedMode, LedSource, LedColor, LedBri, LedFlash };
+  enum class ProjectSection { Scenes = 0, Groove, Led, Audio };
+  enum class MainFocus { Load = 0, SaveAs, New, ImportMidi, ClearProject, VisualStyle, GrooveMode, GrooveFlavor, ApplyMacros, Volume, LedMode, LedSource, LedColor, LedBri, LedFlash, AudioRate, AudioBlock, AudioAutoTune, AudioDualCore, AudioRecord };
 
  private:
   enum class DialogType { None = 0, Load, SaveAs, ImportMidi, MidiAdvance, ConfirmClear };
@@ -65,6 +68,7 @@ class ProjectPage : public IPage, public IMultiHelpFramesProvider {
   bool deleteSelectionInDialog();
   bool handleSaveDialogInput(char key);
   void ensureMainFocusVisible(int visibleRows);
+  void toggleRecording();
   template <typename F>
   void withAudioGuard(F&& fn) {
       if (audio_guard_) audio_guard_(std::forward<F>(fn));
@@ -76,6 +80,7 @@ class ProjectPage : public IPage, public IMultiHelpFramesProvider {
   IGfx& gfx_;
   MiniAcid& mini_acid_;
   AudioGuard audio_guard_;
+  IAudioRecorder* audio_recorder_ = nullptr;
   MainFocus main_focus_;
   ProjectSection section_ = ProjectSection::Scenes;
   DialogType dialog_type_;
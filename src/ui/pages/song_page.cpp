@@ -920,15 +920,6 @@ bool SongPage::handleEvent(UIEvent& ui_event) {
   }
 
   if (ui_event.event_type == GROOVEPUTER_APPLICATION_EVENT) {
-    auto trackFromIndex = [](int idx) {
-      switch (idx) {
-        case 0: return SongTrack::SynthA;
-        case 1: return SongTrack::SynthB;
-        case 2: return SongTrack::Drums;
-        default: return SongTrack::Voice;
-      }
-    };
-
     bool wholeSongScope = cursorOnModeButton() || cursorOnPlayheadLabel();
     bool trackValid = false;
     SongTrack track = trackForColumn(cursorTrack(), trackValid);
@@ -987,14 +978,7 @@ bool SongPage::handleEvent(UIEvent& ui_event) {
           g_song_slot_clipboard.source_slot = mini_acid_.activeSongSlot();
           g_song_slot_clipboard.has_song = true;
           withAudioGuard([&]() {
-            for (int r = 0; r < Song::kMaxPositions; ++r) {
-              mini_acid_.clearSongPattern(r, SongTrack::SynthA);
-              mini_acid_.clearSongPattern(r, SongTrack::SynthB);
-              mini_acid_.clearSongPattern(r, SongTrack::Drums);
-              mini_acid_.clearSongPattern(r, SongTrack::Voice);
-            }
-            mini_acid_.setSongLength(1);
-            mini_acid_.setSongReverse(false);
+            mini_acid_.replaceSong(Song{});
             if (mini_acid_.songModeEnabled() && !mini_acid_.isPlaying()) {
               mini_acid_.setSongPosition(0);
             }
@@ -1067,23 +1051,9 @@ bool SongPage::handleEvent(UIEvent& ui_event) {
         if (wholeSongScope) {
           if (!g_song_slot_clipboard.has_song) return false;
           Song pasted = g_song_slot_clipboard.song;
+          for (int r = pasted.length; r < Song::kMaxPositions; ++r) pasted.positions[r] = SongPosition{};
           withAudioGuard([&]() {
-            for (int r = 0; r < Song::kMaxPositions; ++r) {
-              mini_acid_.clearSongPattern(r, SongTrack::SynthA);
-              mini_acid_.clearSongPattern(r, SongTrack::SynthB);
-              mini_acid_.clearSongPattern(r, SongTrack::Drums);
-              mini_acid_.clearSongPattern(r, SongTrack::Voice);
-            }
-            mini_acid_.setSongLength(pasted.length);
-            mini_acid_.setSongReverse(pasted.reverse);
-            for (int r = 0; r < pasted.length && r < Song::kMaxPositions; ++r) {
-              for (int t = 0; t < SongPosition::kTrackCount; ++t) {
-                int pattern = pasted.positions[r].patterns[t];
-                SongTrack tr = trackFromIndex(t);
-                if (pattern < 0) mini_acid_.clearSongPattern(r, tr);
-                else mini_acid_.setSongPattern(r, tr, pattern);
-              }
-            }
+            mini_acid_.replaceSong(pasted);
             if (mini_acid_.songModeEnabled() && !mini_acid_.isPlaying()) {
               mini_acid_.setSongPosition(0);
             }
@@ -144,11 +144,8 @@ class TapePage::ModeComponent : public FocusableComponent {
   }
 
   void cycleMode() {
-    guard_([this](){
-      TapeState& tape = synth_.sceneManager().currentScene().tape;
-      tape.mode = nextTapeMode(tape.mode);
-      synth_.tapeLooper->setMode(tape.mode);
-    });
+    const TapeState& tape = synth_.sceneManager().currentScene().tape;
+    synth_.setTapeMode(nextTapeMode(tape.mode), synth_.tapeLooper->dubAutoExit());
   }
 
  private:
@@ -196,7 +193,6 @@ class TapePage::PresetComponent : public FocusableComponent {
       } else {
         loadTapePreset(tape.preset, tape.macro);
       }
-      synth_.tapeFX->applyMacro(tape.macro);
     });
   }
 
@@ -225,7 +221,6 @@ void TapePage::initComponents() {
         case 3: macro.tone = val; break;
         case 4: macro.crush = val; break;
       }
-      mini_acid_.tapeFX->applyMacro(macro);
     });
   };
 
@@ -238,7 +233,6 @@ void TapePage::initComponents() {
     audio_guard_([this, v]() {
       TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
       tape.looperVolume = static_cast<float>(v) / 100.0f;
-      mini_acid_.tapeLooper->setVolume(tape.looperVolume);
     });
   });
 
@@ -385,12 +379,7 @@ bool TapePage::handleEvent(UIEvent& ui_event) {
   char lowerKey = static_cast<char>(std::tolower(static_cast<unsigned char>(ui_event.key)));
 
   auto setTapeMode = [this](TapeMode mode) {
-    audio_guard_([this, mode]() {
-      TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
-      tape.mode = mode;
-      mini_acid_.tapeLooper->setDubAutoExit(false);
-      mini_acid_.tapeLooper->setMode(mode);
-    });
+    mini_acid_.setTapeMode(mode, false);
   };
   
   // Q-I Pattern Selection (Standardized)
@@ -406,27 +395,19 @@ bool TapePage::handleEvent(UIEvent& ui_event) {
 
   // Hotkeys
   if (lowerKey == 'x' && !ui_event.ctrl && !ui_event.alt && !ui_event.shift && !ui_event.meta) {
-    audio_guard_([this]() {
-      TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
-      const bool hasLoop = mini_acid_.tapeLooper->hasLoop();
-      const bool isFirstRec = mini_acid_.tapeLooper->isFirstRecordPass();
-
-      if (!hasLoop) {
-        // No loop yet: X arms/starts REC, second X closes take into PLAY.
-        tape.mode = (tape.mode == TapeMode::Rec && isFirstRec) ? TapeMode::Play : TapeMode::Rec;
-        mini_acid_.tapeLooper->setDubAutoExit(false);
-      } else {
-        // Existing loop: X toggles PLAY <-> DUB as performance workflow.
-        if (tape.mode == TapeMode::Dub) {
-          tape.mode = TapeMode::Play;
-          mini_acid_.tapeLooper->setDubAutoExit(false);
-        } else {
-          tape.mode = TapeMode::Dub;
-          mini_acid_.tapeLooper->setDubAutoExit(true);  // safety: one cycle only
-        }
-      }
-      mini_acid_.tapeLooper->setMode(tape.mode);
-    });
+    const TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
+    const bool hasLoop = mini_acid_.tapeLooper->hasLoop();
+    const bool isFirstRec = mini_acid_.tapeLooper->isFirstRecordPass();
+
+    if (!hasLoop) {
+      // No loop yet: X arms/starts REC, second X closes take into PLAY.
+      mini_acid_.setTapeMode((tape.mode == TapeMode::Rec && isFirstRec) ? TapeMode::Play : TapeMode::Rec, false);
+    } else if (tape.mode == TapeMode::Dub) {
+      // Existing loop: X toggles PLAY <-> DUB as performance workflow.
+      mini_acid_.setTapeMode(TapeMode::Play, false);
+    } else {
+      mini_acid_.setTapeMode(TapeMode::Dub, true);  // safety: one cycle only
+    }
     return true;
   }
 
@@ -437,25 +418,16 @@ bool TapePage::handleEvent(UIEvent& ui_event) {
 
   // Performance actions for small-screen live workflow.
   if (lowerKey == 'a' && !ui_event.ctrl && !ui_event.alt && !ui_event.shift && !ui_event.meta) {
-    audio_guard_([this]() {
-      TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
-      mini_acid_.tapeLooper->clear();
-      mini_acid_.tapeLooper->setDubAutoExit(false);
-      tape.mode = TapeMode::Rec;
-      tape.fxEnabled = true;
-      mini_acid_.tapeLooper->setMode(tape.mode);
-    });
+    mini_acid_.clearTapeLoop();
+    mini_acid_.sceneManager().currentScene().tape.fxEnabled = true;
+    mini_acid_.setTapeMode(TapeMode::Rec, false);
     UI::showToast("CAPTURE: REC", 1000);
     return true;
   }
   if (lowerKey == 's' && !ui_event.ctrl && !ui_event.alt && !ui_event.shift && !ui_event.meta) {
-    audio_guard_([this]() {
-      TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
-      if (!mini_acid_.tapeLooper->hasLoop()) return;
-      tape.mode = TapeMode::Dub;
-      mini_acid_.tapeLooper->setDubAutoExit(true);  // one cycle safety
-      mini_acid_.tapeLooper->setMode(tape.mode);
-    });
+    if (mini_acid_.tapeLooper->hasLoop()) {
+      mini_acid_.setTapeMode(TapeMode::Dub, true);  // one cycle safety
+    }
     if (mini_acid_.tapeLooper->hasLoop()) UI::showToast("THICKEN: DUB x1", 900);
     else UI::showToast("THICKEN: NO LOOP", 900);
     return true;
@@ -479,7 +451,6 @@ bool TapePage::handleEvent(UIEvent& ui_event) {
         tape.groove = perf_prev_groove_;
         perf_wash_active_ = false;
       }
-      mini_acid_.tapeFX->applyMinimalParams(tape.space, tape.movement, tape.groove);
     });
     UI::showToast(perf_wash_active_ ? "WASH: ON" : "WASH: OFF", 900);
     return true;
@@ -495,7 +466,6 @@ bool TapePage::handleEvent(UIEvent& ui_event) {
         tape.looperVolume = perf_prev_loop_volume_;
         perf_loop_muted_ = false;
       }
-      mini_acid_.tapeLooper->setVolume(tape.looperVolume);
     });
     UI::showToast(perf_loop_muted_ ? "LOOP: MUTED" : "LOOP: UNMUTED", 900);
     return true;
@@ -522,42 +492,29 @@ bool TapePage::handleEvent(UIEvent& ui_event) {
       audio_guard_([this](){
         TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
         tape.speed = 0; // 0.5x
-        mini_acid_.tapeLooper->setSpeed(tape.speed);
       });
       return true;
     case '2':
       audio_guard_([this](){
         TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
         tape.speed = 1; // 1.0x
-        mini_acid_.tapeLooper->setSpeed(tape.speed);
       });
       return true;
     case '3':
       audio_guard_([this](){
         TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
         tape.speed = 2; // 2.0x
-        mini_acid_.tapeLooper->setSpeed(tape.speed);
       });
       return true;
     case '\n': // Enter = stutter toggle
-      audio_guard_([this](){
-        const bool active = mini_acid_.tapeLooper->stutterActive();
-        mini_acid_.tapeLooper->setStutter(!active);
-      });
+      mini_acid_.toggleTapeStutter();
       return true;
     case '\b': // Backspace/Del = eject
     case 0x7F:
-      audio_guard_([this](){
-        mini_acid_.tapeLooper->eject();
-        TapeState& tape = mini_acid_.sceneManager().currentScene().tape;
-        tape.mode = TapeMode::Stop;
-        tape.fxEnabled = false;
-      });
+      mini_acid_.ejectTape();
       return true;
     case ' ':
-      audio_guard_([this](){
-        mini_acid_.tapeLooper->clear();
-      });
+      mini_acid_.clearTapeLoop();
       return true;
   }
 